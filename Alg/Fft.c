@@ -0,0 +1,475 @@
+/*********************************************************************************************************
+* 模块名称：Fft.c
+* 摘    要：Q15定点基2实数FFT，块浮点缩放，供振动监测等频谱分析使用
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：复数FFT为按时间抽取，先位反序重排，再逐级蝶形；旋转因子查1024点正弦表的四分之一周期，
+*           点数较少时按步长跳着查；
+*           溢出分析：旋转因子的模不超过1，蝶形输出的模不超过两个输入的模之和，
+*           输入各分量不超过FFT_NOSCALE_MAX时输出的模不超过23170，否则右移1位后不超过输入的模，
+*           所以只要输入的模不超过32767，每级之后仍不超过32767
+* 注    意：
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "Fft.h"
+#if (defined FFT_BENCH) && (FFT_BENCH == TRUE)
+#include "UART1.h"
+#endif
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#define FFT_SIN_PERIOD   (1 << FFT_LOG2N_MAX)   //正弦表对应的整周期点数
+#define FFT_SIN_QUARTER  (FFT_SIN_PERIOD / 4)    //正弦表只存四分之一周期
+#define FFT_NOSCALE_MAX  8191                    //各分量都不超过此值时本级不移位
+
+#if (defined FFT_BENCH) && (FFT_BENCH == TRUE)
+#define DEMCR       (*(volatile uint32*)0xE000EDFC)  //调试异常和监视控制寄存器，bit24-TRCENA
+#define DWT_CTRL    (*(volatile uint32*)0xE0001000)  //DWT控制寄存器，bit0-CYCCNTENA
+#define DWT_CYCCNT  (*(volatile uint32*)0xE0001004)  //DWT周期计数器
+#endif
+
+/*********************************************************************************************************
+*                                              枚举结构体定义
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              内部变量
+*********************************************************************************************************/
+//sin(2 * pi * i / 1024)，i = 0 ~ 256，Q15，1.0记为32767
+static const int16 s_arrSinQ15[FFT_SIN_QUARTER + 1] =
+{
+      0,   201,   402,   603,   804,  1005,  1206,  1407,  1608,  1809,  2009,  2210,
+   2411,  2611,  2811,  3012,  3212,  3412,  3612,  3812,  4011,  4211,  4410,  4609,
+   4808,  5007,  5205,  5404,  5602,  5800,  5998,  6195,  6393,  6590,  6787,  6983,
+   7180,  7376,  7571,  7767,  7962,  8157,  8351,  8546,  8740,  8933,  9127,  9319,
+   9512,  9704,  9896, 10088, 10279, 10469, 10660, 10850, 11039, 11228, 11417, 11605,
+  11793, 11980, 12167, 12354, 12540, 12725, 12910, 13095, 13279, 13463, 13646, 13828,
+  14010, 14192, 14373, 14553, 14733, 14912, 15091, 15269, 15447, 15624, 15800, 15976,
+  16151, 16326, 16500, 16673, 16846, 17018, 17190, 17361, 17531, 17700, 17869, 18037,
+  18205, 18372, 18538, 18703, 18868, 19032, 19195, 19358, 19520, 19681, 19841, 20001,
+  20160, 20318, 20475, 20632, 20788, 20943, 21097, 21251, 21403, 21555, 21706, 21856,
+  22006, 22154, 22302, 22449, 22595, 22740, 22884, 23028, 23170, 23312, 23453, 23593,
+  23732, 23870, 24008, 24144, 24279, 24414, 24548, 24680, 24812, 24943, 25073, 25202,
+  25330, 25457, 25583, 25708, 25833, 25956, 26078, 26199, 26320, 26439, 26557, 26674,
+  26791, 26906, 27020, 27133, 27246, 27357, 27467, 27576, 27684, 27791, 27897, 28002,
+  28106, 28209, 28311, 28411, 28511, 28610, 28707, 28803, 28899, 28993, 29086, 29178,
+  29269, 29359, 29448, 29535, 29622, 29707, 29792, 29875, 29957, 30038, 30118, 30196,
+  30274, 30350, 30425, 30499, 30572, 30644, 30715, 30784, 30853, 30920, 30986, 31050,
+  31114, 31177, 31238, 31298, 31357, 31415, 31471, 31527, 31581, 31634, 31686, 31737,
+  31786, 31834, 31881, 31927, 31972, 32015, 32058, 32099, 32138, 32177, 32214, 32251,
+  32286, 32319, 32352, 32383, 32413, 32442, 32470, 32496, 32522, 32546, 32568, 32590,
+  32610, 32629, 32647, 32664, 32679, 32693, 32706, 32718, 32729, 32738, 32746, 32753,
+  32758, 32762, 32766, 32767, 32767,
+};
+
+/*********************************************************************************************************
+*                                              内部函数声明
+*********************************************************************************************************/
+static  int16  Sat16(int32 x);                                   //饱和到int16
+static  int16  SinQ15(uint16 i);                                 //sin(2 * pi * i / FFT_SIN_PERIOD)
+static  uint16 MaxAbs(const int16* pData, uint16 len);           //最大绝对值
+static  void   BitReverse(int16* pData, uint16 m);               //复数序列位反序重排
+static  uint8  CpxFft(int16* pData, uint8 log2M, uint16* pMax);  //就地复数FFT，返回右移的级数
+static  uint8  SplitReal(int16* pData, uint8 log2N, uint16 max); //从复数FFT结果分离出实数序列的频谱，返回右移的位数
+
+/*********************************************************************************************************
+*                                              内部函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：Sat16
+* 函数功能：饱和到int16
+* 输入参数：x-待饱和的数
+* 输出参数：void
+* 返 回 值：饱和后的值
+* 创建日期：2026年10月19日
+* 注    意：按溢出分析不会越界，只防舍入进位
+*********************************************************************************************************/
+static  int16 Sat16(int32 x)
+{
+  if(x > 32767)
+  {
+    return 32767;
+  }
+  if(x < -32768)
+  {
+    return -32768;
+  }
+
+  return (int16)x;
+}
+
+/*********************************************************************************************************
+* 函数名称：SinQ15
+* 函数功能：查表计算正弦
+* 输入参数：i-角度，一周为FFT_SIN_PERIOD
+* 输出参数：void
+* 返 回 值：sin(2 * pi * i / FFT_SIN_PERIOD)，Q15
+* 创建日期：2026年10月19日
+* 注    意：cos(x)用SinQ15(i + FFT_SIN_QUARTER)
+*********************************************************************************************************/
+static  int16 SinQ15(uint16 i)
+{
+  i &= FFT_SIN_PERIOD - 1;
+  if(i <= FFT_SIN_QUARTER)
+  {
+    return s_arrSinQ15[i];
+  }
+  if(i <= 2 * FFT_SIN_QUARTER)
+  {
+    return s_arrSinQ15[2 * FFT_SIN_QUARTER - i];
+  }
+  if(i <= 3 * FFT_SIN_QUARTER)
+  {
+    return -s_arrSinQ15[i - 2 * FFT_SIN_QUARTER];
+  }
+
+  return -s_arrSinQ15[FFT_SIN_PERIOD - i];
+}
+
+/*********************************************************************************************************
+* 函数名称：MaxAbs
+* 函数功能：求最大绝对值
+* 输入参数：pData-数据，len-个数
+* 输出参数：void
+* 返 回 值：最大绝对值
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static  uint16 MaxAbs(const int16* pData, uint16 len)
+{
+  uint16 max = 0;
+  uint16 a;
+  uint16 i;
+
+  for(i = 0; i < len; i++)
+  {
+    a = (uint16)((pData[i] < 0) ? -pData[i] : pData[i]);
+    if(a > max)
+    {
+      max = a;
+    }
+  }
+
+  return max;
+}
+
+/*********************************************************************************************************
+* 函数名称：BitReverse
+* 函数功能：复数序列按下标的位反序重排
+* 输入参数：pData-复数序列，实部、虚部交替存放，m-复数个数
+* 输出参数：pData-重排后的序列
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：反序下标逐个递增计算，不查表
+*********************************************************************************************************/
+static  void BitReverse(int16* pData, uint16 m)
+{
+  uint16 i;
+  uint16 j = 0;
+  uint16 bit;
+  int16  t;
+
+  for(i = 0; i < m; i++)
+  {
+    if(i < j)
+    {
+      t = pData[2 * i];     pData[2 * i]     = pData[2 * j];     pData[2 * j]     = t;
+      t = pData[2 * i + 1]; pData[2 * i + 1] = pData[2 * j + 1]; pData[2 * j + 1] = t;
+    }
+    bit = m >> 1;
+    while(j & bit)
+    {
+      j  ^= bit;
+      bit >>= 1;
+    }
+    j |= bit;
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：CpxFft
+* 函数功能：就地复数FFT，块浮点
+* 输入参数：pData-复数序列，实部、虚部交替存放，log2M-复数个数为2^log2M，pMax-输入各分量的最大绝对值
+* 输出参数：pData-频谱，pMax-输出各分量的最大绝对值
+* 返 回 值：右移的级数，实际频谱 = 输出 * 2^返回值
+* 创建日期：2026年10月19日
+* 注    意：旋转因子W = cos - j * sin，每组蝶形只查一次表；各分量的最大值在蝶形中顺便统计，供下一级判断
+*********************************************************************************************************/
+static  uint8 CpxFft(int16* pData, uint8 log2M, uint16* pMax)
+{
+  uint16 m    = 1 << log2M;
+  uint16 max  = *pMax;
+  uint8  exp  = 0;
+  uint16 half;
+  uint16 step;
+  uint16 j;
+  uint16 a;
+  uint16 b;
+  uint8  scale;
+  int32  wr;
+  int32  wi;
+  int32  tr;
+  int32  ti;
+  int32  ar;
+  int32  ai;
+  int16  x[4];
+  uint8  n;
+
+  BitReverse(pData, m);
+
+  for(half = 1; half < m; half <<= 1)
+  {
+    scale = (max > FFT_NOSCALE_MAX);
+    exp  += scale;
+    max   = 0;
+    step  = FFT_SIN_PERIOD / (2 * half);
+    for(j = 0; j < half; j++)
+    {
+      wr =  SinQ15(j * step + FFT_SIN_QUARTER);
+      wi = -SinQ15(j * step);
+      for(a = j; a < m; a += 2 * half)
+      {
+        b  = a + half;
+        tr = (wr * pData[2 * b] - wi * pData[2 * b + 1] + (1 << 14)) >> 15;
+        ti = (wr * pData[2 * b + 1] + wi * pData[2 * b] + (1 << 14)) >> 15;
+        ar = pData[2 * a];
+        ai = pData[2 * a + 1];
+        x[0] = Sat16((ar + tr + scale) >> scale);
+        x[1] = Sat16((ai + ti + scale) >> scale);
+        x[2] = Sat16((ar - tr + scale) >> scale);
+        x[3] = Sat16((ai - ti + scale) >> scale);
+        pData[2 * a]     = x[0];
+        pData[2 * a + 1] = x[1];
+        pData[2 * b]     = x[2];
+        pData[2 * b + 1] = x[3];
+        for(n = 0; n < 4; n++)
+        {
+          if((uint16)((x[n] < 0) ? -x[n] : x[n]) > max)
+          {
+            max = (uint16)((x[n] < 0) ? -x[n] : x[n]);
+          }
+        }
+      }
+    }
+  }
+
+  *pMax = max;
+  return exp;
+}
+
+/*********************************************************************************************************
+* 函数名称：SplitReal
+* 函数功能：从N/2点复数FFT的结果分离出N点实数序列的频谱
+* 输入参数：pData-复数FFT的结果Z，log2N-实数序列点数为2^log2N，max-Z各分量的最大绝对值
+* 输出参数：pData-实数序列的频谱，格式见Fft.h
+* 返 回 值：右移的位数，0或1
+* 创建日期：2026年10月19日
+* 注    意：M = N/2，E = (Z[k] + conj(Z[M-k])) / 2，O = -j * (Z[k] - conj(Z[M-k])) / 2，
+*           X[k] = E + W^k * O，X[M-k] = conj(E - W^k * O)，W = exp(-j * 2 * pi / N)，k和M-k一起计算；
+*           evr、evi、odr、odi为E、O的2倍，需要右移时先除以2，保证乘积之和不超过int32
+*********************************************************************************************************/
+static  uint8 SplitReal(int16* pData, uint8 log2N, uint16 max)
+{
+  uint16 m     = 1 << (log2N - 1);
+  uint16 step  = FFT_SIN_PERIOD >> log2N;
+  uint8  scale = (max > FFT_NOSCALE_MAX);
+  uint16 k;
+  int32  evr;
+  int32  evi;
+  int32  odr;
+  int32  odi;
+  int32  wr;
+  int32  wi;
+  int32  tr;
+  int32  ti;
+  int32  ar;
+  int32  ai;
+  int32  br;
+  int32  bi;
+
+  //直流和奈奎斯特频率都只有实部
+  ar = pData[0];
+  ai = pData[1];
+  pData[0] = Sat16((ar + ai + scale) >> scale);
+  pData[1] = Sat16((ar - ai + scale) >> scale);
+
+  for(k = 1; k <= m / 2; k++)
+  {
+    ar = pData[2 * k];
+    ai = pData[2 * k + 1];
+    br = pData[2 * (m - k)];
+    bi = pData[2 * (m - k) + 1];
+    evr = ar + br;
+    evi = ai - bi;
+    odr = ai + bi;
+    odi = br - ar;
+    if(scale)
+    {
+      evr = (evr + 1) >> 1;
+      evi = (evi + 1) >> 1;
+      odr = (odr + 1) >> 1;
+      odi = (odi + 1) >> 1;
+    }
+
+    wr =  SinQ15(k * step + FFT_SIN_QUARTER);
+    wi = -SinQ15(k * step);
+    tr = (wr * odr - wi * odi + (1 << 14)) >> 15;
+    ti = (wr * odi + wi * odr + (1 << 14)) >> 15;
+
+    pData[2 * k]     = Sat16((evr + tr + 1) >> 1);
+    pData[2 * k + 1] = Sat16((evi + ti + 1) >> 1);
+    if(k != m - k)
+    {
+      pData[2 * (m - k)]     = Sat16((evr - tr + 1) >> 1);
+      pData[2 * (m - k) + 1] = Sat16((ti - evi + 1) >> 1);
+    }
+  }
+
+  return scale;
+}
+
+/*********************************************************************************************************
+*                                              API函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：FftReal
+* 函数功能：就地做实数FFT
+* 输入参数：pData-2^log2N个实数，绝对值不超过FFT_IN_MAX，log2N-FFT_LOG2N_MIN ~ FFT_LOG2N_MAX
+* 输出参数：pData-频谱，格式见Fft.h
+* 返 回 值：块浮点指数，实际频谱 = 输出 * 2^指数，可能为负，FFT_EXP_ERR--点数不支持
+* 创建日期：2026年10月19日
+* 注    意：实数序列相邻两个看作一个复数，不需要重排就是N/2点复数序列
+*********************************************************************************************************/
+int8 FftReal(int16* pData, uint8 log2N)
+{
+  uint16 len = 1 << log2N;
+  uint16 max;
+  uint16 i;
+  uint8  shift = 0;
+  uint8  exp;
+
+  if(log2N < FFT_LOG2N_MIN || log2N > FFT_LOG2N_MAX)
+  {
+    return FFT_EXP_ERR;
+  }
+
+  //小信号先左移到FFT_IN_MAX的一半以上，舍入误差相对变小
+  max = MaxAbs(pData, len);
+  while(max != 0 && max <= FFT_IN_MAX / 2)
+  {
+    max <<= 1;
+    shift++;
+  }
+  if(shift > 0)
+  {
+    for(i = 0; i < len; i++)
+    {
+      pData[i] = (int16)(pData[i] << shift);
+    }
+  }
+
+  exp  = CpxFft(pData, log2N - 1, &max);
+  exp += SplitReal(pData, log2N, max);
+
+  return (int8)(exp - shift);
+}
+
+/*********************************************************************************************************
+* 函数名称：FftHann
+* 函数功能：就地乘汉宁窗
+* 输入参数：pData-2^log2N个实数，log2N-FFT_LOG2N_MIN ~ FFT_LOG2N_MAX
+* 输出参数：pData-加窗后的数据
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：w[n] = 0.5 - 0.5 * cos(2 * pi * n / N)，即sin(pi * n / N)^2，用余弦算，N = 2^FFT_LOG2N_MAX时也不丢角度精度；
+*           相干增益0.5，功率增益3/8，频谱泄漏比不加窗小得多
+*********************************************************************************************************/
+void FftHann(int16* pData, uint8 log2N)
+{
+  uint16 len   = 1 << log2N;
+  uint8  shift = FFT_LOG2N_MAX - log2N;  //n映射到整周期
+  int32  w;
+  uint16 n;
+
+  if(log2N < FFT_LOG2N_MIN || log2N > FFT_LOG2N_MAX)
+  {
+    return;
+  }
+
+  for(n = 0; n < len; n++)
+  {
+    w = (32768 - SinQ15((uint16)((n << shift) + FFT_SIN_QUARTER))) >> 1;
+    pData[n] = (int16)((pData[n] * w + (1 << 14)) >> 15);
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：FftPower
+* 函数功能：计算第k个频点的模的平方
+* 输入参数：pData-FftReal的输出，k-频点，1 ~ N/2 - 1
+* 输出参数：void
+* 返 回 值：实部平方 + 虚部平方，实际值再乘以4^指数
+* 创建日期：2026年10月19日
+* 注    意：直流和奈奎斯特频率只有实部，直接用pData[0]、pData[1]
+*********************************************************************************************************/
+uint32 FftPower(const int16* pData, uint16 k)
+{
+  int32 re = pData[2 * k];
+  int32 im = pData[2 * k + 1];
+
+  return (uint32)(re * re) + (uint32)(im * im);
+}
+
+#if (defined FFT_BENCH) && (FFT_BENCH == TRUE)
+/*********************************************************************************************************
+* 函数名称：FftBench
+* 函数功能：测量256、512、1024点实数FFT的周期数
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：用DWT周期计数器计时，含加窗，结果由debug输出；数据放在静态数组中，栈不够放1024点；
+*           在InitSoftware之后调用一次
+*********************************************************************************************************/
+void FftBench(void)
+{
+  static int16 s_arrData[1 << FFT_LOG2N_MAX];
+  uint32 cycles;
+  uint32 hann;
+  uint16 i;
+  uint8  log2N;
+  int8   exp;
+
+  DEMCR      |= 1UL << 24;  //TRCENA
+  DWT_CYCCNT  = 0;
+  DWT_CTRL   |= 1UL;        //CYCCNTENA
+
+  for(log2N = 8; log2N <= FFT_LOG2N_MAX; log2N++)
+  {
+    for(i = 0; i < (1 << log2N); i++)
+    {
+      s_arrData[i] = (int16)((int16)((i * 2654435761UL) >> 16) >> 2);  //伪随机采样，不超过FFT_IN_MAX
+    }
+
+    cycles = DWT_CYCCNT;
+    FftHann(s_arrData, log2N);
+    hann   = DWT_CYCCNT - cycles;
+    cycles = DWT_CYCCNT;
+    exp    = FftReal(s_arrData, log2N);
+    cycles = DWT_CYCCNT - cycles;
+
+    debug("FftBench %d: hann %d, fft %d cycles, exp %d, RAM %d bytes\r\n", 1 << log2N, (int)hann, (int)cycles, exp, (int)(sizeof(int16) << log2N));
+  }
+}
+#endif
@@ -0,0 +1,58 @@
+/*********************************************************************************************************
+* 模块名称：Fft.h
+* 摘    要：Q15定点基2实数FFT，块浮点缩放，供振动监测等频谱分析使用
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：N点实数序列看作N/2点复数序列做复数FFT，再分离出实数序列的频谱，运算量约为N点复数FFT的一半；
+*           块浮点：每级蝶形之前检查数据的最大绝对值，可能溢出时该级结果右移1位并累计指数，
+*           小信号先左移到接近半满量程，各级也不移位，比每级固定右移多保留有效位；
+*           就地运算，除输入数组外不占RAM，旋转因子为Flash中257个int16的正弦表；
+*           与双精度DFT对比，1024点满量程正弦的误差约-52dB，满量程白噪声约-64dB，数十个读数的小信号约-52dB，
+*           点数每减半误差降低约2~3dB(Test/FftTest.c实测)；
+*           周期数(Cortex-M3，72MHz，Flash 2个等待周期，估算，实测见FftBench)：
+*           256点约3.2万、512点约7万、1024点约15万，即1024点约2ms
+* 注    意：输入的绝对值不超过16384，即半满量程，块浮点才能保证不溢出；
+*           输出格式：[0]直流，[1]N/2处(奈奎斯特频率)，都只有实部，其余[2k]、[2k+1]为第k个频点的实部、虚部，
+*           k = 1 ~ N/2 - 1；实际频谱 = 输出 * 2^指数
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+#ifndef _FFT_H_
+#define _FFT_H_
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "DataType.h"
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#define FFT_LOG2N_MIN  4    //最少16点
+#define FFT_LOG2N_MAX  10   //最多1024点，正弦表按此生成
+#define FFT_IN_MAX     16384  //输入绝对值的上限
+#define FFT_EXP_ERR    (-128) //FftReal点数不支持时的返回值
+
+#define FFT_BENCH FALSE  //TRUE--编译FftBench，用DWT周期计数器测量各点数FFT的周期数
+
+/*********************************************************************************************************
+*                                              枚举结构体定义
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              API函数声明
+*********************************************************************************************************/
+int8  FftReal(int16* pData, uint8 log2N);                 //就地做2^log2N点实数FFT，返回块浮点指数，FFT_EXP_ERR--点数不支持
+void  FftHann(int16* pData, uint8 log2N);                 //就地乘汉宁窗
+uint32 FftPower(const int16* pData, uint16 k);            //第k个频点的模的平方，k = 1 ~ N/2 - 1
+
+#if (defined FFT_BENCH) && (FFT_BENCH == TRUE)
+void  FftBench(void);                                     //测量256、512、1024点FFT的周期数，结果由debug输出
+#endif
+
+#endif
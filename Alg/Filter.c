@@ -0,0 +1,424 @@
+/*********************************************************************************************************
+* 模块名称：Filter.c
+* 摘    要：Q15定点数字滤波，FIR、双二阶IIR和中值滤波可以串成滤波链，按块处理采样
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：按块处理时一级处理完整块再交给下一级，每级的状态在循环中保存在寄存器里；
+*           FIR用32位累加，系数绝对值之和不超过2时不会溢出；双二阶用64位累加(SMLAL)，输出饱和到int16
+* 注    意：
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "Filter.h"
+#if (defined FILTER_BENCH) && (FILTER_BENCH == TRUE)
+#include "UART1.h"
+#endif
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#if (defined FILTER_BENCH) && (FILTER_BENCH == TRUE)
+#define DEMCR       (*(volatile uint32*)0xE000EDFC)  //调试异常和监视控制寄存器，bit24-TRCENA
+#define DWT_CTRL    (*(volatile uint32*)0xE0001000)  //DWT控制寄存器，bit0-CYCCNTENA
+#define DWT_CYCCNT  (*(volatile uint32*)0xE0001004)  //DWT周期计数器
+#define BENCH_LEN   64                               //每次测量的采样个数
+#endif
+
+/*********************************************************************************************************
+*                                              枚举结构体定义
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              内部变量
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              内部函数声明
+*********************************************************************************************************/
+static  int16 Sat16(int32 x);                                              //饱和到int16
+static  void  ProcFir(StructFilterStage* pStage, int16* pData, uint16 len);    //FIR按块滤波
+static  void  ProcBiquad(StructFilterStage* pStage, int16* pData, uint16 len); //双二阶按块滤波
+static  void  ProcMedian(StructFilterStage* pStage, int16* pData, uint16 len); //中值按块滤波
+static  StructFilterStage* AddStage(StructFilterChain* pChain, uint8 type, const int16* pCoef, uint8 len); //添加一级
+
+/*********************************************************************************************************
+*                                              内部函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：Sat16
+* 函数功能：饱和到int16
+* 输入参数：x-待饱和的数
+* 输出参数：void
+* 返 回 值：饱和后的值
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static  int16 Sat16(int32 x)
+{
+  if(x > 32767)
+  {
+    return 32767;
+  }
+  if(x < -32768)
+  {
+    return -32768;
+  }
+
+  return (int16)x;
+}
+
+/*********************************************************************************************************
+* 函数名称：ProcFir
+* 函数功能：FIR按块滤波
+* 输入参数：pStage-滤波级，pData-采样，len-采样个数
+* 输出参数：pData-滤波结果
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：历史为环形，最新采样在pos；卷积分成两段，避免每个抽头都判断回绕
+*********************************************************************************************************/
+static  void  ProcFir(StructFilterStage* pStage, int16* pData, uint16 len)
+{
+  const int16* pCoef = pStage->pCoef;
+  int16* pHist = pStage->arrState;
+  uint8  taps  = pStage->len;
+  uint8  pos   = pStage->pos;
+  int32  acc;
+  uint16 n;
+  uint8  k;
+
+  for(n = 0; n < len; n++)
+  {
+    pos = (pos + 1 < taps) ? pos + 1 : 0;
+    pHist[pos] = pData[n];
+
+    acc = 0;
+    for(k = 0; k <= pos; k++)  //c[0]~c[pos]对应pHist[pos]~pHist[0]
+    {
+      acc += (int32)pCoef[k] * pHist[pos - k];
+    }
+    for(; k < taps; k++)       //其余系数对应pHist[taps-1]~pHist[pos+1]
+    {
+      acc += (int32)pCoef[k] * pHist[taps + pos - k];
+    }
+    pData[n] = Sat16((acc + (1 << 14)) >> 15);
+  }
+
+  pStage->pos = pos;
+}
+
+/*********************************************************************************************************
+* 函数名称：ProcBiquad
+* 函数功能：双二阶IIR按块滤波
+* 输入参数：pStage-滤波级，pData-采样，len-采样个数
+* 输出参数：pData-滤波结果
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：直接I型，反馈的是饱和后的输出，不会因溢出振荡；
+*           截掉的低位计入下一个采样(误差反馈)，低截止频率时极点靠近单位圆，否则截位误差被放大成直流偏差
+*********************************************************************************************************/
+static  void  ProcBiquad(StructFilterStage* pStage, int16* pData, uint16 len)
+{
+  const int16* c = pStage->pCoef;
+  int32 x1 = pStage->arrState[0];
+  int32 x2 = pStage->arrState[1];
+  int32 y1 = pStage->arrState[2];
+  int32 y2 = pStage->arrState[3];
+  int32 err = pStage->arrState[4];
+  int32 x0;
+  long long acc;
+  long long q;
+  uint16 n;
+
+  for(n = 0; n < len; n++)
+  {
+    x0  = pData[n];
+    acc = (long long)c[0] * x0 + (long long)c[1] * x1 + (long long)c[2] * x2
+        - (long long)c[3] * y1 - (long long)c[4] * y2 + err;
+    q   = (acc + (1 << (FILTER_BIQUAD_SHIFT - 1))) >> FILTER_BIQUAD_SHIFT;
+    err = (int32)(acc - (q << FILTER_BIQUAD_SHIFT));
+    x2 = x1;
+    x1 = x0;
+    y2 = y1;
+    y1 = Sat16((int32)q);
+    pData[n] = (int16)y1;
+  }
+
+  pStage->arrState[0] = (int16)x1;
+  pStage->arrState[1] = (int16)x2;
+  pStage->arrState[2] = (int16)y1;
+  pStage->arrState[3] = (int16)y2;
+  pStage->arrState[4] = (int16)err;
+}
+
+/*********************************************************************************************************
+* 函数名称：ProcMedian
+* 函数功能：中值按块滤波
+* 输入参数：pStage-滤波级，pData-采样，len-采样个数
+* 输出参数：pData-滤波结果
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：窗口最大FILTER_MEDIAN_MAX，每个采样拷贝窗口后插入排序取中间值，比维护有序表简单且足够快
+*********************************************************************************************************/
+static  void  ProcMedian(StructFilterStage* pStage, int16* pData, uint16 len)
+{
+  int16  arrSort[FILTER_MEDIAN_MAX];
+  int16* pHist = pStage->arrState;
+  uint8  size  = pStage->len;
+  uint8  pos   = pStage->pos;
+  int16  v;
+  uint16 n;
+  uint8  i;
+  uint8  j;
+
+  for(n = 0; n < len; n++)
+  {
+    pos = (pos + 1 < size) ? pos + 1 : 0;
+    pHist[pos] = pData[n];
+
+    for(i = 0; i < size; i++)
+    {
+      v = pHist[i];
+      for(j = i; j > 0 && arrSort[j - 1] > v; j--)
+      {
+        arrSort[j] = arrSort[j - 1];
+      }
+      arrSort[j] = v;
+    }
+    pData[n] = arrSort[size / 2];
+  }
+
+  pStage->pos = pos;
+}
+
+/*********************************************************************************************************
+* 函数名称：AddStage
+* 函数功能：在滤波链末尾添加一级
+* 输入参数：pChain-滤波链，type-种类，pCoef-系数表，len-抽头数或窗口
+* 输出参数：pChain-滤波链
+* 返 回 值：添加的滤波级，NULL--滤波链已满
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static  StructFilterStage* AddStage(StructFilterChain* pChain, uint8 type, const int16* pCoef, uint8 len)
+{
+  StructFilterStage* pStage;
+
+  if(pChain->num >= FILTER_STAGE_MAX)
+  {
+    return NULL;
+  }
+
+  pStage = &pChain->arrStage[pChain->num];
+  pStage->type   = type;
+  pStage->len    = len;
+  pStage->pos    = 0;
+  pStage->primed = 0;
+  pStage->pCoef  = pCoef;
+  pChain->num++;
+
+  return pStage;
+}
+
+/*********************************************************************************************************
+*                                              API函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：FilterInit
+* 函数功能：清空滤波链
+* 输入参数：pChain-滤波链
+* 输出参数：pChain-滤波链
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：没有滤波级时FilterBlock不改变采样
+*********************************************************************************************************/
+void  FilterInit(StructFilterChain* pChain)
+{
+  pChain->num = 0;
+}
+
+/*********************************************************************************************************
+* 函数名称：FilterAddFir
+* 函数功能：在滤波链末尾添加FIR
+* 输入参数：pChain-滤波链，pCoef-taps个Q15系数，taps-抽头数，1~FILTER_FIR_MAX
+* 输出参数：pChain-滤波链
+* 返 回 值：1--成功，0--参数错误或滤波链已满
+* 创建日期：2026年10月19日
+* 注    意：系数之和为32768时直流增益为1
+*********************************************************************************************************/
+uint8 FilterAddFir(StructFilterChain* pChain, const int16* pCoef, uint8 taps)
+{
+  if(taps == 0 || taps > FILTER_FIR_MAX)
+  {
+    return 0;
+  }
+
+  return (AddStage(pChain, FILTER_FIR, pCoef, taps) != NULL);
+}
+
+/*********************************************************************************************************
+* 函数名称：FilterAddBiquad
+* 函数功能：在滤波链末尾添加双二阶IIR
+* 输入参数：pChain-滤波链，pCoef-b0 b1 b2 a1 a2，Q14，a0归一化为1
+* 输出参数：pChain-滤波链
+* 返 回 值：1--成功，0--滤波链已满
+* 创建日期：2026年10月19日
+* 注    意：低通时令b0 + b1 + b2 = 2^14 + a1 + a2，量化后直流增益仍严格为1
+*********************************************************************************************************/
+uint8 FilterAddBiquad(StructFilterChain* pChain, const int16* pCoef)
+{
+  return (AddStage(pChain, FILTER_BIQUAD, pCoef, 0) != NULL);
+}
+
+/*********************************************************************************************************
+* 函数名称：FilterAddMedian
+* 函数功能：在滤波链末尾添加中值滤波
+* 输入参数：pChain-滤波链，n-窗口，3~FILTER_MEDIAN_MAX的奇数
+* 输出参数：pChain-滤波链
+* 返 回 值：1--成功，0--参数错误或滤波链已满
+* 创建日期：2026年10月19日
+* 注    意：输出延迟(n - 1) / 2个采样
+*********************************************************************************************************/
+uint8 FilterAddMedian(StructFilterChain* pChain, uint8 n)
+{
+  if(n < 3 || n > FILTER_MEDIAN_MAX || (n & 1) == 0)
+  {
+    return 0;
+  }
+
+  return (AddStage(pChain, FILTER_MEDIAN, NULL, n) != NULL);
+}
+
+/*********************************************************************************************************
+* 函数名称：FilterReset
+* 函数功能：清除各级的历史
+* 输入参数：pChain-滤波链
+* 输出参数：pChain-滤波链
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：下一个采样到来时重新填满历史
+*********************************************************************************************************/
+void  FilterReset(StructFilterChain* pChain)
+{
+  uint8 i;
+
+  for(i = 0; i < pChain->num; i++)
+  {
+    pChain->arrStage[i].primed = 0;
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：FilterBlock
+* 函数功能：就地滤波一块Q15采样
+* 输入参数：pChain-滤波链，pData-采样，len-采样个数
+* 输出参数：pData-滤波结果
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：各级依次处理整块；每级第一次处理时用第一个采样填满历史，相当于之前一直是这个值
+*********************************************************************************************************/
+void  FilterBlock(StructFilterChain* pChain, int16* pData, uint16 len)
+{
+  StructFilterStage* pStage;
+  uint8 i;
+  uint8 k;
+
+  if(len == 0)
+  {
+    return;
+  }
+
+  for(i = 0; i < pChain->num; i++)
+  {
+    pStage = &pChain->arrStage[i];
+    if(!pStage->primed)
+    {
+      for(k = 0; k < FILTER_FIR_MAX; k++)
+      {
+        pStage->arrState[k] = pData[0];
+      }
+      if(pStage->type == FILTER_BIQUAD)
+      {
+        pStage->arrState[4] = 0;  //截位误差
+      }
+      pStage->pos    = 0;
+      pStage->primed = 1;
+    }
+
+    switch(pStage->type)
+    {
+      case FILTER_FIR:
+        ProcFir(pStage, pData, len);
+        break;
+      case FILTER_BIQUAD:
+        ProcBiquad(pStage, pData, len);
+        break;
+      case FILTER_MEDIAN:
+        ProcMedian(pStage, pData, len);
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+#if (defined FILTER_BENCH) && (FILTER_BENCH == TRUE)
+/*********************************************************************************************************
+* 函数名称：FilterBench
+* 函数功能：测量各滤波器每个采样的周期数
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：用DWT周期计数器计时，每种滤波器处理BENCH_LEN个采样，结果包含函数调用开销，由debug输出；
+*           在InitSoftware之后调用一次，不连接调试器时DWT同样可用
+*********************************************************************************************************/
+void  FilterBench(void)
+{
+  static const int16 arrFir8[8]   = {4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096};
+  static const int16 arrFir16[16] = {2048, 2048, 2048, 2048, 2048, 2048, 2048, 2048,
+                                     2048, 2048, 2048, 2048, 2048, 2048, 2048, 2048};
+  static const int16 arrBiquad[5] = {39, 77, 39, -30442, 14213};
+  StructFilterChain chain;
+  int16  arrData[BENCH_LEN];
+  uint32 cycles;
+  uint8  test;
+  uint8  i;
+
+  DEMCR      |= 1UL << 24;  //TRCENA
+  DWT_CYCCNT  = 0;
+  DWT_CTRL   |= 1UL;        //CYCCNTENA
+
+  for(test = 0; test < 5; test++)
+  {
+    FilterInit(&chain);
+    switch(test)
+    {
+      case 0: FilterAddFir(&chain, arrFir8, 8);    break;
+      case 1: FilterAddFir(&chain, arrFir16, 16);  break;
+      case 2: FilterAddBiquad(&chain, arrBiquad);  break;
+      case 3: FilterAddMedian(&chain, 5);          break;
+      default: FilterAddMedian(&chain, 9);         break;
+    }
+    for(i = 0; i < BENCH_LEN; i++)
+    {
+      arrData[i] = (int16)((i * 2654435761UL) >> 16);  //伪随机采样
+    }
+    FilterBlock(&chain, arrData, 1);  //先填满历史，不计入
+
+    cycles = DWT_CYCCNT;
+    FilterBlock(&chain, arrData, BENCH_LEN);
+    cycles = DWT_CYCCNT - cycles;
+
+    debug("FilterBench %d: %d cycles/sample\r\n", test, (int)(cycles / BENCH_LEN));
+  }
+}
+#endif
@@ -0,0 +1,82 @@
+/*********************************************************************************************************
+* 模块名称：Filter.h
+* 摘    要：Q15定点数字滤波，FIR、双二阶IIR和中值滤波可以串成滤波链，按块处理采样
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：采样为Q15，FIR系数为Q15，双二阶系数为Q14(可表示±2)，累加都不会溢出；
+*           每级滤波第一个采样到来时用它填满历史，避免从0开始的启动过渡；
+*           每个采样的周期数为估算值，按各级内循环的指令数和Flash 2个等待周期推算，未在目标板上实测
+*           (Cortex-M3，72MHz)：FIR约12 + 6 * 抽头数，双二阶约45，中值约20 + 3 * N * N / 2；
+*           目标板上打开FILTER_BENCH由FilterBench实测；Test/FilterBench.c在主机上测同样几种滤波级，
+*           只能对照各级开销的相对大小
+* 注    意：系数表只保存指针，必须在滤波链使用期间一直有效，一般定义为const数组
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+#ifndef _FILTER_H_
+#define _FILTER_H_
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "DataType.h"
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#define FILTER_STAGE_MAX    3   //每条滤波链最多的级数
+#define FILTER_FIR_MAX      16  //FIR最多的抽头数
+#define FILTER_MEDIAN_MAX   9   //中值滤波最大的窗口，必须为奇数
+#define FILTER_BIQUAD_SHIFT 14  //双二阶系数的小数位数
+
+#define FILTER_BENCH FALSE  //TRUE--编译FilterBench，用DWT周期计数器测量各滤波器每个采样的周期数
+
+/*********************************************************************************************************
+*                                              枚举结构体定义
+*********************************************************************************************************/
+//滤波器种类
+typedef enum
+{
+  FILTER_FIR    = 0x00,  //FIR，y = c[0] * x[n] + c[1] * x[n-1] + ...
+  FILTER_BIQUAD = 0x01,  //双二阶IIR直接I型，系数为b0 b1 b2 a1 a2，y = b0 * x[n] + b1 * x[n-1] + b2 * x[n-2] - a1 * y[n-1] - a2 * y[n-2]
+  FILTER_MEDIAN = 0x02,  //中值滤波，去除尖峰
+}EnumFilterType;
+
+//一级滤波
+typedef struct
+{
+  uint8        type;    //EnumFilterType
+  uint8        len;     //FIR的抽头数或中值滤波的窗口
+  uint8        pos;     //历史采样中最新采样的位置
+  uint8        primed;  //1--已用第一个采样填满历史
+  const int16* pCoef;   //系数表，中值滤波不用
+  int16        arrState[FILTER_FIR_MAX];  //历史采样，双二阶为x[n-1] x[n-2] y[n-1] y[n-2] 截位误差
+}StructFilterStage;
+
+//滤波链，采样依次经过各级
+typedef struct
+{
+  uint8             num;  //级数
+  StructFilterStage arrStage[FILTER_STAGE_MAX];
+}StructFilterChain;
+
+/*********************************************************************************************************
+*                                              API函数声明
+*********************************************************************************************************/
+void  FilterInit(StructFilterChain* pChain);                                  //清空滤波链
+uint8 FilterAddFir(StructFilterChain* pChain, const int16* pCoef, uint8 taps);//添加FIR，1--成功
+uint8 FilterAddBiquad(StructFilterChain* pChain, const int16* pCoef);         //添加双二阶IIR，pCoef为5个Q14系数，1--成功
+uint8 FilterAddMedian(StructFilterChain* pChain, uint8 n);                    //添加中值滤波，n为奇数，1--成功
+void  FilterReset(StructFilterChain* pChain);                                 //清除历史，从下一个采样重新开始
+void  FilterBlock(StructFilterChain* pChain, int16* pData, uint16 len);       //就地滤波一块Q15采样
+
+#if (defined FILTER_BENCH) && (FILTER_BENCH == TRUE)
+void  FilterBench(void);                                                      //测量各滤波器每个采样的周期数，结果由debug输出
+#endif
+
+#endif
@@ -0,0 +1,433 @@
+/*********************************************************************************************************
+* 模块名称：Ring.c
+* 摘    要：单生产者/单消费者环形缓冲区，元素大小可配置，供字节队列和16位队列共用
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：
+* 注    意：先拷贝数据再更新head/tail，中间加内存屏障，保证对方看到新位置时数据已经有效；
+*           RING_DROP_OLD时生产者也会推进tail，双方都用LDREXH/STREXH修改tail，
+*           这种缓冲区不能用RingPeekRead零拷贝读，否则正在读的数据可能被覆盖
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "Ring.h"
+#include "stm32f10x.h"
+#include <string.h>
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#define RING_MAX_LEN  0x8000  //最大容量，head - tail需要用uint16表示
+
+/*********************************************************************************************************
+*                                              枚举结构体定义
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              内部变量
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              内部函数声明
+*********************************************************************************************************/
+static  uint8   CasTail(StructRing* pRing, uint16 oldTail, uint16 newTail);  //tail仍为oldTail时改为newTail
+static  uint16  DropOld(StructRing* pRing, uint16 len);                      //推进tail腾出len个元素的空间
+
+/*********************************************************************************************************
+*                                              内部函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：CasTail
+* 函数功能：tail仍为oldTail时改为newTail
+* 输入参数：pRing-环形缓冲区，oldTail-读到的tail，newTail-新的tail
+* 输出参数：pRing-环形缓冲区
+* 返 回 值：1-修改成功，0-tail已被对方修改或独占访问被中断打断，需要重新读取
+* 创建日期：2026年10月19日
+* 注    意：只在RING_DROP_OLD时使用
+*********************************************************************************************************/
+static  uint8 CasTail(StructRing* pRing, uint16 oldTail, uint16 newTail)
+{
+  if(__LDREXH((uint16_t*)&pRing->tail) != oldTail)
+  {
+    __CLREX();
+    return 0;
+  }
+
+  return __STREXH(newTail, (uint16_t*)&pRing->tail) == 0;
+}
+
+/*********************************************************************************************************
+* 函数名称：DropOld
+* 函数功能：丢弃最旧的元素，使缓冲区至少有len个空闲元素
+* 输入参数：pRing-环形缓冲区，len-需要的空闲元素个数，不超过容量
+* 输出参数：pRing-环形缓冲区
+* 返 回 值：丢弃的元素个数
+* 创建日期：2026年10月19日
+* 注    意：由生产者调用，消费者可能同时在推进tail，用CasTail重试
+*********************************************************************************************************/
+static  uint16 DropOld(StructRing* pRing, uint16 len)
+{
+  uint16 head = pRing->head;
+  uint16 tail;
+  uint16 free;
+
+  do
+  {
+    tail = pRing->tail;
+    free = (uint16)(pRing->mask + 1 - (uint16)(head - tail));
+    if(free >= len)
+    {
+      return 0;
+    }
+  }while(!CasTail(pRing, tail, tail + (len - free)));
+
+  return len - free;
+}
+
+/*********************************************************************************************************
+*                                              API函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：InitRing
+* 函数功能：初始化环形缓冲区
+* 输入参数：pRing-环形缓冲区，pBuf-元素存储区，elemSize-每个元素的字节数，len-存储区能存放的元素个数
+* 输出参数：pRing-环形缓冲区
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：len不是2的幂时只使用不超过len的最大2的幂个元素
+*********************************************************************************************************/
+void InitRing(StructRing* pRing, void* pBuf, uint8 elemSize, uint16 len)
+{
+  uint16 cap = 1;  //实际容量
+
+  while(cap < RING_MAX_LEN && (uint16)(cap << 1) <= len)
+  {
+    cap <<= 1;
+  }
+
+  pRing->head     = 0;
+  pRing->tail     = 0;
+  pRing->mask     = cap - 1;
+  pRing->elemSize = elemSize;
+  pRing->policy   = RING_DROP_NEW;
+  pRing->pBuffer  = (uint8*)pBuf;
+
+  memset(&pRing->stats, 0, sizeof(pRing->stats));
+  pRing->stats.size = cap;
+
+  memset(pBuf, 0, (uint32)cap * elemSize);
+}
+
+/*********************************************************************************************************
+* 函数名称：ClearRing
+* 函数功能：清空环形缓冲区
+* 输入参数：pRing-环形缓冲区
+* 输出参数：pRing-环形缓冲区
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：只修改tail，由消费者调用
+*********************************************************************************************************/
+void ClearRing(StructRing* pRing)
+{
+  uint16 tail;
+
+  if(pRing->policy != RING_DROP_OLD)
+  {
+    pRing->tail = pRing->head;
+    return;
+  }
+
+  do
+  {
+    tail = pRing->tail;
+  }while(!CasTail(pRing, tail, pRing->head));
+}
+
+/*********************************************************************************************************
+* 函数名称：RingSetPolicy
+* 函数功能：设置空间不足时的丢弃策略
+* 输入参数：pRing-环形缓冲区，policy-丢弃策略，EnumRingPolicy
+* 输出参数：pRing-环形缓冲区
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：在InitRing之后、开始读写之前调用；用RingPeekRead零拷贝读的缓冲区不能设为RING_DROP_OLD
+*********************************************************************************************************/
+void RingSetPolicy(StructRing* pRing, uint8 policy)
+{
+  pRing->policy = policy;
+}
+
+/*********************************************************************************************************
+* 函数名称：RingGetStats
+* 函数功能：读取写入、丢弃的元素个数和最高水位
+* 输入参数：pRing-环形缓冲区
+* 输出参数：pStats-统计
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：统计由生产者修改，在另一方读取时各字段可能不是同一时刻的值，只用于观察缓冲区大小是否合适
+*********************************************************************************************************/
+void RingGetStats(StructRing* pRing, StructRingStats* pStats)
+{
+  *pStats = pRing->stats;
+}
+
+/*********************************************************************************************************
+* 函数名称：RingLength
+* 函数功能：返回缓冲区中元素的个数
+* 输入参数：pRing-环形缓冲区
+* 输出参数：void
+* 返 回 值：元素的个数
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+uint16 RingLength(StructRing* pRing)
+{
+  return (uint16)(pRing->head - pRing->tail);
+}
+
+/*********************************************************************************************************
+* 函数名称：RingFree
+* 函数功能：返回还能写入元素的个数
+* 输入参数：pRing-环形缓冲区
+* 输出参数：void
+* 返 回 值：空闲元素的个数
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+uint16 RingFree(StructRing* pRing)
+{
+  return (uint16)(pRing->mask + 1 - (uint16)(pRing->head - pRing->tail));
+}
+
+/*********************************************************************************************************
+* 函数名称：RingPut
+* 函数功能：写入len个元素
+* 输入参数：pRing-环形缓冲区，pData-待写入的元素，len-期望写入的个数
+* 输出参数：pRing-环形缓冲区
+* 返 回 值：实际写入的个数，空间不足时按丢弃策略：
+*           RING_DROP_NEW只写入能放下的部分，RING_DROP_FRAME一个也不写入，
+*           RING_DROP_OLD丢弃最旧的元素后全部写入(超过容量时只写入最后容量个)
+* 创建日期：2026年10月19日
+* 注    意：由生产者调用
+*********************************************************************************************************/
+uint16 RingPut(StructRing* pRing, const void* pData, uint16 len)
+{
+  uint16 head  = pRing->head;
+  uint16 free  = (uint16)(pRing->mask + 1 - (uint16)(head - pRing->tail));
+  uint16 pos   = head & pRing->mask;
+  uint16 first;  //第一段写到缓冲区末尾的个数
+  uint16 drop  = 0;
+  uint16 used;
+  uint8  size  = pRing->elemSize;
+
+  if(len > free)
+  {
+    if(pRing->policy == RING_DROP_OLD)
+    {
+      if(len > pRing->mask + 1)
+      {
+        drop  = len - (pRing->mask + 1);
+        pData = (const uint8*)pData + (uint32)drop * size;
+        len   = pRing->mask + 1;
+      }
+      drop += DropOld(pRing, len);
+    }
+    else if(pRing->policy == RING_DROP_FRAME)
+    {
+      drop = len;
+      len  = 0;
+    }
+    else
+    {
+      drop = len - free;
+      len  = free;
+    }
+    pRing->stats.dropNum += drop;
+  }
+
+  first = pRing->mask + 1 - pos;
+  if(first > len)
+  {
+    first = len;
+  }
+
+  memcpy(&pRing->pBuffer[(uint32)pos * size], pData, (uint32)first * size);
+  memcpy(pRing->pBuffer, (const uint8*)pData + (uint32)first * size, (uint32)(len - first) * size);
+
+  __DMB();  //数据写完后再更新head
+  pRing->head = head + len;
+
+  pRing->stats.putNum += len;
+  used = (uint16)(head + len - pRing->tail);
+  if(used > pRing->stats.peak)
+  {
+    pRing->stats.peak = used;
+  }
+
+  return len;
+}
+
+/*********************************************************************************************************
+* 函数名称：RingGet
+* 函数功能：读出len个元素
+* 输入参数：pRing-环形缓冲区，len-期望读出的个数
+* 输出参数：pData-读出的元素存放的地址
+* 返 回 值：实际读出的个数，元素不够时只读出已有的部分
+* 创建日期：2026年10月19日
+* 注    意：由消费者调用；RING_DROP_OLD时若读的过程中生产者丢弃了旧数据，则重新读
+*********************************************************************************************************/
+uint16 RingGet(StructRing* pRing, void* pData, uint16 len)
+{
+  uint16 tail;
+  uint16 num;
+  uint16 pos;
+  uint16 first;  //第一段读到缓冲区末尾的个数
+  uint16 want  = len;
+  uint8  size  = pRing->elemSize;
+
+  while(1)
+  {
+    tail = pRing->tail;
+    num  = (uint16)(pRing->head - tail);
+    pos  = tail & pRing->mask;
+    len  = want;
+
+    if(len > num)
+    {
+      len = num;
+    }
+
+    first = pRing->mask + 1 - pos;
+    if(first > len)
+    {
+      first = len;
+    }
+
+    __DMB();  //看到head之后再读数据
+    memcpy(pData, &pRing->pBuffer[(uint32)pos * size], (uint32)first * size);
+    memcpy((uint8*)pData + (uint32)first * size, pRing->pBuffer, (uint32)(len - first) * size);
+
+    __DMB();  //数据读完后再释放空间
+    if(pRing->policy != RING_DROP_OLD)
+    {
+      pRing->tail = tail + len;
+      break;
+    }
+    if(CasTail(pRing, tail, tail + len))
+    {
+      break;
+    }
+  }
+
+  return len;
+}
+
+/*********************************************************************************************************
+* 函数名称：RingPeekRead
+* 函数功能：返回从读位置开始、在缓冲区中地址连续的元素，不出队
+* 输入参数：pRing-环形缓冲区
+* 输出参数：ppData-连续元素的首地址
+* 返 回 值：连续元素的个数，跨过缓冲区末尾时只返回末尾之前的部分
+* 创建日期：2026年10月19日
+* 注    意：用完后调用RingCommitRead出队
+*********************************************************************************************************/
+uint16 RingPeekRead(StructRing* pRing, void** ppData)
+{
+  uint16 tail = pRing->tail;
+  uint16 num  = (uint16)(pRing->head - tail);
+  uint16 pos  = tail & pRing->mask;
+
+  if(num > pRing->mask + 1 - pos)
+  {
+    num = pRing->mask + 1 - pos;
+  }
+
+  __DMB();
+  *ppData = &pRing->pBuffer[(uint32)pos * pRing->elemSize];
+
+  return num;
+}
+
+/*********************************************************************************************************
+* 函数名称：RingCommitRead
+* 函数功能：确认读走len个元素
+* 输入参数：pRing-环形缓冲区，len-读走的个数
+* 输出参数：pRing-环形缓冲区
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：len不能超过缓冲区中元素的个数
+*********************************************************************************************************/
+void RingCommitRead(StructRing* pRing, uint16 len)
+{
+  uint16 tail;
+
+  __DMB();
+  if(pRing->policy != RING_DROP_OLD)
+  {
+    pRing->tail += len;
+    return;
+  }
+
+  do
+  {
+    tail = pRing->tail;
+  }while(!CasTail(pRing, tail, tail + len));
+}
+
+/*********************************************************************************************************
+* 函数名称：RingPeekWrite
+* 函数功能：返回从写位置开始、在缓冲区中地址连续的空闲元素
+* 输入参数：pRing-环形缓冲区
+* 输出参数：ppData-连续空闲元素的首地址
+* 返 回 值：连续空闲元素的个数，跨过缓冲区末尾时只返回末尾之前的部分
+* 创建日期：2026年10月19日
+* 注    意：写完后调用RingCommitWrite入队
+*********************************************************************************************************/
+uint16 RingPeekWrite(StructRing* pRing, void** ppData)
+{
+  uint16 head = pRing->head;
+  uint16 free = (uint16)(pRing->mask + 1 - (uint16)(head - pRing->tail));
+  uint16 pos  = head & pRing->mask;
+
+  if(free > pRing->mask + 1 - pos)
+  {
+    free = pRing->mask + 1 - pos;
+  }
+
+  *ppData = &pRing->pBuffer[(uint32)pos * pRing->elemSize];
+
+  return free;
+}
+
+/*********************************************************************************************************
+* 函数名称：RingCommitWrite
+* 函数功能：确认写入len个元素
+* 输入参数：pRing-环形缓冲区，len-写入的个数
+* 输出参数：pRing-环形缓冲区
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：len不能超过空闲元素的个数
+*********************************************************************************************************/
+void RingCommitWrite(StructRing* pRing, uint16 len)
+{
+  uint16 used;
+
+  __DMB();
+  pRing->head += len;
+
+  pRing->stats.putNum += len;
+  used = (uint16)(pRing->head - pRing->tail);
+  if(used > pRing->stats.peak)
+  {
+    pRing->stats.peak = used;
+  }
+}
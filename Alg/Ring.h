@@ -0,0 +1,80 @@
+/*********************************************************************************************************
+* 模块名称：Ring.h
+* 摘    要：单生产者/单消费者环形缓冲区，元素大小可配置，供字节队列和16位队列共用
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：写位置head只由生产者修改，读位置tail只由消费者修改，两者都自由增长，取模用容量掩码；
+*           一方在中断、一方在主循环中使用时不需要关中断；
+*           批量读写用memcpy，跨过缓冲区末尾时分两段拷贝；
+*           RingPeekRead/RingCommitRead、RingPeekWrite/RingCommitWrite直接访问缓冲区，供DMA等零拷贝使用
+*           空间不足时按RingSetPolicy设置的策略丢弃数据，并统计写入、丢弃的元素个数和最高水位
+* 注    意：容量必须为2的幂，且不超过32768个元素；不是2的幂时InitRing向下取整
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+#ifndef _RING_H_
+#define _RING_H_
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "DataType.h"
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              枚举结构体定义
+*********************************************************************************************************/
+//空间不足时的丢弃策略
+typedef enum
+{
+  RING_DROP_NEW   = 0x00,  //丢弃放不下的新数据，能放下的部分照常写入
+  RING_DROP_OLD   = 0x01,  //丢弃最旧的数据腾出空间，新数据全部写入
+  RING_DROP_FRAME = 0x02,  //以每次写入为一帧，放不下时整帧丢弃，不写入半帧
+}EnumRingPolicy;
+
+//环形缓冲区统计，只由生产者修改
+typedef struct
+{
+  uint32 putNum;   //写入的元素个数
+  uint32 dropNum;  //丢弃的元素个数
+  uint16 peak;     //最高水位，即缓冲区中曾经同时存在的最多元素个数
+  uint16 size;     //容量
+}StructRingStats;
+
+//环形缓冲区结构体
+typedef struct
+{
+  volatile uint16 head;     //写位置，只由生产者修改
+  volatile uint16 tail;     //读位置，只由消费者修改，RING_DROP_OLD时生产者也会修改
+  uint16          mask;     //容量 - 1
+  uint8           elemSize; //每个元素的字节数
+  uint8           policy;   //丢弃策略，EnumRingPolicy
+  uint8*          pBuffer;  //缓冲区
+  StructRingStats stats;    //统计
+}StructRing;
+
+/*********************************************************************************************************
+*                                              API函数声明
+*********************************************************************************************************/
+void   InitRing(StructRing* pRing, void* pBuf, uint8 elemSize, uint16 len); //初始化，len为元素个数
+void   ClearRing(StructRing* pRing);                            //清空，由消费者调用
+void   RingSetPolicy(StructRing* pRing, uint8 policy);          //设置空间不足时的丢弃策略，EnumRingPolicy
+void   RingGetStats(StructRing* pRing, StructRingStats* pStats);//读取统计
+uint16 RingLength(StructRing* pRing);                           //返回缓冲区中元素的个数
+uint16 RingFree(StructRing* pRing);                             //返回还能写入元素的个数
+uint16 RingPut(StructRing* pRing, const void* pData, uint16 len); //写入len个元素，返回实际写入个数
+uint16 RingGet(StructRing* pRing, void* pData, uint16 len);     //读出len个元素，返回实际读出个数
+uint16 RingPeekRead(StructRing* pRing, void** ppData);          //返回读位置开始地址连续的元素个数，不出队
+void   RingCommitRead(StructRing* pRing, uint16 len);           //RingPeekRead之后确认读走len个元素
+uint16 RingPeekWrite(StructRing* pRing, void** ppData);         //返回写位置开始地址连续的空闲元素个数
+void   RingCommitWrite(StructRing* pRing, uint16 len);          //RingPeekWrite之后确认写入len个元素
+
+#endif
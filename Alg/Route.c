@@ -21,6 +21,7 @@
 #include "SendDataToHost.h"
 #include "RADIO.h"
 #include "PackUnpack.h"
+#include "Tdma.h"
 #include "string.h"
 
 /*********************************************************************************************************
@@ -45,6 +46,23 @@ volatile static StructRouteTable s_structRouteTable;//路由线性表
 static StructRoute s_structRouteBuf[ROUTE_TABLE_SIZE];//路由表信息存放数组
 volatile static uint8 IndexOfParent;  //父节点表中下标
 
+static uint8 s_iBeaconSeq;            //信标序号，邻居据此统计投递率
+static uint8 s_iPendingRate = ROUTE_RATE_NONE;  //待切换的空中速率
+static uint32 s_iRateSwitchMs;        //待切换速率的切换时刻(millis)
+static uint8 s_iQuietCnt;             //连续收不到信标的周期数
+static int16 s_iNoiseAvg;             //环境噪声滑动平均，单位1/16dBm，0表示未知
+static uint16 s_iReserve;             //本节点波形流预留的负载(字节/秒)
+//各空中速率档位的空中速率(bps)
+static const uint16 s_arrAirBps[RADIO_AIR_RATE_NUM] = {300, 1200, 2400, 4800, 9600, 19200, 38400, 62500};
+#if (defined WOR_LEAF && WOR_LEAF)//WOR叶子节点
+static uint8 s_iWorListenCnt;         //距上次连续接收的路由周期数
+#endif
+#if (defined SINK && SINK)//汇聚节点
+static uint8 s_iLastVote = ROUTE_RATE_NONE;     //上个周期的投票结果
+static uint8 s_iRateHoldCnt;          //投票结果连续保持的周期数
+static uint8 s_iRateRepeat;           //切换命令还须重复广播的次数
+#endif
+
 /*********************************************************************************************************
 *                                              内部函数声明
 *********************************************************************************************************/
@@ -60,6 +78,19 @@ static void  RouteTimerTask(void);     //定时20S，路由表更新，父结点
 static void  UpdateParent(void);       //更新父节点
 static void  DecreaseLiveTime(void);   //老化路由表
 static void  DeleteTable(void);        //删除超时过期路由项
+static int16 AvgQ4(int16 avg, int16 dbm);         //1/16dBm为单位的滑动平均
+static uint8 LinkVote(StructRoute *pRou, uint8 cur);  //由链路投递率和信噪余量得出该链路能承受的速率档位
+static uint8 CalcRateVote(void);       //计算本节点子树能承受的最高速率档位
+static void  ApplyAirRate(uint8 rate); //切换空中速率并清零链路统计
+static void  AdaptAirRate(void);       //速率自适应定时任务
+static void  UpdateChannel(void);      //按父结点选择本节点的接收信道
+static uint8 ScanNextChannel(void);    //失去网络时换下一个信道寻找网络
+static uint8 AddChannel(uint8 *pCh, uint8 num, uint8 ch);  //信道加入集合
+static uint16 LoadCapacity(void);      //当前空中速率下可预留给波形流的负载
+static uint8 ToLoadUnit(uint16 load, uint8 up);  //字节/秒换算为信标中的单位
+#if (defined WOR_LEAF && WOR_LEAF)//WOR叶子节点
+static void  WorTask(void);            //WOR监听与连续接收的切换
+#endif
 
 /*********************************************************************************************************
 *                                              内部函数实现
@@ -86,6 +117,15 @@ void InitRouTab(void)
   structRou.qualify = 0;
   structRou.RecCnt = 0;
   structRou.SedCnt = 0;
+  structRou.rateVote = ROUTE_RATE_BASE;
+  structRou.rssiAvg  = 0;
+  structRou.flags    = 0;
+  structRou.channel  = ROUTE_CH_BASE;
+  structRou.subSize  = 0;
+  structRou.slotNeed = 0;
+  structRou.child    = 0;
+  structRou.load     = 0;
+  structRou.headroom = 0;
   
   s_structRouteTable.len = ROUTE_TABLE_SIZE;//表长
   s_structRouteTable.elemNum = 0;           //当前行数
@@ -129,7 +169,7 @@ int8 find(uint8 addh, uint8 addl)
   
   for(i = 0; i<len; i++)
   {
-    if(strupRou[i].addh == addh && strupRou[i].addh == addl)
+    if(strupRou[i].addh == addh && strupRou[i].addl == addl)
     {
       return i;
     }
@@ -167,11 +207,39 @@ uint8 InsertRou(StructRoute *pRou)
 * 输出参数：无
 * 返 回 值：void
 * 创建日期：2021年11月2日
-* 注    意：也许可以用RSSI指示链路质量？
+* 注    意：每个邻居统计到ROUTE_EST_WINDOW个信标序号后计算一次投递率(%)，qualify为其滑动平均，0表示未知；
+*           同时更新环境噪声的滑动平均，各邻居的RSSI在收到信标时更新
 *********************************************************************************************************/
 void UpdateEst(void)
 {
+  uint8 len = s_structRouteTable.elemNum;
+  StructRoute *strupRou = s_structRouteTable.pRouBuf;
+  uint8 i;
+  uint8 prr;
+  int16 noise;
+  
+  if(RadioGetNoise(&noise))
+  {
+    s_iNoiseAvg = AvgQ4(s_iNoiseAvg, noise);
+  }
   
+  for(i = 1; i<len; i++)//i=0是默认路由
+  {
+    if(strupRou[i].SedCnt >= ROUTE_EST_WINDOW)
+    {
+      prr = (uint8)((uint16)strupRou[i].RecCnt * 100 / strupRou[i].SedCnt);
+      if(strupRou[i].qualify == 0)
+      {
+        strupRou[i].qualify = prr;
+      }
+      else
+      {
+        strupRou[i].qualify = (uint8)(((uint16)strupRou[i].qualify * 3 + prr) / 4);
+      }
+      strupRou[i].SedCnt = 0;
+      strupRou[i].RecCnt = 0;
+    }
+  }
 }
 
 /*********************************************************************************************************
@@ -181,7 +249,8 @@ void UpdateEst(void)
 * 输出参数：无
 * 返 回 值：void
 * 创建日期：2021年11月2日
-* 注    意：利用广播消息更新路由表 |addh |addl |dis |
+* 注    意：利用广播消息更新路由表 |addh |addl |dis |seq |vote |flags |channel |size |need |parent |load |room |，
+*           序号的跳变计入应收信标数
 *********************************************************************************************************/
 uint8 UpdateTable(uint8 *pMsg, uint8 position)
 {
@@ -189,6 +258,7 @@ uint8 UpdateTable(uint8 *pMsg, uint8 position)
   StructRoute temp;
   uint8 ok  = 1;
   uint8 dis = pMsg[2];
+  uint8 gap = (uint8)(pMsg[3] - strupRou[position].no);//与上次收到的序号之差
   temp = strupRou[position];
   
   if(dis <= 0xff )//最大255跳
@@ -197,6 +267,21 @@ uint8 UpdateTable(uint8 *pMsg, uint8 position)
     temp.liveliness = 100;
   }
   
+  if(gap != 0 && gap < 0x80)//新信标，序号回退视为重复包
+  {
+    temp.SedCnt   += gap;
+    temp.RecCnt   += 1;
+    temp.no        = pMsg[3];
+    temp.rateVote  = pMsg[4];
+    temp.flags     = pMsg[5];
+    temp.channel   = pMsg[6];
+    temp.subSize   = pMsg[7];
+    temp.slotNeed  = pMsg[8];
+    temp.child     = (MAKEHWORD(pMsg[9], pMsg[10]) == getAddress());
+    temp.load      = pMsg[11];
+    temp.headroom  = pMsg[12];
+  }
+  
   strupRou[position] = temp;//存入路由表
   return ok;
 }
@@ -214,7 +299,13 @@ void RouteTimerTask()
 {
   DecreaseLiveTime(); //老化路由表
   DeleteTable();      //删除超时过期路由项
+  UpdateEst();        //更新链路投递率
   UpdateParent();     //父结点更新
+  UpdateChannel();    //接收信道跟随父结点
+#if (defined WOR_LEAF && WOR_LEAF)//WOR叶子节点
+  WorTask();          //WOR监听与连续接收的切换
+#endif
+  AdaptAirRate();     //空中速率自适应
   SendRouteTask();    //广播路由信息给邻居
 }
 
@@ -225,7 +316,7 @@ void RouteTimerTask()
 * 输出参数：无
 * 返 回 值：void
 * 创建日期：2021年11月2日
-* 注    意：
+* 注    意：WOR叶子节点不转发，不能作为父结点
 *********************************************************************************************************/
 void  UpdateParent()
 {
@@ -238,7 +329,7 @@ void  UpdateParent()
   for(i = 0; i<len; i++)
   {
     uint8 dis = strupRou[i].distance;
-    if(dis < MinHop)
+    if(dis < MinHop && !(strupRou[i].flags & ROUTE_FLAG_WOR))
     {
       MinHop = dis;
       Index = i;
@@ -312,21 +403,405 @@ void DeleteTable()
 * 输出参数：
 * 返 回 值：
 * 创建日期：2021年11月6日
-* 注    意：广播发送路由消息|SenCnt |addh |addl |dis |no |recCnt |
+* 注    意：广播发送路由消息|addh |addl |dis |seq |vote |flags |channel |size |need |parent |load |room |，
+*           load为本节点子树预留的负载，room为本节点到汇聚节点的路径余量，子结点据此接纳波形流
 *********************************************************************************************************/
 void SendRouteTask(void)    
 {
   uint8 arrRouteData[DATALEN] = {0}; //初始化数据分组的数组
   
-  uint16 add = getAddress();//取得模块地址,失败返回0xffff,占用串口！！！
+  uint16 add = getAddress();//取得模块地址,失败返回0xffff
   
   arrRouteData[0] = add>>8; //结点自己的地址高位
   arrRouteData[1] = add;    //结点自己的地址低位
   arrRouteData[2] = s_structRouteBuf[IndexOfParent].distance;//跳数
+  arrRouteData[3] = ++s_iBeaconSeq;  //信标序号
+  arrRouteData[4] = CalcRateVote();  //速率投票
+#if (defined WOR_LEAF && WOR_LEAF)//WOR叶子节点
+  arrRouteData[5] = ROUTE_FLAG_WOR;  //邻居给本节点发送时须带唤醒前导码
+#endif
+  arrRouteData[6] = RadioGetChannel();  //本节点的接收信道
+#if (defined MAC_TDMA) && (MAC_TDMA == TRUE)
+  TdmaGetDemand(&arrRouteData[7], &arrRouteData[8]);  //本节点子树的规模，父结点据此分配时隙
+#endif
+  arrRouteData[9]  = GetParentAddr() >> 8;  //父结点地址，邻居据此判断是否是它的子结点
+  arrRouteData[10] = GetParentAddr();
+  arrRouteData[11] = ToLoadUnit(RouteGetLoad(), 1);      //负载向上取整
+  arrRouteData[12] = ToLoadUnit(RouteGetHeadroom(), 0);  //余量向下取整，子结点不会超额预留
   
   SendRouteToNeighbor(arrRouteData, DATALEN);
 }
 
+/*********************************************************************************************************
+* 函数名称：AvgQ4
+* 函数功能：1/16dBm为单位的滑动平均，新值权重1/8
+* 输入参数：avg-原平均值(1/16dBm)，0表示未知，dbm-新测量值(dBm)
+* 输出参数：无
+* 返 回 值：新平均值(1/16dBm)
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static int16 AvgQ4(int16 avg, int16 dbm)
+{
+  int16 x = dbm * 16;
+  
+  if(avg == 0)
+  {
+    return x;
+  }
+  return avg + (x - avg) / 8;
+}
+
+/*********************************************************************************************************
+* 函数名称：LinkVote
+* 函数功能：由链路投递率和信噪余量得出该链路能承受的速率档位
+* 输入参数：pRou-邻居表项，cur-当前速率档位
+* 输出参数：无
+* 返 回 值：速率档位
+* 创建日期：2026年10月19日
+* 注    意：每次最多升降一档；RSSI和噪声都已知时，余量不足ROUTE_MARGIN_UP不升速
+*********************************************************************************************************/
+static uint8 LinkVote(StructRoute *pRou, uint8 cur)
+{
+  uint8 qualify = pRou->qualify;
+  uint8 margin  = 1;   //信噪余量是否足够
+  
+  if(pRou->rssiAvg != 0 && s_iNoiseAvg != 0)
+  {
+    margin = (pRou->rssiAvg - s_iNoiseAvg) >= ROUTE_MARGIN_UP * 16;
+  }
+  
+  if(qualify == 0)
+  {
+    return cur;
+  }
+  if(qualify >= ROUTE_PRR_UP && margin && cur < ROUTE_RATE_MAX)
+  {
+    return cur + 1;
+  }
+  if(qualify < ROUTE_PRR_DOWN && cur > ROUTE_RATE_MIN)
+  {
+    return cur - 1;
+  }
+  return cur;
+}
+
+/*********************************************************************************************************
+* 函数名称：CalcRateVote
+* 函数功能：计算本节点子树能承受的最高速率档位
+* 输入参数：void
+* 输出参数：无
+* 返 回 值：速率档位
+* 创建日期：2026年10月19日
+* 注    意：取到父结点链路、到各子结点链路的投票以及子结点信标中投票的最小值，
+*           子结点指跳数比本节点多的邻居，投票随信标逐跳汇聚到汇聚节点
+*********************************************************************************************************/
+static uint8 CalcRateVote(void)
+{
+  uint8 len = s_structRouteTable.elemNum;
+  StructRoute *strupRou = s_structRouteTable.pRouBuf;
+  uint8 cur   = RadioGetAirRate();
+  uint8 myDis = strupRou[IndexOfParent].distance;
+  uint8 vote  = ROUTE_RATE_MAX;
+  uint8 child = 0;      //子结点个数
+  uint8 temp;
+  uint8 i;
+  
+#if (defined SINK && SINK)//汇聚节点
+  //汇聚节点没有父结点，只看子结点
+#else
+  if(IndexOfParent == 0)//没有父结点
+  {
+    return cur;
+  }
+  vote = LinkVote(&strupRou[IndexOfParent], cur);
+#endif
+  
+  for(i = 1; i<len; i++)
+  {
+    if(strupRou[i].distance != 0xff && strupRou[i].distance > myDis + 1)//子结点
+    {
+      temp = LinkVote(&strupRou[i], cur);
+      if(strupRou[i].rateVote < temp)
+      {
+        temp = strupRou[i].rateVote;
+      }
+      if(temp < vote)
+      {
+        vote = temp;
+      }
+      child++;
+    }
+  }
+  
+#if (defined SINK && SINK)//汇聚节点
+  return (child == 0) ? cur : vote;  //没有子结点时不改变速率
+#else
+  return vote;
+#endif
+}
+
+/*********************************************************************************************************
+* 函数名称：ApplyAirRate
+* 函数功能：切换空中速率并清零链路统计
+* 输入参数：rate-空中速率档位
+* 输出参数：无
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：速率变化后原来的投递率不再有效
+*********************************************************************************************************/
+static void ApplyAirRate(uint8 rate)
+{
+  uint8 len = s_structRouteTable.elemNum;
+  StructRoute *strupRou = s_structRouteTable.pRouBuf;
+  uint8 i;
+  
+  if(rate == RadioGetAirRate() || !RadioSetAirRate(rate))
+  {
+    return;
+  }
+  debug("空中速率切换为%d\r\n", rate);
+  
+  for(i = 1; i<len; i++)
+  {
+    strupRou[i].qualify = 0;
+    strupRou[i].SedCnt  = 0;
+    strupRou[i].RecCnt  = 0;
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：AdaptAirRate
+* 函数功能：速率自适应定时任务
+* 输入参数：void
+* 输出参数：无
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：汇聚节点的投票结果连续ROUTE_RATE_HOLD个周期不变才广播CMD_SET_AIR_RATE，
+*           命令带切换前的剩余时间，之后ROUTE_RATE_REPEAT-1个周期重复广播，全网到时由RouteRateTask同时切换；
+*           连续ROUTE_RATE_LOST个周期收不到信标时，汇聚节点退回基础速率，普通节点轮换信道和速率寻找网络
+*********************************************************************************************************/
+static void AdaptAirRate(void)
+{
+  uint8 cur = RadioGetAirRate();
+#if (defined SINK && SINK)//汇聚节点
+  uint8 vote;
+#endif
+  
+  if(s_iPendingRate != ROUTE_RATE_NONE)//切换进行中，等待切换时刻
+  {
+#if (defined SINK && SINK)//汇聚节点
+    if(s_iRateRepeat > 0)
+    {
+      s_iRateRepeat--;
+      SendBcastCmd(0, CMD_SET_AIR_RATE, s_iPendingRate, GetAirRateRemain());
+    }
+#endif
+    return;
+  }
+  
+#if (defined WOR_LEAF && WOR_LEAF)//WOR叶子节点
+  if(RadioGetIdleMode() == MODEM_WOR)
+  {
+    return;   //WOR监听期间收不到信标，只在连续接收的周期判断是否失去网络
+  }
+#endif
+  
+  if(++s_iQuietCnt >= ROUTE_RATE_LOST)//失去网络
+  {
+    s_iQuietCnt = 0;
+#if (defined SINK && SINK)//汇聚节点
+    ApplyAirRate(ROUTE_RATE_BASE);
+#else
+    if(!ScanNextChannel())//所有信道都试过后再换速率
+    {
+      ApplyAirRate(cur >= ROUTE_RATE_MAX ? ROUTE_RATE_MIN : cur + 1);
+    }
+#endif
+    return;
+  }
+  
+#if (defined SINK && SINK)//汇聚节点
+  vote = CalcRateVote();
+  if(vote != cur && vote == s_iLastVote)
+  {
+    s_iRateHoldCnt++;
+  }
+  else
+  {
+    s_iRateHoldCnt = 0;
+  }
+  s_iLastVote = vote;
+  
+  if(s_iRateHoldCnt >= ROUTE_RATE_HOLD)
+  {
+    s_iRateHoldCnt = 0;
+    s_iRateRepeat  = ROUTE_RATE_REPEAT - 1;
+    SetPendingAirRate(vote, ROUTE_RATE_SWITCH_MS / 10);
+    SendBcastCmd(0, CMD_SET_AIR_RATE, vote, GetAirRateRemain());
+  }
+#endif
+}
+
+/*********************************************************************************************************
+* 函数名称：UpdateChannel
+* 函数功能：按父结点选择本节点的接收信道
+* 输入参数：void
+* 输出参数：无
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：汇聚节点固定使用ROUTE_CH_BASE；父结点是汇聚节点时由本节点地址在其余信道中选一个，
+*           作为本子树的信道；更深的节点沿用父结点的信道，整棵子树共用一个信道。
+*           信道变化后子结点从本节点发到其原信道的信标中得知新信道并跟随
+*********************************************************************************************************/
+static void UpdateChannel(void)
+{
+#if (defined SINK && SINK)//汇聚节点
+  //汇聚节点信道固定
+#else
+  StructRoute *pParent = &s_structRouteBuf[IndexOfParent];
+  uint8 ch;
+  
+  if(IndexOfParent == 0)//没有父结点，由ScanNextChannel寻找网络
+  {
+    return;
+  }
+  
+  ch = pParent->channel;
+#if (ROUTE_CH_NUM > 1)
+  if(pParent->distance == 1)//父结点是汇聚节点
+  {
+    ch = ROUTE_CH_BASE + 1 + getAddress() % (ROUTE_CH_NUM - 1);
+  }
+#endif
+  
+  if(ch != RadioGetChannel() && RadioSetChannel(ch))
+  {
+    debug("接收信道切换为%d\r\n", ch);
+  }
+#endif
+}
+
+/*********************************************************************************************************
+* 函数名称：ScanNextChannel
+* 函数功能：失去网络时换下一个信道寻找网络
+* 输入参数：void
+* 输出参数：无
+* 返 回 值：1--已换到下一个信道，0--所有信道都已试过，回到ROUTE_CH_BASE
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static uint8 ScanNextChannel(void)
+{
+  uint8 ch = RadioGetChannel() + 1;
+  
+  if(ch < ROUTE_CH_BASE + 1 || ch >= ROUTE_CH_BASE + ROUTE_CH_NUM)
+  {
+    RadioSetChannel(ROUTE_CH_BASE);
+    return 0;
+  }
+  RadioSetChannel(ch);
+  return 1;
+}
+
+/*********************************************************************************************************
+* 函数名称：AddChannel
+* 函数功能：信道加入集合，已有的不重复加入
+* 输入参数：pCh-信道集合，num-集合中已有的个数，ch-信道
+* 输出参数：pCh
+* 返 回 值：加入后的个数
+* 创建日期：2026年10月19日
+* 注    意：集合最多ROUTE_CH_NUM个
+*********************************************************************************************************/
+static uint8 AddChannel(uint8 *pCh, uint8 num, uint8 ch)
+{
+  uint8 i;
+  
+  for(i = 0; i < num; i++)
+  {
+    if(pCh[i] == ch)
+    {
+      return num;
+    }
+  }
+  if(num < ROUTE_CH_NUM)
+  {
+    pCh[num++] = ch;
+  }
+  return num;
+}
+
+/*********************************************************************************************************
+* 函数名称：LoadCapacity
+* 函数功能：当前空中速率下可预留给波形流的负载
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：负载(字节/秒)
+* 创建日期：2026年10月19日
+* 注    意：只按本节点的发送时间估计，没有计入同信道邻居的发送，ROUTE_LOAD_SHARE须留出余地；
+*           TDMA时超帧长度随空中速率变化，容量取两者中小的
+*********************************************************************************************************/
+static uint16 LoadCapacity(void)
+{
+  uint16 cap = (uint16)((uint32)s_arrAirBps[RadioGetAirRate()] / 8 * ROUTE_LOAD_SHARE / 100);
+#if (defined MAC_TDMA) && (MAC_TDMA == TRUE)
+  if(TdmaCapacity() < cap)//TDMA时还受超帧时隙数限制
+  {
+    cap = TdmaCapacity();
+  }
+#endif
+  return cap;
+}
+
+/*********************************************************************************************************
+* 函数名称：ToLoadUnit
+* 函数功能：字节/秒换算为信标中的单位
+* 输入参数：load-负载(字节/秒)，up-1--向上取整，0--向下取整
+* 输出参数：void
+* 返 回 值：以ROUTE_LOAD_UNIT为单位的负载，超过255按255计
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static uint8 ToLoadUnit(uint16 load, uint8 up)
+{
+  uint16 unit = (load + (up ? ROUTE_LOAD_UNIT - 1 : 0)) / ROUTE_LOAD_UNIT;
+
+  return (unit > 0xFF) ? 0xFF : (uint8)unit;
+}
+
+#if (defined WOR_LEAF && WOR_LEAF)//WOR叶子节点
+/*********************************************************************************************************
+* 函数名称：WorTask
+* 函数功能：WOR监听与连续接收的切换
+* 输入参数：void
+* 输出参数：无
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：没有父结点时连续接收寻找网络；有父结点后平时WOR监听，每ROUTE_WOR_LISTEN个周期连续接收
+*           一个周期，收听邻居信标维持路由表，接收时间约为连续接收的1/ROUTE_WOR_LISTEN；
+*           本节点发送的数据和信标由无线模块临时切换到传输模式发出
+*********************************************************************************************************/
+static void WorTask(void)
+{
+  if(IndexOfParent == 0)//没有父结点
+  {
+    s_iWorListenCnt = 0;
+    RadioSetIdleMode(MODEM_TRANSFER);
+    return;
+  }
+  
+  if(++s_iWorListenCnt >= ROUTE_WOR_LISTEN)
+  {
+    s_iWorListenCnt = 0;
+    RadioSetIdleMode(MODEM_TRANSFER);
+  }
+  else
+  {
+    RadioSetIdleMode(MODEM_WOR);
+  }
+}
+#endif
+
 /*********************************************************************************************************
 *                                              API函数实现
 *********************************************************************************************************/
@@ -397,24 +872,44 @@ uint8 UpdateRouTab(uint8 *pMsg)
 * 输出参数：void
 * 返 回 值：1---成功
 * 创建日期：2022年2月2日
-* 注    意：pMsg---->|SrcAddh |SrcAddL |MinDis |
+* 注    意：pMsg---->|SrcAddh |SrcAddL |MinDis |seq |vote |flags |channel |size |need |parent |load |room |，
+*           rssi为该信标的RSSI(dBm)，0表示未知
 *********************************************************************************************************/
-uint8 UpdateRouTab2(uint8 *pMsg)
+uint8 UpdateRouTab2(uint8 *pMsg, int16 rssi)
 {
   uint8 ok = 0;
   int8 index = find(pMsg[0], pMsg[1]);//查找路由表中有无该地址
   StructRoute StRou;
   
+  s_iQuietCnt = 0;   //收到信标
+  
   if(index > -1)//有
   {
     ok = UpdateTable(pMsg, index);//更新路由表
+    if(rssi != 0)
+    {
+      s_structRouteBuf[index].rssiAvg = AvgQ4(s_structRouteBuf[index].rssiAvg, rssi);
+    }
   }
   else          //无则插入新路由项
   {
+    memset(&StRou, 0, sizeof(StructRoute));
     StRou.addh       = pMsg[0];         //addh
     StRou.addl       = pMsg[1];         //addl
     StRou.distance   = pMsg[2] < 0xFF? pMsg[2] + 1 : 0xFF; //dis
     StRou.liveliness = 100;       //刷新存活时间
+    StRou.no         = pMsg[3];   //信标序号
+    StRou.SedCnt     = 1;
+    StRou.RecCnt     = 1;
+    StRou.rateVote   = pMsg[4];
+    StRou.rssiAvg    = rssi * 16;
+    StRou.flags      = pMsg[5];
+    StRou.channel    = pMsg[6];
+    StRou.subSize    = pMsg[7];
+    StRou.slotNeed   = pMsg[8];
+    StRou.child      = (MAKEHWORD(pMsg[9], pMsg[10]) == getAddress());
+    StRou.load       = pMsg[11];
+    StRou.headroom   = pMsg[12];
     
     ok = InsertRou(&StRou);            //插入新的表项
   }
@@ -456,6 +951,285 @@ void RouteTimerTasks(void)
   RouteTimerTask();
 }
 
+/*********************************************************************************************************
+* 函数名称：GetNoiseAvg
+* 函数功能：返回本节点环境噪声滑动平均
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：环境噪声(dBm)，0表示未知
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+int16 GetNoiseAvg(void)
+{
+  return s_iNoiseAvg / 16;
+}
+
+/*********************************************************************************************************
+* 函数名称：SetPendingAirRate
+* 函数功能：收到速率切换命令，到切换时刻再切换
+* 输入参数：rate-空中速率档位，remain-距切换时刻的剩余时间(10ms)
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：不立即切换，留出时间把命令转发给子结点；重复收到的命令以最新的剩余时间为准
+*********************************************************************************************************/
+void SetPendingAirRate(uint8 rate, uint16 remain)
+{
+  if(rate <= ROUTE_RATE_MAX)
+  {
+    s_iPendingRate  = rate;
+    s_iRateSwitchMs = millis() + (uint32)remain * 10;
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：GetAirRateRemain
+* 函数功能：取得待切换速率的剩余时间，填入要发出的切换命令
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：剩余时间(10ms)
+* 创建日期：2026年10月19日
+* 注    意：扣除一个数据包在当前速率下的空中时间，使下一跳收到时算出的切换时刻与本节点一致
+*********************************************************************************************************/
+uint16 GetAirRateRemain(void)
+{
+  uint32 air  = (uint32)ROUTE_PKT_AIR_BYTES * 8 * 1000 / s_arrAirBps[RadioGetAirRate()];
+  int32  left = (int32)(s_iRateSwitchMs - millis()) - (int32)air;
+
+  return left > 0 ? (uint16)(left / 10) : 0;
+}
+
+/*********************************************************************************************************
+* 函数名称：RouteRateTask
+* 函数功能：到达切换时刻时切换空中速率
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：每2ms调用一次，全网按同一时刻切换，不等各自的路由周期
+*********************************************************************************************************/
+void RouteRateTask(void)
+{
+  if(s_iPendingRate != ROUTE_RATE_NONE && (int32)(millis() - s_iRateSwitchMs) >= 0)
+  {
+    ApplyAirRate(s_iPendingRate);
+    s_iPendingRate = ROUTE_RATE_NONE;
+    s_iQuietCnt    = 0;
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：IsWorNeighbor
+* 函数功能：查询邻居是否处于WOR监听
+* 输入参数：add-邻居地址
+* 输出参数：void
+* 返 回 值：1--是，发送给它的数据须带唤醒前导码，0--不是或不在路由表中
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+uint8 IsWorNeighbor(uint16 add)
+{
+  int8 index;
+  
+  if(add == 0xFFFF)
+  {
+    return 0;
+  }
+  index = find(add >> 8, add);
+  
+  return (index > 0 && (s_structRouteBuf[index].flags & ROUTE_FLAG_WOR)) ? 1 : 0;
+}
+
+/*********************************************************************************************************
+* 函数名称：HasWorNeighbor
+* 函数功能：查询是否有处于WOR监听的邻居
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：1--有，广播的命令须带唤醒前导码，0--没有
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+uint8 HasWorNeighbor(void)
+{
+  uint8 len = s_structRouteTable.elemNum;
+  uint8 i;
+  
+  for(i = 1; i<len; i++)//i=0是默认路由
+  {
+    if(s_structRouteBuf[i].flags & ROUTE_FLAG_WOR)
+    {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/*********************************************************************************************************
+* 函数名称：GetNeighborChannel
+* 函数功能：返回给邻居发送时使用的信道
+* 输入参数：add-邻居地址
+* 输出参数：void
+* 返 回 值：邻居的接收信道，不在路由表中时为本节点的接收信道
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+uint8 GetNeighborChannel(uint16 add)
+{
+  int8 index = find(add >> 8, add);
+  
+  if(index > 0)//i=0是默认路由
+  {
+    return s_structRouteBuf[index].channel;
+  }
+  return RadioGetChannel();
+}
+
+/*********************************************************************************************************
+* 函数名称：GetBcastChannels
+* 函数功能：取得广播须覆盖的信道
+* 输入参数：pCh-信道存放的首地址，至少ROUTE_CH_NUM字节
+* 输出参数：pCh
+* 返 回 值：信道个数
+* 创建日期：2026年10月19日
+* 注    意：本节点的接收信道、父结点和各子结点的接收信道，信标和命令在每个信道上各发一次
+*********************************************************************************************************/
+uint8 GetBcastChannels(uint8 *pCh)
+{
+  uint8 len = s_structRouteTable.elemNum;
+  StructRoute *strupRou = s_structRouteTable.pRouBuf;
+  uint8 myDis = strupRou[IndexOfParent].distance;
+  uint8 num = 0;
+  uint8 i;
+  
+  num = AddChannel(pCh, num, RadioGetChannel());
+  if(IndexOfParent != 0)
+  {
+    num = AddChannel(pCh, num, strupRou[IndexOfParent].channel);
+  }
+  for(i = 1; i<len; i++)
+  {
+    if(strupRou[i].distance != 0xff && strupRou[i].distance > myDis + 1)//子结点
+    {
+      num = AddChannel(pCh, num, strupRou[i].channel);
+    }
+  }
+  return num;
+}
+
+/*********************************************************************************************************
+* 函数名称：GetChildList
+* 函数功能：取得子结点的地址及其子树规模
+* 输入参数：pAdd-地址存放首地址，pSize-子树节点数存放首地址，pNeed-子树所需时隙数存放首地址，max-最多取几个
+* 输出参数：pAdd,pSize,pNeed
+* 返 回 值：子结点个数
+* 创建日期：2026年10月19日
+* 注    意：子结点指信标中父结点地址为本节点的邻居
+*********************************************************************************************************/
+uint8 GetChildList(uint16 *pAdd, uint8 *pSize, uint8 *pNeed, uint8 max)
+{
+  uint8 len = s_structRouteTable.elemNum;
+  uint8 num = 0;
+  uint8 i;
+  
+  for(i = 1; i<len && num < max; i++)//i=0是默认路由
+  {
+    if(s_structRouteBuf[i].child)
+    {
+      pAdd[num]  = MAKEHWORD(s_structRouteBuf[i].addh, s_structRouteBuf[i].addl);
+      pSize[num] = s_structRouteBuf[i].subSize;
+      pNeed[num] = s_structRouteBuf[i].slotNeed;
+      num++;
+    }
+  }
+  return num;
+}
+
+/*********************************************************************************************************
+* 函数名称：RouteSetReserve
+* 函数功能：设置本节点波形流预留的负载
+* 输入参数：load-负载(字节/秒)，0--取消预留
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：下一个信标起计入本节点子树的负载，沿路径各节点的余量随信标逐跳更新
+*********************************************************************************************************/
+void RouteSetReserve(uint16 load)
+{
+  s_iReserve = load;
+}
+
+/*********************************************************************************************************
+* 函数名称：RouteGetReserve
+* 函数功能：返回本节点波形流预留的负载
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：负载(字节/秒)
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+uint16 RouteGetReserve(void)
+{
+  return s_iReserve;
+}
+
+/*********************************************************************************************************
+* 函数名称：RouteGetLoad
+* 函数功能：返回本节点子树预留的负载
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：负载(字节/秒) = 本节点的预留 + 各子结点信标中的子树负载，即本节点须发送的波形流
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+uint16 RouteGetLoad(void)
+{
+  uint8  len  = s_structRouteTable.elemNum;
+  uint32 load = s_iReserve;
+  uint8  i;
+  
+  for(i = 1; i<len; i++)//i=0是默认路由
+  {
+    if(s_structRouteBuf[i].child)
+    {
+      load += (uint32)s_structRouteBuf[i].load * ROUTE_LOAD_UNIT;
+    }
+  }
+  return (load > 0xFFFF) ? 0xFFFF : (uint16)load;
+}
+
+/*********************************************************************************************************
+* 函数名称：RouteGetHeadroom
+* 函数功能：返回本节点到汇聚节点的路径上还能预留的负载
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：余量(字节/秒)，未入网时为0
+* 创建日期：2026年10月19日
+* 注    意：余量 = min(本节点的容量 - 子树负载, 父结点信标中的余量)，父结点的余量已扣除本节点子树的负载；
+*           信标周期内的变化要到下一个信标才传开，同一周期内接纳的多个波形流可能超额
+*********************************************************************************************************/
+uint16 RouteGetHeadroom(void)
+{
+  uint16 cap  = LoadCapacity();
+  uint16 load = RouteGetLoad();
+  uint16 room = (cap > load) ? cap - load : 0;
+#if (defined SINK && SINK)//汇聚节点
+#else
+  uint16 up;
+  
+  if(IndexOfParent == 0)//没有父结点
+  {
+    return 0;
+  }
+  up = (uint16)s_structRouteBuf[IndexOfParent].headroom * ROUTE_LOAD_UNIT;
+  if(up < room)
+  {
+    room = up;
+  }
+#endif
+  return room;
+}
+
 /*********************************************************************************************************
 * 函数名称：
 * 函数功能：
@@ -27,6 +27,33 @@
 *********************************************************************************************************/
 #define ROUTE_TABLE_SIZE 16           //设置路由表的行数
 
+//速率自适应，E22收发同一速率，全网使用同一空中速率，由汇聚节点统一决定
+#define ROUTE_EST_WINDOW  8           //链路估计窗口，每统计8个信标序号计算一次投递率
+#define ROUTE_PRR_UP      95          //投递率不低于该值(%)时可提高一档空中速率
+#define ROUTE_PRR_DOWN    80          //投递率低于该值(%)时须降低一档空中速率
+#define ROUTE_RATE_MIN    0x00        //允许的最低空中速率档位(0.3k)
+#define ROUTE_RATE_MAX    0x05        //允许的最高空中速率档位(19.2k)
+#define ROUTE_RATE_BASE   0x02        //基础空中速率档位(2.4k)，与E22默认工作参数一致
+#define ROUTE_RATE_HOLD   3           //汇聚节点投票结果须连续保持的周期数
+#define ROUTE_RATE_LOST   4           //连续多少个周期收不到信标认为失去网络
+#define ROUTE_RATE_NONE   0xFF        //无待切换的速率
+#define ROUTE_RATE_REPEAT 3           //汇聚节点在连续几个路由周期中广播同一切换命令，漏收的节点可从后续广播得知
+#define ROUTE_RATE_SWITCH_MS 20000    //决定切换到全网同时切换的时间(ms)，须容纳ROUTE_RATE_REPEAT次广播逐跳转发完毕
+#define ROUTE_PKT_AIR_BYTES 67        //每个数据包占的空中字节数：定点传输的地址和信道3字节 + 数据包64字节
+#define ROUTE_MARGIN_UP   10          //信号高出噪声不少于该值(dB)时才允许提高空中速率
+
+//WOR叶子节点，平时低功耗监听，邻居给它发送数据时须带唤醒前导码
+#define ROUTE_FLAG_WOR    0x01        //信标标志位：本节点处于WOR监听，不能作为父结点
+#define ROUTE_WOR_LISTEN  20          //WOR叶子节点每隔多少个路由周期连续接收一个周期，收听邻居信标
+
+//多信道，汇聚节点的每个子结点带领的子树使用一个接收信道，定点传输按帧指定发送信道，不同子树可同时发送
+#define ROUTE_CH_BASE     0x17        //汇聚节点的接收信道，也是未入网节点的初始信道，与E22默认工作参数一致
+#define ROUTE_CH_NUM      4           //可用信道数，ROUTE_CH_BASE ~ ROUTE_CH_BASE+ROUTE_CH_NUM-1，1为单信道
+
+//波形流容量预留，负载以空中字节/秒计，信标逐跳上报子树预留的负载、下传到汇聚节点路径上的余量
+#define ROUTE_LOAD_SHARE  50          //空中速率中可预留给波形流的比例(%)，其余留给信标、命令、周期数据和冲突
+#define ROUTE_LOAD_UNIT   16          //信标中负载和余量的单位(字节/秒)
+
 /*********************************************************************************************************
 *                                              枚举结构体定义
 *********************************************************************************************************/
@@ -41,6 +68,15 @@ typedef struct{
   uint8 SedCnt;    //发送计数
   uint8 RecCnt;    //接收计数
   int8 liveliness;//是否可用，每60S减30，收到消息置60.假设30S广播一次
+  uint8 rateVote;  //邻居信标中的速率投票，即其子树能承受的最高空中速率档位
+  int16 rssiAvg;   //收到该邻居信标的RSSI滑动平均，单位1/16dBm，0表示未知
+  uint8 flags;     //邻居信标中的标志位，ROUTE_FLAG_WOR
+  uint8 channel;   //邻居的接收信道，给它发送时使用
+  uint8 subSize;   //邻居子树的节点数(含自己)，TDMA时隙分配用
+  uint8 slotNeed;  //邻居子树需要的时隙数，TDMA时隙分配用
+  uint8 child;     //1--该邻居的父结点是本节点
+  uint8 load;      //邻居子树预留的负载，单位ROUTE_LOAD_UNIT
+  uint8 headroom;  //邻居到汇聚节点的路径上还能预留的负载，单位ROUTE_LOAD_UNIT
 }StructRoute;
 
 /*********************************************************************************************************
@@ -48,8 +84,21 @@ typedef struct{
 *********************************************************************************************************/
 void InitRoute(void);         //初始化线性路由表
 uint8 UpdateRouTab(uint8 *pMsg);    //更新路由表   ,地址有相同，更新，无则插入
-uint8 UpdateRouTab2(uint8 *pMsg);
+uint8 UpdateRouTab2(uint8 *pMsg, int16 rssi);  //用信标及其RSSI更新路由表
+int16 GetNoiseAvg(void);      //返回本节点环境噪声滑动平均(dBm)
 uint16 GetParentAddr(void);//查找父结点地址
 void RouteTimerTasks(void);   //路由定时任务(广播路由分组，更新生命周期)
+void SetPendingAirRate(uint8 rate, uint16 remain);  //收到速率切换命令，remain(10ms)后切换
+uint16 GetAirRateRemain(void);   //待切换速率的剩余时间(10ms)，已扣除转发一跳的空中时间
+void RouteRateTask(void);        //到达切换时刻时切换空中速率，每2ms调用一次
+uint8 IsWorNeighbor(uint16 add);     //查询邻居是否处于WOR监听，1--是
+uint8 HasWorNeighbor(void);          //查询是否有处于WOR监听的邻居，1--有
+uint8 GetNeighborChannel(uint16 add);  //返回给邻居发送时使用的信道
+uint8 GetBcastChannels(uint8 *pCh);  //取得广播须覆盖的信道，返回信道个数，pCh至少ROUTE_CH_NUM字节
+uint8 GetChildList(uint16 *pAdd, uint8 *pSize, uint8 *pNeed, uint8 max);  //取得子结点的地址及其子树规模，返回个数
+void  RouteSetReserve(uint16 load);  //设置本节点波形流预留的负载(字节/秒)，0--取消
+uint16 RouteGetReserve(void);        //返回本节点波形流预留的负载(字节/秒)
+uint16 RouteGetLoad(void);           //返回本节点子树预留的负载(字节/秒)，即本节点须转发的
+uint16 RouteGetHeadroom(void);       //返回本节点到汇聚节点的路径上还能预留的负载(字节/秒)
 
 #endif
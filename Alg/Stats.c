@@ -0,0 +1,214 @@
+/*********************************************************************************************************
+* 模块名称：Stats.c
+* 摘    要：窗口统计，用Welford方法逐个读数更新最小值、最大值、均值和方差
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：n = n + 1；d = x - mean；mean = mean + d / n；m2 = m2 + d * (x - mean)；方差 = m2 / n
+* 注    意：StatsAdd每个读数只有一次除法和一次32×32→64位乘法，可以在2ms任务中处理快速采样的全部读数；
+*           标准差在窗口结束时开方一次
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "Stats.h"
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#define STATS_MAX_NUM  0xFFFF  //一个窗口最多的读数个数
+
+/*********************************************************************************************************
+*                                              枚举结构体定义
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              内部变量
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              内部函数声明
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              内部函数实现
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              API函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：StatsReset
+* 函数功能：清空统计，开始新的窗口
+* 输入参数：pStats-窗口统计
+* 输出参数：pStats-窗口统计
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+void  StatsReset(StructStats* pStats)
+{
+  pStats->num  = 0;
+  pStats->min  = 0;
+  pStats->max  = 0;
+  pStats->mean = 0;
+  pStats->m2   = 0;
+}
+
+/*********************************************************************************************************
+* 函数名称：StatsAdd
+* 函数功能：加入一个读数
+* 输入参数：pStats-窗口统计，x-读数
+* 输出参数：pStats-窗口统计
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：d / n四舍五入，误差不超过半个最低位，不会累积成偏差
+*********************************************************************************************************/
+void  StatsAdd(StructStats* pStats, int16 x)
+{
+  int32 xq = (int32)x << STATS_FRAC;  //读数，与均值小数位数相同
+  int32 delta;                        //读数与旧均值之差
+
+  if(pStats->num == 0)
+  {
+    pStats->num  = 1;
+    pStats->min  = x;
+    pStats->max  = x;
+    pStats->mean = xq;
+    pStats->m2   = 0;
+    return;
+  }
+
+  if(pStats->num >= STATS_MAX_NUM)
+  {
+    return;
+  }
+
+  pStats->num++;
+  delta = xq - pStats->mean;
+  if(delta >= 0)
+  {
+    pStats->mean += (delta + pStats->num / 2) / pStats->num;
+  }
+  else
+  {
+    pStats->mean -= (-delta + pStats->num / 2) / pStats->num;
+  }
+  pStats->m2 += (long long)delta * (xq - pStats->mean);
+
+  if(x < pStats->min)
+  {
+    pStats->min = x;
+  }
+  if(x > pStats->max)
+  {
+    pStats->max = x;
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：StatsMean
+* 函数功能：返回均值
+* 输入参数：pStats-窗口统计
+* 输出参数：void
+* 返 回 值：均值，四舍五入
+* 创建日期：2026年10月19日
+* 注    意：负数右移按算术移位处理，ARMCC如此实现
+*********************************************************************************************************/
+int16 StatsMean(const StructStats* pStats)
+{
+  return (int16)((pStats->mean + (1 << (STATS_FRAC - 1))) >> STATS_FRAC);
+}
+
+/*********************************************************************************************************
+* 函数名称：StatsVar
+* 函数功能：返回总体方差
+* 输入参数：pStats-窗口统计
+* 输出参数：void
+* 返 回 值：方差，四舍五入，超过uint32时取0xFFFFFFFF
+* 创建日期：2026年10月19日
+* 注    意：m2有2 * STATS_FRAC位小数
+*********************************************************************************************************/
+uint32 StatsVar(const StructStats* pStats)
+{
+  unsigned long long var;  //方差，有2 * STATS_FRAC位小数
+
+  if(pStats->num == 0 || pStats->m2 <= 0)
+  {
+    return 0;
+  }
+
+  var = ((unsigned long long)pStats->m2 / pStats->num + (1ULL << (2 * STATS_FRAC - 1))) >> (2 * STATS_FRAC);
+  if(var > 0xFFFFFFFFULL)
+  {
+    return 0xFFFFFFFF;
+  }
+
+  return (uint32)var;
+}
+
+/*********************************************************************************************************
+* 函数名称：StatsStd
+* 函数功能：返回总体标准差
+* 输入参数：pStats-窗口统计
+* 输出参数：void
+* 返 回 值：标准差，四舍五入
+* 创建日期：2026年10月19日
+* 注    意：先对有2 * STATS_FRAC位小数的方差开方，得到有STATS_FRAC位小数的标准差，再舍去小数
+*********************************************************************************************************/
+uint16 StatsStd(const StructStats* pStats)
+{
+  uint32 std;  //标准差，有STATS_FRAC位小数
+
+  if(pStats->num == 0 || pStats->m2 <= 0)
+  {
+    return 0;
+  }
+
+  std = Sqrt64((unsigned long long)pStats->m2 / pStats->num);
+
+  return (uint16)((std + (1 << (STATS_FRAC - 1))) >> STATS_FRAC);
+}
+
+/*********************************************************************************************************
+* 函数名称：Sqrt64
+* 函数功能：64位整数开方
+* 输入参数：x-被开方数
+* 输出参数：void
+* 返 回 值：x的平方根，向下取整
+* 创建日期：2026年10月19日
+* 注    意：逐位试商，32次循环；Vibration也用它求有效值
+*********************************************************************************************************/
+uint32 Sqrt64(unsigned long long x)
+{
+  unsigned long long root = 0;
+  unsigned long long bit  = 1ULL << 62;  //不超过x的最大的4的幂
+
+  while(bit > x)
+  {
+    bit >>= 2;
+  }
+
+  while(bit != 0)
+  {
+    if(x >= root + bit)
+    {
+      x   -= root + bit;
+      root = (root >> 1) + bit;
+    }
+    else
+    {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+
+  return (uint32)root;
+}
@@ -1,11 +1,12 @@
 /*********************************************************************************************************
-* 模块名称：Queue.h
-* 摘    要：Queue模块
+* 模块名称：Stats.h
+* 摘    要：窗口统计，用Welford方法逐个读数更新最小值、最大值、均值和方差
 * 当前版本：1.0.0
-* 作    者：SZLY(COPYRIGHT 2018 - 2020 SZLY. All rights reserved.)
-* 完成日期：2020年01月01日 
-* 内    容：
-* 注    意：                                                                  
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：均值保留STATS_FRAC位小数，偏差平方和用64位整数累加；
+*           Welford方法每次只用新读数与当前均值之差更新，不会像先求平方和再减均值平方那样丢失有效位
+* 注    意：一个窗口最多65535个读数，满了之后不再累加
 **********************************************************************************************************
 * 取代版本：
 * 作    者：
@@ -13,8 +14,8 @@
 * 修改内容：
 * 修改文件：
 *********************************************************************************************************/
-#ifndef _QUEUE_H_
-#define _QUEUE_H_
+#ifndef _STATS_H_
+#define _STATS_H_
 
 /*********************************************************************************************************
 *                                              包含头文件
@@ -24,31 +25,29 @@
 /*********************************************************************************************************
 *                                              宏定义
 *********************************************************************************************************/
+#define STATS_FRAC  8  //均值的小数位数
 
 /*********************************************************************************************************
 *                                              枚举结构体定义
 *********************************************************************************************************/
-//定义数据类型，即队列中元素的数据类型
-typedef uint8  DATA_TYPE;
-
-//定义循环队列结构体
+//窗口统计
 typedef struct
 {
-  int16       front;    //头指针，队非空时指向队头元素
-  int16       rear;     //尾指针，队非空时指向队尾元素的下一个位置
-  int16       bufLen;   //队列的总容量
-  int16       elemNum;  //当前队列中的元素的数量
-  DATA_TYPE *pBuffer; //循环队列的缓冲区
-}StructCirQue;
+  uint16    num;   //读数个数
+  int16     min;   //最小值
+  int16     max;   //最大值
+  int32     mean;  //均值，有STATS_FRAC位小数
+  long long m2;    //偏差平方和，有2 * STATS_FRAC位小数
+}StructStats;
 
 /*********************************************************************************************************
 *                                              API函数声明
 *********************************************************************************************************/
-void  InitQueue(StructCirQue* pQue, DATA_TYPE* pBuf, int16 len);  //初始化队列
-void  ClearQueue(StructCirQue* pQue);                           //清队列
-uint8    QueueEmpty(StructCirQue* pQue);                           //判断队列是否为空，1为空，0为非空
-int16   QueueLength(StructCirQue* pQue);                          //返回队列中元素个数，即为队列的长度
-int16   EnQueue(StructCirQue* pQue, DATA_TYPE* pInput, int16 len);  //入队len个元素
-int16   DeQueue(StructCirQue* pQue, DATA_TYPE* pOutput, int16 len); //出队len个元素
+void   StatsReset(StructStats* pStats);           //清空，开始新的窗口
+void   StatsAdd(StructStats* pStats, int16 x);    //加入一个读数
+int16  StatsMean(const StructStats* pStats);      //返回均值，四舍五入
+uint32 StatsVar(const StructStats* pStats);       //返回总体方差，四舍五入，单位为读数单位的平方
+uint16 StatsStd(const StructStats* pStats);       //返回总体标准差，四舍五入，与读数同单位
+uint32 Sqrt64(unsigned long long x);              //64位整数开方，向下取整
 
 #endif
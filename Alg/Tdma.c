@@ -0,0 +1,634 @@
+/*********************************************************************************************************
+* 模块名称：Tdma.c
+* 摘    要：TDMA时隙调度，超帧由汇聚节点的同步包逐跳下传，父结点给子结点分配无冲突的发送时隙
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：同步包|addh |addl |seq |slot |endOff(2) |slotMs(2) |n |{addh |addl |first |count}*n |，
+*           endOff为该包发送完成时距超帧开始的时间(ms)，接收方据此对齐超帧；
+*           子结点只跟随父结点的同步包，从中取得分配给自己的时隙块
+* 注    意：Main.h中MAC_TDMA为TRUE时编译本文件
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "Tdma.h"
+#include "SendDataToHost.h"
+
+#if (defined MAC_TDMA) && (MAC_TDMA == TRUE)
+
+#include "PackUnpack.h"
+#include "Route.h"
+#include "RADIO.h"
+#include "Timer.h"
+#include "string.h"
+#include <stdlib.h>
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#define TDMA_SINK_SYNC    ROUTE_CH_NUM    //汇聚节点的同步时隙数，各子树信道上各发一次
+#define TDMA_SLOT_NONE    0xFF            //无效时隙
+#define TDMA_SYNC_HEAD    9               //同步包中分配表之前的字节数
+
+/*********************************************************************************************************
+*                                              枚举结构体定义
+*********************************************************************************************************/
+//分配给子结点的时隙块
+typedef struct
+{
+  uint16 add;       //子结点地址
+  uint8  first;     //第一个时隙
+  uint8  count;     //时隙个数，0表示没有分到，在竞争期发送
+}StructSlotAlloc;
+
+/*********************************************************************************************************
+*                                              内部变量
+*********************************************************************************************************/
+//各空中速率档位下的时隙长度(ms)，可容纳一个数据包的空中时间和串口时间
+static const uint16 s_arrSlotMs[RADIO_AIR_RATE_NUM] = {2200, 600, 330, 180, 100, 60, 40, 30};
+
+static uint8  s_iSynced;          //1--已同步
+static uint8  s_iGotSync;         //本超帧收到了父结点的同步包
+static uint8  s_iLostCnt;         //连续收不到同步包的超帧数
+static uint32 s_iFrameStart;      //当前超帧开始的时刻(ms)
+static uint16 s_iSlotMs;          //时隙长度(ms)，由汇聚节点决定
+static uint8  s_iFrameSeq;        //超帧序号
+static uint8  s_iLastSlot;        //本超帧已处理的时隙
+static uint8  s_iCapDone;         //本超帧竞争期已发送
+static uint16 s_iCapOffset;       //本超帧在竞争期内的发送时刻(ms)
+static uint8  s_iSampleDue;       //本超帧的采样时刻已到
+static uint8  s_iSampleMark;      //本超帧已标记过采样时刻
+static uint8  s_iSampleFrames;    //距上次采样的超帧数
+
+static uint8  s_iMyFirst;         //父结点分配给本节点的时隙块
+static uint8  s_iMyCount;
+static uint8  s_iSyncSlot;        //本节点发送同步包的时隙
+static uint8  s_iUpFirst;         //本节点的上行时隙
+static uint8  s_iUpNum;
+static StructSlotAlloc s_arrAlloc[TDMA_CHILD_MAX];  //分配给子结点的时隙块
+static uint8  s_iAllocNum;
+
+#if (defined SINK) && (SINK == TRUE)//汇聚节点没有上行
+#else
+static uint8  s_arrUplink[TDMA_UPLINK_NUM][DATALEN]; //上行队列
+static uint8  s_arrUplinkLen[TDMA_UPLINK_NUM];
+static uint8  s_arrUplinkType[TDMA_UPLINK_NUM]; //分组种类，EnumPackType
+static uint8  s_iUplinkHead;      //队头
+static uint8  s_iUplinkNum;       //队列中的数据包个数
+#endif
+
+/*********************************************************************************************************
+*                                              内部函数声明
+*********************************************************************************************************/
+static uint32 FrameLen(void);                 //超帧长度(ms)
+static void   NewFrame(void);                 //进入下一个超帧
+static void   ComputeLayout(void);            //计算本节点及子结点的时隙
+static void   OnSlot(uint8 slot);             //时隙开始时发送
+static void   SendSync(uint8 slot, uint8 channel);  //发送同步包
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+#else
+static void   SendUplink(void);               //从上行队列取一包发给父结点
+#endif
+static uint8  StreamPackets(void);            //本节点波形流每个超帧的数据包个数
+
+/*********************************************************************************************************
+*                                              内部函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：FrameLen
+* 函数功能：超帧长度
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：超帧长度(ms)
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static uint32 FrameLen(void)
+{
+  return (uint32)TDMA_SLOT_NUM * s_iSlotMs + TDMA_CAP_MS;
+}
+
+/*********************************************************************************************************
+* 函数名称：NewFrame
+* 函数功能：进入下一个超帧
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：汇聚节点在超帧开始时按当前空中速率确定时隙长度；普通节点连续TDMA_SYNC_LOST个超帧
+*           收不到父结点的同步包则失步，回到随机接入
+*********************************************************************************************************/
+static void NewFrame(void)
+{
+  while(millis() - s_iFrameStart >= FrameLen())
+  {
+    s_iFrameStart += FrameLen();
+  }
+  s_iFrameSeq++;
+  s_iLastSlot   = TDMA_SLOT_NONE;
+  s_iCapDone    = 0;
+  s_iCapOffset  = rand() % (TDMA_CAP_MS / 2);
+  s_iSampleMark = 0;
+
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+  s_iSlotMs = s_arrSlotMs[RadioGetAirRate()];
+#else
+  if(!s_iGotSync && ++s_iLostCnt >= TDMA_SYNC_LOST)
+  {
+    s_iSynced = 0;
+    debug("TDMA失步\r\n");
+    return;
+  }
+  s_iGotSync = 0;
+#endif
+
+  ComputeLayout();
+}
+
+/*********************************************************************************************************
+* 函数名称：ComputeLayout
+* 函数功能：计算本节点及子结点的时隙
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：本节点的时隙块内依次为子结点时隙块、同步时隙、上行时隙；时隙块不够时先保证本节点的
+*           上行时隙，子结点按顺序分配，分不到的在竞争期发送
+*********************************************************************************************************/
+static void ComputeLayout(void)
+{
+  uint16 arrAdd[TDMA_CHILD_MAX];
+  uint8  arrSize[TDMA_CHILD_MAX];
+  uint8  arrNeed[TDMA_CHILD_MAX];
+  uint8  num;
+  uint8  first;
+  uint8  childEnd;
+  uint8  pos;
+  uint8  cnt;
+  uint8  i;
+
+  num = GetChildList(arrAdd, arrSize, arrNeed, TDMA_CHILD_MAX);
+
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+  first       = TDMA_SINK_SYNC;
+  childEnd    = TDMA_SLOT_NUM;
+  s_iSyncSlot = TDMA_SLOT_NONE;   //汇聚节点在时隙0 ~ TDMA_SINK_SYNC-1发送同步包
+  s_iUpNum    = 0;
+#else
+  {
+    uint8 size;
+    uint8 need;
+    uint8 end = s_iMyFirst + s_iMyCount;
+
+    TdmaGetDemand(&size, &need);
+    first      = s_iMyFirst;
+    s_iUpNum   = (size < s_iMyCount) ? size : s_iMyCount;
+    s_iUpFirst = end - s_iUpNum;
+    childEnd   = s_iUpFirst;
+    s_iSyncSlot = TDMA_SLOT_NONE;
+    if(num > 0 && childEnd > first)
+    {
+      s_iSyncSlot = --childEnd;
+    }
+  }
+#endif
+
+  pos = first;
+  for(i = 0; i < num; i++)
+  {
+    cnt = (pos < childEnd) ? childEnd - pos : 0;
+    if(arrNeed[i] < cnt)
+    {
+      cnt = arrNeed[i];
+    }
+    s_arrAlloc[i].add   = arrAdd[i];
+    s_arrAlloc[i].first = pos;
+    s_arrAlloc[i].count = cnt;
+    pos += cnt;
+  }
+  s_iAllocNum = num;
+}
+
+/*********************************************************************************************************
+* 函数名称：OnSlot
+* 函数功能：时隙开始时发送
+* 输入参数：slot-时隙号
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static void OnSlot(uint8 slot)
+{
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+  uint8 arrCh[ROUTE_CH_NUM];
+
+  if(slot < TDMA_SINK_SYNC && slot < GetBcastChannels(arrCh))
+  {
+    SendSync(slot, arrCh[slot]);
+  }
+#else
+  if(slot == s_iSyncSlot)
+  {
+    SendSync(slot, RadioGetChannel());  //子结点沿用本节点的接收信道
+  }
+  else if(s_iUpNum > 0 && slot >= s_iUpFirst && slot < s_iUpFirst + s_iUpNum)
+  {
+    SendUplink();
+  }
+#endif
+}
+
+/*********************************************************************************************************
+* 函数名称：SendSync
+* 函数功能：发送同步包
+* 输入参数：slot-本时隙号，channel-发送信道
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：发送完成时刻按最近测得的每帧发送时延估计
+*********************************************************************************************************/
+static void SendSync(uint8 slot, uint8 channel)
+{
+  uint8  arrSync[DATALEN];
+  uint16 add = getAddress();
+  uint16 endOff;
+  uint8  len = TDMA_SYNC_HEAD;
+  uint8  i;
+
+  endOff = (uint16)(millis() - s_iFrameStart) + (uint16)(RadioGetTxLatency() / 1000);
+
+  arrSync[0] = add >> 8;
+  arrSync[1] = add;
+  arrSync[2] = s_iFrameSeq;
+  arrSync[3] = slot;
+  arrSync[4] = endOff >> 8;
+  arrSync[5] = endOff;
+  arrSync[6] = s_iSlotMs >> 8;
+  arrSync[7] = s_iSlotMs;
+  arrSync[8] = s_iAllocNum;
+  for(i = 0; i < s_iAllocNum; i++)
+  {
+    arrSync[len++] = s_arrAlloc[i].add >> 8;
+    arrSync[len++] = s_arrAlloc[i].add;
+    arrSync[len++] = s_arrAlloc[i].first;
+    arrSync[len++] = s_arrAlloc[i].count;
+  }
+
+  SendSyncPack(arrSync, len, channel);
+}
+
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+#else
+/*********************************************************************************************************
+* 函数名称：SendUplink
+* 函数功能：从上行队列取一包发给父结点
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static void SendUplink(void)
+{
+  if(s_iUplinkNum == 0)
+  {
+    return;
+  }
+  if(s_arrUplinkType[s_iUplinkHead] == TYPE_WAVE)
+  {
+    SendWaveToParentNow(s_arrUplink[s_iUplinkHead], s_arrUplinkLen[s_iUplinkHead]);
+  }
+  else if(s_arrUplinkType[s_iUplinkHead] == TYPE_VIB)
+  {
+    SendVibToParentNow(s_arrUplink[s_iUplinkHead], s_arrUplinkLen[s_iUplinkHead]);
+  }
+  else
+  {
+    SendDateToParentNow(s_arrUplink[s_iUplinkHead], s_arrUplinkLen[s_iUplinkHead]);
+  }
+  s_iUplinkHead = (s_iUplinkHead + 1) % TDMA_UPLINK_NUM;
+  s_iUplinkNum--;
+}
+#endif
+
+/*********************************************************************************************************
+* 函数名称：StreamPackets
+* 函数功能：本节点波形流每个超帧的数据包个数
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：数据包个数，向上取整
+* 创建日期：2026年10月19日
+* 注    意：由Route中本节点预留的负载折算，随信标上报，父结点按此多分配上行时隙
+*********************************************************************************************************/
+static uint8 StreamPackets(void)
+{
+  uint32 bytes = (uint32)RouteGetReserve() * FrameLen() / 1000;
+  uint32 num   = (bytes + ROUTE_PKT_AIR_BYTES - 1) / ROUTE_PKT_AIR_BYTES;
+
+  return (num > 0xFF) ? 0xFF : (uint8)num;
+}
+
+/*********************************************************************************************************
+*                                              API函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：InitTdma
+* 函数功能：初始化Tdma模块
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：汇聚节点以当前时刻为第一个超帧的开始，普通节点等待父结点的同步包
+*********************************************************************************************************/
+void InitTdma(void)
+{
+  s_iGotSync     = 0;
+  s_iLostCnt     = 0;
+  s_iFrameSeq    = 0;
+  s_iLastSlot    = TDMA_SLOT_NONE;
+  s_iCapDone     = 0;
+  s_iSampleDue   = 0;
+  s_iSampleMark  = 0;
+  s_iSampleFrames = 0;
+  s_iMyFirst     = 0;
+  s_iMyCount     = 0;
+  s_iSyncSlot    = TDMA_SLOT_NONE;
+  s_iUpNum       = 0;
+  s_iAllocNum    = 0;
+  s_iSlotMs      = s_arrSlotMs[RadioGetAirRate()];
+  s_iFrameStart  = millis();
+
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+  s_iSynced = 1;
+  ComputeLayout();
+#else
+  s_iUplinkHead = 0;
+  s_iUplinkNum  = 0;
+  s_iSynced     = 0;
+#endif
+}
+
+/*********************************************************************************************************
+* 函数名称：TdmaProc
+* 函数功能：时隙调度
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：在2ms任务中调用，每个时隙开始TDMA_GUARD_MS后发送；没有分到时隙时在竞争期随机时刻发送上行数据
+*********************************************************************************************************/
+void TdmaProc(void)
+{
+  uint32 elapsed;
+  uint32 capStart;
+  uint32 smpTime;
+  uint8  slot;
+
+  if(!s_iSynced)
+  {
+    return;
+  }
+
+  if(millis() - s_iFrameStart >= FrameLen())
+  {
+    NewFrame();
+    if(!s_iSynced)
+    {
+      return;
+    }
+  }
+  elapsed  = millis() - s_iFrameStart;
+  capStart = (uint32)TDMA_SLOT_NUM * s_iSlotMs;
+
+  //采样时刻：本节点第一个上行时隙之前，没有时隙时在竞争期之前
+  smpTime = (s_iUpNum > 0) ? (uint32)s_iUpFirst * s_iSlotMs : capStart;
+  smpTime = (smpTime > TDMA_SAMPLE_LEAD_MS) ? smpTime - TDMA_SAMPLE_LEAD_MS : 0;
+  if(!s_iSampleMark && elapsed >= smpTime)
+  {
+    s_iSampleMark = 1;
+    s_iSampleDue  = 1;
+  }
+
+  if(elapsed < capStart)
+  {
+    slot = elapsed / s_iSlotMs;
+    if(slot != s_iLastSlot && elapsed - (uint32)slot * s_iSlotMs >= TDMA_GUARD_MS)
+    {
+      s_iLastSlot = slot;
+      OnSlot(slot);
+    }
+  }
+  else if(!s_iCapDone && elapsed >= capStart + s_iCapOffset)
+  {
+    s_iCapDone = 1;
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+#else
+    if(s_iUpNum == 0)
+    {
+      SendUplink();
+    }
+#endif
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：TdmaOnSync
+* 函数功能：处理收到的同步包
+* 输入参数：pMsg-同步包数据，rxMs-包头到达的时刻(ms)
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：只跟随父结点的同步包；超帧开始时刻 = 到达时刻 - 串口时延 - 发送方的endOff
+*********************************************************************************************************/
+void TdmaOnSync(uint8 *pMsg, uint32 rxMs)
+{
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+  //汇聚节点是时间基准
+#else
+  uint16 slotMs = MAKEHWORD(pMsg[6], pMsg[7]);
+  uint16 add    = getAddress();
+  uint8  num    = pMsg[8];
+  uint8  i;
+
+  if(MAKEHWORD(pMsg[0], pMsg[1]) != GetParentAddr() || slotMs == 0 || num > TDMA_CHILD_MAX)
+  {
+    return;
+  }
+
+  s_iFrameStart = rxMs - TDMA_RX_DELAY_MS - MAKEHWORD(pMsg[4], pMsg[5]);
+  s_iSlotMs     = slotMs;
+  s_iFrameSeq   = pMsg[2];
+  if(!s_iSynced)
+  {
+    s_iLastSlot   = pMsg[3];  //之前的时隙已经过去
+    s_iCapDone    = 0;
+    s_iSampleMark = 0;
+    debug("TDMA已同步\r\n");
+  }
+
+  s_iMyFirst = 0;
+  s_iMyCount = 0;
+  for(i = 0; i < num; i++)
+  {
+    if(MAKEHWORD(pMsg[TDMA_SYNC_HEAD + i * 4], pMsg[TDMA_SYNC_HEAD + i * 4 + 1]) == add)
+    {
+      s_iMyFirst = pMsg[TDMA_SYNC_HEAD + i * 4 + 2];
+      s_iMyCount = pMsg[TDMA_SYNC_HEAD + i * 4 + 3];
+      break;
+    }
+  }
+
+  s_iSynced  = 1;
+  s_iGotSync = 1;
+  s_iLostCnt = 0;
+  ComputeLayout();
+#endif
+}
+
+/*********************************************************************************************************
+* 函数名称：TdmaIsSynced
+* 函数功能：查询是否已与父结点同步
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：1--已同步，0--未同步
+* 创建日期：2026年10月19日
+* 注    意：汇聚节点始终为1
+*********************************************************************************************************/
+uint8 TdmaIsSynced(void)
+{
+  return s_iSynced;
+}
+
+/*********************************************************************************************************
+* 函数名称：TdmaInCap
+* 函数功能：查询当前是否处于竞争期
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：1--处于竞争期或未同步，可以随机接入，0--处于时隙期
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+uint8 TdmaInCap(void)
+{
+  uint32 elapsed = millis() - s_iFrameStart;
+
+  return !s_iSynced || elapsed >= (uint32)TDMA_SLOT_NUM * s_iSlotMs;
+}
+
+/*********************************************************************************************************
+* 函数名称：TdmaSampleDue
+* 函数功能：查询是否该采样
+* 输入参数：periodMs-采样周期(ms)
+* 输出参数：void
+* 返 回 值：1--该采样了，0--没到
+* 创建日期：2026年10月19日
+* 注    意：采样周期按超帧长度向上取整，采样时刻在本节点上行时隙之前，数据在本超帧内发出
+*********************************************************************************************************/
+uint8 TdmaSampleDue(uint16 periodMs)
+{
+  if(!s_iSampleDue)
+  {
+    return 0;
+  }
+  s_iSampleDue = 0;
+
+  if((uint32)(s_iSampleFrames + 1) * FrameLen() < periodMs)
+  {
+    s_iSampleFrames++;
+    return 0;
+  }
+  s_iSampleFrames = 0;
+  return 1;
+}
+
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+#else
+/*********************************************************************************************************
+* 函数名称：TdmaPutUplink
+* 函数功能：分组放入上行队列
+* 输入参数：packType-分组种类，TYPE_DATA、TYPE_WAVE或TYPE_VIB，pData-数据，len-长度，最多DATALEN
+* 输出参数：void
+* 返 回 值：1--成功，0--队列满
+* 创建日期：2026年10月19日
+* 注    意：本节点和转发的数据都经此队列，在本节点的上行时隙中每时隙发送一包；汇聚节点没有此函数
+*********************************************************************************************************/
+uint8 TdmaPutUplink(uint8 packType, uint8 *pData, uint8 len)
+{
+  uint8 tail;
+
+  if(s_iUplinkNum >= TDMA_UPLINK_NUM)
+  {
+    return 0;
+  }
+  if(len > DATALEN)
+  {
+    len = DATALEN;
+  }
+
+  tail = (s_iUplinkHead + s_iUplinkNum) % TDMA_UPLINK_NUM;
+  memcpy(s_arrUplink[tail], pData, len);
+  s_arrUplinkLen[tail] = len;
+  s_arrUplinkType[tail] = packType;
+  s_iUplinkNum++;
+  return 1;
+}
+#endif
+
+/*********************************************************************************************************
+* 函数名称：TdmaGetDemand
+* 函数功能：计算本节点子树的节点数和所需时隙数
+* 输入参数：pSize-节点数存放地址，pNeed-时隙数存放地址
+* 输出参数：pSize,pNeed
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：节点数 = 1 + 本节点波形流每个超帧的包数 + 各子结点子树的节点数，即本节点每个超帧要发送的上行包数；
+*           时隙数 = 节点数 + 同步时隙(有子结点时) + 各子结点子树的时隙数，超过255按255计
+*********************************************************************************************************/
+void TdmaGetDemand(uint8 *pSize, uint8 *pNeed)
+{
+  uint16 arrAdd[TDMA_CHILD_MAX];
+  uint8  arrSize[TDMA_CHILD_MAX];
+  uint8  arrNeed[TDMA_CHILD_MAX];
+  uint16 size = 1 + StreamPackets();
+  uint16 need;
+  uint8  num;
+  uint8  i;
+
+  num = GetChildList(arrAdd, arrSize, arrNeed, TDMA_CHILD_MAX);
+  need = (num > 0) ? 1 : 0;
+  for(i = 0; i < num; i++)
+  {
+    size += (arrSize[i] > 0) ? arrSize[i] : 1;   //子结点尚未上报时至少算它自己
+    need += arrNeed[i];
+  }
+  need += size;
+
+  *pSize = (size > 0xFF) ? 0xFF : (uint8)size;
+  *pNeed = (need > 0xFF) ? 0xFF : (uint8)need;
+}
+
+/*********************************************************************************************************
+* 函数名称：TdmaCapacity
+* 函数功能：超帧的时隙能承载的负载
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：负载(字节/秒)
+* 创建日期：2026年10月19日
+* 注    意：全网共用一个超帧，每个时隙发一包，扣除汇聚节点的同步时隙；各节点自己的上行和同步时隙没有扣除，
+*           只作为汇聚节点余量的上限
+*********************************************************************************************************/
+uint16 TdmaCapacity(void)
+{
+  return (uint16)((uint32)(TDMA_SLOT_NUM - TDMA_SINK_SYNC) * ROUTE_PKT_AIR_BYTES * 1000 / FrameLen());
+}
+
+#endif
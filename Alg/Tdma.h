@@ -0,0 +1,57 @@
+/*********************************************************************************************************
+* 模块名称：Tdma.h
+* 摘    要：TDMA时隙调度，超帧由汇聚节点的同步包逐跳下传，父结点给子结点分配无冲突的发送时隙
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：超帧 = TDMA_SLOT_NUM个时隙 + 竞争期：
+*           时隙0 ~ ROUTE_CH_NUM-1为汇聚节点的同步时隙，其余时隙按子树逐级分配；
+*           每个节点的时隙块内依次为各子结点的时隙块、本节点的同步时隙、本节点的上行时隙，
+*           子结点先于父结点发送，数据在一个超帧内逐跳到达汇聚节点；
+*           竞争期用于入网、路由信标和命令，没有分到时隙的节点也在竞争期发送数据
+* 注    意：Main.h中MAC_TDMA为TRUE时编译本文件
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+#ifndef _TDMA_H_
+#define _TDMA_H_
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "DataType.h"
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#define TDMA_SLOT_NUM       32        //每个超帧的时隙数
+#define TDMA_CAP_MS         3000      //超帧末尾竞争期的长度(ms)
+#define TDMA_GUARD_MS       10        //时隙开始后延迟发送的保护时间(ms)
+#define TDMA_RX_DELAY_MS    5         //模块空中接收完成到串口输出的时延(ms)
+#define TDMA_SYNC_LOST      3         //连续多少个超帧收不到父结点的同步包认为失步
+#define TDMA_SAMPLE_LEAD_MS 20        //在本节点第一个上行时隙之前多少ms采样
+#define TDMA_UPLINK_NUM     8         //上行队列能缓存的数据包个数
+#define TDMA_CHILD_MAX      13        //同步包中最多分配时隙的子结点个数
+
+/*********************************************************************************************************
+*                                              枚举结构体定义
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              API函数声明
+*********************************************************************************************************/
+void  InitTdma(void);                           //初始化Tdma模块
+void  TdmaProc(void);                           //时隙调度，在2ms任务中调用
+void  TdmaOnSync(uint8 *pMsg, uint32 rxMs);     //处理收到的同步包，rxMs为包头到达的时刻
+uint8 TdmaIsSynced(void);                       //1--已与父结点同步
+uint8 TdmaInCap(void);                          //1--当前处于竞争期或未同步
+uint8 TdmaSampleDue(uint16 periodMs);           //1--该采样了，按periodMs折算为超帧数
+uint8 TdmaPutUplink(uint8 packType, uint8 *pData, uint8 len);  //分组放入上行队列，在本节点时隙中发给父结点，0--队列满，只用于普通节点
+void  TdmaGetDemand(uint8 *pSize, uint8 *pNeed);//本节点子树的节点数和所需时隙数，随路由信标上报
+uint16 TdmaCapacity(void);                      //超帧的时隙能承载的负载(字节/秒)，接纳波形流时用
+
+#endif
@@ -30,6 +30,10 @@ typedef unsigned char       uint8;
 typedef unsigned short      uint16;
 typedef unsigned int        uint32;
 
+typedef uint8               u8;     //兼容sx126x驱动
+typedef uint16              u16;
+typedef uint32              u32;
+
 typedef int                 BOOL;
 typedef unsigned char       BYTE;
 typedef unsigned short      HWORD;  //两个字节组成一个半字
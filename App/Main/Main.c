@@ -7,10 +7,12 @@
 * 内    容：
 * 注    意：注意勾选Options for Target 'Target1'->Code Generation->Use MicroLIB，否则printf无法使用                                                                  
 **********************************************************************************************************
-* 取代版本：
-* 作    者：
-* 完成日期：
-* 修改内容：
+* 取代版本：1.1.0
+* 作    者：LYL
+* 完成日期：2026年10月19日
+* 修改内容：接收数据不再每2ms只处理1个字节，主循环每轮按预算读空接收缓冲区，空闲时WFI等中断唤醒；
+*           采样时取缓冲区中全部过采样读数的平均值，不再只取1个读数丢弃其余；
+*           传感器由Sensor模块按登记表采样、定点换算和打包；ADC越限报警唤醒主循环后立即发送
 * 修改文件：
 *********************************************************************************************************/
 
@@ -26,12 +28,20 @@
 /*********************************************************************************************************
 *                                              宏定义
 *********************************************************************************************************/
+#define RX_DRAIN_CHUNK   32   //每次从接收缓冲区读出的字节数，再大每字节分摊的读出开销已减少不多，见Test/RxBench.c
+#define RX_DRAIN_BUDGET  256  //主循环每轮最多处理的接收字节数，超出的留到下一轮，一轮约0.6ms，不耽误2ms任务
 
+#define SMP_PRD_FLOOR    1000   //采样周期的下限(ms)，最快1s采样1次
+#define SMP_MAX_DEF      24000  //默认最慢的采样周期(ms)
+#define SMP_QUIET_NUM    3      //连续多少次采样信号平稳后采样周期加倍
 
 /*********************************************************************************************************
 *                                              内部变量
 *********************************************************************************************************/
-static uint16 Smp_Period = 1500;//x ms
+static uint16 Smp_Period = 1500;//x ms，当前实际的采样周期
+static uint16 s_iSmpMin  = 1500;          //最快的采样周期(ms)
+static uint16 s_iSmpMax  = SMP_MAX_DEF;   //最慢的采样周期(ms)，不大于s_iSmpMin时不自适应
+static uint8  s_iQuietCnt = 0;            //信号连续平稳的采样次数
 
 /*********************************************************************************************************
 *                                              枚举结构体定义
@@ -42,8 +52,11 @@ static uint16 Smp_Period = 1500;//x ms
 *********************************************************************************************************/
 static  void  InitSoftware(void);   //初始化软件相关的模块
 static  void  InitHardware(void);   //初始化硬件相关的模块
+static  uint8 ProcRxTask(void);     //处理无线和云端串口接收的数据
+static  void  ProcAlarmTask(void);  //发送越限报警
 static  void  Proc2msTask(void);    //2ms处理任务
 static  void  Proc1SecTask(void);   //1s处理任务
+static  void  AdaptSmpPrd(uint8 active);  //按信号是否活跃调整采样周期
 
 /*********************************************************************************************************
 *                                              内部函数实现
@@ -63,6 +76,21 @@ static  void  InitSoftware(void)
   InitProcHostCmd();      //初始化ProcHostCmd模块
   InitSendDataToHost();   //初始化SendDataToHost模块
   InitRoute();            //初始化Route模块
+  InitSensor();           //初始化Sensor模块
+  InitWaveStream();       //初始化WaveStream模块
+  InitVibration();        //初始化Vibration模块
+#if (defined MAC_TDMA) && (MAC_TDMA == TRUE)
+  InitTdma();             //初始化Tdma模块
+#endif
+#if (defined FILTER_BENCH) && (FILTER_BENCH == TRUE)
+  FilterBench();          //测量各滤波器每个采样的周期数
+#endif
+#if (defined SENSOR_BENCH) && (SENSOR_BENCH == TRUE)
+  SensorBench();          //比较定点换算与浮点换算的周期数和误差
+#endif
+#if (defined FFT_BENCH) && (FFT_BENCH == TRUE)
+  FftBench();             //测量256、512、1024点FFT的周期数
+#endif
 }
 
 /*********************************************************************************************************
@@ -79,7 +107,7 @@ static  void  InitHardware(void)
   SystemInit();       //系统初始化
   InitRCC();          //初始化RCC模块
   InitNVIC();         //初始化NVIC模块
-  InitUART1(9600);    //初始化UART模块
+  InitUART1(9600);    //初始化UART模块，InitLORA中按E22工作参数切换波特率
 #if (defined SINK) && (SINK == TRUE)//汇聚节点
   InitUART2(115200);
 #endif
@@ -91,6 +119,115 @@ static  void  InitHardware(void)
   InitLORA();         //初始化LORA模块
 }
 
+/*********************************************************************************************************
+* 函数名称：ProcRxTask
+* 函数功能：处理无线和云端串口接收的数据
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：1--用完预算后缓冲区中还有数据，0--已读空
+* 创建日期：2026年10月19日
+* 注    意：每轮主循环调用；原来每2ms只处理1个字节，最多500字节/秒，低于9600波特率的960字节/秒，
+*           中继节点的接收缓冲区会越积越多直到溢出
+*********************************************************************************************************/
+static  uint8 ProcRxTask(void)
+{
+  uint8  arrRec[RX_DRAIN_CHUNK];  //读出的数据
+  uint8  len;                     //本次读出的字节数
+  uint16 total = 0;               //本轮已处理的字节数
+  uint8  more  = 0;               //1--缓冲区中还有数据
+  uint8  i;
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+  char*  pJson;                   //收齐的JSON消息
+  uint16 jsonLen;
+#endif
+
+  do
+  {
+    len = RadioReadData(arrRec, sizeof(arrRec));  //读无线接收数据
+    for(i = 0; i < len; i++)
+    {
+      ProcHostCmd(arrRec[i]);  //解包并处理
+    }
+    total += len;
+  }while(len == sizeof(arrRec) && total < RX_DRAIN_BUDGET);
+  more = (len == sizeof(arrRec));
+
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+  total = 0;
+  do
+  {
+    len = ReadUART2(arrRec, sizeof(arrRec));  //读云端串口数据
+    for(i = 0; i < len; i++)
+    {
+      if(UnPackJson(arrRec[i]))  //收齐一条JSON消息立即处理
+      {
+        pJson = GetUnPackJson(&jsonLen);
+        ProcCloudCmd(pJson, jsonLen);
+      }
+    }
+    total += len;
+  }while(len == sizeof(arrRec) && total < RX_DRAIN_BUDGET);
+  more |= (len == sizeof(arrRec));
+#endif
+
+  return more;
+}
+
+/*********************************************************************************************************
+* 函数名称：ProcAlarmTask
+* 函数功能：把ADC越限事件打包为报警分组发出
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：每轮主循环最先调用，越限中断把CPU从WFI唤醒后立即发送，不等采样周期
+*********************************************************************************************************/
+static  void  ProcAlarmTask(void)
+{
+  uint8 arrAlarm[DATALEN] = {0};  //报警分组：[0..1]节点地址，[2..]报警记录
+
+  arrAlarm[0] = getAddress()>>8;
+  arrAlarm[1] = getAddress();
+  while(SensorAlarm(&arrAlarm[2], DATALEN - 2) > 0)
+  {
+    ProcAlarmPack(arrAlarm);
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：AdaptSmpPrd
+* 函数功能：按信号是否活跃调整采样周期
+* 输入参数：active-1--本次采样信号活跃
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：活跃时立即回到最快的周期，连续SMP_QUIET_NUM次平稳后周期加倍，直到最慢的周期；
+*           实际周期随数据分组上报，云端按它恢复时间序列
+*********************************************************************************************************/
+static  void  AdaptSmpPrd(uint8 active)
+{
+#if (defined MAIN_ADAPT_SMP) && (MAIN_ADAPT_SMP == TRUE)
+  if(s_iSmpMax <= s_iSmpMin)
+  {
+    Smp_Period = s_iSmpMin;
+    return;
+  }
+
+  if(active)
+  {
+    s_iQuietCnt = 0;
+    Smp_Period  = s_iSmpMin;
+    return;
+  }
+
+  if(++s_iQuietCnt >= SMP_QUIET_NUM)
+  {
+    s_iQuietCnt = 0;
+    Smp_Period  = (Smp_Period >= s_iSmpMax / 2) ? s_iSmpMax : Smp_Period * 2;
+  }
+#endif
+}
+
 /*********************************************************************************************************
 * 函数名称：Proc2msTask
 * 函数功能：2ms处理任务 
@@ -98,54 +235,58 @@ static  void  InitHardware(void)
 * 输出参数：void
 * 返 回 值：void
 * 创建日期：2021年07月11日
-* 注    意：
+* 注    意：TDMA已同步时采样时刻对齐本节点的上行时隙
 *********************************************************************************************************/
 static  void  Proc2msTask(void)
 {  
-  uint8  uart1RecData; //串口数据
-  uint16 adcData;      //队列数据
-  float waveData;     //波形数据
+  uint8  len;          //传感器数据的打包长度
+  uint8 smpNow;       //1--该采样了
+  uint8 ready;        //1--有统计窗口结束
 
   static uint16 s_iCnt4 = 0;   //计数器
-  static uint8 s_iPointCnt = 0;        //温度数据包的点计数器
-  static uint8 s_arrData[70] = {0}; //初始化数组
+  static uint8 s_arrData[DATALEN] = {0}; //数据分组
   
   if(Get2msFlag())  //判断2ms标志状态
   {
-    if(ReadUART1(&uart1RecData, 1)) //读串口接收数据
-    {       
-      ProcHostCmd(uart1RecData);  //处理命令      
-    }
+    RadioProc();  //无线后台处理
+    RouteRateTask();  //到时切换空中速率
 
     srand(millis());
-    s_iCnt4++;      //计数增加
-    if(s_iCnt4 >= Smp_Period/2 + rand()%120+20)  //达到Smp_Period (ms)
+#if (defined MAC_TDMA) && (MAC_TDMA == TRUE)
+    TdmaProc();     //时隙调度
+    if(TdmaIsSynced())
+    {
+      smpNow = TdmaSampleDue(Smp_Period);
+    }
+    else
+#endif
     {
-      if(ReadADCBuf(&adcData))  //从缓存队列中取出1个数据到adcData
+      s_iCnt4++;    //计数增加
+      smpNow = (s_iCnt4 >= Smp_Period/2 + rand()%120+20);  //达到Smp_Period (ms)
+    }
+    ready = SensorProc(smpNow);  //按登记表采样各传感器
+    if(smpNow || ready)
+    {
+      //数据分组：[0]当前采样周期/100，[1..2]节点地址，[3..]SensorPack打包的传感器数值
+      s_arrData[0] = Smp_Period/100;
+      s_arrData[1] = getAddress()>>8;
+      s_arrData[2] = getAddress();
+      len = SensorPack(&s_arrData[3], DATALEN - 3);
+      if(len > 0)  //各传感器都没超过死区、也没到心跳间隔时不发送
       {
-        ClearADCBuf();
-        waveData = (float)adcData*(3.3 / 4096);
-        waveData = (1.43 - waveData)/0.0043 + 25.0;  //计算获取温度的值，12位ADC，2^12=4095，参考电压3.3V
-        s_arrData[s_iPointCnt] = (uint8)(int)waveData;  //存放到数组
-        s_arrData[s_iPointCnt+1] = Smp_Period/100;
-        s_arrData[s_iPointCnt+2] = getAddress()>>8;
-        s_arrData[s_iPointCnt+3] = getAddress();
-        
-        s_iPointCnt++;  //温度数据包的点计数器加1操作
-
-        if(s_iPointCnt >= 1)  //接收到x个点
-        {
-          #if (defined SINK) && (SINK == TRUE)//汇聚节点
-          #else
-          SendDateToParent(s_arrData, 2);
-          //SendDateToParent(s_arrData, 70);
-          //SendDateToParent(s_arrData, 70);
-          #endif
-          s_iPointCnt = 0;  //计数器清零
-        }
+        #if (defined SINK) && (SINK == TRUE)//汇聚节点
+        #else
+        SendDateToParent(s_arrData, 3 + len);
+        #endif
       }
+    }
+    if(smpNow)
+    {
+      AdaptSmpPrd(SensorActivity());  //下次的采样周期
       s_iCnt4 = 0;  //准备下次的循环
     }
+    WaveStreamProc();  //波形流压缩、发送，没有波形流时直接返回
+    VibProc();         //振动捕获、分析、发送特征，不到捕获周期时直接返回
     
     LEDFlicker(250);//调用闪烁函数     
     Clr2msFlag();   //清除2ms标志
@@ -180,8 +321,6 @@ static  void  Proc1SecTask(void)
     //printf发送到UART1，即到LOAR模块
     //debug("This is the first STM32F103 Project, by Zhangsan\r\n");
     #if (defined SINK) && (SINK == TRUE)//汇聚节点
-    ProcCloudCmd();    
-    
     //SendCmdPack(0x00, 0x01, 0xff, 0x0001, 0);
     
     #else
@@ -191,8 +330,13 @@ static  void  Proc1SecTask(void)
     
     if(s_iCnt >= 3 + rand()%3)//每n秒执行一次
     {
-      s_iCnt = 0;
-      RouteTimerTasks();
+#if (defined MAC_TDMA) && (MAC_TDMA == TRUE)
+      if(TdmaInCap())//TDMA模式下路由信标只在竞争期发送
+#endif
+      {
+        s_iCnt = 0;
+        RouteTimerTasks();
+      }
     }
     
     Clr1SecFlag();  //清除1s标志
@@ -201,17 +345,39 @@ static  void  Proc1SecTask(void)
 
 /*********************************************************************************************************
 * 函数名称：SetSmpPrd
-* 函数功能：设置采样周期
-* 输入参数：void
+* 函数功能：设置最快的采样周期
+* 输入参数：Period-采样周期，单位100ms
 * 输出参数：void
 * 返 回 值：uint8
 * 创建日期：2022年3月18日23:19:30
-* 注    意：
+* 注    意：不自适应时即为固定的采样周期；设置后从最快的周期开始采样
 *********************************************************************************************************/
 uint8  SetSmpPrd(uint8 Period)
 {
-  uint16 min = 1000;
-  Smp_Period = 100*Period>min? 100*Period:min;//最快1S采样1次
+  uint16 min = SMP_PRD_FLOOR;
+  s_iSmpMin   = 100*Period>min? 100*Period:min;//最快1S采样1次
+  Smp_Period  = s_iSmpMin;
+  s_iQuietCnt = 0;
+  return 1;
+}
+
+/*********************************************************************************************************
+* 函数名称：SetSmpMax
+* 函数功能：设置最慢的采样周期
+* 输入参数：Period-采样周期，单位100ms
+* 输出参数：void
+* 返 回 值：uint8
+* 创建日期：2026年10月19日
+* 注    意：不大于最快的周期时采样周期固定为最快的周期；最大25.5s，数据分组中以100ms为单位用1个字节上报
+*********************************************************************************************************/
+uint8  SetSmpMax(uint8 Period)
+{
+  s_iSmpMax = 100 * (uint16)Period;
+  if(Smp_Period > s_iSmpMax)
+  {
+    Smp_Period = s_iSmpMax > s_iSmpMin ? s_iSmpMax : s_iSmpMin;
+  }
+  return 1;
 }
 
 /*********************************************************************************************************
@@ -221,10 +387,13 @@ uint8  SetSmpPrd(uint8 Period)
 * 输出参数：void
 * 返 回 值：int
 * 创建日期：2021年07月11日
-* 注    意：
+* 注    意：睡眠前关中断再检查标志，检查之后到达的中断挂起后WFI立即返回，不会漏掉；
+*           串口接收由IDLE、DMA半满/全满中断唤醒，一帧数据收完即被处理
 *********************************************************************************************************/
 int main(void)
 { 
+  uint8 rxMore;     //1--接收缓冲区中还有数据
+  
   InitHardware();   //初始化硬件相关函数
   InitSoftware();   //初始化软件相关函数
   
@@ -232,7 +401,18 @@ int main(void)
 
   while(1)
   {
+    ProcAlarmTask();        //发送越限报警
+    rxMore = ProcRxTask();  //处理接收数据
     Proc2msTask();  //2ms处理任务
     Proc1SecTask(); //1s处理任务   
+
+#if (defined MAIN_WFI) && (MAIN_WFI == TRUE)
+    __disable_irq();
+    if(!rxMore && !Get2msFlag() && !Get1SecFlag() && !ADCAlarmPending())
+    {
+      __WFI();      //等待中断
+    }
+    __enable_irq();
+#endif
   }
 }
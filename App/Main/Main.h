@@ -36,12 +36,25 @@
 #include "SendDataToHost.h"
 #include "ADC.h"
 #include "Route.h"
+#include "Tdma.h"
+#include "Sensor.h"
+#include "WaveStream.h"
+#include "Vibration.h"
+#include "Fft.h"
 
 
 /*********************************************************************************************************
 *                                              宏定义
 *********************************************************************************************************/
 #define SINK TRUE  //汇聚节点设置为TRUE ,否则为FALSE
+#define WOR_LEAF FALSE  //只发送数据、不转发的叶子节点设置为TRUE，无线模块以WOR模式低功耗监听
+#define MAC_TDMA FALSE  //TRUE--按汇聚节点下发的超帧时隙发送，全网须一致；FALSE--随机接入
+#define MAIN_WFI TRUE   //TRUE--主循环没有待处理的事时WFI睡眠，由定时器、串口、AUX中断唤醒；用调试器单步时可设为FALSE
+#define MAIN_ADAPT_SMP TRUE  //TRUE--采样周期在SetSmpPrd和SetSmpMax设置的范围内随信号变化快慢自适应；FALSE--固定为SetSmpPrd设置的周期
+
+#if (SINK == TRUE) && (WOR_LEAF == TRUE)
+#error "汇聚节点不能工作在WOR模式"
+#endif
   
 /*********************************************************************************************************
 *                                              枚举结构体定义
@@ -50,6 +63,7 @@
 /*********************************************************************************************************
 *                                              API函数定义
 *********************************************************************************************************/
-uint8  SetSmpPrd(uint8 Period);
+uint8  SetSmpPrd(uint8 Period);  //设置最快的采样周期(100ms)，并从最快的周期开始采样
+uint8  SetSmpMax(uint8 Period);  //设置最慢的采样周期(100ms)，不大于最快的周期时不自适应
 
 #endif
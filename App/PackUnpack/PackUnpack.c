@@ -33,6 +33,7 @@
 /*********************************************************************************************************
 *                                              宏定义
 *********************************************************************************************************/
+#define UNPACK_GAP_MS   50    //同一数据包相邻字节的最大处理间隔(ms)，另加接收DMA半满前的停留时间
 
 /*********************************************************************************************************
 *                                              内部变量
@@ -44,6 +45,22 @@ static uint8       s_iPackLen;       //数据包长度，用来判断数据长
 static uint8       s_iGotPackId;     //获取到ID的标志
 static uint8       s_iRestByteNum;   //剩余字节数
 static uint32      s_millis_last;    //上次接收到串口1的数据的时间
+static uint8       s_iWaitRssi;      //1--数据包已收齐，下一个字节为RSSI
+static uint8       s_iPackValid;     //已收齐的数据包校验是否正确
+static int16       s_iRssi;          //最近一个有效包的RSSI(dBm)，0表示未知
+static uint32      s_iPackStartMs;   //当前数据包包头被解析的时刻(ms)
+static uint8       s_iRefeed;        //1--上次返回1时已用掉该字节，调用者再次传入时忽略
+
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+//以下参数在分帧云端JSON消息时使用
+static char        s_arrJson[JSON_FRAME_MAX + 1];  //JSON消息缓冲区，末尾留1字节放'\0'
+static uint16      s_iJsonLen;       //已收到的长度
+static uint8       s_iJsonDepth;     //花括号嵌套深度，0表示在消息之外
+static uint8       s_iJsonInStr;     //1--在字符串中，字符串中的花括号不计入深度
+static uint8       s_iJsonEsc;       //1--上一个字符是字符串中的转义符
+static uint8       s_iJsonDrop;      //1--当前消息超长，收完后丢弃
+static uint32      s_iJsonLastMs;    //上次收到JSON数据的时间
+#endif
 
 /*********************************************************************************************************
 *                                              内部函数声明
@@ -51,6 +68,7 @@ static uint32      s_millis_last;    //上次接收到串口1的数据的时间
 static  void  PackWithCheckSum(uint8* pPack);    //带校验和的数据打包
 static  short  CalculatePackCheckSum(StructPackType* pPack);    //计算校验和
 static  uint8    UnpackWithCheckSum(StructPackType* pPack); //带校验和的数据解包
+static  uint8    IsPackType(uint8 type);                    //判断是否为合法的包种类
 
 /*********************************************************************************************************
 *                                              内部函数实现
@@ -70,6 +88,32 @@ static void PackWithCheckSum(uint8* pPack)
 
 }
 
+/*********************************************************************************************************
+* 函数名称：IsPackType
+* 函数功能：判断是否为合法的包种类
+* 输入参数：type-包种类
+* 输出参数：无
+* 返 回 值：1--是EnumPackType中的一种，0--不是
+* 创建日期：2026年10月19日
+* 注    意：打包和接收包头都用它判断，新增包种类时只需在此添加
+*********************************************************************************************************/
+static uint8 IsPackType(uint8 type)
+{
+  switch(type)
+  {
+    case TYPE_DATA:
+    case TYPE_ROUTE:
+    case TYPE_SYS:
+    case TYPE_SYNC:
+    case TYPE_ALARM:
+    case TYPE_WAVE:
+    case TYPE_VIB:
+      return 1;
+    default:
+      return 0;
+  }
+}
+
 /*********************************************************************************************************
 * 函数名称：CalculatePackCheckSum
 * 函数功能：计算数据包校验和，2字节
@@ -147,6 +191,20 @@ void  InitPackUnpack(void)
   s_iGotPackId   = 0; //获取到数据包ID标志默认为0，即尚未获取到有效模块ID
   s_iRestByteNum = 0; //剩余的字节数默认为0 
   s_millis_last  = 0;//上次接收到串口1的数据的时间
+  s_iWaitRssi    = 0;
+  s_iPackValid   = 0;
+  s_iRssi        = 0;
+  s_iPackStartMs = 0;
+  s_iRefeed      = 0;
+
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+  s_iJsonLen     = 0;
+  s_iJsonDepth   = 0;
+  s_iJsonInStr   = 0;
+  s_iJsonEsc     = 0;
+  s_iJsonDrop    = 0;
+  s_iJsonLastMs  = 0;
+#endif
 }
 
 /*********************************************************************************************************
@@ -162,7 +220,7 @@ uint8  PackData(StructPackType* pPT)
 {
   uint8 valid = 0;
 
-  if(pPT->packType == TYPE_DATA || pPT->packType == TYPE_ROUTE || pPT->packType == TYPE_SYS)//包种类必须在0x01～0x03之间
+  if(IsPackType(pPT->packType))//包种类必须是EnumPackType中的一种
   {
     valid = 1;    //表示模块ID是合法的
     pPT->checkSum = CalculatePackCheckSum(pPT);//计算校验和
@@ -179,18 +237,44 @@ uint8  PackData(StructPackType* pPT)
 * 输出参数：void
 * 返 回 值：是否解包成功，1-解包成功，0-解包失败
 * 创建日期：2022年02月01日
-* 注    意：
+* 注    意：RADIO_RSSI_BYTE为TRUE时模块在每包末尾附带1字节RSSI，收到该字节后才交出数据包；
+*           返回1后调用者须以同一字节再次调用，直到返回0(见ProcHostCmd)：RSSI字节超时未到时，
+*           先交出数据包(RSSI未知)，该字节在再次调用时按新数据处理
 *********************************************************************************************************/
 uint8  UnPackData(uint8 data)
 {
   uint8 findPack = 0;
   uint8* pBuf;
   uint32 millis_cur = millis();//当前时间（相对时间）
+  uint32 gapMs = UNPACK_GAP_MS + GetUART1RxLatency();  //超过此间隔认为是新数据
   
   pBuf = s_ptPack.arrData;      //pBuf指向s_ptPack的缓冲区arrData，即pBuf和s_ptPack->arrData的值是同一个
+  if(s_iRefeed)               //该字节已经用过
+  {
+    s_iRefeed = 0;
+    return 0;
+  }
+  
+  if(s_iWaitRssi)             //数据包已收齐
+  {
+    s_iWaitRssi = 0;
+    if(millis_cur - s_millis_last < gapMs)//RSSI字节紧跟在数据包后面
+    {
+      s_iRssi        = RADIO_RSSI_DBM(data);
+      s_millis_last  = millis_cur;
+      s_iRefeed      = s_iPackValid;
+      return s_iPackValid;
+    }
+    if(s_iPackValid)          //RSSI字节丢失，仍交出数据包，该字节在再次调用时处理
+    {
+      s_iRssi = 0;
+      return 1;
+    }
+  }
+  
   if(s_iGotPackId)            //已经接收到包ID
   {
-    if(millis_cur - s_millis_last < 50)//时间间隔不超过xms
+    if(millis_cur - s_millis_last < gapMs)//时间间隔不超过gapMs
     {
       pBuf[s_iPackLen - 1] = data;             //赋给pBuf[s_iPackLen]，也相当于赋给s_ptPack中对应的成员
       s_iPackLen++;                            //包长自增
@@ -208,13 +292,20 @@ uint8  UnPackData(uint8 data)
         }
         #endif
         
+        #if (RADIO_RSSI_BYTE == TRUE)
+        s_iPackValid = findPack;               //等收到RSSI字节再交出
+        s_iWaitRssi  = 1;
+        findPack     = 0;
+        #endif
+        
       }
     }
     else//超时，认为是新数据包
     {
       debug("超时");
-      if( data == TYPE_DATA || data == TYPE_ROUTE  || data == TYPE_SYS)
+      if(IsPackType(data))
       {
+        s_iPackStartMs     = millis_cur;
         s_iRestByteNum     = PACKLEN - 1;//剩余的包长，即打包好的包长减去1
         s_iPackLen         = 1;          //尚未接收到包ID即表示包长为1
         s_ptPack.packType = data;       //数据包的种类
@@ -222,14 +313,16 @@ uint8  UnPackData(uint8 data)
       }
     }
   }
-  else if(data == TYPE_DATA || data == TYPE_ROUTE  || data == TYPE_SYS)       //当前的数据为包ID,即接收到包头开始接收，否则丢弃
+  else if(IsPackType(data))       //当前的数据为包ID,即接收到包头开始接收，否则丢弃
   {
+    s_iPackStartMs     = millis_cur;
     s_iRestByteNum     = PACKLEN - 1;//剩余的包长，即打包好的包长减去1
     s_iPackLen         = 1;          //尚未接收到包ID即表示包长为1
     s_ptPack.packType = data;       //数据包的种类
     s_iGotPackId       = 1;          //表示已经接收到包ID  
   }
   s_millis_last  = millis();         //更新这次接收到串口1的数据的时间，供下次使用
+  s_iRefeed      = findPack;
   return findPack;                   //如果获取到完整的数据包，并解包成功，findPack为1，否则为0
 }
 
@@ -246,3 +339,133 @@ StructPackType  GetUnPackRslt(void)
 {
   return(s_ptPack);
 }
+
+/*********************************************************************************************************
+* 函数名称：GetUnPackRssi
+* 函数功能：获取最近一个解包成功的数据包的RSSI
+* 输入参数：void 
+* 输出参数：void
+* 返 回 值：RSSI(dBm)，0表示未知
+* 创建日期：2026年10月19日
+* 注    意：在UnPackData返回1之后调用
+*********************************************************************************************************/
+int16  GetUnPackRssi(void)
+{
+  return(s_iRssi);
+}
+
+/*********************************************************************************************************
+* 函数名称：GetUnPackTime
+* 函数功能：获取最近一个解包成功的数据包包头被解析的时刻
+* 输入参数：void 
+* 输出参数：void
+* 返 回 值：时刻(ms)
+* 创建日期：2026年10月19日
+* 注    意：在UnPackData返回1之后调用；模块在空中接收完成后才从串口输出，接收数据没有积压时，
+*           该时刻接近空中接收完成的时刻，不受逐字节解包耗时的影响
+*********************************************************************************************************/
+uint32 GetUnPackTime(void)
+{
+  return(s_iPackStartMs);
+}
+
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+/*********************************************************************************************************
+* 函数名称：UnPackJson
+* 函数功能：从云端串口数据流中分出完整的JSON消息，收到一个字节就处理一个字节
+* 输入参数：data，串口2收到的数据
+* 输出参数：void
+* 返 回 值：1-收到一条完整的JSON消息，此时通过调用GetUnPackJson取走，0-还没有收完
+* 创建日期：2026年10月19日
+* 注    意：以最外层花括号配对确定一条消息，字符串中的花括号不计入；消息之外的字符(换行等)忽略；
+*           超过JSON_FRAME_MAX的消息整条丢弃；字符串中遇到换行或字节间隔超过JSON_FRAME_TIMEOUT时
+*           丢弃当前消息重新同步，残缺的消息不会吞掉后面按行发送的消息
+*********************************************************************************************************/
+uint8  UnPackJson(uint8 data)
+{
+  uint32 millis_cur = millis();  //当前时间（相对时间）
+
+  if(s_iJsonDepth > 0 && millis_cur - s_iJsonLastMs > JSON_FRAME_TIMEOUT)
+  {
+    s_iJsonDepth = 0;  //消息中断，丢弃已收到的部分
+  }
+  s_iJsonLastMs = millis_cur;
+
+  if(s_iJsonDepth == 0)  //在消息之外，等待'{'
+  {
+    if(data != '{')
+    {
+      return 0;
+    }
+    s_iJsonLen   = 0;
+    s_iJsonInStr = 0;
+    s_iJsonEsc   = 0;
+    s_iJsonDrop  = 0;
+  }
+  else if(s_iJsonInStr)  //在字符串中
+  {
+    if(s_iJsonEsc)
+    {
+      s_iJsonEsc = 0;
+    }
+    else if(data == '\\')
+    {
+      s_iJsonEsc = 1;
+    }
+    else if(data == '"')
+    {
+      s_iJsonInStr = 0;
+    }
+    else if(data == '\n')  //字符串不能跨行，按消息出错处理
+    {
+      s_iJsonDepth = 0;
+      return 0;
+    }
+  }
+  else if(data == '"')
+  {
+    s_iJsonInStr = 1;
+  }
+  else if(data == '}')
+  {
+    s_iJsonDepth--;
+  }
+
+  if(data == '{' && !s_iJsonInStr)
+  {
+    s_iJsonDepth++;
+  }
+
+  if(s_iJsonLen < JSON_FRAME_MAX)
+  {
+    s_arrJson[s_iJsonLen++] = (char)data;
+  }
+  else
+  {
+    s_iJsonDrop = 1;  //超长，继续跟踪花括号直到消息结束
+  }
+
+  if(s_iJsonDepth == 0)  //最外层花括号已配对
+  {
+    s_arrJson[s_iJsonLen] = '\0';
+    return !s_iJsonDrop;
+  }
+
+  return 0;
+}
+
+/*********************************************************************************************************
+* 函数名称：GetUnPackJson
+* 函数功能：读取最近一条收完的JSON消息
+* 输入参数：void
+* 输出参数：pLen，消息长度，不含'\0'
+* 返 回 值：消息首地址，以'\0'结尾
+* 创建日期：2026年10月19日
+* 注    意：在UnPackJson返回1之后、下一次调用UnPackJson之前使用
+*********************************************************************************************************/
+char*  GetUnPackJson(uint16* pLen)
+{
+  *pLen = s_iJsonLen;
+  return s_arrJson;
+}
+#endif
@@ -27,6 +27,11 @@
 *********************************************************************************************************/
 #define DATALEN 61                          //数据包数据部分的长度
 #define PACKLEN sizeof(StructPackType)      //数据包总长度
+
+#define JSON_FRAME_MAX     512              //云端JSON消息的最大长度，超长的整条丢弃
+#define JSON_FRAME_TIMEOUT 500              //JSON消息中两个字节的最大间隔(ms)，超时丢弃已收到的部分
+
+#define CMD_RESP_FLAG      0x80             //命令分组中命令代号最高位为1表示是命令应答，发往汇聚节点
   
 /*********************************************************************************************************
 *                                              枚举结构体定义
@@ -37,11 +42,22 @@ typedef enum
   TYPE_DATA    = 0x01,  //数据分组
   TYPE_ROUTE   = 0x02,  //路由分组
   TYPE_SYS     = 0x03,  //系统信息
+  TYPE_SYNC    = 0x04,  //TDMA超帧同步
+  TYPE_ALARM   = 0x05,  //越限报警，逐跳立即转发到汇聚节点
+  TYPE_WAVE    = 0x06,  //波形流数据块，差分变位宽压缩，带块序号
+  TYPE_VIB     = 0x07,  //振动特征分组，FFT提取的有效值、谱峰和频带有效值
 }EnumPackType; 
 
 typedef enum 
 {
   CMD_SET_SMP_PRD = 0x01,//设置采样周期
+  CMD_SET_AIR_RATE = 0x02,//设置全网空中速率，对象地址为0xFFFF，附加参数为距切换时刻的剩余时间(10ms)
+  CMD_GET_QUE_STATS = 0x03,//读取串口缓冲区的入队、丢弃个数和最高水位，应答逐跳上传到汇聚节点
+  CMD_SET_DEADBAND = 0x04,//设置上报死区，单位为各传感器的dbUnit，对象地址为0xFFFF时全网设置
+  CMD_SET_HEARTBEAT = 0x05,//设置心跳间隔(分钟)，对象地址为0xFFFF时全网设置
+  CMD_SET_SMP_MAX = 0x06,//设置自适应时最慢的采样周期(100ms)，CMD_SET_SMP_PRD设置最快的周期
+  CMD_WAVE_STREAM = 0x07,//开始波形流，参数为采样率(10Hz)，0为停止；只能对单个节点，应答带是否接纳和预留的负载
+  CMD_SET_VIB_PRD = 0x08,//设置振动特征的捕获周期(s)，0为停止，对象地址为0xFFFF时全网设置
   
 }EnumCmdType;
 
@@ -53,15 +69,16 @@ typedef struct
   short checkSum;    //校验和2
 }StructPackType;//uint8---4Byte;uint8*---4Byte;short---2Byte
 
-//发送串口包类型结构体
-typedef struct
+//模块ID，与二级ID一起标识数据的种类
+typedef enum
 {
-  uint8  reverse;//保留，用于字节对齐
-  uint8  addh;
-  uint8  addl;
-  uint8  channel;
-  StructPackType spt2;
-}SentStructPackType;
+  MODULE_SYS      = 0x01,         //系统信息
+  MODULE_ECG      = 0x10,         //心电
+  MODULE_RESP     = 0x11,         //呼吸
+  MODULE_TEMP     = 0x12,         //体温
+  MODULE_SPO2     = 0x13,         //血氧
+  MODULE_NBP      = 0x14,         //无创血压
+}EnumModuleID;
 
 //定义二级ID，0x00～0xFF，因为是分属于不同的模块ID，因此不同模块ID的二级ID可以重复
 //系统模块的二级ID
@@ -156,4 +173,8 @@ void  InitPackUnpack(void);           //初始化PackUnpack模块
 uint8    PackData(StructPackType* pPT);  //对数据进行打包，1-打包成功，0-打包失败             
 uint8    UnPackData(uint8 data);            //对数据进行解包，1-解包成功，0-解包失败
 StructPackType  GetUnPackRslt(void);  //读取解包后数据包
+int16  GetUnPackRssi(void);           //读取解包后数据包的RSSI(dBm)，0表示未知
+uint32 GetUnPackTime(void);           //读取解包后数据包包头被解析的时刻(ms)
+uint8  UnPackJson(uint8 data);           //从云端串口数据流中分出完整的JSON消息，1--收到一条，汇聚节点使用
+char*  GetUnPackJson(uint16* pLen);      //读取收到的JSON消息，以'\0'结尾
 #endif
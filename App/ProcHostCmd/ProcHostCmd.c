@@ -24,20 +24,40 @@
 #include "SendDataToHost.h"
 #include "ADC.h"
 #include "Route.h"
+#include "Tdma.h"
 #include "RADIO.h"
 #include "cJSON.h"
 #include "Main.h"
 #include "UART2.h"
 #include <string.h>
 #include "UART1.h"
+#include "Sensor.h"
+#include "WaveStream.h"
+#include "Vibration.h"
 
 /*********************************************************************************************************
 *                                              宏定义
 *********************************************************************************************************/
+#define BCAST_SEEN_NUM  8       //记录最近收到的广播命令条数
+#define BCAST_SEEN_MS   30000   //广播命令记录的保留时间(ms)，同一广播的各个副本在此时间内到达，
+                                //发起节点重启后序号从头开始，过期的记录不会误判新命令
+#define QUE_STATS_HEAD  6   //缓冲区统计应答的头部：命令ID、命令代号、缓冲区个数、地址高、地址低、保留
+#define QUE_STATS_NUM   4   //上报统计的缓冲区个数：UART1发送、接收，UART2发送、接收
+#define QUE_STATS_LEN   13  //每个缓冲区的统计：编号、容量2、最高水位2、丢弃个数4、入队个数4，高字节在前
+#define WAVE_RESP_LEN   11  //波形流应答：命令ID、命令代号、是否接纳、地址2、采样率2、预留负载2、路径余量2，高字节在前
+#define JSON_BUF_SIZE   1024  //波形数据块、振动特征的JSON，不超过UART2发送缓冲区
 
 /*********************************************************************************************************
 *                                              枚举结构体定义
 *********************************************************************************************************/
+//收到的广播命令记录
+typedef struct
+{
+  uint16 src;    //发起节点地址
+  uint16 seq;    //广播序号
+  uint32 time;   //收到的时刻(millis)
+  uint8  valid;  //记录是否有效
+}StructBcastSeen;
 
 /*********************************************************************************************************
 *                                              内部变量
@@ -46,16 +66,75 @@
 static uint8 IdBuff[10] = {0};//存储上次命令ID，防止重复
 #endif
 static uint8 lastRecCmdID = 0;
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+static const char* s_arrQueName[QUE_STATS_NUM] = {"UART1_TX", "UART1_RX", "UART2_TX", "UART2_RX"};
+static char  s_arrJson[JSON_BUF_SIZE];  //数据块、振动特征的JSON，数值多，cJSON所需的堆不够，直接格式化
+#else
+static StructBcastSeen s_arrBcastSeen[BCAST_SEEN_NUM];  //最近收到的广播命令，广播命令每个节点只执行并转发一次
+static uint8 s_iBcastSeenIdx;         //下一个写入位置
+#endif
 
 /*********************************************************************************************************
 *                                              内部函数声明
 *********************************************************************************************************/
 static uint8  OnGenWave(uint8* pMsg);  //生成波形的响应函数
 static uint8  SetSamplePeriod(uint8 CmdVlaue);  //设置采样周期的响应函数
+static uint8  PackQueStats(uint8 CmdID, uint8* pBuf);  //把本节点串口缓冲区的统计打包成应答
+static uint8  PackWaveResp(uint8 CmdID, uint8 CmdValue, uint8* pBuf);  //开始或停止波形流，结果打包成应答
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+static void   PostQueStats(uint8* pResp);  //把缓冲区统计应答格式化为JSON发给云端
+static void   PostWaveResp(uint8* pResp);  //把波形流应答格式化为JSON发给云端
+static void   PostWave(StructWaveBlock* pBlock, uint16 lost);  //把解包的数据块格式化为JSON发给云端
+static uint16 PrintMv(char* pBuf, uint16 adc);  //把ADC读数格式化为mV，两位小数
+static void   PostVib(StructVibFeature* pFeat);  //把解包的振动特征格式化为JSON发给云端
+static void   AddSensorProp(cJSON* pParams, const char* pName, int32 value, uint8 format);  //添加一个传感器属性
+#else
+static uint8  IsBcastSeen(uint8* pRecData);     //广播命令是否已经处理过
+#endif
 
 /*********************************************************************************************************
 *                                              内部函数实现
 *********************************************************************************************************/
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+#else
+/*********************************************************************************************************
+* 函数名称：IsBcastSeen
+* 函数功能：判断广播命令是否已经处理过，未处理过则记录下来
+* 输入参数：pRecData-收到的命令包数据
+* 输出参数：void
+* 返 回 值：1-已处理过，0-新的广播命令
+* 创建日期：2026年10月19日
+* 注    意：按(源地址,广播序号)判断，云端下发的命令ID可能相同
+*********************************************************************************************************/
+static uint8 IsBcastSeen(uint8* pRecData)
+{
+  uint16 src = MAKEHWORD(pRecData[CMD_OFS_SRC], pRecData[CMD_OFS_SRC + 1]);
+  uint16 seq = MAKEHWORD(pRecData[CMD_OFS_SEQ], pRecData[CMD_OFS_SEQ + 1]);
+  uint32 now = millis();
+  uint8  i;
+  
+  for(i = 0; i < BCAST_SEEN_NUM; i++)
+  {
+    if(s_arrBcastSeen[i].valid && now - s_arrBcastSeen[i].time >= BCAST_SEEN_MS)
+    {
+      s_arrBcastSeen[i].valid = 0;  //过期
+    }
+    if(s_arrBcastSeen[i].valid && s_arrBcastSeen[i].src == src && s_arrBcastSeen[i].seq == seq)
+    {
+      return 1;
+    }
+  }
+  
+  s_arrBcastSeen[s_iBcastSeenIdx].src   = src;
+  s_arrBcastSeen[s_iBcastSeenIdx].seq   = seq;
+  s_arrBcastSeen[s_iBcastSeenIdx].time  = now;
+  s_arrBcastSeen[s_iBcastSeenIdx].valid = 1;
+  s_iBcastSeenIdx = (s_iBcastSeenIdx + 1) % BCAST_SEEN_NUM;
+  
+  return 0;
+}
+#endif
+
 /*********************************************************************************************************
 * 函数名称：OnGenWave
 * 函数功能：生成波形的响应函数
@@ -104,6 +183,324 @@ static uint8  SetSamplePeriod(uint8 CmdVlaue)
   return(CMD_ACK_OK);       //返回命令成功
 }
 
+/*********************************************************************************************************
+* 函数名称：PackQueStats
+* 函数功能：把本节点串口缓冲区的统计打包成应答
+* 输入参数：CmdID-命令ID号
+* 输出参数：pBuf-应答数据，长度不小于QUE_STATS_HEAD + QUE_STATS_NUM * QUE_STATS_LEN
+* 返 回 值：应答数据的长度
+* 创建日期：2026年10月19日
+* 注    意：多字节数高字节在前
+*********************************************************************************************************/
+static uint8 PackQueStats(uint8 CmdID, uint8* pBuf)
+{
+  StructRingStats arrStats[QUE_STATS_NUM];
+  uint16 addr = getAddress();
+  uint8* p;
+  uint8  i;
+
+  GetUART1Stats(&arrStats[0], &arrStats[1]);
+  GetUART2Stats(&arrStats[2], &arrStats[3]);
+
+  pBuf[0] = CmdID;
+  pBuf[1] = CMD_GET_QUE_STATS | CMD_RESP_FLAG;
+  pBuf[2] = QUE_STATS_NUM;
+  pBuf[3] = HIBYTE(addr);
+  pBuf[4] = LOBYTE(addr);
+  pBuf[5] = 0;
+
+  p = &pBuf[QUE_STATS_HEAD];
+  for(i = 0; i < QUE_STATS_NUM; i++)
+  {
+    p[0]  = i;
+    p[1]  = HIBYTE(arrStats[i].size);
+    p[2]  = LOBYTE(arrStats[i].size);
+    p[3]  = HIBYTE(arrStats[i].peak);
+    p[4]  = LOBYTE(arrStats[i].peak);
+    p[5]  = (uint8)(arrStats[i].dropNum >> 24);
+    p[6]  = (uint8)(arrStats[i].dropNum >> 16);
+    p[7]  = (uint8)(arrStats[i].dropNum >> 8);
+    p[8]  = (uint8)(arrStats[i].dropNum);
+    p[9]  = (uint8)(arrStats[i].putNum >> 24);
+    p[10] = (uint8)(arrStats[i].putNum >> 16);
+    p[11] = (uint8)(arrStats[i].putNum >> 8);
+    p[12] = (uint8)(arrStats[i].putNum);
+    p += QUE_STATS_LEN;
+  }
+
+  return QUE_STATS_HEAD + QUE_STATS_NUM * QUE_STATS_LEN;
+}
+
+/*********************************************************************************************************
+* 函数名称：PackWaveResp
+* 函数功能：开始或停止本节点的波形流，结果打包成应答
+* 输入参数：CmdID-命令ID，CmdValue-采样率(10Hz)，0为停止
+* 输出参数：pBuf-应答数据，长度不小于WAVE_RESP_LEN
+* 返 回 值：应答数据的长度
+* 创建日期：2026年10月19日
+* 注    意：拒绝时采样率为0，云端可按应答中的路径余量降低采样率或空中速率后重试；多字节数高字节在前
+*********************************************************************************************************/
+static uint8 PackWaveResp(uint8 CmdID, uint8 CmdValue, uint8* pBuf)
+{
+  uint16 addr = getAddress();
+  uint16 room;
+  uint8  ok = 1;
+
+  if(CmdValue == 0)
+  {
+    StopWaveStream();
+  }
+  else
+  {
+    ok = StartWaveStream((uint16)CmdValue * 10);
+  }
+  room = RouteGetHeadroom();
+
+  pBuf[0]  = CmdID;
+  pBuf[1]  = CMD_WAVE_STREAM | CMD_RESP_FLAG;
+  pBuf[2]  = ok;
+  pBuf[3]  = HIBYTE(addr);
+  pBuf[4]  = LOBYTE(addr);
+  pBuf[5]  = HIBYTE(WaveStreamRate());
+  pBuf[6]  = LOBYTE(WaveStreamRate());
+  pBuf[7]  = HIBYTE(RouteGetReserve());
+  pBuf[8]  = LOBYTE(RouteGetReserve());
+  pBuf[9]  = HIBYTE(room);
+  pBuf[10] = LOBYTE(room);
+
+  return WAVE_RESP_LEN;
+}
+
+/*********************************************************************************************************
+* 函数名称：PostQueStats
+* 函数功能：把缓冲区统计应答格式化为JSON发给云端
+* 输入参数：pResp-PackQueStats打包的应答
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：格式如下，Drop不为0或Peak接近Size时应加大对应节点的UART1_BUF_SIZE/UART2_BUF_SIZE
+  {
+  "id": "1",
+  "version": "1.0",
+  "params": {
+    "Addr": 2,
+    "Queues": [{"Que": "UART1_TX", "Size": 256, "Peak": 70, "Drop": 0, "Put": 10230}, ...]
+  },
+  "method": "thing.event.Que_Stats.post"
+  }
+*********************************************************************************************************/
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+static void PostQueStats(uint8* pResp)
+{
+  static uint32 MsgNo = 1;
+  char   MsgNobuf[10];
+  char*  out;
+  cJSON* root   = cJSON_CreateObject();
+  cJSON* params = cJSON_CreateObject();
+  cJSON* queues = cJSON_CreateArray();
+  cJSON* que;
+  uint8* p   = &pResp[QUE_STATS_HEAD];
+  uint8  num = pResp[2];
+  uint8  i;
+
+  if(num > QUE_STATS_NUM)
+  {
+    num = QUE_STATS_NUM;
+  }
+
+  sprintf(MsgNobuf, "%d", MsgNo);
+  MsgNo++;
+  cJSON_AddStringToObject(root, "id", MsgNobuf);
+  cJSON_AddStringToObject(root, "version", "1.0");
+
+  cJSON_AddNumberToObject(params, "Addr", MAKEHWORD(pResp[3], pResp[4]));
+  for(i = 0; i < num; i++)
+  {
+    if(p[0] < QUE_STATS_NUM)
+    {
+      que = cJSON_CreateObject();
+      cJSON_AddStringToObject(que, "Que", s_arrQueName[p[0]]);
+      cJSON_AddNumberToObject(que, "Size", MAKEHWORD(p[1], p[2]));
+      cJSON_AddNumberToObject(que, "Peak", MAKEHWORD(p[3], p[4]));
+      cJSON_AddNumberToObject(que, "Drop", ((uint32)p[5] << 24) | ((uint32)p[6] << 16) | ((uint32)p[7] << 8) | p[8]);
+      cJSON_AddNumberToObject(que, "Put",  ((uint32)p[9] << 24) | ((uint32)p[10] << 16) | ((uint32)p[11] << 8) | p[12]);
+      cJSON_AddItemToArray(queues, que);
+    }
+    p += QUE_STATS_LEN;
+  }
+  cJSON_AddItemToObject(params, "Queues", queues);
+
+  cJSON_AddItemToObject(root, "params", params);
+  cJSON_AddStringToObject(root, "method", "thing.event.Que_Stats.post");
+
+  out = cJSON_Print(root);
+  WriteUART2((uint8*)out, strlen(out));
+  cJSON_Delete(root);
+  free(out);
+}
+
+/*********************************************************************************************************
+* 函数名称：PostWaveResp
+* 函数功能：把波形流应答格式化为JSON发给云端
+* 输入参数：pResp-PackWaveResp打包的应答
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：格式如下，Load、Headroom单位为空中字节/秒，Headroom为接纳之后还剩的路径余量
+  {
+  "id": "1",
+  "version": "1.0",
+  "params": {"Addr": 2, "Accepted": 1, "Rate": 500, "Load": 670, "Headroom": 2100},
+  "method": "thing.event.Wave_Stream.post"
+  }
+*********************************************************************************************************/
+static void PostWaveResp(uint8* pResp)
+{
+  static uint32 MsgNo = 1;
+  char   MsgNobuf[10];
+  char*  out;
+  cJSON* root   = cJSON_CreateObject();
+  cJSON* params = cJSON_CreateObject();
+
+  sprintf(MsgNobuf, "%d", MsgNo);
+  MsgNo++;
+  cJSON_AddStringToObject(root, "id", MsgNobuf);
+  cJSON_AddStringToObject(root, "version", "1.0");
+
+  cJSON_AddNumberToObject(params, "Addr", MAKEHWORD(pResp[3], pResp[4]));
+  cJSON_AddNumberToObject(params, "Accepted", pResp[2]);
+  cJSON_AddNumberToObject(params, "Rate", MAKEHWORD(pResp[5], pResp[6]));
+  cJSON_AddNumberToObject(params, "Load", MAKEHWORD(pResp[7], pResp[8]));
+  cJSON_AddNumberToObject(params, "Headroom", MAKEHWORD(pResp[9], pResp[10]));
+
+  cJSON_AddItemToObject(root, "params", params);
+  cJSON_AddStringToObject(root, "method", "thing.event.Wave_Stream.post");
+
+  out = cJSON_Print(root);
+  WriteUART2((uint8*)out, strlen(out));
+  cJSON_Delete(root);
+  free(out);
+}
+
+/*********************************************************************************************************
+* 函数名称：PostWave
+* 函数功能：把解包的数据块格式化为JSON发给云端
+* 输入参数：pBlock-解包的数据块，lost-与上一块之间丢失的块数
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：格式如下，Data为ADC读数，Lost不为0时Data与上一块之间的波形不连续
+  {"id":"1","version":"1.0","params":{"Addr":2,"Module":16,"Type":2,"Seq":37,"Rate":500,"Lost":0,
+  "Data":[8120,8124,...]},"method":"thing.event.Wave.post"}
+*********************************************************************************************************/
+static void PostWave(StructWaveBlock* pBlock, uint16 lost)
+{
+  static uint32 MsgNo = 1;
+  uint16 len;
+  uint8  i;
+
+  len = sprintf(s_arrJson, "{\"id\":\"%u\",\"version\":\"1.0\",\"params\":{\"Addr\":%u,\"Module\":%u,\"Type\":%u,"
+                "\"Seq\":%u,\"Rate\":%u,\"Lost\":%u,\"Data\":[",
+                MsgNo, pBlock->addr, pBlock->module, pBlock->secondId, pBlock->seq, pBlock->rate, lost);
+  MsgNo++;
+  for(i = 0; i < pBlock->num; i++)
+  {
+    len += sprintf(&s_arrJson[len], (i == 0) ? "%u" : ",%u", pBlock->arrSmp[i]);
+  }
+  len += sprintf(&s_arrJson[len], "]},\"method\":\"thing.event.Wave.post\"}");
+
+  WriteUART2((uint8*)s_arrJson, len);
+}
+
+/*********************************************************************************************************
+* 函数名称：PrintMv
+* 函数功能：把ADC读数格式化为mV，两位小数
+* 输入参数：adc-ADC_RESULT_BITS位读数的单位
+* 输出参数：pBuf-格式化结果
+* 返 回 值：格式化的字符数
+* 创建日期：2026年10月19日
+* 注    意：整数运算，不用浮点格式化
+*********************************************************************************************************/
+static uint16 PrintMv(char* pBuf, uint16 adc)
+{
+  uint32 centiMv = ((uint32)adc * (SENSOR_VREF_UV / 10000) + ADC_FULL_SCALE / 2) / ADC_FULL_SCALE;  //0.01mV
+
+  return sprintf(pBuf, "%u.%02u", centiMv / 100, centiMv % 100);
+}
+
+/*********************************************************************************************************
+* 函数名称：PostVib
+* 函数功能：把解包的振动特征格式化为JSON发给云端
+* 输入参数：pFeat-解包的振动特征
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：格式如下，Peaks为谱峰频率和正弦幅值，Bands为各频带上限频率和有效值，幅值都是去直流后的
+  {"id":"1","version":"1.0","params":{"Addr":2,"Seq":5,"Points":1024,"Rate":8000,"Mean_mV":1650.12,
+  "RMS_mV":35.20,"Peak_mV":60.11,"Crest":1.71,"Peaks":[{"Hz":120.3,"mV":49.70},...],
+  "Bands":[{"Hz":500,"mV":3.10},...]},"method":"thing.event.Vib_Features.post"}
+*********************************************************************************************************/
+static void PostVib(StructVibFeature* pFeat)
+{
+  static uint32 MsgNo = 1;
+  uint16 len;
+  uint8  i;
+
+  len = sprintf(s_arrJson, "{\"id\":\"%u\",\"version\":\"1.0\",\"params\":{\"Addr\":%u,\"Seq\":%u,"
+                "\"Points\":%u,\"Rate\":%u,\"Mean_mV\":",
+                MsgNo, pFeat->addr, pFeat->seq, 1U << pFeat->log2N, pFeat->rate);
+  MsgNo++;
+  len += PrintMv(&s_arrJson[len], pFeat->mean);
+  len += sprintf(&s_arrJson[len], ",\"RMS_mV\":");
+  len += PrintMv(&s_arrJson[len], pFeat->rms);
+  len += sprintf(&s_arrJson[len], ",\"Peak_mV\":");
+  len += PrintMv(&s_arrJson[len], pFeat->peak);
+  len += sprintf(&s_arrJson[len], ",\"Crest\":%u.%02u,\"Peaks\":[", pFeat->crest / 100, pFeat->crest % 100);
+  for(i = 0; i < pFeat->peakNum; i++)
+  {
+    len += sprintf(&s_arrJson[len], "%s{\"Hz\":%u.%u,\"mV\":", (i == 0) ? "" : ",",
+                   pFeat->arrPeakHz[i] / 10, pFeat->arrPeakHz[i] % 10);
+    len += PrintMv(&s_arrJson[len], pFeat->arrPeakAmp[i]);
+    s_arrJson[len++] = '}';
+  }
+  len += sprintf(&s_arrJson[len], "],\"Bands\":[");
+  for(i = 0; i < pFeat->bandNum; i++)
+  {
+    len += sprintf(&s_arrJson[len], "%s{\"Hz\":%u,\"mV\":", (i == 0) ? "" : ",", pFeat->arrBandHz[i]);
+    len += PrintMv(&s_arrJson[len], pFeat->arrBandRms[i]);
+    s_arrJson[len++] = '}';
+  }
+  len += sprintf(&s_arrJson[len], "]},\"method\":\"thing.event.Vib_Features.post\"}");
+
+  WriteUART2((uint8*)s_arrJson, len);
+}
+
+/*********************************************************************************************************
+* 函数名称：AddSensorProp
+* 函数功能：按AlinkJSON格式添加一个传感器属性
+* 输入参数：pParams-params对象，pName-属性名，value-数值，format-上报格式，EnumSensorFormat
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static void AddSensorProp(cJSON* pParams, const char* pName, int32 value, uint8 format)
+{
+  cJSON* pProp = cJSON_CreateObject();
+  
+  if(format == SENSOR_FMT_CENTI)
+  {
+    cJSON_AddNumberToObject(pProp, "value", value / 100.0);
+  }
+  else
+  {
+    cJSON_AddNumberToObject(pProp, "value", value);
+  }
+  //cJSON_AddNumberToObject(pProp, "time", 1524448722000);//时间戳，可选
+  cJSON_AddItemToObject(pParams, pName, pProp);
+}
+#endif
+
 /*********************************************************************************************************
 *                                              API函数实现
 *********************************************************************************************************/
@@ -148,7 +545,7 @@ void ProcHostCmd(uint8 recData)
         break;
       case TYPE_ROUTE:        //路由分组  
         debug("\r\nROUTE\r\n");
-        ack = UpdateRouTab2(pack.arrData);              //更新路由表
+        ack = UpdateRouTab2(pack.arrData, GetUnPackRssi());  //更新路由表
 //        ackArr[0] = ack;
 //        sprintf((char*)ackArr+1, "OK=%d,TYPE_ROUTE ACK",ack);
 //        SendAckPack(pack.arrData[0], pack.arrData[1], 0x00, ackArr, sizeof(ackArr));
@@ -157,6 +554,21 @@ void ProcHostCmd(uint8 recData)
         debug("\r\nSYS\r\n");
         ProcCmdPack(pack.arrData);
         break;
+      case TYPE_ALARM:      //报警分组
+        debug("\r\nALARM\r\n");
+        ProcAlarmPack(pack.arrData);
+        break;
+      case TYPE_WAVE:       //波形流数据块
+        ProcWavePack(pack.arrData);
+        break;
+      case TYPE_VIB:        //振动特征分组
+        ProcVibPack(pack.arrData);
+        break;
+#if (defined MAC_TDMA) && (MAC_TDMA == TRUE)
+      case TYPE_SYNC:       //TDMA同步分组
+        TdmaOnSync(pack.arrData, GetUnPackTime());
+        break;
+#endif
       default:          
         break;
     }
@@ -194,11 +606,19 @@ void ProcDatePack(uint8* pRecData)
   char* out;
   static uint32 MsgNo=1;
   char MsgNobuf[10];
+  char nameBuf[12];              //没有登记的传感器的属性名
+  char propBuf[32];              //统计记录各项的属性名
+  const char* pName;
   cJSON* id;
   cJSON* root = cJSON_CreateObject();
   cJSON* root2 = cJSON_CreateObject();
-  cJSON* root3 = cJSON_CreateObject();
   cJSON* root3_1 = cJSON_CreateObject();
+  const StructSensorDef* pDef;
+  uint8* pEntry = &pRecData[4];  //传感器数值
+  uint8* pEnd   = &pRecData[DATALEN];
+  uint8  num    = pRecData[3];   //传感器个数
+  uint8  format;
+  uint8  i;
     
   sprintf(MsgNobuf, "%d", MsgNo);
   id = cJSON_CreateString(MsgNobuf);
@@ -208,11 +628,44 @@ void ProcDatePack(uint8* pRecData)
   cJSON_AddItemToObject(root, "id", id);
   cJSON_AddStringToObject(root, "version", "1.0");
     
-  cJSON_AddNumberToObject(root3, "value", pRecData[0]);
-  cJSON_AddNumberToObject(root3_1, "value", pRecData[1]);
-  //cJSON_AddNumberToObject(root3, "time", 1524448722000);//时间戳，可选
+  //数据分组：[0]采样周期/100，[1..2]节点地址，[3]传感器个数，[4..]每个传感器：编号、格式、数值高、数值低，
+  //格式带SENSOR_FMT_STATS的是统计记录：编号、格式、均值、最小值、最大值、标准差、读数个数
+  for(i = 0; i < num && pEntry + SENSOR_ENTRY_LEN <= pEnd; i++)
+  {
+    pDef   = SensorFind(pEntry[0]);
+    format = pEntry[1] & ~SENSOR_FMT_STATS;
+    if(pDef != NULL)
+    {
+      pName = pDef->name;
+    }
+    else
+    {
+      sprintf(nameBuf, "Sensor_%d", pEntry[0]);
+      pName = nameBuf;
+    }
+    
+    AddSensorProp(root2, pName, (int16)MAKEHWORD(pEntry[2], pEntry[3]), format);
+    if(!(pEntry[1] & SENSOR_FMT_STATS))
+    {
+      pEntry += SENSOR_ENTRY_LEN;
+      continue;
+    }
     
-  cJSON_AddItemToObject(root2, "F103ship_temperature", root3);
+    if(pEntry + SENSOR_STATS_LEN > pEnd)
+    {
+      break;
+    }
+    sprintf(propBuf, "%s_min", pName);
+    AddSensorProp(root2, propBuf, (int16)MAKEHWORD(pEntry[4], pEntry[5]), format);
+    sprintf(propBuf, "%s_max", pName);
+    AddSensorProp(root2, propBuf, (int16)MAKEHWORD(pEntry[6], pEntry[7]), format);
+    sprintf(propBuf, "%s_std", pName);
+    AddSensorProp(root2, propBuf, MAKEHWORD(pEntry[8], pEntry[9]), format);
+    sprintf(propBuf, "%s_cnt", pName);
+    AddSensorProp(root2, propBuf, MAKEHWORD(pEntry[10], pEntry[11]), SENSOR_FMT_INT);
+    pEntry += SENSOR_STATS_LEN;
+  }
+  cJSON_AddNumberToObject(root3_1, "value", pRecData[0]);
   cJSON_AddItemToObject(root2, "Smp_Period", root3_1);
   
   cJSON_AddItemToObject(root, "params", root2);
@@ -231,33 +684,30 @@ void ProcDatePack(uint8* pRecData)
 /*********************************************************************************************************
 * 函数名称：ProcCloudCmd
 * 函数功能：处理云端下发的命令
-* 输入参数：void
+* 输入参数：pJson-一条完整的JSON消息，以'\0'结尾，len-消息长度
 * 输出参数：void
 * 返 回 值：void
 * 创建日期：2022年03月10日
-* 注    意：
+* 注    意：由UnPackJson分帧，收齐一条立即处理
 *********************************************************************************************************/
 #if (defined SINK) && (SINK == TRUE)//汇聚节点
-void ProcCloudCmd(void)
+void ProcCloudCmd(char* pJson, uint16 len)
 {
-  char CmdBuf[256]={0};
-  uint8 Cnt;
-  cJSON *root, *method, *id, *params, *ADC_period_S, *version, *Period_ms, *CmdObj;
+  cJSON *root, *method, *id, *params, *ADC_period_S, *version, *Period_ms, *CmdObj, *Deadband, *Heartbeat_min, *Rate_Hz, *Period_S;
   //char str[] = "{\"method\":\"thing.service.property.set\",\"id\":\"19244945\",\"params\":{\"ADC_period_S\":3},\"version\":\"1.0.0\"}";
   char pdebug[100] = {0};
+  uint8 arrResp[DATALEN];
 
-  Cnt = ReadUART2((uint8*)CmdBuf, 0xff);
-  
-  if(Cnt < 101)
+  if(len == 0)
   {
     return;
   }
-  debug((uint8*)CmdBuf);
+  debug((uint8*)pJson);
   
 /*接收成功则反序列化以下JSON
 {"method":"thing.service.property.set","id":"19244945","params":{"ADC_period_S":3},"version":"1.0.0"}
 */
-  root = cJSON_Parse(CmdBuf);
+  root = cJSON_Parse(pJson);
   //必须有的参数
   method = cJSON_GetObjectItem(root, "method");//没有此对象则返回空
   id = cJSON_GetObjectItem(root, "id");
@@ -267,6 +717,10 @@ void ProcCloudCmd(void)
   ADC_period_S = cJSON_GetObjectItem(params, "ADC_period_S");
   Period_ms = cJSON_GetObjectItem(params, "Period_ms");
   CmdObj = cJSON_GetObjectItem(params, "CmdObj");
+  Deadband = cJSON_GetObjectItem(params, "Deadband");
+  Heartbeat_min = cJSON_GetObjectItem(params, "Heartbeat_min");
+  Rate_Hz = cJSON_GetObjectItem(params, "Rate_Hz");
+  Period_S = cJSON_GetObjectItem(params, "Period_S");
   if(root == NULL || method == NULL || id == NULL  || version == NULL)
   {
     cJSON_Delete(root);
@@ -301,6 +755,56 @@ void ProcCloudCmd(void)
       SendCmdPack((uint8)*(id->valuestring), CMD_SET_SMP_PRD, Period_ms->valueint, CmdObj->valueint, 0);
     }
   }
+  if(0 == strcmp("thing.service.Smp_Period_Max", method->valuestring))//设置自适应时最慢的采样周期
+  {
+    if (Period_ms && CmdObj)
+    {
+      SendCmdPack((uint8)*(id->valuestring), CMD_SET_SMP_MAX, Period_ms->valueint, CmdObj->valueint, 0);
+    }
+  }
+  if(0 == strcmp("thing.service.Que_Stats", method->valuestring))//读取CmdObj节点的串口缓冲区统计
+  {
+    if (CmdObj)
+    {
+      if(CmdObj->valueint == getAddress())//汇聚节点自己的统计直接上报
+      {
+        PackQueStats((uint8)*(id->valuestring), arrResp);
+        PostQueStats(arrResp);
+      }
+      else
+      {
+        SendCmdPack((uint8)*(id->valuestring), CMD_GET_QUE_STATS, 0, CmdObj->valueint, 0);
+      }
+    }
+  }
+  if(0 == strcmp("thing.service.Deadband", method->valuestring))//设置CmdObj节点的上报死区，CmdObj为65535时全网设置
+  {
+    if (Deadband && CmdObj)
+    {
+      SendCmdPack((uint8)*(id->valuestring), CMD_SET_DEADBAND, Deadband->valueint, CmdObj->valueint, 0);
+    }
+  }
+  if(0 == strcmp("thing.service.Heartbeat", method->valuestring))//设置CmdObj节点的心跳间隔，CmdObj为65535时全网设置
+  {
+    if (Heartbeat_min && CmdObj)
+    {
+      SendCmdPack((uint8)*(id->valuestring), CMD_SET_HEARTBEAT, Heartbeat_min->valueint, CmdObj->valueint, 0);
+    }
+  }
+  if(0 == strcmp("thing.service.Wave_Stream", method->valuestring))//CmdObj节点按Rate_Hz开始波形流，Rate_Hz为0时停止
+  {
+    if (Rate_Hz && CmdObj && CmdObj->valueint != 0xFFFF && Rate_Hz->valueint >= 0 && Rate_Hz->valueint / 10 <= 0xFF)
+    {
+      SendCmdPack((uint8)*(id->valuestring), CMD_WAVE_STREAM, Rate_Hz->valueint / 10, CmdObj->valueint, 0);
+    }
+  }
+  if(0 == strcmp("thing.service.Vib_Period", method->valuestring))//设置CmdObj节点的振动捕获周期，Period_S为0时停止，CmdObj为65535时全网设置
+  {
+    if (Period_S && CmdObj && Period_S->valueint >= 0 && Period_S->valueint <= 0xFF)
+    {
+      SendCmdPack((uint8)*(id->valuestring), CMD_SET_VIB_PRD, Period_S->valueint, CmdObj->valueint, 0);
+    }
+  }
 
   cJSON_Delete(root);//最后释放内存
 }
@@ -313,12 +817,65 @@ void ProcCloudCmd(void)
 * 输出参数：void
 * 返 回 值：void
 * 创建日期：2022年3月18日21:19:52
-* 注    意：接收处理SendCmdPack()函数的消息
+* 注    意：接收处理SendCmdPack()函数的消息，对象地址为0xFFFF的是广播命令；
+*           命令代号带CMD_RESP_FLAG的是命令应答，普通节点转发给父结点，汇聚节点上报云端
 *********************************************************************************************************/
 void ProcCmdPack(uint8* pRecData)
 {  
 #if (defined SINK) && (SINK == TRUE)//汇聚节点
+  if(pRecData[1] == (CMD_GET_QUE_STATS | CMD_RESP_FLAG))
+  {
+    PostQueStats(pRecData);
+  }
+  else if(pRecData[1] == (CMD_WAVE_STREAM | CMD_RESP_FLAG))
+  {
+    PostWaveResp(pRecData);
+  }
 #else
+  uint8 arrResp[DATALEN];
+
+  if(pRecData[1] & CMD_RESP_FLAG)//子树中节点的命令应答，转发给父结点
+  {
+    SendRespToParent(pRecData, DATALEN);
+    return;
+  }
+
+  if(pRecData[3] == 0xFF && pRecData[4] == 0xFF)//广播命令，执行后转发
+  {
+    uint16 remain;
+    
+    if(IsBcastSeen(pRecData))//已经处理过
+    {
+      return;
+    }
+    
+    switch (pRecData[1])
+    {
+      case CMD_SET_AIR_RATE:
+        SetPendingAirRate(pRecData[2], MAKEHWORD(pRecData[CMD_OFS_ARG], pRecData[CMD_OFS_ARG + 1]));  //到切换时刻全网同时切换
+        remain = GetAirRateRemain();  //转发时改为下一跳收到时的剩余时间
+        pRecData[CMD_OFS_ARG]     = remain>>8;
+        pRecData[CMD_OFS_ARG + 1] = remain;
+        break;
+      case CMD_SET_DEADBAND:
+        SetReportDeadband(pRecData[2]);
+        break;
+      case CMD_SET_HEARTBEAT:
+        SetReportHeartbeat(pRecData[2]);
+        break;
+      case CMD_SET_SMP_MAX:
+        SetSmpMax(pRecData[2]);
+        break;
+      case CMD_SET_VIB_PRD:
+        SetVibPeriod(pRecData[2]);
+        break;
+      default:
+        break;
+    }
+    ForwardCmdPack(pRecData);//转发该命令
+    return;
+  }
+  
   if(lastRecCmdID == pRecData[0])//已经接收过这条命令
   {
 //    return;
@@ -331,6 +888,24 @@ void ProcCmdPack(uint8* pRecData)
     	case CMD_SET_SMP_PRD: 
         SetSamplePeriod(pRecData[2]);
     		break;
+      case CMD_GET_QUE_STATS:
+        SendRespToParent(arrResp, PackQueStats(pRecData[0], arrResp));
+        break;
+      case CMD_WAVE_STREAM:
+        SendRespToParent(arrResp, PackWaveResp(pRecData[0], pRecData[2], arrResp));
+        break;
+      case CMD_SET_DEADBAND:
+        SetReportDeadband(pRecData[2]);
+        break;
+      case CMD_SET_HEARTBEAT:
+        SetReportHeartbeat(pRecData[2]);
+        break;
+      case CMD_SET_SMP_MAX:
+        SetSmpMax(pRecData[2]);
+        break;
+      case CMD_SET_VIB_PRD:
+        SetVibPeriod(pRecData[2]);
+        break;
     	default:
     		break;
     }
@@ -342,3 +917,128 @@ void ProcCmdPack(uint8* pRecData)
   
 #endif
 }
+
+/*********************************************************************************************************
+* 函数名称：ProcWavePack
+* 函数功能：处理波形流数据块
+* 输入参数：pRecData-WaveStream压缩的数据块，格式见WaveUnpack
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：普通节点原样转发给父结点，不解包，TDMA上行队列满时丢弃，汇聚节点由序号的缺口发现；
+*           汇聚节点解包、检查序号后上报云端，重复或迟到的块丢弃
+*********************************************************************************************************/
+void ProcWavePack(uint8* pRecData)
+{
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+  static StructWaveBlock block;  //解包结果，放在栈上太大
+  uint16 lost;
+
+  if(!WaveUnpack(pRecData, &block))
+  {
+    debug("波形数据块格式错误\r\n");
+    return;
+  }
+  if(WaveCheckSeq(block.addr, block.seq, &lost))
+  {
+    PostWave(&block, lost);
+  }
+#else  //普通节点
+  if(!SendWaveToParent(pRecData, DATALEN))
+  {
+    debug("波形数据块丢弃\r\n");
+  }
+#endif
+}
+
+/*********************************************************************************************************
+* 函数名称：ProcVibPack
+* 函数功能：处理振动特征分组
+* 输入参数：pRecData-振动特征分组，格式见VibUnpack
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：本节点的特征不经此函数；普通节点原样转发给父结点，汇聚节点解包后上报云端
+*********************************************************************************************************/
+void ProcVibPack(uint8* pRecData)
+{
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+  StructVibFeature feat;
+
+  if(!VibUnpack(pRecData, &feat))
+  {
+    debug("振动特征分组格式错误\r\n");
+    return;
+  }
+  PostVib(&feat);
+#else  //普通节点
+  if(!SendVibToParent(pRecData, DATALEN))
+  {
+    debug("振动特征分组丢弃\r\n");
+  }
+#endif
+}
+
+/*********************************************************************************************************
+* 函数名称：ProcAlarmPack
+* 函数功能：处理报警分组
+* 输入参数：pRecData-报警数据，[0..1]节点地址，[2..]SensorAlarm打包的报警记录
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：本节点的报警也由此发出；普通节点立即转发给父结点，汇聚节点按以下格式上报云端：
+  {
+  "id": "123",
+  "version": "1.0",
+  "params": {"Addr": 2, "Sensor": "AIN1_mV", "Dir": "High", "Value": 3120},
+  "method": "thing.event.Threshold_Alarm.post"
+  }
+*********************************************************************************************************/
+void ProcAlarmPack(uint8* pRecData)
+{
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+  static uint32 MsgNo = 1;
+  char   MsgNobuf[10];
+  char   nameBuf[12];  //没有登记的传感器的名称
+  char*  out;
+  cJSON* root   = cJSON_CreateObject();
+  cJSON* params = cJSON_CreateObject();
+  const StructSensorDef* pDef = SensorFind(pRecData[2]);
+  int16  value = (int16)MAKEHWORD(pRecData[5], pRecData[6]);
+
+  sprintf(MsgNobuf, "%d", MsgNo);
+  MsgNo++;
+  cJSON_AddStringToObject(root, "id", MsgNobuf);
+  cJSON_AddStringToObject(root, "version", "1.0");
+
+  cJSON_AddNumberToObject(params, "Addr", MAKEHWORD(pRecData[0], pRecData[1]));
+  if(pDef != NULL)
+  {
+    cJSON_AddStringToObject(params, "Sensor", pDef->name);
+  }
+  else
+  {
+    sprintf(nameBuf, "Sensor_%d", pRecData[2]);
+    cJSON_AddStringToObject(params, "Sensor", nameBuf);
+  }
+  cJSON_AddStringToObject(params, "Dir", pRecData[4] ? "High" : "Low");
+  if(pRecData[3] == SENSOR_FMT_CENTI)
+  {
+    cJSON_AddNumberToObject(params, "Value", value / 100.0);
+  }
+  else
+  {
+    cJSON_AddNumberToObject(params, "Value", value);
+  }
+
+  cJSON_AddItemToObject(root, "params", params);
+  cJSON_AddStringToObject(root, "method", "thing.event.Threshold_Alarm.post");
+
+  out = cJSON_Print(root);
+  WriteUART2((uint8*)out, strlen(out));
+  cJSON_Delete(root);
+  free(out);
+#else  //普通节点
+  SendAlarmToParent(pRecData, DATALEN);  //立即转发给父结点
+#endif
+}
@@ -46,8 +46,11 @@ typedef enum{
 void  InitProcHostCmd(void);    //初始化ProcHostCmd模块       
 void  ProcHostCmd(uint8 recData);//处理主机命令
 #if (defined SINK) && (SINK == TRUE)//汇聚节点
-void  ProcCloudCmd(void);//处理云端下发的命令
+void  ProcCloudCmd(char* pJson, uint16 len);//处理云端下发的一条JSON命令
 #endif
 void  ProcDatePack(uint8* pRecData);
 void  ProcCmdPack(uint8* pRecData);
+void  ProcAlarmPack(uint8* pRecData);
+void  ProcWavePack(uint8* pRecData);   //处理波形流数据块，汇聚节点上报云端，普通节点转发
+void  ProcVibPack(uint8* pRecData);    //处理振动特征分组，汇聚节点上报云端，普通节点转发
 #endif
@@ -22,6 +22,7 @@
 #include "UART1.h"
 #include "Route.h"
 #include "RADIO.h"
+#include "Tdma.h"
 #include "string.h"
 
 /*********************************************************************************************************
@@ -35,11 +36,17 @@
 /*********************************************************************************************************
 *                                              内部变量
 *********************************************************************************************************/
+static uint16 s_iBcastSeq;  //本节点发起的广播命令序号
  
 /*********************************************************************************************************
 *                                              内部函数声明
 *********************************************************************************************************/
-static  void  SendPackToHost(uint8 addh, uint8 addl, uint8 channel, StructPackType* pt);  //打包数据，并将数据发送到主机
+static  void  SendPackToHost(uint8 addh, uint8 addl, uint8 channel, StructPackType* pt, uint8 wake);  //打包数据，并将数据发送到主机
+static  void  SendBcastPack(StructPackType* pt, uint8 wake);  //在邻居使用的各信道上广播数据包
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+#else
+static  void  SendToParent(uint8 packType, uint8* pData, uint8 len);  //立即给父结点发送指定种类的分组
+#endif
 
 /*********************************************************************************************************
 *                                              内部函数实现
@@ -47,29 +54,83 @@ static  void  SendPackToHost(uint8 addh, uint8 addl, uint8 channel, StructPackTy
 /*********************************************************************************************************
 * 函数名称：SendPackToHost
 * 函数功能：打包数据，并将数据发送到主机
-* 输入参数：pPackSent，指向结构体变量的地址
+* 输入参数：pPackSent，指向结构体变量的地址，wake-1--带唤醒前导码发送给WOR监听的节点
 * 输出参数：void
 * 返 回 值：void
 * 创建日期：2021年11月07日
 * 注    意：
 *********************************************************************************************************/
-static  void  SendPackToHost(uint8 addh, uint8 addl, uint8 channel, StructPackType* pt)
+static  void  SendPackToHost(uint8 addh, uint8 addl, uint8 channel, StructPackType* pt, uint8 wake)
 {
-  SentStructPackType sspt2;
   uint8 packValid  = 0;  //打包正确标志位，默认值为0
   
-  sspt2.addh = addh;  //广播地址高位,1
-  sspt2.addl = addl;  //广播地址低位,2
-  sspt2.channel = channel;  //信道地址,3
   packValid = PackData(pt); //打包数据，加校验和
   
   if(0 < packValid)         //如果打包正确
   {
-    sspt2.spt2 = *pt; //复制数据包
-    RadioSendData((uint8*)&sspt2+1, PACKLEN+3);  //无线发送数据 uint8--_4Byte;uint8*---4Byte;short---2Byte
+    if(wake)
+    {
+      RadioSendWakeData(MAKEHWORD(addh, addl), channel, (uint8*)pt, PACKLEN);  //目的节点处于WOR监听
+    }
+    else
+    {
+      RadioSendData(MAKEHWORD(addh, addl), channel, (uint8*)pt, PACKLEN);  //无线发送数据，地址和信道由无线模块单独写入
+    }
   }
 }
 
+/*********************************************************************************************************
+* 函数名称：SendBcastPack
+* 函数功能：在邻居使用的各信道上广播数据包
+* 输入参数：pt-数据包，wake-1--带唤醒前导码
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：各子树使用不同的接收信道，广播须在本节点、父结点和子结点的接收信道上各发一次
+*********************************************************************************************************/
+static  void  SendBcastPack(StructPackType* pt, uint8 wake)
+{
+  uint8 arrCh[ROUTE_CH_NUM];
+  uint8 num;
+  uint8 i;
+  
+  num = GetBcastChannels(arrCh);
+  for(i = 0; i < num; i++)
+  {
+    SendPackToHost(0xff, 0xff, arrCh[i], pt, wake);
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：SendToParent
+* 函数功能：立即给父结点发送指定种类的分组
+* 输入参数：packType-分组种类，pData-分组数据，len-数据长度
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：数据数组长度最大为61个字节，无应答，不保证传输成功
+*********************************************************************************************************/
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+#else
+static  void  SendToParent(uint8 packType, uint8* pData, uint8 len)
+{
+  uint16 P_Add;  //父结点地址
+  StructPackType  pt;  //包结构体变量
+  memset(&pt, '\0', sizeof(StructPackType));
+  
+  pt.packType = packType;
+  memcpy(pt.arrData, pData, len);
+  P_Add = GetParentAddr();
+  
+  if(P_Add == 0xffff)
+  {
+    debug("未连接Lora网络");
+    return;
+  }
+  SendPackToHost(P_Add>>8, P_Add, GetNeighborChannel(P_Add), &pt, 0);  //发到父结点的接收信道
+}
+#endif
+
 /*********************************************************************************************************
 *                                              API函数实现
 *********************************************************************************************************/
@@ -104,7 +165,7 @@ void SendAckPack(uint8 addh, uint8 addl,uint8 channel, uint8* ackMsg, uint8 len)
   pt.packType = TYPE_DATA;
   memcpy(pt.arrData, ackMsg, len);
   
-  SendPackToHost(addh,addl,channel,&pt);
+  SendPackToHost(addh,addl,channel,&pt,IsWorNeighbor(MAKEHWORD(addh, addl)));
 }
 
 /*********************************************************************************************************
@@ -114,11 +175,18 @@ void SendAckPack(uint8 addh, uint8 addl,uint8 channel, uint8* ackMsg, uint8 len)
 * 输出参数：void
 * 返 回 值：void
 * 创建日期：2022年3月18日20:36:55
-* 注    意：
+* 注    意：对象地址为0xFFFF时发起广播命令，PassCnt不再使用；
+*           命令对象是WOR监听的邻居时直接发给它，有WOR监听的邻居时广播带唤醒前导码
 *********************************************************************************************************/
 void SendCmdPack(uint8 CmdID, uint8 Cmd, uint8 CmdValue, uint16 ObjectAdd, uint8 PassCnt)  //发送命令包
 {
   StructPackType  pt;              //包结构体2变量
+  
+  if(ObjectAdd == 0xFFFF)
+  {
+    SendBcastCmd(CmdID, Cmd, CmdValue, 0);
+    return;
+  }
   memset(&pt, '\0', sizeof(StructPackType));
   
   pt.packType = TYPE_SYS;
@@ -130,7 +198,71 @@ void SendCmdPack(uint8 CmdID, uint8 Cmd, uint8 CmdValue, uint16 ObjectAdd, uint8
   pt.arrData[4] = ObjectAdd;
   pt.arrData[5] = PassCnt+1;
   
-  SendPackToHost(0xff, 0xff, 0x00, &pt);
+  if(IsWorNeighbor(ObjectAdd))
+  {
+    SendPackToHost(ObjectAdd>>8, ObjectAdd, GetNeighborChannel(ObjectAdd), &pt, 1);
+  }
+  else
+  {
+    SendBcastPack(&pt, HasWorNeighbor());
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：SendBcastCmd
+* 函数功能：发起广播命令
+* 输入参数：CmdID-命令ID号，Cmd-命令代号，CmdValue-命令参数，CmdArg-附加参数
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：每条广播取新的序号，各节点按(源地址,序号)去重，不依赖云端下发的命令ID；
+*           有WOR监听的邻居时带唤醒前导码
+*********************************************************************************************************/
+void SendBcastCmd(uint8 CmdID, uint8 Cmd, uint8 CmdValue, uint16 CmdArg)
+{
+  StructPackType  pt;              //包结构体变量
+  uint16 src = getAddress();
+  
+  memset(&pt, '\0', sizeof(StructPackType));
+  s_iBcastSeq++;
+  
+  pt.packType = TYPE_SYS;
+  
+  pt.arrData[0] = CmdID;
+  pt.arrData[1] = Cmd;
+  pt.arrData[2] = CmdValue;
+  pt.arrData[3] = 0xFF;
+  pt.arrData[4] = 0xFF;
+  pt.arrData[5] = 1;
+  pt.arrData[CMD_OFS_SRC]     = src>>8;
+  pt.arrData[CMD_OFS_SRC + 1] = src;
+  pt.arrData[CMD_OFS_SEQ]     = s_iBcastSeq>>8;
+  pt.arrData[CMD_OFS_SEQ + 1] = s_iBcastSeq;
+  pt.arrData[CMD_OFS_ARG]     = CmdArg>>8;
+  pt.arrData[CMD_OFS_ARG + 1] = CmdArg;
+  
+  SendPackToHost(0xff, 0xff, 0x00, &pt, HasWorNeighbor());
+}
+
+/*********************************************************************************************************
+* 函数名称：ForwardCmdPack
+* 函数功能：原样转发收到的广播命令
+* 输入参数：pCmdData-收到的命令包数据
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：保留源地址和广播序号，转发次数加1；有WOR监听的邻居时带唤醒前导码
+*********************************************************************************************************/
+void ForwardCmdPack(uint8* pCmdData)
+{
+  StructPackType  pt;              //包结构体变量
+  memset(&pt, '\0', sizeof(StructPackType));
+  
+  pt.packType = TYPE_SYS;
+  memcpy(pt.arrData, pCmdData, DATALEN);
+  pt.arrData[5]++;
+  
+  SendPackToHost(0xff, 0xff, 0x00, &pt, HasWorNeighbor());
 }
 
 /*********************************************************************************************************
@@ -150,7 +282,27 @@ void  SendRouteToNeighbor(uint8* pRouteData, uint8 len)
   pt.packType = TYPE_ROUTE;
   memcpy(pt.arrData, pRouteData, len);
   
-  SendPackToHost(0xff,0xff,0x00,&pt);
+  SendBcastPack(&pt, 0);
+}
+
+/*********************************************************************************************************
+* 函数名称：SendSyncPack
+* 函数功能：在指定信道上广播TDMA同步包
+* 输入参数：pSyncData-同步包数据，len-长度，channel-信道
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：同步包在本节点的同步时隙中发送，每个时隙只发一个信道
+*********************************************************************************************************/
+void  SendSyncPack(uint8* pSyncData, uint8 len, uint8 channel)
+{
+  StructPackType  pt;  //包结构体变量
+  memset(&pt, '\0', sizeof(StructPackType));
+  
+  pt.packType = TYPE_SYNC;
+  memcpy(pt.arrData, pSyncData, len);
+  
+  SendPackToHost(0xff, 0xff, channel, &pt, 0);
 }
 
 /*********************************************************************************************************
@@ -160,27 +312,137 @@ void  SendRouteToNeighbor(uint8* pRouteData, uint8 len)
 * 输出参数：void
 * 返 回 值：void
 * 创建日期：2022年02月12日
-* 注    意：数据数组长度最大为61个字节，太长只发前61个，无应答，不保证传输成功
+* 注    意：数据数组长度最大为61个字节，太长只发前61个，无应答，不保证传输成功；
+*           TDMA已同步时放入上行队列，在本节点的时隙中发送
 *********************************************************************************************************/
 #if (defined SINK) && (SINK == TRUE)//汇聚节点
 
 #else  //普通节点
 void  SendDateToParent(uint8* pSentData, uint8 len)
 {
-  uint16 P_Add;  //父结点地址
-  StructPackType  pt;  //包结构体变量
-  memset(&pt, '\0', sizeof(StructPackType));
-  
-  pt.packType = TYPE_DATA;
-  memcpy(pt.arrData, pSentData, len);
-  P_Add = GetParentAddr();
-  
-  if(P_Add == 0xffff)
+#if (defined MAC_TDMA) && (MAC_TDMA == TRUE)
+  if(TdmaIsSynced())
   {
-    debug("未连接Lora网络");
+    if(!TdmaPutUplink(TYPE_DATA, pSentData, len))
+    {
+      debug("TDMA上行队列已满\r\n");
+    }
     return;
   }
-  SendPackToHost(P_Add>>8, P_Add, 0x00, &pt);
+#endif
+  SendDateToParentNow(pSentData, len);
+}
+
+/*********************************************************************************************************
+* 函数名称：SendDateToParentNow
+* 函数功能：立即给父结点发送数据
+* 输入参数：pSentData-待发送数据存放的地址
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2022年02月12日
+* 注    意：数据数组长度最大为61个字节，太长只发前61个，无应答，不保证传输成功
+*********************************************************************************************************/
+void  SendDateToParentNow(uint8* pSentData, uint8 len)
+{
+  SendToParent(TYPE_DATA, pSentData, len);
+}
+
+/*********************************************************************************************************
+* 函数名称：SendRespToParent
+* 函数功能：给父结点发送命令应答分组
+* 输入参数：pResp-应答数据，命令代号带CMD_RESP_FLAG，len-数据长度
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：应答很少，立即在竞争期发送，不占用TDMA上行队列
+*********************************************************************************************************/
+void  SendRespToParent(uint8* pResp, uint8 len)
+{
+  SendToParent(TYPE_SYS, pResp, len);
+}
+
+/*********************************************************************************************************
+* 函数名称：SendAlarmToParent
+* 函数功能：立即给父结点发送报警分组
+* 输入参数：pAlarm-报警数据，len-数据长度
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：报警优先于周期数据，TDMA已同步时也不进上行队列等本节点的时隙，立即发送
+*********************************************************************************************************/
+void  SendAlarmToParent(uint8* pAlarm, uint8 len)
+{
+  SendToParent(TYPE_ALARM, pAlarm, len);
+}
+
+/*********************************************************************************************************
+* 函数名称：SendWaveToParent
+* 函数功能：给父结点发送波形流数据块
+* 输入参数：pWave-数据块，len-数据长度
+* 输出参数：void
+* 返 回 值：1--已发送或已放入上行队列，0--TDMA上行队列满，由调用者保留稍后再发
+* 创建日期：2026年10月19日
+* 注    意：TDMA已同步时放入上行队列，在父结点按预留负载多分配的上行时隙中发送
+*********************************************************************************************************/
+uint8 SendWaveToParent(uint8* pWave, uint8 len)
+{
+#if (defined MAC_TDMA) && (MAC_TDMA == TRUE)
+  if(TdmaIsSynced())
+  {
+    return TdmaPutUplink(TYPE_WAVE, pWave, len);
+  }
+#endif
+  SendWaveToParentNow(pWave, len);
+  return 1;
+}
+
+/*********************************************************************************************************
+* 函数名称：SendWaveToParentNow
+* 函数功能：立即给父结点发送波形流数据块
+* 输入参数：pWave-数据块，len-数据长度
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：无应答，丢失的块由汇聚节点按块序号发现
+*********************************************************************************************************/
+void  SendWaveToParentNow(uint8* pWave, uint8 len)
+{
+  SendToParent(TYPE_WAVE, pWave, len);
+}
+
+/*********************************************************************************************************
+* 函数名称：SendVibToParent
+* 函数功能：给父结点发送振动特征分组
+* 输入参数：pVib-特征分组，len-数据长度
+* 输出参数：void
+* 返 回 值：1--已发送或已放入上行队列，0--TDMA上行队列满，本次特征丢弃
+* 创建日期：2026年10月19日
+* 注    意：TDMA已同步时放入上行队列，在本节点的上行时隙中发送
+*********************************************************************************************************/
+uint8 SendVibToParent(uint8* pVib, uint8 len)
+{
+#if (defined MAC_TDMA) && (MAC_TDMA == TRUE)
+  if(TdmaIsSynced())
+  {
+    return TdmaPutUplink(TYPE_VIB, pVib, len);
+  }
+#endif
+  SendVibToParentNow(pVib, len);
+  return 1;
+}
+
+/*********************************************************************************************************
+* 函数名称：SendVibToParentNow
+* 函数功能：立即给父结点发送振动特征分组
+* 输入参数：pVib-特征分组，len-数据长度
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+void  SendVibToParentNow(uint8* pVib, uint8 len)
+{
+  SendToParent(TYPE_VIB, pVib, len);
 }
 #endif
 /*********************************************************************************************************
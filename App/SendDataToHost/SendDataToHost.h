@@ -25,6 +25,11 @@
 /*********************************************************************************************************
 *                                              宏定义
 *********************************************************************************************************/
+//命令包数据：|CmdID |Cmd |Value |ObjH |ObjL |PassCnt |SrcH |SrcL |SeqH |SeqL |ArgH |ArgL |
+//广播命令(对象地址0xFFFF)由发起节点填写源地址和广播序号，各节点按(源地址,序号)去重
+#define CMD_OFS_SRC    6    //广播命令发起节点地址的位置，高位在前
+#define CMD_OFS_SEQ    8    //广播序号的位置，高位在前
+#define CMD_OFS_ARG    10   //附加参数的位置，高位在前
 
 /*********************************************************************************************************
 *                                              枚举结构体定义
@@ -36,12 +41,22 @@
 void  InitSendDataToHost(void);                          //初始化SendDataToHost模块
 void SendAckPack(uint8 addh, uint8 addl,uint8 channel, uint8* ackMsg, uint8 len);  //发送命令应答数据包
 void SendCmdPack(uint8 CmdID, uint8 Cmd, uint8 CmdValue, uint16 ObjectAdd, uint8 passCnt);  //发送命令包
+void SendBcastCmd(uint8 CmdID, uint8 Cmd, uint8 CmdValue, uint16 CmdArg);  //发起广播命令
+void ForwardCmdPack(uint8* pCmdData);                   //原样转发收到的广播命令
 
 void  SendRouteToNeighbor(uint8* pRouteData, uint8 len);               //广播发送路由信息
+void  SendSyncPack(uint8* pSyncData, uint8 len, uint8 channel);        //在指定信道上广播TDMA同步包
 #if (defined SINK) && (SINK == TRUE)//汇聚节点
 void  SendDateToE20(uint8* pSentData, uint8 len);                   //给Eport-E20发送数据
 #else
 void  SendDateToParent(uint8* pSentData, uint8 len);                   //给父结点发送数据
+void  SendDateToParentNow(uint8* pSentData, uint8 len);                //立即给父结点发送数据，不经TDMA上行队列
+void  SendRespToParent(uint8* pResp, uint8 len);                       //给父结点发送命令应答分组
+void  SendAlarmToParent(uint8* pAlarm, uint8 len);                     //立即给父结点发送报警分组
+uint8 SendWaveToParent(uint8* pWave, uint8 len);                       //给父结点发送波形流数据块，0--TDMA上行队列满
+void  SendWaveToParentNow(uint8* pWave, uint8 len);                    //立即给父结点发送波形流数据块，不经TDMA上行队列
+uint8 SendVibToParent(uint8* pVib, uint8 len);                         //给父结点发送振动特征分组，0--TDMA上行队列满
+void  SendVibToParentNow(uint8* pVib, uint8 len);                      //立即给父结点发送振动特征分组，不经TDMA上行队列
 #endif
 
 #endif
@@ -0,0 +1,1011 @@
+/*********************************************************************************************************
+* 模块名称：Sensor.c
+* 摘    要：传感器模块，按传感器登记表采样、用定点整数换算并打包上报
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：线性换算：数值 = offset + (adc * gain) >> shift，
+*           offset、gain、shift在SetSensorCal中由标定参数算出，shift取不使乘积溢出的最大值；
+*           打包格式：[传感器个数n][编号 格式 数值高 数值低] * n；
+*           新数值与上次上报的值相差不超过死区，且距上次上报不到心跳间隔时不打包，节省空中时间；
+*           统计记录：[编号 格式|SENSOR_FMT_STATS 均值 最小值 最大值 标准差 读数个数]，每个窗口结束时上报一次，不受死区限制；
+*           报警记录：[编号 格式 方向 数值]，数值随读数减小的传感器(如温度、供电电压)，读数越下限即数值越上限
+* 注    意：只有SetSensorCal使用64位整数除法，换算本身是32位乘法和移位
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "Sensor.h"
+#include "ADC.h"
+#include "Timer.h"
+#include "Stats.h"
+#include <stddef.h>
+#if (defined SENSOR_BENCH) && (SENSOR_BENCH == TRUE)
+#include "UART1.h"
+#endif
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#define SENSOR_NUM  (sizeof(s_arrSensorDef) / sizeof(s_arrSensorDef[0]))  //登记的传感器个数
+
+#if (defined SENSOR_BENCH) && (SENSOR_BENCH == TRUE)
+#define DEMCR       (*(volatile uint32*)0xE000EDFC)  //调试异常和监视控制寄存器，bit24-TRCENA
+#define DWT_CTRL    (*(volatile uint32*)0xE0001000)  //DWT控制寄存器，bit0-CYCCNTENA
+#define DWT_CYCCNT  (*(volatile uint32*)0xE0001004)  //DWT周期计数器
+#endif
+
+/*********************************************************************************************************
+*                                              枚举结构体定义
+*********************************************************************************************************/
+//线性换算系数
+typedef struct
+{
+  int32 offset;  //读数为0时的数值
+  int32 gain;    //每个读数对应的数值，有shift位小数
+  uint8 shift;   //gain的小数位数
+}StructSensorConv;
+
+//传感器运行状态
+typedef struct
+{
+  StructSensorConv conv;     //换算系数
+  uint32           lastMs;   //上次采样的时刻
+  int16            value;    //最近一次的数值
+  uint8            valid;    //1--value有效，已经采样过
+  uint8            fresh;    //1--上次打包之后有新数值
+  int16            sentVal;  //上次上报的数值
+  uint32           sentMs;   //上次上报的时刻
+  uint8            sent;     //1--已经上报过，sentVal有效
+  uint16           window;   //统计窗口的读数个数，0--上报原始数值
+  StructStats      stats;    //当前窗口的统计
+  StructStats      done;     //最近结束的窗口的统计，fresh为1时有效
+  StructFilterChain filter;  //滤波链，没有滤波级时采样取缓冲区平均
+  uint16           lastAdc;  //最近一个滤波后的读数
+  uint8            hasAdc;   //1--上次采样之后有滤波后的读数
+  int16            alarmLow; //报警下限
+  int16            alarmHigh;//报警上限，alarmLow >= alarmHigh表示不报警
+}StructSensorState;
+
+/*********************************************************************************************************
+*                                              内部变量
+*********************************************************************************************************/
+//传感器登记表，增加传感器在此加一项
+static const StructSensorDef s_arrSensorDef[] =
+{
+  //芯片温度，跟随节点采样周期，上报0.01℃，死区单位0.1℃，-20℃~85℃以外报警
+  {SENSOR_ID_TEMP, ADC_CH_TEMP, SENSOR_CONV_LINEAR, SENSOR_FMT_CENTI, 10, 0,     0,    -2000, 8500, "F103ship_temperature",
+   {SENSOR_V25_UV, 2500, SENSOR_SLOPE_UV, 100, SENSOR_VREF_UV, ADC_RESULT_BITS}},
+  //供电电压，变化慢，每分钟采样一次，死区单位10mV，2.9V~3.6V以外报警
+  {SENSOR_ID_VDD,  ADC_CH_VREF, SENSOR_CONV_SUPPLY, SENSOR_FMT_INT,   10, 60000, 0,    2900,  3600, "Supply_mV",
+   {SENSOR_VREFINT_UV, 0, 0, 0, 0, ADC_RESULT_BITS}},
+  //PA1外部输入电压(mV)，每1250个读数(约10s)上报一条统计记录，高于3V报警，由模拟看门狗检测
+  {SENSOR_ID_AIN1, ADC_CH_AIN1, SENSOR_CONV_LINEAR, SENSOR_FMT_INT,   10, 0,     1250, 0,     3000, "AIN1_mV",
+   {0, 0, 1000, 1, SENSOR_VREF_UV, ADC_RESULT_BITS}},
+};
+
+//抑制工频干扰的FIR：读数每8ms一个(125Hz)，5点平均在25Hz的整数倍处为零点，正好滤除50Hz，系数之和为32768
+static const int16 s_arrFirHum[5] = {6553, 6554, 6554, 6554, 6553};
+
+//2Hz二阶巴特沃斯低通(fs = 125Hz)，Q14，b0 + b1 + b2 = 2^14 + a1 + a2，直流增益为1
+static const int16 s_arrBiquadLp2Hz[5] = {39, 77, 39, -30442, 14213};
+
+static StructSensorState s_arrSensorState[SENSOR_NUM];  //各传感器的运行状态，下标与登记表一致
+static StructSensorCal   s_arrSensorCal[SENSOR_NUM];    //各传感器当前的标定参数
+static uint8             s_iDeadband  = SENSOR_DEADBAND_DEF;              //上报死区，单位为dbUnit
+static uint32            s_iHeartbeat = SENSOR_HEARTBEAT_DEF * 60000UL;   //心跳间隔(ms)，0--不按心跳上报
+static uint8             s_iActive    = 0;  //1--上次SensorActivity之后信号活跃
+
+/*********************************************************************************************************
+*                                              内部函数声明
+*********************************************************************************************************/
+static  int32 DivRound(long long num, long long den);                      //四舍五入的有符号除法
+static  void  CalcConv(const StructSensorCal* pCal, StructSensorConv* pConv); //由标定参数计算线性换算系数
+static  int16 Convert(uint8 idx, uint16 adc);                              //把读数换算为数值
+static  uint16 Invert(uint8 idx, int16 value);                             //把数值换算为读数
+static  uint8 IsFalling(uint8 idx);                                        //判断数值是否随读数增大而减小
+static  void  ApplyAlarm(uint8 idx);                                       //把报警阈值换算为读数交给ADC模块
+static  uint8 ReadMean(uint8 ch, uint16* pMean);                           //读出通道缓冲区中全部读数的平均值
+static  uint8 NeedReport(uint8 idx, uint32 now);                           //判断新数值是否需要上报
+static  void  UpdateValue(uint8 idx, int16 value);                         //保存新数值，检查信号是否活跃
+static  void  InitFilter(uint8 idx);                                       //配置默认的滤波链
+static  uint8 ProcStream(uint8 idx);                                       //按块读出读数，滤波后加入统计窗口或保存
+static  uint8 PackStats(const StructSensorDef* pDef, const StructStats* pStats, uint8* pBuf); //打包统计记录
+#if (defined SENSOR_BENCH) && (SENSOR_BENCH == TRUE)
+static  int16 ConvertFloat(uint8 idx, uint16 adc);                         //用浮点按标定公式换算，作为比较的基准
+#endif
+
+/*********************************************************************************************************
+*                                              内部函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：DivRound
+* 函数功能：四舍五入的有符号除法
+* 输入参数：num-被除数，den-除数，不为0
+* 输出参数：void
+* 返 回 值：num / den四舍五入后的值
+* 创建日期：2026年10月19日
+* 注    意：C语言的整数除法向0截断，先按商的符号加减半个除数
+*********************************************************************************************************/
+static  int32 DivRound(long long num, long long den)
+{
+  if((num < 0) == (den < 0))
+  {
+    return (int32)((num + den / 2) / den);
+  }
+
+  return (int32)((num - den / 2) / den);
+}
+
+/*********************************************************************************************************
+* 函数名称：CalcConv
+* 函数功能：由标定参数计算线性换算系数
+* 输入参数：pCal-标定参数
+* 输出参数：pConv-换算系数
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：gain = scale * vrefUV / (slopeUV * 2^bits)，放大2^shift倍取整；
+*           满量程读数乘以gain不能超过int32，否则减小shift
+*********************************************************************************************************/
+static  void  CalcConv(const StructSensorCal* pCal, StructSensorConv* pConv)
+{
+  long long den = (long long)pCal->slopeUV << pCal->bits;  //增益的分母
+  long long num = (long long)pCal->vrefUV * pCal->scale;   //增益的分子
+  long long gain;
+  uint8     shift = SENSOR_MAX_SHIFT;
+
+  while(1)
+  {
+    gain = DivRound(num << shift, den);
+    if(gain < 0)
+    {
+      gain = -gain;
+    }
+    if(shift == 0 || (gain << pCal->bits) < 0x80000000LL)
+    {
+      break;
+    }
+    shift--;
+  }
+
+  pConv->shift  = shift;
+  pConv->gain   = DivRound(num << shift, den);
+  pConv->offset = pCal->refVal - DivRound((long long)pCal->refUV * pCal->scale, pCal->slopeUV);
+}
+
+/*********************************************************************************************************
+* 函数名称：Convert
+* 函数功能：把读数换算为数值
+* 输入参数：idx-登记表下标，adc-ADC读数
+* 输出参数：void
+* 返 回 值：数值，超出int16范围时取边界值
+* 创建日期：2026年10月19日
+* 注    意：负数右移按算术移位处理，ARMCC如此实现
+*********************************************************************************************************/
+static  int16 Convert(uint8 idx, uint16 adc)
+{
+  const StructSensorConv* pConv = &s_arrSensorState[idx].conv;
+  const StructSensorCal*  pCal  = &s_arrSensorCal[idx];
+  int32 prod;   //读数乘以定点增益
+  int32 value;  //换算结果
+
+  if(s_arrSensorDef[idx].conv == SENSOR_CONV_SUPPLY)
+  {
+    if(adc == 0)
+    {
+      return 0;
+    }
+    //Vrefint(mV) * 2^bits / 读数，1200 * 16384不超过uint32
+    value = (int32)((((uint32)pCal->refUV / 1000 << pCal->bits) + adc / 2) / adc);
+  }
+  else
+  {
+    prod = (int32)adc * pConv->gain;
+    if(pConv->shift > 0)
+    {
+      prod += (int32)1 << (pConv->shift - 1);  //四舍五入
+    }
+    value = pConv->offset + (prod >> pConv->shift);
+  }
+
+  if(value > 32767)
+  {
+    value = 32767;
+  }
+  else if(value < -32768)
+  {
+    value = -32768;
+  }
+
+  return (int16)value;
+}
+
+/*********************************************************************************************************
+* 函数名称：Invert
+* 函数功能：把数值换算为读数，Convert的逆运算
+* 输入参数：idx-登记表下标，value-数值
+* 输出参数：void
+* 返 回 值：读数，超出范围时取0或ADC_FULL_SCALE - 1
+* 创建日期：2026年10月19日
+* 注    意：只在设置报警阈值时调用，使用64位除法
+*********************************************************************************************************/
+static  uint16 Invert(uint8 idx, int16 value)
+{
+  const StructSensorConv* pConv = &s_arrSensorState[idx].conv;
+  const StructSensorCal*  pCal  = &s_arrSensorCal[idx];
+  int32 adc;  //换算结果
+
+  if(s_arrSensorDef[idx].conv == SENSOR_CONV_SUPPLY)
+  {
+    if(value <= 0)
+    {
+      return ADC_FULL_SCALE - 1;
+    }
+    adc = (int32)((((uint32)pCal->refUV / 1000 << pCal->bits) + value / 2) / value);
+  }
+  else
+  {
+    if(pConv->gain == 0)
+    {
+      return 0;
+    }
+    adc = DivRound((long long)(value - pConv->offset) << pConv->shift, pConv->gain);
+  }
+
+  if(adc < 0)
+  {
+    return 0;
+  }
+  if(adc > ADC_FULL_SCALE - 1)
+  {
+    return ADC_FULL_SCALE - 1;
+  }
+
+  return (uint16)adc;
+}
+
+/*********************************************************************************************************
+* 函数名称：IsFalling
+* 函数功能：判断数值是否随读数增大而减小
+* 输入参数：idx-登记表下标
+* 输出参数：void
+* 返 回 值：1--减小，如供电电压和芯片温度，0--增大
+* 创建日期：2026年10月19日
+* 注    意：此时数值的上限对应读数的下限
+*********************************************************************************************************/
+static  uint8 IsFalling(uint8 idx)
+{
+  return (s_arrSensorDef[idx].conv == SENSOR_CONV_SUPPLY || s_arrSensorState[idx].conv.gain < 0);
+}
+
+/*********************************************************************************************************
+* 函数名称：ApplyAlarm
+* 函数功能：把报警阈值换算为读数交给ADC模块
+* 输入参数：idx-登记表下标
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：换算系数改变后也要调用
+*********************************************************************************************************/
+static  void  ApplyAlarm(uint8 idx)
+{
+  const StructSensorState* pState = &s_arrSensorState[idx];
+  uint16 low;   //下限对应的读数
+  uint16 high;  //上限对应的读数
+
+  if(pState->alarmLow >= pState->alarmHigh)
+  {
+    ClearADCAlarm(s_arrSensorDef[idx].adcCh);
+    return;
+  }
+
+  low  = Invert(idx, pState->alarmLow);
+  high = Invert(idx, pState->alarmHigh);
+  if(IsFalling(idx))
+  {
+    SetADCAlarm(s_arrSensorDef[idx].adcCh, high, low);
+  }
+  else
+  {
+    SetADCAlarm(s_arrSensorDef[idx].adcCh, low, high);
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：ReadMean
+* 函数功能：读出通道缓冲区中全部读数的平均值
+* 输入参数：ch-ADC通道
+* 输出参数：pMean-平均值
+* 返 回 值：1--有读数，0--缓冲区为空
+* 创建日期：2026年10月19日
+* 注    意：缓冲区满时丢弃最旧的读数，平均的是最近ADC1_BUF_SIZE个读数
+*********************************************************************************************************/
+static  uint8 ReadMean(uint8 ch, uint16* pMean)
+{
+  uint16 adc;
+  uint32 sum = 0;  //读数的累加和
+  uint16 num = 0;  //读数的个数
+
+  while(ReadADCBuf(ch, &adc))
+  {
+    sum += adc;
+    num++;
+  }
+
+  if(num == 0)
+  {
+    return 0;
+  }
+
+  *pMean = (uint16)(sum / num);
+  return 1;
+}
+
+/*********************************************************************************************************
+* 函数名称：NeedReport
+* 函数功能：判断新数值是否需要上报
+* 输入参数：idx-登记表下标，now-当前时刻(ms)
+* 输出参数：void
+* 返 回 值：1--需要上报，0--不需要
+* 创建日期：2026年10月19日
+* 注    意：从未上报过、与上次上报的值相差超过死区、或距上次上报达到心跳间隔时上报
+*********************************************************************************************************/
+static  uint8 NeedReport(uint8 idx, uint32 now)
+{
+  const StructSensorState* pState = &s_arrSensorState[idx];
+  int32 delta;  //与上次上报的值之差
+
+  if(!pState->sent)
+  {
+    return 1;
+  }
+
+  delta = (int32)pState->value - pState->sentVal;
+  if(delta < 0)
+  {
+    delta = -delta;
+  }
+  if(delta > (int32)s_iDeadband * s_arrSensorDef[idx].dbUnit)
+  {
+    return 1;
+  }
+
+  return (s_iHeartbeat != 0 && now - pState->sentMs >= s_iHeartbeat);
+}
+
+/*********************************************************************************************************
+* 函数名称：UpdateValue
+* 函数功能：保存新数值，与上次采样比较检查信号是否活跃
+* 输入参数：idx-登记表下标，value-新数值
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：只有跟随节点采样周期的传感器参与判断；死区为0时按1个dbUnit判断，避免噪声使采样一直保持最快
+*********************************************************************************************************/
+static  void  UpdateValue(uint8 idx, int16 value)
+{
+  StructSensorState* pState = &s_arrSensorState[idx];
+  int32 delta = (int32)value - pState->value;  //与上次采样之差
+  int32 band  = (s_iDeadband > 0 ? s_iDeadband : 1) * (int32)s_arrSensorDef[idx].dbUnit;
+
+  if(delta < 0)
+  {
+    delta = -delta;
+  }
+  if(pState->valid && s_arrSensorDef[idx].periodMs == 0 && delta > band)
+  {
+    s_iActive = 1;
+  }
+
+  pState->value = value;
+  pState->valid = 1;
+  pState->fresh = 1;
+}
+
+/*********************************************************************************************************
+* 函数名称：InitFilter
+* 函数功能：配置默认的滤波链
+* 输入参数：idx-登记表下标
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：先中值去尖峰再线性滤波，尖峰不会被线性滤波展宽；供电电压每分钟采样一次，不滤波
+*********************************************************************************************************/
+static  void  InitFilter(uint8 idx)
+{
+  StructFilterChain* pChain = &s_arrSensorState[idx].filter;
+
+  FilterInit(pChain);
+  switch(s_arrSensorDef[idx].id)
+  {
+    case SENSOR_ID_TEMP:
+      FilterAddMedian(pChain, 3);
+      FilterAddBiquad(pChain, s_arrBiquadLp2Hz);
+      break;
+    case SENSOR_ID_AIN1:
+      FilterAddMedian(pChain, 5);
+      FilterAddFir(pChain, s_arrFirHum, 5);
+      break;
+    default:
+      break;
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：ProcStream
+* 函数功能：按块读出通道缓冲区中的全部读数，滤波后加入统计窗口或保存最近一个
+* 输入参数：idx-登记表下标
+* 输出参数：void
+* 返 回 值：1--有统计窗口结束，0--没有
+* 创建日期：2026年10月19日
+* 注    意：每次2ms任务都要调用，滤波器和统计窗口要看到每一个读数；
+*           14位读数减去中点后左移2位即为Q15；上次结束的窗口还没打包时被新结束的窗口覆盖
+*********************************************************************************************************/
+static  uint8 ProcStream(uint8 idx)
+{
+  StructSensorState* pState = &s_arrSensorState[idx];
+  uint16 arrBlock[SENSOR_BLOCK_LEN];
+  int16* pQ15  = (int16*)arrBlock;  //就地转换为Q15
+  uint16 num;
+  uint16 i;
+  uint8  ready = 0;  //1--有窗口结束
+
+  while((num = ReadADCBlock(s_arrSensorDef[idx].adcCh, arrBlock, SENSOR_BLOCK_LEN)) > 0)
+  {
+    if(pState->filter.num > 0)
+    {
+      for(i = 0; i < num; i++)
+      {
+        pQ15[i] = (int16)(((int32)arrBlock[i] - ADC_FULL_SCALE / 2) << (15 - ADC_RESULT_BITS + 1));
+      }
+      FilterBlock(&pState->filter, pQ15, num);
+      for(i = 0; i < num; i++)
+      {
+        arrBlock[i] = (uint16)((pQ15[i] >> (15 - ADC_RESULT_BITS + 1)) + ADC_FULL_SCALE / 2);
+      }
+    }
+
+    if(pState->window == 0)
+    {
+      pState->lastAdc = arrBlock[num - 1];
+      pState->hasAdc  = 1;
+      continue;
+    }
+
+    for(i = 0; i < num; i++)
+    {
+      StatsAdd(&pState->stats, Convert(idx, arrBlock[i]));
+      if(pState->stats.num >= pState->window)
+      {
+        pState->done  = pState->stats;
+        pState->value = StatsMean(&pState->done);
+        pState->fresh = 1;
+        StatsReset(&pState->stats);
+        ready = 1;
+      }
+    }
+  }
+
+  return ready;
+}
+
+/*********************************************************************************************************
+* 函数名称：PackStats
+* 函数功能：打包统计记录
+* 输入参数：pDef-登记表的一项，pStats-窗口统计
+* 输出参数：pBuf-打包结果，长度为SENSOR_STATS_LEN
+* 返 回 值：打包的长度
+* 创建日期：2026年10月19日
+* 注    意：方差可能超过16位，上报与数值同单位的标准差
+*********************************************************************************************************/
+static  uint8 PackStats(const StructSensorDef* pDef, const StructStats* pStats, uint8* pBuf)
+{
+  int16  mean = StatsMean(pStats);
+  uint16 std  = StatsStd(pStats);
+
+  pBuf[0]  = pDef->id;
+  pBuf[1]  = pDef->format | SENSOR_FMT_STATS;
+  pBuf[2]  = HIBYTE(mean);
+  pBuf[3]  = LOBYTE(mean);
+  pBuf[4]  = HIBYTE(pStats->min);
+  pBuf[5]  = LOBYTE(pStats->min);
+  pBuf[6]  = HIBYTE(pStats->max);
+  pBuf[7]  = LOBYTE(pStats->max);
+  pBuf[8]  = HIBYTE(std);
+  pBuf[9]  = LOBYTE(std);
+  pBuf[10] = HIBYTE(pStats->num);
+  pBuf[11] = LOBYTE(pStats->num);
+
+  return SENSOR_STATS_LEN;
+}
+
+#if (defined SENSOR_BENCH) && (SENSOR_BENCH == TRUE)
+/*********************************************************************************************************
+* 函数名称：ConvertFloat
+* 函数功能：用浮点按标定公式换算，作为比较的基准
+* 输入参数：idx-登记表下标，adc-ADC读数
+* 输出参数：void
+* 返 回 值：数值，超出int16范围时取边界值
+* 创建日期：2026年10月19日
+* 注    意：即改为定点换算之前的做法，Cortex-M3上由软件浮点库完成
+*********************************************************************************************************/
+static  int16 ConvertFloat(uint8 idx, uint16 adc)
+{
+  const StructSensorCal* pCal = &s_arrSensorCal[idx];
+  float uv;     //输入电压(uV)
+  float value;  //换算结果
+
+  if(s_arrSensorDef[idx].conv == SENSOR_CONV_SUPPLY)
+  {
+    if(adc == 0)
+    {
+      return 0;
+    }
+    value = (float)pCal->refUV / 1000.0f * (float)(1UL << pCal->bits) / (float)adc;
+  }
+  else
+  {
+    uv    = (float)adc * (float)pCal->vrefUV / (float)(1UL << pCal->bits);
+    value = (float)pCal->refVal + (float)pCal->scale * (uv - (float)pCal->refUV) / (float)pCal->slopeUV;
+  }
+  value += (value < 0.0f) ? -0.5f : 0.5f;
+
+  if(value > 32767.0f)
+  {
+    return 32767;
+  }
+  if(value < -32768.0f)
+  {
+    return -32768;
+  }
+
+  return (int16)value;
+}
+#endif
+
+/*********************************************************************************************************
+*                                              API函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：InitSensor
+* 函数功能：初始化Sensor模块
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：使用登记表中的默认标定参数，内部温度传感器的V25偏差较大，需要精确值时用SetSensorCal重新标定
+*********************************************************************************************************/
+void  InitSensor(void)
+{
+  uint8 i;
+
+  for(i = 0; i < SENSOR_NUM; i++)
+  {
+    s_arrSensorState[i].lastMs = 0;
+    s_arrSensorState[i].value  = 0;
+    s_arrSensorState[i].valid  = 0;
+    s_arrSensorState[i].fresh  = 0;
+    s_arrSensorState[i].sent   = 0;
+    s_arrSensorState[i].window = s_arrSensorDef[i].window;
+    s_arrSensorState[i].alarmLow  = s_arrSensorDef[i].alarmLow;
+    s_arrSensorState[i].alarmHigh = s_arrSensorDef[i].alarmHigh;
+    s_arrSensorState[i].hasAdc = 0;
+    StatsReset(&s_arrSensorState[i].stats);
+    InitFilter(i);
+    SetSensorCal(s_arrSensorDef[i].id, &s_arrSensorDef[i].cal);
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：SetSensorCal
+* 函数功能：重新标定传感器，计算换算系数
+* 输入参数：id-传感器编号，pCal-标定参数
+* 输出参数：void
+* 返 回 值：1--成功，0--没有该传感器
+* 创建日期：2026年10月19日
+* 注    意：报警阈值按新的换算系数重新换算为读数
+*********************************************************************************************************/
+uint8 SetSensorCal(uint8 id, const StructSensorCal* pCal)
+{
+  uint8 i;
+
+  for(i = 0; i < SENSOR_NUM; i++)
+  {
+    if(s_arrSensorDef[i].id == id)
+    {
+      s_arrSensorCal[i] = *pCal;
+      if(s_arrSensorDef[i].conv == SENSOR_CONV_LINEAR)
+      {
+        CalcConv(pCal, &s_arrSensorState[i].conv);
+      }
+      ApplyAlarm(i);
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+/*********************************************************************************************************
+* 函数名称：SensorProc
+* 函数功能：按各传感器的采样周期采样并换算
+* 输入参数：smpNow-1--节点的采样时刻到了，periodMs为0的传感器此时采样
+* 输出参数：void
+* 返 回 值：1--有统计窗口结束，应立即打包上报，0--没有
+* 创建日期：2026年10月19日
+* 注    意：在2ms任务中调用；没有滤波链时一次采样取通道缓冲区中全部读数的平均值，有滤波链时取最近一个滤波后的读数；
+*           设置了统计窗口的传感器每次调用都把全部读数加入窗口，不按采样周期采样
+*********************************************************************************************************/
+uint8 SensorProc(uint8 smpNow)
+{
+  const StructSensorDef* pDef;
+  StructSensorState*     pState;
+  uint32 now   = millis();
+  uint16 adc;
+  uint8  ready = 0;  //1--有统计窗口结束
+  uint8  due;        //1--该采样了
+  uint8  i;
+
+  for(i = 0; i < SENSOR_NUM; i++)
+  {
+    pDef   = &s_arrSensorDef[i];
+    pState = &s_arrSensorState[i];
+
+    if(pState->window > 0 || pState->filter.num > 0)
+    {
+      ready |= ProcStream(i);
+      if(pState->window > 0)
+      {
+        continue;
+      }
+    }
+
+    if(pDef->periodMs == 0)
+    {
+      due = smpNow;
+    }
+    else
+    {
+      due = (now - pState->lastMs >= pDef->periodMs);
+    }
+
+    if(due)
+    {
+      pState->lastMs = now;
+      if(pState->filter.num > 0)
+      {
+        if(pState->hasAdc)
+        {
+          pState->hasAdc = 0;
+          UpdateValue(i, Convert(i, pState->lastAdc));
+        }
+      }
+      else if(ReadMean(pDef->adcCh, &adc))
+      {
+        UpdateValue(i, Convert(i, adc));
+      }
+    }
+  }
+
+  return ready;
+}
+
+/*********************************************************************************************************
+* 函数名称：SensorPack
+* 函数功能：把上次打包之后采到、且需要上报的数值和结束的统计窗口打包
+* 输入参数：size-pBuf的长度
+* 输出参数：pBuf-打包结果，[传感器个数n][编号 格式 数值高 数值低]或[统计记录] * n
+* 返 回 值：打包的长度，0--没有需要上报的数值
+* 创建日期：2026年10月19日
+* 注    意：放不下的传感器留到下次打包；没有超过死区、也没到心跳间隔的新数值直接丢弃
+*********************************************************************************************************/
+uint8 SensorPack(uint8* pBuf, uint8 size)
+{
+  StructSensorState* pState;
+  uint32 now = millis();
+  uint8* p   = &pBuf[1];
+  uint8  num = 0;  //打包的传感器个数
+  uint8  i;
+
+  for(i = 0; i < SENSOR_NUM; i++)
+  {
+    pState = &s_arrSensorState[i];
+    if(!pState->fresh)
+    {
+      continue;
+    }
+    if(pState->window > 0)
+    {
+      if(p + SENSOR_STATS_LEN > pBuf + size)
+      {
+        continue;
+      }
+      p += PackStats(&s_arrSensorDef[i], &pState->done, p);
+      num++;
+      pState->fresh = 0;
+      continue;
+    }
+    if(p + SENSOR_ENTRY_LEN > pBuf + size)
+    {
+      continue;
+    }
+    pState->fresh = 0;
+    if(!NeedReport(i, now))
+    {
+      continue;
+    }
+    p[0] = s_arrSensorDef[i].id;
+    p[1] = s_arrSensorDef[i].format;
+    p[2] = HIBYTE(pState->value);
+    p[3] = LOBYTE(pState->value);
+    p += SENSOR_ENTRY_LEN;
+    num++;
+    pState->sentVal = pState->value;
+    pState->sentMs  = now;
+    pState->sent    = 1;
+  }
+
+  if(num == 0)
+  {
+    return 0;
+  }
+
+  pBuf[0] = num;
+  return (uint8)(p - pBuf);
+}
+
+/*********************************************************************************************************
+* 函数名称：SetSensorWindow
+* 函数功能：设置统计窗口
+* 输入参数：id-传感器编号，num-窗口的读数个数，0--上报原始数值
+* 输出参数：void
+* 返 回 值：1--成功，0--没有该传感器
+* 创建日期：2026年10月19日
+* 注    意：丢弃当前窗口已累加的读数，从下一个读数开始新的窗口
+*********************************************************************************************************/
+uint8 SetSensorWindow(uint8 id, uint16 num)
+{
+  uint8 i;
+
+  for(i = 0; i < SENSOR_NUM; i++)
+  {
+    if(s_arrSensorDef[i].id == id)
+    {
+      s_arrSensorState[i].window = num;
+      s_arrSensorState[i].fresh  = 0;
+      StatsReset(&s_arrSensorState[i].stats);
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+/*********************************************************************************************************
+* 函数名称：SensorFind
+* 函数功能：按编号查找登记表
+* 输入参数：id-传感器编号
+* 输出参数：void
+* 返 回 值：登记表项，没有返回NULL
+* 创建日期：2026年10月19日
+* 注    意：汇聚节点据此得到属性名
+*********************************************************************************************************/
+const StructSensorDef* SensorFind(uint8 id)
+{
+  uint8 i;
+
+  for(i = 0; i < SENSOR_NUM; i++)
+  {
+    if(s_arrSensorDef[i].id == id)
+    {
+      return &s_arrSensorDef[i];
+    }
+  }
+
+  return NULL;
+}
+
+/*********************************************************************************************************
+* 函数名称：SetSensorAlarm
+* 函数功能：设置报警阈值
+* 输入参数：id-传感器编号，low-下限，high-上限，与数值同单位，low >= high时关闭报警
+* 输出参数：void
+* 返 回 值：1--成功，0--没有该传感器
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+uint8 SetSensorAlarm(uint8 id, int16 low, int16 high)
+{
+  uint8 i;
+
+  for(i = 0; i < SENSOR_NUM; i++)
+  {
+    if(s_arrSensorDef[i].id == id)
+    {
+      s_arrSensorState[i].alarmLow  = low;
+      s_arrSensorState[i].alarmHigh = high;
+      ApplyAlarm(i);
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+/*********************************************************************************************************
+* 函数名称：SensorAlarm
+* 函数功能：取出一个越限事件，换算为数值打包为报警记录
+* 输入参数：size-pBuf的长度
+* 输出参数：pBuf-报警记录，[编号 格式 方向 数值高 数值低]
+* 返 回 值：打包的长度，0--没有事件
+* 创建日期：2026年10月19日
+* 注    意：在主循环中调用；没有登记传感器的通道的事件直接丢弃
+*********************************************************************************************************/
+uint8 SensorAlarm(uint8* pBuf, uint8 size)
+{
+  StructADCAlarm alarm;
+  int16 value;
+  uint8 i;
+
+  if(size < SENSOR_ALARM_LEN)
+  {
+    return 0;
+  }
+
+  while(ReadADCAlarm(&alarm))
+  {
+    for(i = 0; i < SENSOR_NUM; i++)
+    {
+      if(s_arrSensorDef[i].adcCh == alarm.ch)
+      {
+        value   = Convert(i, alarm.adc);
+        pBuf[0] = s_arrSensorDef[i].id;
+        pBuf[1] = s_arrSensorDef[i].format;
+        pBuf[2] = IsFalling(i) ? !alarm.above : alarm.above;
+        pBuf[3] = HIBYTE(value);
+        pBuf[4] = LOBYTE(value);
+        return SENSOR_ALARM_LEN;
+      }
+    }
+  }
+
+  return 0;
+}
+
+/*********************************************************************************************************
+* 函数名称：SensorActivity
+* 函数功能：查询信号是否活跃
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：1--上次查询之后有传感器相邻两次采样之差超过死区，0--信号平稳
+* 创建日期：2026年10月19日
+* 注    意：查询后清除，在节点的采样时刻调用
+*********************************************************************************************************/
+uint8 SensorActivity(void)
+{
+  uint8 active = s_iActive;
+
+  s_iActive = 0;
+  return active;
+}
+
+/*********************************************************************************************************
+* 函数名称：SensorFilter
+* 函数功能：返回传感器的滤波链
+* 输入参数：id-传感器编号
+* 输出参数：void
+* 返 回 值：滤波链，没有该传感器返回NULL
+* 创建日期：2026年10月19日
+* 注    意：在主循环中用FilterInit、FilterAdd*重新配置，滤波链为空时恢复为取缓冲区平均
+*********************************************************************************************************/
+StructFilterChain* SensorFilter(uint8 id)
+{
+  uint8 i;
+
+  for(i = 0; i < SENSOR_NUM; i++)
+  {
+    if(s_arrSensorDef[i].id == id)
+    {
+      return &s_arrSensorState[i].filter;
+    }
+  }
+
+  return NULL;
+}
+
+/*********************************************************************************************************
+* 函数名称：SetReportDeadband
+* 函数功能：设置上报死区
+* 输入参数：steps-死区，单位为各传感器登记的dbUnit，0--数值有变化就上报
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：由TYPE_SYS命令CMD_SET_DEADBAND设置
+*********************************************************************************************************/
+void  SetReportDeadband(uint8 steps)
+{
+  s_iDeadband = steps;
+}
+
+/*********************************************************************************************************
+* 函数名称：SetReportHeartbeat
+* 函数功能：设置心跳间隔
+* 输入参数：minutes-心跳间隔(分钟)，0--只在超过死区时上报
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：由TYPE_SYS命令CMD_SET_HEARTBEAT设置；心跳保证父结点和云端能确认节点仍在线
+*********************************************************************************************************/
+void  SetReportHeartbeat(uint8 minutes)
+{
+  s_iHeartbeat = (uint32)minutes * 60000UL;
+}
+
+#if (defined SENSOR_BENCH) && (SENSOR_BENCH == TRUE)
+/*********************************************************************************************************
+* 函数名称：SensorBench
+* 函数功能：比较各传感器定点换算与浮点换算的周期数和误差
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：用DWT周期计数器计时，每个传感器依次换算全部ADC_FULL_SCALE个读数，结果包含函数调用开销，由debug输出；
+*           误差为两者结果之差的最大绝对值，单位为数值的最小单位；在InitSoftware之后调用一次
+*********************************************************************************************************/
+void  SensorBench(void)
+{
+  volatile int16 sink;  //防止换算被优化掉
+  uint32 fixCycles;
+  uint32 fltCycles;
+  int32  err;
+  int32  errMax;
+  uint16 adc;
+  uint8  i;
+
+  DEMCR      |= 1UL << 24;  //TRCENA
+  DWT_CYCCNT  = 0;
+  DWT_CTRL   |= 1UL;        //CYCCNTENA
+
+  for(i = 0; i < SENSOR_NUM; i++)
+  {
+    fixCycles = DWT_CYCCNT;
+    for(adc = 0; adc < ADC_FULL_SCALE; adc++)
+    {
+      sink = Convert(i, adc);
+    }
+    fixCycles = DWT_CYCCNT - fixCycles;
+
+    fltCycles = DWT_CYCCNT;
+    for(adc = 0; adc < ADC_FULL_SCALE; adc++)
+    {
+      sink = ConvertFloat(i, adc);
+    }
+    fltCycles = DWT_CYCCNT - fltCycles;
+
+    errMax = 0;
+    for(adc = 0; adc < ADC_FULL_SCALE; adc++)
+    {
+      err = (int32)Convert(i, adc) - ConvertFloat(i, adc);
+      if(err < 0)
+      {
+        err = -err;
+      }
+      if(err > errMax)
+      {
+        errMax = err;
+      }
+    }
+
+    debug("SensorBench %d: fixed %d, float %d cycles/conv, max err %d\r\n", s_arrSensorDef[i].id,
+          (int)(fixCycles / ADC_FULL_SCALE), (int)(fltCycles / ADC_FULL_SCALE), (int)errMax);
+  }
+  (void)sink;
+}
+#endif
@@ -0,0 +1,126 @@
+/*********************************************************************************************************
+* 模块名称：Sensor.h
+* 摘    要：传感器模块，按传感器登记表采样、用定点整数换算并打包上报
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：登记表每项描述一个传感器：编号、ADC通道、换算方式、标定参数、采样周期和上报格式；
+*           增加传感器只需在Sensor.c的登记表中加一项，不用修改Proc2msTask；
+*           线性传感器由标定参数预先算出偏移和定点增益，换算时只用一次整数乘法和移位；
+*           上报策略：数值与上次上报的值相差超过死区，或距上次上报超过心跳间隔时才上报；
+*           设置了统计窗口的传感器不上报原始数值，每个窗口的读数汇总为一条统计记录(均值、最小、最大、标准差、个数)；
+*           报警阈值换算为ADC读数交给ADC模块比较，越限事件由SensorAlarm换算回数值打包；
+*           跟随节点采样周期的传感器相邻两次采样之差超过死区时记为信号活跃，供采样周期自适应；
+*           设置了滤波链的传感器每次都按块读出全部读数，经Q15滤波后再采样或统计，不再取缓冲区平均
+* 注    意：Cortex-M3没有FPU，运行时避免float/double运算；一个ADC通道只能登记给一个传感器
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+#ifndef _SENSOR_H_
+#define _SENSOR_H_
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "DataType.h"
+#include "Filter.h"
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#define SENSOR_MAX_SHIFT  20  //定点增益的最大小数位数
+#define SENSOR_ENTRY_LEN  4   //上报时每个传感器占的字节数：编号、格式、数值高字节、数值低字节
+#define SENSOR_STATS_LEN  12  //统计记录占的字节数：编号、格式、均值、最小值、最大值、标准差、读数个数，后五项各2字节
+#define SENSOR_FMT_STATS  0x80  //格式的最高位为1表示统计记录，低位仍为EnumSensorFormat
+#define SENSOR_ALARM_LEN  5   //报警记录的字节数：编号、格式、方向(1--高于上限，0--低于下限)、数值高字节、数值低字节
+#define SENSOR_BLOCK_LEN  16  //按块滤波时每块的读数个数
+
+#define SENSOR_DEADBAND_DEF   2   //默认死区，单位为各传感器登记的dbUnit
+#define SENSOR_HEARTBEAT_DEF  15  //默认心跳间隔(分钟)，超过这么久没有上报时不管变化多少都上报一次
+
+//芯片内部传感器的典型参数，见STM32F103数据手册
+#define SENSOR_V25_UV      1430000  //温度传感器25℃时的输出电压(uV)
+#define SENSOR_SLOPE_UV    (-4300)  //温度传感器每升高1℃输出电压的变化(uV)
+#define SENSOR_VREF_UV     3300000  //ADC参考电压(uV)
+#define SENSOR_VREFINT_UV  1200000  //内部参考电压(uV)
+
+#define SENSOR_BENCH FALSE  //TRUE--编译SensorBench，用DWT周期计数器比较定点换算与浮点换算的周期数和误差
+
+/*********************************************************************************************************
+*                                              枚举结构体定义
+*********************************************************************************************************/
+//传感器编号，上报时标识数据
+typedef enum
+{
+  SENSOR_ID_TEMP = 0x00,  //芯片温度(0.01℃)
+  SENSOR_ID_VDD  = 0x01,  //供电电压(mV)
+  SENSOR_ID_AIN1 = 0x02,  //外部模拟输入电压(mV)
+}EnumSensorId;
+
+//换算方式
+typedef enum
+{
+  SENSOR_CONV_LINEAR = 0x00,  //数值与输入电压成线性关系，由标定参数换算
+  SENSOR_CONV_SUPPLY = 0x01,  //读数为内部参考电压，换算为供电电压(mV)：VDDA = Vrefint * 满量程 / 读数
+}EnumSensorConv;
+
+//上报格式，数值都是int16，高字节在前
+typedef enum
+{
+  SENSOR_FMT_INT   = 0x00,  //数值即为结果
+  SENSOR_FMT_CENTI = 0x01,  //数值为结果的100倍
+}EnumSensorFormat;
+
+//标定参数，线性换算时：数值 = refVal + scale * (电压 - refUV) / slopeUV；
+//SENSOR_CONV_SUPPLY只使用refUV(内部参考电压)和bits
+typedef struct
+{
+  int32  refUV;     //标定点的输入电压(uV)
+  int16  refVal;    //标定点的数值
+  int32  slopeUV;   //数值每变化scale时输入电压的变化(uV)，电压随数值增大而下降时为负
+  int16  scale;     //slopeUV对应的数值变化量
+  uint32 vrefUV;    //ADC参考电压(uV)
+  uint8  bits;      //ADC读数的位数
+}StructSensorCal;
+
+//登记表的一项
+typedef struct
+{
+  uint8           id;        //传感器编号，EnumSensorId
+  uint8           adcCh;     //ADC通道，EnumADCChannel
+  uint8           conv;      //换算方式，EnumSensorConv
+  uint8           format;    //上报格式，EnumSensorFormat
+  int16           dbUnit;    //死区的单位，与数值同单位，死区 = 节点的死区设置 * dbUnit
+  uint32          periodMs;  //采样周期(ms)，0表示跟随节点的采样周期
+  uint16          window;    //统计窗口的读数个数，0表示上报原始数值；读数每ADC_SMP_US * ADC_OVS_NUM产生一个
+  int16           alarmLow;  //报警下限，与数值同单位
+  int16           alarmHigh; //报警上限，alarmLow >= alarmHigh表示不报警
+  const char*     name;      //汇聚节点上报云端时的属性名
+  StructSensorCal cal;       //默认标定参数
+}StructSensorDef;
+
+/*********************************************************************************************************
+*                                              API函数声明
+*********************************************************************************************************/
+void  InitSensor(void);                                   //初始化Sensor模块，按登记表的默认标定参数计算换算系数
+uint8 SetSensorCal(uint8 id, const StructSensorCal* pCal);//重新标定id传感器，1--成功，0--没有该传感器
+uint8 SensorProc(uint8 smpNow);                           //按各传感器的采样周期采样换算，smpNow-1--节点的采样时刻到了，返回1--有统计窗口结束
+uint8 SensorPack(uint8* pBuf, uint8 size);                //把上次打包之后采到的数值和统计记录打包，返回长度，0--没有新数值
+uint8 SetSensorWindow(uint8 id, uint16 num);              //设置id传感器的统计窗口，num为0时上报原始数值，1--成功
+uint8 SetSensorAlarm(uint8 id, int16 low, int16 high);    //设置id传感器的报警阈值，low >= high时关闭报警，1--成功
+uint8 SensorAlarm(uint8* pBuf, uint8 size);               //取出一个越限事件打包为报警记录，返回长度，0--没有事件
+uint8 SensorActivity(void);                               //1--上次查询之后有传感器相邻两次采样之差超过死区
+StructFilterChain* SensorFilter(uint8 id);                //返回id传感器的滤波链，用FilterInit、FilterAdd*重新配置，没有返回NULL
+const StructSensorDef* SensorFind(uint8 id);              //按编号查找登记表，没有返回NULL
+void  SetReportDeadband(uint8 steps);                     //设置上报死区，单位为各传感器的dbUnit，0--数值有变化就上报
+void  SetReportHeartbeat(uint8 minutes);                  //设置心跳间隔(分钟)，0--只在超过死区时上报
+
+#if (defined SENSOR_BENCH) && (SENSOR_BENCH == TRUE)
+void  SensorBench(void);                                  //比较各传感器定点换算与浮点换算的周期数和误差，结果由debug输出
+#endif
+
+#endif
@@ -0,0 +1,467 @@
+/*********************************************************************************************************
+* 模块名称：Vibration.c
+* 摘    要：振动监测模块，定时捕获一段高速采样，FFT提取频带能量、峰值频率、有效值和峰值因数，只发送特征
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：幅值换算：N点汉宁窗的功率增益为3/8，单边谱的有效值平方 = 16 * sum(|X[k]|^2) / (3 * N^2)，
+*           频带有效值按此对频带内的频点求和；正弦分量的幅值为有效值的sqrt(2)倍，对峰值两侧VIB_PEAK_BINS个
+*           频点求和，不受频率落在两个频点之间的影响；
+*           峰值频率：汉宁窗下用相邻三个频点的模插值，delta = 2 * (m[k+1] - m[k-1]) / (m[k-1] + 2 * m[k] + m[k+1])，
+*           对纯正弦是精确的
+* 注    意：
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "Vibration.h"
+#include "ADC.h"
+#include "Fft.h"
+#include "Stats.h"
+#include "Timer.h"
+#include "RADIO.h"
+#include "PackUnpack.h"
+#include "SendDataToHost.h"
+#include <string.h>
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#define VIB_DELTA_FRAC  8   //峰值频率插值的小数位数
+
+/*********************************************************************************************************
+*                                              枚举结构体定义
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              内部变量
+*********************************************************************************************************/
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+#else
+static uint16 s_arrVibBuf[1 << VIB_LOG2N];  //捕获的采样，分析时就地改写为FFT结果
+static uint8  s_iPeriod;                    //捕获周期(s)，0--不捕获
+static uint32 s_iLastMs;                    //上次开始捕获的时刻(ms)
+static uint8  s_iCapturing;                 //1--正在捕获
+static uint16 s_iRate;                      //本次捕获的实际采样率(Hz)
+static uint8  s_iSeq;                       //下一个特征分组的序号
+#endif
+
+/*********************************************************************************************************
+*                                              内部函数声明
+*********************************************************************************************************/
+static uint16 ScaleExp(uint32 v, int8 shift);                                  //v * 2^shift，四舍五入并饱和到uint16
+static uint16 BandRms(const int16* pSpec, uint16 lo, uint16 hi, int8 shift, uint8 sine); //lo ~ hi频点的有效值或正弦幅值
+static uint16 PeakHz(const int16* pSpec, uint16 k, uint8 log2N, uint16 rate);  //插值求k附近谱峰的频率(0.1Hz)
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+#else
+static uint8  VibPack(const StructVibFeature* pFeat, uint8* pBuf);             //打包特征分组
+#endif
+
+/*********************************************************************************************************
+*                                              内部函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：ScaleExp
+* 函数功能：按块浮点指数缩放
+* 输入参数：v-数值，shift-左移的位数，为负时右移
+* 输出参数：void
+* 返 回 值：v * 2^shift，四舍五入，超过65535时为65535
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static uint16 ScaleExp(uint32 v, int8 shift)
+{
+  if(shift < 0)
+  {
+    if(shift <= -32)
+    {
+      return 0;
+    }
+    v = (v + (1UL << (-shift - 1))) >> (-shift);
+  }
+  else if(v != 0)
+  {
+    if(shift >= 16 || v > (0xFFFFUL >> shift))
+    {
+      return 0xFFFF;
+    }
+    v <<= shift;
+  }
+
+  return (v > 0xFFFF) ? 0xFFFF : (uint16)v;
+}
+
+/*********************************************************************************************************
+* 函数名称：BandRms
+* 函数功能：求lo ~ hi频点的有效值，或其中正弦分量的幅值
+* 输入参数：pSpec-FftReal的输出，lo、hi-频点范围，1 ~ N/2 - 1，shift-块浮点指数 - log2N，
+*           sine-1--按正弦分量求幅值，0--求有效值
+* 输出参数：void
+* 返 回 值：ADC_RESULT_BITS位读数的单位
+* 创建日期：2026年10月19日
+* 注    意：有效值 = sqrt(16 / 3 * sum) * 2^指数 / N，幅值再乘sqrt(2)，sum为各频点模的平方之和
+*********************************************************************************************************/
+static uint16 BandRms(const int16* pSpec, uint16 lo, uint16 hi, int8 shift, uint8 sine)
+{
+  unsigned long long sum = 0;
+  uint16 k;
+
+  for(k = lo; k <= hi; k++)
+  {
+    sum += FftPower(pSpec, k);
+  }
+
+  return ScaleExp(Sqrt64(sum * (sine ? 32 : 16) / 3), shift);
+}
+
+/*********************************************************************************************************
+* 函数名称：PeakHz
+* 函数功能：用相邻三个频点的模插值求谱峰的频率
+* 输入参数：pSpec-FftReal的输出，k-局部最大的频点，2 ~ N/2 - 2，log2N-点数，rate-采样率(Hz)
+* 输出参数：void
+* 返 回 值：频率(0.1Hz)
+* 创建日期：2026年10月19日
+* 注    意：插值结果限制在k两侧半个频点以内
+*********************************************************************************************************/
+static uint16 PeakHz(const int16* pSpec, uint16 k, uint8 log2N, uint16 rate)
+{
+  int32 a = (int32)Sqrt64(FftPower(pSpec, k - 1));
+  int32 b = (int32)Sqrt64(FftPower(pSpec, k));
+  int32 c = (int32)Sqrt64(FftPower(pSpec, k + 1));
+  int32 den = a + 2 * b + c;
+  int32 delta = 0;  //偏移的频点数，VIB_DELTA_FRAC位小数
+
+  if(den > 0)
+  {
+    delta = (2 * (c - a) * (1 << VIB_DELTA_FRAC)) / den;
+  }
+  if(delta > (1 << (VIB_DELTA_FRAC - 1)))
+  {
+    delta = 1 << (VIB_DELTA_FRAC - 1);
+  }
+  if(delta < -(1 << (VIB_DELTA_FRAC - 1)))
+  {
+    delta = -(1 << (VIB_DELTA_FRAC - 1));
+  }
+
+  return (uint16)((((unsigned long long)(((int32)k << VIB_DELTA_FRAC) + delta)) * rate * 10
+                   + (1UL << (log2N + VIB_DELTA_FRAC - 1))) >> (log2N + VIB_DELTA_FRAC));
+}
+
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+#else
+/*********************************************************************************************************
+* 函数名称：VibPack
+* 函数功能：打包特征分组
+* 输入参数：pFeat-特征
+* 输出参数：pBuf-特征分组，长度不小于DATALEN
+* 返 回 值：特征分组的长度
+* 创建日期：2026年10月19日
+* 注    意：格式见VibUnpack
+*********************************************************************************************************/
+static uint8 VibPack(const StructVibFeature* pFeat, uint8* pBuf)
+{
+  uint8* p = pBuf;
+  uint8  i;
+
+  *p++ = HIBYTE(pFeat->addr);
+  *p++ = LOBYTE(pFeat->addr);
+  *p++ = pFeat->seq;
+  *p++ = pFeat->log2N;
+  *p++ = HIBYTE(pFeat->rate);
+  *p++ = LOBYTE(pFeat->rate);
+  *p++ = HIBYTE(pFeat->mean);
+  *p++ = LOBYTE(pFeat->mean);
+  *p++ = HIBYTE(pFeat->rms);
+  *p++ = LOBYTE(pFeat->rms);
+  *p++ = HIBYTE(pFeat->peak);
+  *p++ = LOBYTE(pFeat->peak);
+  *p++ = HIBYTE(pFeat->crest);
+  *p++ = LOBYTE(pFeat->crest);
+  *p++ = pFeat->peakNum;
+  for(i = 0; i < pFeat->peakNum; i++)
+  {
+    *p++ = HIBYTE(pFeat->arrPeakHz[i]);
+    *p++ = LOBYTE(pFeat->arrPeakHz[i]);
+    *p++ = HIBYTE(pFeat->arrPeakAmp[i]);
+    *p++ = LOBYTE(pFeat->arrPeakAmp[i]);
+  }
+  *p++ = pFeat->bandNum;
+  for(i = 0; i < pFeat->bandNum; i++)
+  {
+    *p++ = HIBYTE(pFeat->arrBandHz[i]);
+    *p++ = LOBYTE(pFeat->arrBandHz[i]);
+    *p++ = HIBYTE(pFeat->arrBandRms[i]);
+    *p++ = LOBYTE(pFeat->arrBandRms[i]);
+  }
+
+  return (uint8)(p - pBuf);
+}
+#endif
+
+/*********************************************************************************************************
+*                                              API函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：InitVibration
+* 函数功能：初始化Vibration模块
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+void InitVibration(void)
+{
+  SetVibPeriod(VIB_PERIOD_DEF);
+}
+
+/*********************************************************************************************************
+* 函数名称：SetVibPeriod
+* 函数功能：设置捕获周期
+* 输入参数：sec-捕获周期(s)，0--停止
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：正在进行的捕获放弃，从现在起一个周期后开始下一次捕获；汇聚节点不捕获
+*********************************************************************************************************/
+void SetVibPeriod(uint8 sec)
+{
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+#else
+  if(s_iCapturing)
+  {
+    StopADCCapture();
+    s_iCapturing = 0;
+  }
+  s_iPeriod = sec;
+  s_iLastMs = millis();
+#endif
+}
+
+/*********************************************************************************************************
+* 函数名称：VibProc
+* 函数功能：到周期时启动捕获，捕获完成后提取特征并发给父结点
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：在2ms任务中调用；分析在捕获完成后的那次调用中一次做完，1024点约占用一个2ms周期
+*********************************************************************************************************/
+void VibProc(void)
+{
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+#else
+  StructVibFeature feat;
+  uint8 arrPack[DATALEN];
+
+  if(s_iPeriod == 0)
+  {
+    return;
+  }
+
+  if(!s_iCapturing)
+  {
+    if(millis() - s_iLastMs >= (uint32)s_iPeriod * 1000)
+    {
+      s_iLastMs    = millis();
+      s_iRate      = StartADCCapture(VIB_CH, s_arrVibBuf, 1 << VIB_LOG2N, VIB_RATE);
+      s_iCapturing = (s_iRate != 0);
+    }
+    return;
+  }
+
+  if(!ADCCaptureDone())
+  {
+    return;
+  }
+  StopADCCapture();
+  s_iCapturing = 0;
+
+  if(VibAnalyze(s_arrVibBuf, VIB_LOG2N, s_iRate, &feat))
+  {
+    feat.addr = getAddress();
+    feat.seq  = s_iSeq++;
+    SendVibToParent(arrPack, VibPack(&feat, arrPack));
+  }
+#endif
+}
+
+/*********************************************************************************************************
+* 函数名称：VibAnalyze
+* 函数功能：从一段采样提取振动特征
+* 输入参数：pSmp-2^log2N个ADC_RESULT_BITS位采样，log2N-8 ~ FFT_LOG2N_MAX，rate-采样率(Hz)
+* 输出参数：pSmp-被改写为FFT结果，pFeat-特征，addr和seq由调用者填写
+* 返 回 值：1--成功，0--点数不支持
+* 创建日期：2026年10月19日
+* 注    意：去直流后的采样绝对值不超过满量程的一半，满足FftReal的输入要求；
+*           谱峰为局部最大的频点中模最大的VIB_PEAK_NUM个，不足时peakNum小于VIB_PEAK_NUM
+*********************************************************************************************************/
+uint8 VibAnalyze(uint16* pSmp, uint8 log2N, uint16 rate, StructVibFeature* pFeat)
+{
+  int16* pData = (int16*)pSmp;  //就地改写为去直流的采样，再改写为频谱
+  uint16 len   = 1 << log2N;
+  uint16 half  = len / 2;
+  uint32 arrPeakPow[VIB_PEAK_NUM];
+  uint16 arrPeakBin[VIB_PEAK_NUM];
+  unsigned long long sumSq = 0;
+  uint32 sum = 0;
+  uint32 pow0;
+  uint32 pow1;
+  uint32 pow2;
+  uint16 peak = 0;
+  uint16 lo;
+  uint16 hi;
+  uint16 k;
+  int16  d;
+  int8   exp;
+  uint8  i;
+  uint8  j;
+
+  if(log2N < 8 || log2N > FFT_LOG2N_MAX)
+  {
+    return 0;
+  }
+
+  //时域：均值、有效值、峰值
+  for(k = 0; k < len; k++)
+  {
+    sum += pSmp[k];
+  }
+  pFeat->mean = (uint16)((sum + (len >> 1)) >> log2N);
+  for(k = 0; k < len; k++)
+  {
+    d = (int16)(pSmp[k] - pFeat->mean);
+    pData[k] = d;
+    sumSq += (uint32)((int32)d * d);
+    if((uint16)((d < 0) ? -d : d) > peak)
+    {
+      peak = (uint16)((d < 0) ? -d : d);
+    }
+  }
+  pFeat->log2N = log2N;
+  pFeat->rate  = rate;
+  pFeat->rms   = (uint16)Sqrt64(sumSq >> log2N);
+  pFeat->peak  = peak;
+  pFeat->crest = (pFeat->rms == 0) ? 0 : (uint16)(((uint32)peak * 100 + pFeat->rms / 2) / pFeat->rms);
+
+  //频域
+  FftHann(pData, log2N);
+  exp = FftReal(pData, log2N);
+  exp = exp - (int8)log2N;
+
+  //频带，最后一个频带到N/2 - 1，不含直流和奈奎斯特频率
+  pFeat->bandNum = VIB_BAND_NUM;
+  for(i = 0; i < VIB_BAND_NUM; i++)
+  {
+    lo = (uint16)(((uint32)i * half) / VIB_BAND_NUM);
+    hi = (uint16)(((uint32)(i + 1) * half) / VIB_BAND_NUM) - 1;
+    if(lo < 1)
+    {
+      lo = 1;
+    }
+    pFeat->arrBandHz[i]  = (uint16)(((uint32)(i + 1) * rate) / (2 * VIB_BAND_NUM));
+    pFeat->arrBandRms[i] = BandRms(pData, lo, hi, exp, 0);
+  }
+
+  //谱峰：局部最大的频点按模的平方插入排序
+  pFeat->peakNum = 0;
+  pow0 = FftPower(pData, 1);
+  pow1 = FftPower(pData, 2);
+  for(k = 2; k < half - 1; k++)
+  {
+    pow2 = FftPower(pData, k + 1);
+    if(pow1 > pow0 && pow1 >= pow2)
+    {
+      for(i = pFeat->peakNum; i > 0 && arrPeakPow[i - 1] < pow1; i--)
+      {
+      }
+      if(i < VIB_PEAK_NUM)
+      {
+        j = (pFeat->peakNum < VIB_PEAK_NUM) ? pFeat->peakNum : VIB_PEAK_NUM - 1;
+        for(; j > i; j--)
+        {
+          arrPeakPow[j] = arrPeakPow[j - 1];
+          arrPeakBin[j] = arrPeakBin[j - 1];
+        }
+        arrPeakPow[i] = pow1;
+        arrPeakBin[i] = k;
+        if(pFeat->peakNum < VIB_PEAK_NUM)
+        {
+          pFeat->peakNum++;
+        }
+      }
+    }
+    pow0 = pow1;
+    pow1 = pow2;
+  }
+  for(i = 0; i < pFeat->peakNum; i++)
+  {
+    k  = arrPeakBin[i];
+    lo = (k > VIB_PEAK_BINS) ? k - VIB_PEAK_BINS : 1;
+    hi = (k + VIB_PEAK_BINS < half) ? k + VIB_PEAK_BINS : half - 1;
+    pFeat->arrPeakHz[i]  = PeakHz(pData, k, log2N, rate);
+    pFeat->arrPeakAmp[i] = BandRms(pData, lo, hi, exp, 1);
+  }
+
+  return 1;
+}
+
+/*********************************************************************************************************
+* 函数名称：VibUnpack
+* 函数功能：解包特征分组
+* 输入参数：pData-特征分组，DATALEN字节
+* 输出参数：pFeat-特征
+* 返 回 值：1--成功，0--格式错误
+* 创建日期：2026年10月19日
+* 注    意：特征分组格式：[0..1]源地址，[2]序号，[3]点数为2^n，[4..5]采样率(Hz)，[6..7]均值，[8..9]有效值，
+*           [10..11]峰值，[12..13]峰值因数*100，[14]谱峰个数P，随后P个谱峰：频率(0.1Hz)2、幅值2，
+*           再后频带个数B，随后B个频带：上限频率(Hz)2、有效值2；幅值为ADC_RESULT_BITS位读数的单位，
+*           多字节数高字节在前；VIB_PEAK_NUM为3、VIB_BAND_NUM为8时共60字节
+*********************************************************************************************************/
+uint8 VibUnpack(const uint8* pData, StructVibFeature* pFeat)
+{
+  const uint8* p = pData;
+  uint8 i;
+
+  pFeat->addr    = MAKEHWORD(p[0], p[1]);
+  pFeat->seq     = p[2];
+  pFeat->log2N   = p[3];
+  pFeat->rate    = MAKEHWORD(p[4], p[5]);
+  pFeat->mean    = MAKEHWORD(p[6], p[7]);
+  pFeat->rms     = MAKEHWORD(p[8], p[9]);
+  pFeat->peak    = MAKEHWORD(p[10], p[11]);
+  pFeat->crest   = MAKEHWORD(p[12], p[13]);
+  pFeat->peakNum = p[14];
+  if(pFeat->peakNum > VIB_PEAK_NUM)
+  {
+    return 0;
+  }
+  p += VIB_HEAD_LEN;
+  for(i = 0; i < pFeat->peakNum; i++)
+  {
+    pFeat->arrPeakHz[i]  = MAKEHWORD(p[0], p[1]);
+    pFeat->arrPeakAmp[i] = MAKEHWORD(p[2], p[3]);
+    p += VIB_PEAK_LEN;
+  }
+  pFeat->bandNum = *p++;
+  if(pFeat->bandNum > VIB_BAND_NUM || (p - pData) + pFeat->bandNum * VIB_BAND_LEN > DATALEN)
+  {
+    return 0;
+  }
+  for(i = 0; i < pFeat->bandNum; i++)
+  {
+    pFeat->arrBandHz[i]  = MAKEHWORD(p[0], p[1]);
+    pFeat->arrBandRms[i] = MAKEHWORD(p[2], p[3]);
+    p += VIB_BAND_LEN;
+  }
+
+  return 1;
+}
@@ -0,0 +1,74 @@
+/*********************************************************************************************************
+* 模块名称：Vibration.h
+* 摘    要：振动监测模块，定时捕获一段高速采样，FFT提取频带能量、峰值频率、有效值和峰值因数，只发送特征
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：节点：每隔设定的周期用ADC捕获VIB_CH通道2^VIB_LOG2N个原始采样，捕获期间不占CPU；
+*           捕获完成后去直流求有效值和峰值，加汉宁窗做实数FFT，按频带累加功率，找出最大的VIB_PEAK_NUM个谱峰，
+*           打包成一个特征分组发给父结点；1024点8kHz时一次捕获128ms，分析约2.5ms(估算，实测见FftBench)；
+*           RAM：捕获和FFT共用2^VIB_LOG2N个uint16，1024点为2KB，分析时栈上另用约100字节；
+*           汇聚节点：解包后上报云端
+* 注    意：输入端需要抗混叠滤波，截止频率低于采样率的一半；特征分组格式见VibUnpack
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+#ifndef _VIBRATION_H_
+#define _VIBRATION_H_
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "DataType.h"
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#define VIB_CH          ADC_CH_AIN1       //振动传感器的ADC通道
+#define VIB_LOG2N       10                //每次捕获2^n个采样，8 ~ FFT_LOG2N_MAX，即256 ~ 1024点
+#define VIB_RATE        ADC_CAP_RATE_MAX  //期望的采样率(Hz)，实际为ADC_CAP_RATE_MAX / 2^n中不超过它的最大者
+#define VIB_PERIOD_DEF  0                 //默认的捕获周期(s)，0--不捕获，由CMD_SET_VIB_PRD打开
+
+#define VIB_PEAK_NUM    3     //每次上报的谱峰个数
+#define VIB_PEAK_BINS   2     //谱峰幅值累加峰值两侧各这么多个频点，即汉宁窗主瓣，不受频点偏移影响
+#define VIB_BAND_NUM    8     //0 ~ 采样率/2等分为这么多个频带
+#define VIB_HEAD_LEN    15    //特征分组头部：地址2、序号、点数、采样率2、均值2、有效值2、峰值2、峰值因数2、谱峰个数
+#define VIB_PEAK_LEN    4     //每个谱峰：频率(0.1Hz)2、幅值2
+#define VIB_BAND_LEN    4     //每个频带：上限频率(Hz)2、有效值2
+
+/*********************************************************************************************************
+*                                              枚举结构体定义
+*********************************************************************************************************/
+//一次捕获的特征，幅值都是ADC_RESULT_BITS位读数的单位
+typedef struct
+{
+  uint16 addr;                        //源节点地址
+  uint8  seq;                         //序号，每次捕获加1
+  uint8  log2N;                       //点数为2^log2N
+  uint16 rate;                        //采样率(Hz)
+  uint16 mean;                        //均值，即直流分量
+  uint16 rms;                         //去直流后的有效值
+  uint16 peak;                        //去直流后的最大绝对值
+  uint16 crest;                       //峰值因数 * 100，即peak / rms
+  uint8  peakNum;                     //谱峰个数
+  uint16 arrPeakHz[VIB_PEAK_NUM];     //谱峰频率(0.1Hz)，按幅值从大到小
+  uint16 arrPeakAmp[VIB_PEAK_NUM];    //谱峰幅值，即该频率正弦分量的幅值
+  uint8  bandNum;                     //频带个数
+  uint16 arrBandHz[VIB_BAND_NUM];     //频带上限频率(Hz)，下限为前一个频带的上限
+  uint16 arrBandRms[VIB_BAND_NUM];    //频带内的有效值
+}StructVibFeature;
+
+/*********************************************************************************************************
+*                                              API函数声明
+*********************************************************************************************************/
+void  InitVibration(void);                                  //初始化Vibration模块
+void  SetVibPeriod(uint8 sec);                              //设置捕获周期(s)，0--停止
+void  VibProc(void);                                        //启动捕获、分析并发送特征，在2ms任务中调用
+uint8 VibAnalyze(uint16* pSmp, uint8 log2N, uint16 rate, StructVibFeature* pFeat);  //从采样提取特征，pSmp被改写，1--成功
+uint8 VibUnpack(const uint8* pData, StructVibFeature* pFeat);  //解包特征分组，1--成功
+
+#endif
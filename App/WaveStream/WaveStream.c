@@ -0,0 +1,668 @@
+/*********************************************************************************************************
+* 模块名称：WaveStream.c
+* 摘    要：波形流模块，250~500Hz单通道波形按块采集、差分变位宽压缩、带块序号发送，汇聚节点解包并发现丢块
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：
+* 注    意：
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "WaveStream.h"
+#include "ADC.h"
+#include "Timer.h"
+#include "Route.h"
+#include "RADIO.h"
+#include "PackUnpack.h"
+#include "SendDataToHost.h"
+#include <string.h>
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#define WAVE_PAYLOAD_BITS  ((DATALEN - WAVE_HEAD_LEN) * 8)    //数据块中差值部分的位数
+#define WAVE_PEND_NUM      (2 * WAVE_SMP_MAX)                 //待压缩读数的缓冲区大小
+#define WAVE_TOKEN_PKT     ((uint32)ROUTE_PKT_AIR_BYTES * 1000)  //发送一包消耗的令牌，令牌以1/1000空中字节计
+
+/*********************************************************************************************************
+*                                              枚举结构体定义
+*********************************************************************************************************/
+//汇聚节点跟踪的波形流
+typedef struct
+{
+  uint16 addr;  //源节点地址
+  uint16 next;  //下一个期望的块序号
+  uint8  used;  //1--已占用
+}StructWaveSrc;
+
+/*********************************************************************************************************
+*                                              内部变量
+*********************************************************************************************************/
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+static StructWaveSrc s_arrWaveSrc[WAVE_SRC_MAX];  //跟踪的波形流
+static uint8  s_iSrcVictim;                      //表满时下一个被替换的表项
+#else
+static uint16 s_iRate;                           //当前采样率(Hz)，0--没有波形流
+static uint16 s_iLoad;                           //预留的负载(字节/秒)
+static uint16 s_iSeq;                            //下一块的序号，重新开始时不清零，汇聚节点不会误判丢块
+static uint8  s_iBlockNum;                       //攒够这么多读数就发出，即WAVE_BLOCK_MS的读数
+static uint16 s_arrPend[WAVE_PEND_NUM];          //待压缩的读数
+static uint16 s_iPendNum;
+static uint16 s_iTryNum;                         //上次试压缩时的读数个数
+static uint32 s_iLostMark;                       //上次检查时ADC波形流丢弃的读数个数
+static uint8  s_arrTxQue[WAVE_TXQ_NUM][DATALEN]; //等待令牌的数据块
+static uint8  s_arrTxLen[WAVE_TXQ_NUM];
+static uint8  s_iTxHead;
+static uint8  s_iTxNum;
+static uint32 s_iTokens;                         //令牌，1/1000空中字节
+static uint32 s_iTokenMs;                        //上次补充令牌的时刻(ms)
+#endif
+
+/*********************************************************************************************************
+*                                              内部函数声明
+*********************************************************************************************************/
+static uint8  BitWidth(uint16 z);                                  //z的有效位数
+static void   PutBits(uint8* pBuf, uint16* pPos, uint16 v, uint8 n); //写入n位，高位在前
+static uint16 GetBits(const uint8* pBuf, uint16* pPos, uint8 n);     //读出n位，高位在前
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+#else
+static uint16 ZigZag(uint16 cur, uint16 prev);     //差值zigzag编码
+static uint8  EncodeBlock(uint8* pOut, uint8* pLen); //压缩待压缩读数的开头一块
+static void   PushBlock(uint8 num, uint8* pBlock, uint8 len); //数据块放入发送队列，读数移出
+static void   FlushPend(void);                      //待压缩的读数全部压缩发出
+static void   SendTask(void);                       //按令牌发送队列中的数据块
+#endif
+
+/*********************************************************************************************************
+*                                              内部函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：BitWidth
+* 函数功能：计算z的有效位数
+* 输入参数：z-无符号数
+* 输出参数：void
+* 返 回 值：有效位数，z为0时为0
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static uint8 BitWidth(uint16 z)
+{
+  uint8 w = 0;
+
+  while(z != 0)
+  {
+    w++;
+    z >>= 1;
+  }
+  return w;
+}
+
+/*********************************************************************************************************
+* 函数名称：PutBits
+* 函数功能：在位流中写入n位
+* 输入参数：pBuf-位流，已清零，pPos-写位置(位)，v-数值，n-位数，不超过16
+* 输出参数：pPos-写入后的位置
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：高位在前
+*********************************************************************************************************/
+static void PutBits(uint8* pBuf, uint16* pPos, uint16 v, uint8 n)
+{
+  uint16 pos = *pPos;
+
+  while(n > 0)
+  {
+    n--;
+    if((v >> n) & 1)
+    {
+      pBuf[pos >> 3] |= (uint8)(0x80 >> (pos & 7));
+    }
+    pos++;
+  }
+  *pPos = pos;
+}
+
+/*********************************************************************************************************
+* 函数名称：GetBits
+* 函数功能：从位流中读出n位
+* 输入参数：pBuf-位流，pPos-读位置(位)，n-位数，不超过16
+* 输出参数：pPos-读出后的位置
+* 返 回 值：数值
+* 创建日期：2026年10月19日
+* 注    意：高位在前
+*********************************************************************************************************/
+static uint16 GetBits(const uint8* pBuf, uint16* pPos, uint8 n)
+{
+  uint16 pos = *pPos;
+  uint16 v   = 0;
+
+  while(n > 0)
+  {
+    n--;
+    v = (uint16)((v << 1) | ((pBuf[pos >> 3] >> (7 - (pos & 7))) & 1));
+    pos++;
+  }
+  *pPos = pos;
+  return v;
+}
+
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+#else
+/*********************************************************************************************************
+* 函数名称：ZigZag
+* 函数功能：差值zigzag编码
+* 输入参数：cur-当前读数，prev-前一个读数
+* 输出参数：void
+* 返 回 值：编码，0,-1,1,-2,...依次为0,1,2,3,...
+* 创建日期：2026年10月19日
+* 注    意：读数为ADC_RESULT_BITS位，编码最多ADC_RESULT_BITS + 1位
+*********************************************************************************************************/
+static uint16 ZigZag(uint16 cur, uint16 prev)
+{
+  int32 d = (int32)cur - (int32)prev;
+
+  return (uint16)((d < 0) ? (-2 * d - 1) : (2 * d));
+}
+
+/*********************************************************************************************************
+* 函数名称：EncodeBlock
+* 函数功能：压缩待压缩读数的开头一块
+* 输入参数：pOut-数据块，DATALEN字节
+* 输出参数：pOut-数据块，pLen-数据块的长度
+* 返 回 值：压缩进本块的读数个数
+* 创建日期：2026年10月19日
+* 注    意：逐组加入，一组放不下时减少该组的差值个数，不满WAVE_GROUP的组是最后一组
+*********************************************************************************************************/
+static uint8 EncodeBlock(uint8* pOut, uint8* pLen)
+{
+  uint8* pBits = &pOut[WAVE_HEAD_LEN];
+  uint8  arrWidth[WAVE_GROUP];  //本组各差值的位数
+  uint16 pos = 0;               //已写入的位数
+  uint16 addr = getAddress();
+  uint8  num = 1;               //第一个读数原样存放
+  uint8  cnt;
+  uint8  width;
+  uint8  k;
+
+  memset(pOut, 0, DATALEN);
+
+  while(num < s_iPendNum && num < WAVE_SMP_MAX)
+  {
+    cnt = WAVE_GROUP;
+    if(cnt > s_iPendNum - num)
+    {
+      cnt = s_iPendNum - num;
+    }
+    if(cnt > WAVE_SMP_MAX - num)
+    {
+      cnt = WAVE_SMP_MAX - num;
+    }
+    for(k = 0; k < cnt; k++)
+    {
+      arrWidth[k] = BitWidth(ZigZag(s_arrPend[num + k], s_arrPend[num + k - 1]));
+    }
+
+    //放不下时减少本组的差值个数，位宽可能随之变小
+    while(cnt > 0)
+    {
+      width = 0;
+      for(k = 0; k < cnt; k++)
+      {
+        if(arrWidth[k] > width)
+        {
+          width = arrWidth[k];
+        }
+      }
+      if(pos + WAVE_WIDTH_BITS + (uint16)cnt * width <= WAVE_PAYLOAD_BITS)
+      {
+        break;
+      }
+      cnt--;
+    }
+    if(cnt == 0)
+    {
+      break;
+    }
+
+    PutBits(pBits, &pos, width, WAVE_WIDTH_BITS);
+    for(k = 0; k < cnt; k++)
+    {
+      PutBits(pBits, &pos, ZigZag(s_arrPend[num + k], s_arrPend[num + k - 1]), width);
+    }
+    num += cnt;
+    if(cnt < WAVE_GROUP)
+    {
+      break;
+    }
+  }
+
+  pOut[0]  = HIBYTE(addr);
+  pOut[1]  = LOBYTE(addr);
+  pOut[2]  = WAVE_MODULE;
+  pOut[3]  = WAVE_SECOND_ID;
+  pOut[4]  = HIBYTE(s_iSeq);
+  pOut[5]  = LOBYTE(s_iSeq);
+  pOut[6]  = HIBYTE(s_iRate);
+  pOut[7]  = LOBYTE(s_iRate);
+  pOut[8]  = num;
+  pOut[9]  = HIBYTE(s_arrPend[0]);
+  pOut[10] = LOBYTE(s_arrPend[0]);
+  *pLen = WAVE_HEAD_LEN + (pos + 7) / 8;
+
+  return num;
+}
+
+/*********************************************************************************************************
+* 函数名称：PushBlock
+* 函数功能：数据块放入发送队列，已压缩的读数移出
+* 输入参数：num-块中的读数个数，pBlock-数据块，len-数据块的长度
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：队列满时丢弃最旧的块，汇聚节点由序号的缺口发现
+*********************************************************************************************************/
+static void PushBlock(uint8 num, uint8* pBlock, uint8 len)
+{
+  uint8 tail;
+
+  if(s_iTxNum >= WAVE_TXQ_NUM)
+  {
+    s_iTxHead = (s_iTxHead + 1) % WAVE_TXQ_NUM;
+    s_iTxNum--;
+  }
+  tail = (s_iTxHead + s_iTxNum) % WAVE_TXQ_NUM;
+  memcpy(s_arrTxQue[tail], pBlock, len);
+  s_arrTxLen[tail] = len;
+  s_iTxNum++;
+
+  s_iSeq++;
+  s_iPendNum -= num;
+  memmove(s_arrPend, &s_arrPend[num], s_iPendNum * sizeof(s_arrPend[0]));
+  s_iTryNum = 0;
+}
+
+/*********************************************************************************************************
+* 函数名称：FlushPend
+* 函数功能：待压缩的读数全部压缩发出
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：读数不连续时调用，缺口之前的读数不和之后的读数混在一块中
+*********************************************************************************************************/
+static void FlushPend(void)
+{
+  uint8 arrBlock[DATALEN];
+  uint8 len;
+  uint8 num;
+
+  while(s_iPendNum > 0)
+  {
+    num = EncodeBlock(arrBlock, &len);
+    PushBlock(num, arrBlock, len);
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：SendTask
+* 函数功能：按令牌发送队列中的数据块
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：令牌按预留的负载补充，最多积累WAVE_BURST包；每次最多发一包，TDMA上行队列满时留到下次
+*********************************************************************************************************/
+static void SendTask(void)
+{
+  uint32 now = millis();
+
+  s_iTokens += (now - s_iTokenMs) * s_iLoad;
+  s_iTokenMs = now;
+  if(s_iTokens > WAVE_BURST * WAVE_TOKEN_PKT)
+  {
+    s_iTokens = WAVE_BURST * WAVE_TOKEN_PKT;
+  }
+
+  if(s_iTxNum == 0 || s_iTokens < WAVE_TOKEN_PKT)
+  {
+    return;
+  }
+  if(SendWaveToParent(s_arrTxQue[s_iTxHead], s_arrTxLen[s_iTxHead]))
+  {
+    s_iTokens -= WAVE_TOKEN_PKT;
+    s_iTxHead = (s_iTxHead + 1) % WAVE_TXQ_NUM;
+    s_iTxNum--;
+  }
+}
+#endif
+
+/*********************************************************************************************************
+*                                              API函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：InitWaveStream
+* 函数功能：初始化WaveStream模块
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：上电时没有波形流，由CMD_WAVE_STREAM命令开始
+*********************************************************************************************************/
+void InitWaveStream(void)
+{
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+  memset(s_arrWaveSrc, 0, sizeof(s_arrWaveSrc));
+  s_iSrcVictim = 0;
+#else
+  s_iRate    = 0;
+  s_iLoad    = 0;
+  s_iPendNum = 0;
+  s_iTxNum   = 0;
+#endif
+}
+
+/*********************************************************************************************************
+* 函数名称：StartWaveStream
+* 函数功能：按采样率开始波形流
+* 输入参数：rate-采样率(Hz)，WAVE_RATE_MIN ~ ADC_WAVE_RATE_MAX，ADC只支持500Hz和250Hz，其余向下取
+* 输出参数：void
+* 返 回 值：1--已接纳，0--路径余量不够、采样率不支持或汇聚节点
+* 创建日期：2026年10月19日
+* 注    意：已有波形流时先按释放本节点原来的预留计算余量；接纳后预留的负载下一个信标起沿路径生效
+*********************************************************************************************************/
+uint8 StartWaveStream(uint16 rate)
+{
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+  return 0;
+#else
+  uint16 need;
+  uint16 room;
+
+  if(rate < WAVE_RATE_MIN || rate > ADC_WAVE_RATE_MAX)
+  {
+    return 0;
+  }
+
+  need = WaveStreamLoad(rate);
+  room = RouteGetHeadroom() + RouteGetReserve();
+  if(need > room)
+  {
+    debug("波形流余量不够\r\n");
+    return 0;
+  }
+
+  FlushPend();
+  s_iRate = StartADCWave(WAVE_CH, rate);
+  if(s_iRate == 0)
+  {
+    return 0;
+  }
+  s_iLoad      = WaveStreamLoad(s_iRate);
+  s_iBlockNum  = (uint8)((uint32)s_iRate * WAVE_BLOCK_MS / 1000 < WAVE_SMP_MAX ? (uint32)s_iRate * WAVE_BLOCK_MS / 1000 : WAVE_SMP_MAX);
+  s_iTryNum    = 0;
+  s_iLostMark  = GetADCWaveLost();
+  s_iTokens    = WAVE_TOKEN_PKT;  //第一块不用等令牌
+  s_iTokenMs   = millis();
+  RouteSetReserve(s_iLoad);
+
+  return 1;
+#endif
+}
+
+/*********************************************************************************************************
+* 函数名称：StopWaveStream
+* 函数功能：停止波形流并取消预留
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：已压缩还没发出的数据块丢弃
+*********************************************************************************************************/
+void StopWaveStream(void)
+{
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+#else
+  StopADCWave();
+  RouteSetReserve(0);
+  s_iRate    = 0;
+  s_iLoad    = 0;
+  s_iPendNum = 0;
+  s_iTxNum   = 0;
+#endif
+}
+
+/*********************************************************************************************************
+* 函数名称：WaveStreamRate
+* 函数功能：返回当前采样率
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：采样率(Hz)，0--没有波形流
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+uint16 WaveStreamRate(void)
+{
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+  return 0;
+#else
+  return s_iRate;
+#endif
+}
+
+/*********************************************************************************************************
+* 函数名称：WaveStreamLoad
+* 函数功能：估算波形流的负载
+* 输入参数：rate-采样率(Hz)
+* 输出参数：void
+* 返 回 值：负载(空中字节/秒)，向上取整
+* 创建日期：2026年10月19日
+* 注    意：每秒包数取以下三者中最大的：按每个读数WAVE_EST_BITS位装满数据包、每块最多WAVE_SMP_MAX个读数、
+*           每WAVE_BLOCK_MS至少一块；500Hz约660字节/秒，需要19.2k以上的空中速率
+*********************************************************************************************************/
+uint16 WaveStreamLoad(uint16 rate)
+{
+  uint32 pps;   //每秒包数 * 1000
+  uint32 temp;
+
+  pps  = (uint32)rate * WAVE_EST_BITS * 1000 / WAVE_PAYLOAD_BITS;
+  temp = (uint32)rate * 1000 / WAVE_SMP_MAX;
+  if(temp > pps)
+  {
+    pps = temp;
+  }
+  temp = (uint32)1000 * 1000 / WAVE_BLOCK_MS;
+  if(temp > pps)
+  {
+    pps = temp;
+  }
+
+  return (uint16)((pps * ROUTE_PKT_AIR_BYTES + 999) / 1000);
+}
+
+/*********************************************************************************************************
+* 函数名称：WaveStreamProc
+* 函数功能：读取波形流读数，攒够一块压缩放入发送队列，按令牌发送
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：在2ms任务中调用；读数每增加WAVE_GROUP个试压缩一次，装不下了或攒够s_iBlockNum个时发出；
+*           ADC队列溢出时先发出溢出前的读数，包括还在ADC队列中的，再跳过一个序号，汇聚节点据此记一次丢块
+*********************************************************************************************************/
+void WaveStreamProc(void)
+{
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+#else
+  uint8  arrBlock[DATALEN];
+  uint8  len;
+  uint8  num;
+  uint32 lost;
+
+  if(s_iRate == 0)
+  {
+    return;
+  }
+
+  lost = GetADCWaveLost();
+  if(lost != s_iLostMark)
+  {
+    //队列满时丢的是新读数，队列中的还是溢出前的，读出来与之前的读数一起发出，再跳过序号
+    s_iLostMark = lost;
+    FlushPend();
+    s_iPendNum = ReadADCWave(s_arrPend, WAVE_PEND_NUM);
+    FlushPend();
+    s_iSeq++;
+  }
+  s_iPendNum += ReadADCWave(&s_arrPend[s_iPendNum], WAVE_PEND_NUM - s_iPendNum);
+
+  while(s_iPendNum >= s_iBlockNum || s_iPendNum >= s_iTryNum + WAVE_GROUP)
+  {
+    num = EncodeBlock(arrBlock, &len);
+    if(num < s_iPendNum || s_iPendNum >= s_iBlockNum)
+    {
+      PushBlock(num, arrBlock, len);
+    }
+    else
+    {
+      s_iTryNum = s_iPendNum;  //还装得下，等读数再增加WAVE_GROUP个
+      break;
+    }
+  }
+
+  SendTask();
+#endif
+}
+
+/*********************************************************************************************************
+* 函数名称：WaveUnpack
+* 函数功能：解包数据块
+* 输入参数：pData-数据块，DATALEN字节
+* 输出参数：pBlock-解包结果
+* 返 回 值：1--成功，0--格式错误
+* 创建日期：2026年10月19日
+* 注    意：数据块格式：[0..1]源地址，[2]模块ID，[3]二级ID，[4..5]块序号，[6..7]采样率(Hz)，[8]读数个数n，
+*           [9..10]第一个读数，[11..]其余n-1个读数与前一个之差的位流，高位在前：每WAVE_GROUP个差值一组，
+*           最后一组可以不满，组首WAVE_WIDTH_BITS位为位宽w，随后每个差值zigzag编码后占w位；多字节数高字节在前
+*********************************************************************************************************/
+uint8 WaveUnpack(const uint8* pData, StructWaveBlock* pBlock)
+{
+  const uint8* pBits = &pData[WAVE_HEAD_LEN];
+  uint16 pos = 0;
+  uint16 z;
+  int32  smp;
+  uint8  left;
+  uint8  cnt;
+  uint8  width;
+  uint8  i;
+
+  pBlock->addr     = MAKEHWORD(pData[0], pData[1]);
+  pBlock->module   = pData[2];
+  pBlock->secondId = pData[3];
+  pBlock->seq      = MAKEHWORD(pData[4], pData[5]);
+  pBlock->rate     = MAKEHWORD(pData[6], pData[7]);
+  pBlock->num      = pData[8];
+  if(pBlock->num == 0 || pBlock->num > WAVE_SMP_MAX)
+  {
+    return 0;
+  }
+
+  smp = MAKEHWORD(pData[9], pData[10]);
+  pBlock->arrSmp[0] = (uint16)smp;
+  i = 1;
+  left = pBlock->num - 1;
+  while(left > 0)
+  {
+    cnt = (left < WAVE_GROUP) ? left : WAVE_GROUP;
+    if(pos + WAVE_WIDTH_BITS > WAVE_PAYLOAD_BITS)
+    {
+      return 0;
+    }
+    width = (uint8)GetBits(pBits, &pos, WAVE_WIDTH_BITS);
+    if(pos + (uint16)cnt * width > WAVE_PAYLOAD_BITS)
+    {
+      return 0;
+    }
+    left -= cnt;
+    while(cnt > 0)
+    {
+      z    = GetBits(pBits, &pos, width);
+      smp += (z & 1) ? -(int32)((z + 1) >> 1) : (int32)(z >> 1);
+      pBlock->arrSmp[i++] = (uint16)smp;
+      cnt--;
+    }
+  }
+
+  return 1;
+}
+
+/*********************************************************************************************************
+* 函数名称：WaveCheckSeq
+* 函数功能：检查块序号，发现丢失的块
+* 输入参数：addr-源节点地址，seq-块序号
+* 输出参数：pLost-与上一块之间丢失的块数
+* 返 回 值：1--新块，0--重复或迟到的块，应丢弃
+* 创建日期：2026年10月19日
+* 注    意：汇聚节点调用；第一次收到的波形流不计丢块；跟踪的波形流超过WAVE_SRC_MAX个时轮流替换；
+*           序号回退不超过WAVE_SEQ_WINDOW为重复或迟到的块，回退更多说明源节点重启、序号从0开始，
+*           从该块重新同步，不计丢块，否则该节点之后的块要等序号追上来才能收到
+*********************************************************************************************************/
+uint8 WaveCheckSeq(uint16 addr, uint16 seq, uint16* pLost)
+{
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+  StructWaveSrc* pSrc = NULL;
+  uint16 gap;
+  uint8  i;
+
+  *pLost = 0;
+  for(i = 0; i < WAVE_SRC_MAX; i++)
+  {
+    if(s_arrWaveSrc[i].used && s_arrWaveSrc[i].addr == addr)
+    {
+      pSrc = &s_arrWaveSrc[i];
+      break;
+    }
+  }
+
+  if(pSrc == NULL)
+  {
+    for(i = 0; i < WAVE_SRC_MAX && s_arrWaveSrc[i].used; i++)
+    {
+    }
+    if(i >= WAVE_SRC_MAX)
+    {
+      i = s_iSrcVictim;
+      s_iSrcVictim = (s_iSrcVictim + 1) % WAVE_SRC_MAX;
+    }
+    pSrc = &s_arrWaveSrc[i];
+    pSrc->used = 1;
+    pSrc->addr = addr;
+    pSrc->next = seq + 1;
+    return 1;
+  }
+
+  gap = (uint16)(seq - pSrc->next);
+  if(gap >= 0x8000)//序号回退
+  {
+    if((uint16)(pSrc->next - seq) <= WAVE_SEQ_WINDOW)
+    {
+      return 0;
+    }
+    gap = 0;//回退超出窗口，源节点重启或表项被替换过，按新的波形流重新同步
+  }
+  *pLost     = gap;
+  pSrc->next = seq + 1;
+  return 1;
+#else
+  *pLost = 0;
+  return 1;
+#endif
+}
@@ -0,0 +1,76 @@
+/*********************************************************************************************************
+* 模块名称：WaveStream.h
+* 摘    要：波形流模块，250~500Hz单通道波形按块采集、差分变位宽压缩、带块序号发送，汇聚节点解包并发现丢块
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：节点：ADC波形流读数攒成块，块内第一个读数原样存放，其余只存与前一个读数之差，差值zigzag编码后
+*           每WAVE_GROUP个为一组，组首WAVE_WIDTH_BITS位为本组的位宽，平稳段每个读数只占几位；
+*           一块装满一个数据包、或攒够WAVE_BLOCK_MS的读数就发出，每块序号加1；
+*           开始前按采样率估算负载，路径余量不够时拒绝；接纳后在Route中预留，随信标逐跳计入各节点的负载，
+*           TDMA时父结点按预留多分配上行时隙；发送用令牌桶限制在预留的负载以内，突发不超过WAVE_BURST包；
+*           ADC队列溢出、或压缩效果比估算差来不及发送而丢块时，序号上留出缺口；
+*           汇聚节点：按源地址记录下一个期望的序号，序号的跳变即丢失的块数，大幅回退时重新同步
+* 注    意：数据块格式见WaveUnpack；一个节点同时只有一个波形流
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+#ifndef _WAVE_STREAM_H_
+#define _WAVE_STREAM_H_
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "DataType.h"
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#define WAVE_CH          ADC_CH_AIN1   //波形流的ADC通道
+#define WAVE_MODULE      MODULE_ECG    //数据块中的模块ID，按外接的模拟前端设置
+#define WAVE_SECOND_ID   DAT_ECG_WAVE  //数据块中的二级ID
+#define WAVE_RATE_MIN    250           //允许的最低采样率(Hz)，最高为ADC_WAVE_RATE_MAX
+
+#define WAVE_HEAD_LEN    11     //数据块头部：地址2、模块ID、二级ID、块序号2、采样率2、读数个数、第一个读数2
+#define WAVE_GROUP       8      //每组的差值个数，每组有自己的位宽
+#define WAVE_WIDTH_BITS  4      //组首位宽字段的位数，差值zigzag编码后最多15位
+#define WAVE_SMP_MAX     128    //每块最多的读数个数，汇聚节点上报的JSON不超过UART2缓冲区
+#define WAVE_BLOCK_MS    250    //每块最多攒多长时间的读数(ms)，即波形流的最大时延
+#define WAVE_EST_BITS    8      //估算负载时每个读数平均占的位数(含组首)，心电典型为4~6位
+#define WAVE_TXQ_NUM     4      //等待令牌的数据块个数，满时丢弃最旧的
+#define WAVE_BURST       2      //令牌桶的深度(包)
+#define WAVE_SRC_MAX     4      //汇聚节点同时跟踪序号的波形流个数
+#define WAVE_SEQ_WINDOW  WAVE_TXQ_NUM  //汇聚节点容忍的序号回退，不超过为重复或迟到的块，超过为源节点重启
+
+/*********************************************************************************************************
+*                                              枚举结构体定义
+*********************************************************************************************************/
+//解包后的数据块
+typedef struct
+{
+  uint16 addr;                 //源节点地址
+  uint8  module;               //模块ID，EnumModuleID
+  uint8  secondId;             //二级ID，如DAT_ECG_WAVE
+  uint16 seq;                  //块序号
+  uint16 rate;                 //采样率(Hz)
+  uint8  num;                  //读数个数
+  uint16 arrSmp[WAVE_SMP_MAX]; //读数，ADC_RESULT_BITS位
+}StructWaveBlock;
+
+/*********************************************************************************************************
+*                                              API函数声明
+*********************************************************************************************************/
+void   InitWaveStream(void);                  //初始化WaveStream模块
+uint8  StartWaveStream(uint16 rate);          //按采样率(Hz)开始波形流，1--已接纳，0--余量不够或采样率不支持
+void   StopWaveStream(void);                  //停止波形流并取消预留
+uint16 WaveStreamRate(void);                  //返回当前采样率(Hz)，0--没有波形流
+uint16 WaveStreamLoad(uint16 rate);           //估算采样率为rate时的负载(空中字节/秒)
+void   WaveStreamProc(void);                  //读取、压缩、发送，在2ms任务中调用
+uint8  WaveUnpack(const uint8* pData, StructWaveBlock* pBlock);  //解包数据块，1--成功
+uint8  WaveCheckSeq(uint16 addr, uint16 seq, uint16* pLost);     //检查块序号，1--新块，0--重复或迟到的块
+
+#endif
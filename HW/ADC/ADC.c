@@ -7,10 +7,19 @@
 * 内    容：ADC读取芯片温度
 * 注    意：                                                                  
 **********************************************************************************************************
-* 取代版本：
-* 作    者：
-* 完成日期：
-* 修改内容：
+* 取代版本：1.1.0
+* 作    者：LYL
+* 完成日期：2026年10月19日
+* 修改内容：原来DMA每次只传1个数，TIM3中断每8ms把它放入缓冲区；改为TIM3每ADC_SMP_US触发一次转换，
+*           DMA循环写入乒乓缓冲区，半满、全满中断中把刚填满的半块每ADC_OVS_NUM个累加抽取为一个读数，
+*           不再有逐个采样的中断；按s_arrScanCh扫描多个通道，DMA交替写入各通道的采样；
+*           越限报警：ADC_AWD_CH用模拟看门狗，ADC1_2中断中登记事件；其余通道在DecimateBlock中比较读数，
+*           延迟不超过一个半块；报警后关闭该通道的报警，读数回到阈值以内ADC_ALARM_HYST才重新布防；
+*           波形流：TIM3改为每ADC_WAVE_SMP_US触发，每ADC_OVS_NUM次转换得到一个快读数，波形流通道的快读数
+*           按设定的速率平均后放入波形流队列；各通道每ADC_WAVE_DEC个快读数平均为一个普通读数，
+*           Sensor看到的读数速率和分辨率不随波形流变化；
+*           捕获：同样加快转换，在DMA中断中把捕获通道的原始采样(不过采样)存入调用者的数组，
+*           波形流和捕获任一个进行时保持快速转换
 * 修改文件：
 *********************************************************************************************************/
 /*********************************************************************************************************
@@ -23,17 +32,54 @@
 /*********************************************************************************************************
 *                                              宏定义
 *********************************************************************************************************/
+#define ADC_DMA_HALF  (ADC_OVS_NUM * ADC_BLOCK_NUM * ADC_CH_NUM)  //乒乓缓冲区半块的采样个数
 
 /*********************************************************************************************************
 *                                              枚举结构体定义
 *********************************************************************************************************/
+//通道的报警设置和状态
+typedef struct
+{
+  uint16         low;      //下限，ADC_RESULT_BITS位
+  uint16         high;     //上限，ADC_RESULT_BITS位
+  volatile uint8 on;       //1--报警打开
+  volatile uint8 armed;    //1--已布防，越限时报警；报警后为0，读数回到阈值以内时恢复
+  volatile uint8 pending;  //1--有未取出的报警事件，由中断置1，ReadADCAlarm清0
+  uint8          above;    //事件：1--高于上限，0--低于下限
+  uint16         adc;      //事件：越限时的读数
+}StructAlarmState;
 
 /*********************************************************************************************************
 *                                              内部变量
 *********************************************************************************************************/
-static uint16 s_arrADC1Data;   //存放ADC转换结果数据
-static StructU16CirQue  s_structADCCirQue;            //ADC循环队列
-static uint16 s_arrADCBuf[ADC1_BUF_SIZE];   //ADC循环队列的缓冲区
+//扫描序列，下标为EnumADCChannel
+static const uint8 s_arrScanCh[ADC_CH_NUM] = {ADC_Channel_16, ADC_Channel_17, ADC_Channel_1};
+
+static uint16 s_arrADC1Data[2 * ADC_DMA_HALF];   //DMA循环写入的乒乓缓冲区，前后两半轮流填充，各通道采样交替存放
+static StructU16CirQue  s_arrADCCirQue[ADC_CH_NUM];            //各通道的读数队列
+static uint16 s_arrADCBuf[ADC_CH_NUM][ADC1_BUF_SIZE];   //各通道读数队列的缓冲区
+static StructAlarmState s_arrAlarm[ADC_CH_NUM];         //各通道的报警
+
+static uint8  s_iDecShift;               //每2^n个快读数平均为一个普通读数，波形流或捕获时为ADC_WAVE_DEC_SHIFT，否则为0
+static uint8  s_iDecCnt;                 //已累加的快读数个数
+static uint32 s_arrDecSum[ADC_CH_NUM];   //各通道快读数的累加和
+
+static StructU16CirQue s_structWaveCirQue;        //波形流队列
+static uint16 s_arrWaveBuf[ADC_WAVE_BUF_SIZE];    //波形流队列的缓冲区
+static uint8  s_iWaveCh = ADC_CH_NUM;             //波形流的通道，ADC_CH_NUM表示没有波形流
+static uint8  s_iWaveShift;                       //每2^n个快读数平均为一个波形流读数
+static uint8  s_iWaveCnt;                         //已累加的快读数个数
+static uint32 s_iWaveSum;                         //快读数的累加和
+static volatile uint32 s_iWaveLost;               //队列满丢弃的波形流读数个数
+
+static uint8  s_iCapCh = ADC_CH_NUM;              //捕获的通道，ADC_CH_NUM表示没有捕获
+static uint16* s_pCapBuf;                         //捕获的采样存放的数组
+static uint16 s_iCapLen;                          //要捕获的采样个数
+static volatile uint16 s_iCapNum;                 //已捕获的采样个数
+static uint8  s_iCapShift;                        //每2^n个原始采样平均为一个捕获的采样
+static uint8  s_iCapCnt;                          //已累加的原始采样个数
+static uint32 s_iCapSum;                          //原始采样的累加和
+static uint8  s_iCapSkip;                         //还要丢弃的半块数
 
 /*********************************************************************************************************
 *                                              内部函数声明
@@ -41,23 +87,32 @@ static uint16 s_arrADCBuf[ADC1_BUF_SIZE];   //ADC循环队列的缓冲区
 static void ConfigADC1(void);     //配置ADC1
 static void ConfigDMA1Ch1(void);  //配置DMA通道1
 static void ConfigTimer3(uint16 arr, uint16 psc); //配置TIM3
+static void DecimateBlock(const uint16* pSmp);    //把半块采样过采样抽取为读数
+static void ConfigAWD(void);                      //配置模拟看门狗和ADC1_2中断
+static void PostAlarm(uint8 ch, uint16 adc);      //登记越限事件
+static void CheckAlarm(uint8 ch, uint16 adc);     //用读数检查报警和重新布防
+static void PutWave(uint16 adc);                  //快读数平均后放入波形流队列
+static void SwitchWave(uint8 ch, uint8 shift);    //切换波形流通道和转换速率
+static void SetFastConv(void);                    //按有没有波形流、捕获切换转换速率
+static void CaptureBlock(const uint16* pSmp);     //从半块采样中取出捕获通道的原始采样
 
 /*********************************************************************************************************
 *                                              内部函数实现
 *********************************************************************************************************/
 /*********************************************************************************************************
 * 函数名称：ConfigADC1
-* 函数功能：配置ADC1，采集温度
+* 函数功能：配置ADC1，按s_arrScanCh扫描温度、参考电压和外部输入
 * 输入参数：void
 * 输出参数：void
 * 返 回 值：void
 * 创建日期：2021年07月11日
-* 注    意：ADC123_IN1-PA1
+* 注    意：ADC123_IN1-PA1；每次触发转换整个扫描序列，每个通道采样239.5个周期，共约60us
 **********************************************************************************************************/
 static void ConfigADC1(void)
 {                          
   GPIO_InitTypeDef  GPIO_InitStructure; //GPIO_InitStructure用于存放GPIO的参数
   ADC_InitTypeDef   ADC_InitStructure;  //ADC_InitStructure用于存放ADC的参数
+  uint8 i;
 
   //使能RCC相关时钟
   RCC_ADCCLKConfig(RCC_PCLK2_Div6); //设置ADC时钟分频，ADCCLK=PCLK2/6=12MHz
@@ -73,14 +128,17 @@ static void ConfigADC1(void)
 
   //配置ADC1
   ADC_InitStructure.ADC_Mode               = ADC_Mode_Independent;  //设置为独立模式
-  ADC_InitStructure.ADC_ScanConvMode       = DISABLE;               //禁止扫描模式
+  ADC_InitStructure.ADC_ScanConvMode       = ENABLE;                //使能扫描模式
   ADC_InitStructure.ADC_ContinuousConvMode = DISABLE;               //禁止连续转换模式
   ADC_InitStructure.ADC_ExternalTrigConv   = ADC_ExternalTrigConv_T3_TRGO;  //使用TIM3触发
   ADC_InitStructure.ADC_DataAlign          = ADC_DataAlign_Right;   //设置为右对齐
-  ADC_InitStructure.ADC_NbrOfChannel       = 1; //设置ADC的通道数目
+  ADC_InitStructure.ADC_NbrOfChannel       = ADC_CH_NUM; //设置ADC的通道数目
   ADC_Init(ADC1, &ADC_InitStructure);
 
-  ADC_RegularChannelConfig(ADC1, ADC_Channel_16, 1, ADC_SampleTime_239Cycles5); //设置采样时间为239.5个周期,通道16-内部温度传感器,17-内部参考电压
+  for(i = 0; i < ADC_CH_NUM; i++)
+  {
+    ADC_RegularChannelConfig(ADC1, s_arrScanCh[i], i + 1, ADC_SampleTime_239Cycles5); //设置采样时间为239.5个周期,通道16-内部温度传感器,17-内部参考电压
+  }
   ADC_TempSensorVrefintCmd(ENABLE);//激活温度传感器和内部参考电压通道
 
   ADC_DMACmd(ADC1, ENABLE);                   //使能ADC1的DMA
@@ -94,16 +152,17 @@ static void ConfigADC1(void)
 
 /*********************************************************************************************************
 * 函数名称：ConfigDMA1Ch1
-* 函数功能：配置DMA通道1，把ADC采集结果放到s_arrADC1Data
+* 函数功能：配置DMA通道1，把ADC采集结果循环写入s_arrADC1Data
 * 输入参数：void
 * 输出参数：void
 * 返 回 值：void
 * 创建日期：2021年07月11日
-* 注    意：
+* 注    意：半满、全满时各产生一次中断，DMA写后半块时处理前半块，反之亦然
 **********************************************************************************************************/
 static void ConfigDMA1Ch1(void)
 {
-  DMA_InitTypeDef DMA_InitStructure;  //DMA_InitStructure用于存放DMA的参数
+  DMA_InitTypeDef  DMA_InitStructure;   //DMA_InitStructure用于存放DMA的参数
+  NVIC_InitTypeDef NVIC_InitStructure;  //NVIC_InitStructure用于存放NVIC的参数
   
   //使能RCC相关时钟
   RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);  //使能DMA1的时钟
@@ -111,11 +170,11 @@ static void ConfigDMA1Ch1(void)
   //配置DMA1_Channel1
   DMA_DeInit(DMA1_Channel1);  //将DMA1_CH1寄存器设置为默认值
   DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&(ADC1->DR);           //设置外设地址
-  DMA_InitStructure.DMA_MemoryBaseAddr     = (uint32_t)&s_arrADC1Data;        //设置存储器地址
+  DMA_InitStructure.DMA_MemoryBaseAddr     = (uint32_t)s_arrADC1Data;         //设置存储器地址
   DMA_InitStructure.DMA_DIR                = DMA_DIR_PeripheralSRC;           //设置为外设到存储器模式
-  DMA_InitStructure.DMA_BufferSize         = 1;                               //设置要传输的数据项数目
+  DMA_InitStructure.DMA_BufferSize         = 2 * ADC_DMA_HALF;                //设置要传输的数据项数目
   DMA_InitStructure.DMA_PeripheralInc      = DMA_PeripheralInc_Disable;       //设置外设为非递增模式
-  DMA_InitStructure.DMA_MemoryInc          = DMA_MemoryInc_Disable;           //设置存储器为非递增模式
+  DMA_InitStructure.DMA_MemoryInc          = DMA_MemoryInc_Enable;            //设置存储器为递增模式
   DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_HalfWord; //设置外设数据长度为半字
   DMA_InitStructure.DMA_MemoryDataSize     = DMA_MemoryDataSize_HalfWord;     //设置存储器数据长度为半字
   DMA_InitStructure.DMA_Mode               = DMA_Mode_Circular;               //设置为循环模式
@@ -123,6 +182,15 @@ static void ConfigDMA1Ch1(void)
   DMA_InitStructure.DMA_M2M                = DMA_M2M_Disable;                 //禁止存储器到存储器访问
   DMA_Init(DMA1_Channel1, &DMA_InitStructure);  //根据参数初始化DMA1_Channel1
   
+  DMA_ITConfig(DMA1_Channel1, DMA_IT_HT | DMA_IT_TC, ENABLE);  //使能半满和全满中断
+  
+  //配置NVIC
+  NVIC_InitStructure.NVIC_IRQChannel      = DMA1_Channel1_IRQn; //中断通道号
+  NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 3;     //设置抢占优先级
+  NVIC_InitStructure.NVIC_IRQChannelSubPriority        = 0;     //设置子优先级
+  NVIC_InitStructure.NVIC_IRQChannelCmd   = ENABLE;             //使能中断
+  NVIC_Init(&NVIC_InitStructure);                               //根据参数初始化NVIC
+  
   DMA_Cmd(DMA1_Channel1, ENABLE); //使能DMA1_Channel1
 }
 
@@ -133,12 +201,11 @@ static void ConfigDMA1Ch1(void)
 * 输出参数：void
 * 返 回 值：void
 * 创建日期：2021年07月11日
-* 注    意： 
+* 注    意：只用更新事件触发ADC转换，不产生中断
 **********************************************************************************************************/
 static void ConfigTimer3(uint16 arr, uint16 psc)
 {
   TIM_TimeBaseInitTypeDef  TIM_TimeBaseStructure; //TIM_TimeBaseStructure用于存放TIM3的参数
-  NVIC_InitTypeDef NVIC_InitStructure;            //NVIC_InitStructure用于存放NVIC的参数
     
   //使能RCC相关时钟
   RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM3, ENABLE);  //使能TIM3的时钟
@@ -152,35 +219,326 @@ static void ConfigTimer3(uint16 arr, uint16 psc)
   
   TIM_SelectOutputTrigger(TIM3,TIM_TRGOSource_Update);          //选择更新事件为触发输入
   
-  TIM_ITConfig(TIM3, TIM_IT_Update,ENABLE);                     //使能定时器的更新中断
-  
-  //配置NVIC
-  NVIC_InitStructure.NVIC_IRQChannel      = TIM3_IRQn;          //中断通道号
-  NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 3;     //设置抢占优先级
+  TIM_Cmd(TIM3, ENABLE);  //使能定时器
+}
+
+/*********************************************************************************************************
+* 函数名称：ConfigAWD
+* 函数功能：配置模拟看门狗监视ADC_AWD_CH，配置ADC1_2中断
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：看门狗只比较12位采样，阈值由SetADCAlarm设置前先关闭中断
+**********************************************************************************************************/
+static void ConfigAWD(void)
+{
+  NVIC_InitTypeDef NVIC_InitStructure;  //NVIC_InitStructure用于存放NVIC的参数
+
+  ADC_ITConfig(ADC1, ADC_IT_AWD, DISABLE);
+  ADC_AnalogWatchdogSingleChannelConfig(ADC1, s_arrScanCh[ADC_AWD_CH]);  //只监视ADC_AWD_CH
+  ADC_AnalogWatchdogCmd(ADC1, ADC_AnalogWatchdog_SingleRegEnable);
+
+  //配置NVIC，优先级高于DMA1通道1，越限时能打断抽取
+  NVIC_InitStructure.NVIC_IRQChannel      = ADC1_2_IRQn;        //中断通道号
+  NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 1;     //设置抢占优先级
   NVIC_InitStructure.NVIC_IRQChannelSubPriority        = 0;     //设置子优先级
   NVIC_InitStructure.NVIC_IRQChannelCmd   = ENABLE;             //使能中断
   NVIC_Init(&NVIC_InitStructure);                               //根据参数初始化NVIC
-  
-  TIM_Cmd(TIM3, ENABLE);  //使能定时器
 }
- 
+
 /*********************************************************************************************************
-* 函数名称：TIM3_IRQHandler
-* 函数功能：TIM3中断服务函数，定时把s_arrADC1Data的值放到ADC缓冲区
+* 函数名称：PostAlarm
+* 函数功能：登记越限事件，撤防该通道
+* 输入参数：ch-通道，adc-越限时的读数
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：在中断中调用；上一个事件还没取出时丢弃新事件，撤防保证同一次越限只报警一次；
+*           每个通道只由一个中断登记事件，不需要关中断
+**********************************************************************************************************/
+static void PostAlarm(uint8 ch, uint16 adc)
+{
+  StructAlarmState* pAlarm = &s_arrAlarm[ch];
+
+  pAlarm->armed = 0;
+  if(pAlarm->pending)
+  {
+    return;
+  }
+  pAlarm->above   = (adc > pAlarm->high);
+  pAlarm->adc     = adc;
+  __DMB();  //事件内容写完后再置pending
+  pAlarm->pending = 1;
+}
+
+/*********************************************************************************************************
+* 函数名称：CheckAlarm
+* 函数功能：用读数检查报警，读数回到阈值以内时重新布防
+* 输入参数：ch-通道，adc-读数
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：在DMA1通道1中断中调用；ADC_AWD_CH越限由模拟看门狗检测，这里只负责重新布防并打开看门狗中断
+**********************************************************************************************************/
+static void CheckAlarm(uint8 ch, uint16 adc)
+{
+  StructAlarmState* pAlarm = &s_arrAlarm[ch];
+  uint8 inLow;   //1--高于下限加回差，或没有下限
+  uint8 inHigh;  //1--低于上限减回差，或没有上限
+
+  if(!pAlarm->on)
+  {
+    return;
+  }
+
+  if(pAlarm->armed)
+  {
+    if(ch != ADC_AWD_CH && (adc < pAlarm->low || adc > pAlarm->high))
+    {
+      PostAlarm(ch, adc);
+    }
+    return;
+  }
+
+  inLow  = (pAlarm->low == 0 || adc >= pAlarm->low + ADC_ALARM_HYST);
+  inHigh = (pAlarm->high >= ADC_FULL_SCALE - 1 || adc + ADC_ALARM_HYST <= pAlarm->high);
+  if(inLow && inHigh)
+  {
+    pAlarm->armed = 1;
+    if(ch == ADC_AWD_CH)
+    {
+      ADC_ClearITPendingBit(ADC1, ADC_IT_AWD);  //撤防期间置起的标志
+      ADC_ITConfig(ADC1, ADC_IT_AWD, ENABLE);
+    }
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：PutWave
+* 函数功能：波形流通道的快读数每2^s_iWaveShift个平均后放入波形流队列
+* 输入参数：adc-快读数
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：在DMA1通道1中断中调用；队列满时丢弃新读数并计数，波形流据此在序号上留出缺口
+**********************************************************************************************************/
+static void PutWave(uint16 adc)
+{
+  uint16 d;
+
+  s_iWaveSum += adc;
+  if(++s_iWaveCnt < (1 << s_iWaveShift))
+  {
+    return;
+  }
+
+  d = (uint16)(s_iWaveSum >> s_iWaveShift);
+  s_iWaveSum = 0;
+  s_iWaveCnt = 0;
+  if(EnU16Queue(&s_structWaveCirQue, &d, 1) == 0)
+  {
+    s_iWaveLost++;
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：SwitchWave
+* 函数功能：切换波形流通道和转换速率
+* 输入参数：ch-波形流通道，ADC_CH_NUM表示停止，shift-每2^shift个快读数平均为一个波形流读数
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：修改期间关闭DMA1通道1中断；切换时正在填充的半块前后速率不同，只影响一个普通读数的采样时刻
+**********************************************************************************************************/
+static void SwitchWave(uint8 ch, uint8 shift)
+{
+  NVIC_DisableIRQ(DMA1_Channel1_IRQn);
+
+  s_iWaveCh    = ch;
+  s_iWaveShift = shift;
+  s_iWaveSum   = 0;
+  s_iWaveCnt   = 0;
+  ClearU16Queue(&s_structWaveCirQue);
+  SetFastConv();
+
+  NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+}
+
+/*********************************************************************************************************
+* 函数名称：SetFastConv
+* 函数功能：按有没有波形流、捕获切换转换速率
 * 输入参数：void
 * 输出参数：void
 * 返 回 值：void
-* 创建日期：2021年07月11日
-* 注    意：
+* 创建日期：2026年10月19日
+* 注    意：在关闭DMA1通道1中断时调用；速率不变时不清除正在累加的普通读数
 **********************************************************************************************************/
-void TIM3_IRQHandler(void)
-{  
-  if (TIM_GetITStatus(TIM3, TIM_IT_Update) != RESET)  //判断定时器更新中断是否发生
+static void SetFastConv(void)
+{
+  uint8 fast  = (s_iWaveCh < ADC_CH_NUM) || (s_iCapCh < ADC_CH_NUM);
+  uint8 shift = fast ? ADC_WAVE_DEC_SHIFT : 0;
+  uint8 i;
+
+  if(shift == s_iDecShift)
+  {
+    return;
+  }
+
+  s_iDecShift = shift;
+  s_iDecCnt   = 0;
+  for(i = 0; i < ADC_CH_NUM; i++)
   {
-    TIM_ClearITPendingBit(TIM3, TIM_FLAG_Update);     //清除定时器更新中断标志 
-  }  
+    s_arrDecSum[i] = 0;
+  }
+  TIM_SetAutoreload(TIM3, (fast ? ADC_WAVE_SMP_US : ADC_SMP_US) - 1);
+}
+
+/*********************************************************************************************************
+* 函数名称：CaptureBlock
+* 函数功能：从半块采样中取出捕获通道的原始采样，存入捕获数组
+* 输入参数：pSmp-半块采样的首地址，共ADC_DMA_HALF个
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：在DMA1通道1中断中调用；每2^s_iCapShift个12位采样平均，再左移到ADC_RESULT_BITS位，
+*           与读数同一量纲；存满后不再写入，等StopADCCapture
+**********************************************************************************************************/
+static void CaptureBlock(const uint16* pSmp)
+{
+  uint8 i;
 
-  WriteADCBuf(s_arrADC1Data);   //向ADC缓冲区写入数据
+  if(s_iCapCh >= ADC_CH_NUM || s_iCapNum >= s_iCapLen)
+  {
+    return;
+  }
+  if(s_iCapSkip > 0)
+  {
+    s_iCapSkip--;
+    return;
+  }
+
+  pSmp += s_iCapCh;
+  for(i = 0; i < ADC_OVS_NUM * ADC_BLOCK_NUM; i++)
+  {
+    s_iCapSum += *pSmp;
+    pSmp += ADC_CH_NUM;
+    if(++s_iCapCnt < (1 << s_iCapShift))
+    {
+      continue;
+    }
+    s_pCapBuf[s_iCapNum++] = (uint16)((s_iCapSum << (ADC_RESULT_BITS - 12)) >> s_iCapShift);
+    s_iCapSum = 0;
+    s_iCapCnt = 0;
+    if(s_iCapNum >= s_iCapLen)
+    {
+      break;
+    }
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：DecimateBlock
+* 函数功能：把半块采样过采样抽取为读数，写入各通道的缓冲区
+* 输入参数：pSmp-半块采样的首地址，共ADC_DMA_HALF个
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：各通道采样交替存放，每个通道每ADC_OVS_NUM个12位采样累加后右移ADC_OVS_SHIFT位，
+*           得到ADC_RESULT_BITS位快读数；传感器本身的噪声使低位抖动，过采样才能真正提高分辨率；
+*           每2^s_iDecShift个快读数平均为一个普通读数，没有波形流时快读数就是普通读数
+**********************************************************************************************************/
+static void DecimateBlock(const uint16* pSmp)
+{
+  uint32 arrSum[ADC_CH_NUM];  //各通道的累加和
+  uint16 adc;
+  uint8  i;
+  uint8  j;
+  uint8  ch;
+
+  for(i = 0; i < ADC_BLOCK_NUM; i++)
+  {
+    for(ch = 0; ch < ADC_CH_NUM; ch++)
+    {
+      arrSum[ch] = 0;
+    }
+    for(j = 0; j < ADC_OVS_NUM; j++)
+    {
+      for(ch = 0; ch < ADC_CH_NUM; ch++)
+      {
+        arrSum[ch] += *pSmp++;
+      }
+    }
+    for(ch = 0; ch < ADC_CH_NUM; ch++)
+    {
+      adc = (uint16)(arrSum[ch] >> ADC_OVS_SHIFT);
+      if(ch == s_iWaveCh)
+      {
+        PutWave(adc);
+      }
+      s_arrDecSum[ch] += adc;
+    }
+
+    if(++s_iDecCnt < (1 << s_iDecShift))
+    {
+      continue;
+    }
+    s_iDecCnt = 0;
+    for(ch = 0; ch < ADC_CH_NUM; ch++)
+    {
+      adc = (uint16)(s_arrDecSum[ch] >> s_iDecShift);
+      s_arrDecSum[ch] = 0;
+      WriteADCBuf(ch, adc);
+      CheckAlarm(ch, adc);
+    }
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：DMA1_Channel1_IRQHandler
+* 函数功能：DMA1通道1中断服务函数，处理刚填满的半块采样
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：半满时DMA开始写后半块，处理前半块；全满时DMA回到开头，处理后半块；
+*           处理时间远小于半块的填充时间ADC_DMA_HALF * ADC_SMP_US
+**********************************************************************************************************/
+void DMA1_Channel1_IRQHandler(void)
+{
+  if(DMA_GetITStatus(DMA1_IT_HT1) != RESET)
+  {
+    DMA_ClearITPendingBit(DMA1_IT_HT1);
+    CaptureBlock(&s_arrADC1Data[0]);
+    DecimateBlock(&s_arrADC1Data[0]);
+  }
+
+  if(DMA_GetITStatus(DMA1_IT_TC1) != RESET)
+  {
+    DMA_ClearITPendingBit(DMA1_IT_TC1);
+    CaptureBlock(&s_arrADC1Data[ADC_DMA_HALF]);
+    DecimateBlock(&s_arrADC1Data[ADC_DMA_HALF]);
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：ADC1_2_IRQHandler
+* 函数功能：ADC1、ADC2中断服务函数，处理模拟看门狗越限
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：看门狗在ADC_AWD_CH转换结束时置位，下一个通道转换完之前DR仍是该采样，DMA读DR不影响；
+*           关闭看门狗中断直到CheckAlarm重新布防，否则越限期间每次转换都会进入中断
+**********************************************************************************************************/
+void ADC1_2_IRQHandler(void)
+{
+  if(ADC_GetITStatus(ADC1, ADC_IT_AWD) != RESET)
+  {
+    ADC_ITConfig(ADC1, ADC_IT_AWD, DISABLE);
+    ADC_ClearITPendingBit(ADC1, ADC_IT_AWD);
+    PostAlarm(ADC_AWD_CH, (uint16)(ADC1->DR << (ADC_RESULT_BITS - 12)));
+  }
 }
 
 /*********************************************************************************************************
@@ -197,27 +555,35 @@ void TIM3_IRQHandler(void)
 **********************************************************************************************************/
 void InitADC(void)
 {
-  ConfigTimer3(799, 719);   //100KHz，计数到800为8ms
+  uint8 ch;
+
+  ConfigTimer3(ADC_SMP_US - 1, 71);  //1MHz，计数到ADC_SMP_US触发一次转换，每ADC_OVS_NUM次转换得到一个读数
   ConfigADC1();             //配置ADC1
   ConfigDMA1Ch1();          //配置DMA1的通道1
+  ConfigAWD();              //配置模拟看门狗
 
-  InitU16Queue(&s_structADCCirQue, s_arrADCBuf, ADC1_BUF_SIZE); //初始化ADC缓冲区  
+  for(ch = 0; ch < ADC_CH_NUM; ch++)
+  {
+    InitU16Queue(&s_arrADCCirQue[ch], s_arrADCBuf[ch], ADC1_BUF_SIZE); //初始化ADC缓冲区  
+    SetU16QueuePolicy(&s_arrADCCirQue[ch], RING_DROP_OLD);            //主循环来不及读时保留最新的采样
+  }
+  InitU16Queue(&s_structWaveCirQue, s_arrWaveBuf, ADC_WAVE_BUF_SIZE);  //波形流丢数只能丢新的，保证队列中的读数连续
 }
 
 /*********************************************************************************************************
 * 函数名称：WriteADCBuf
 * 函数功能：向ADC缓冲区写入数据
-* 输入参数：d-待写入的数据
+* 输入参数：ch-通道，EnumADCChannel，d-待写入的数据
 * 输出参数：void
 * 返 回 值：成功标志位，1为成功，0为不成功
 * 创建日期：2021年07月11日
 * 注    意：
 **********************************************************************************************************/
-uint8 WriteADCBuf(uint16 d)
+uint8 WriteADCBuf(uint8 ch, uint16 d)
 {
   uint8 ok = 0;  //将读取成功标志位的值设置为0
 
-  ok = EnU16Queue(&s_structADCCirQue, &d, 1); //入队
+  ok = EnU16Queue(&s_arrADCCirQue[ch], &d, 1); //入队
 
   return ok;  //返回读取成功标志位的值
 }
@@ -225,30 +591,289 @@ uint8 WriteADCBuf(uint16 d)
 /*********************************************************************************************************
 * 函数名称：ReadADCBuf
 * 函数功能：从ADC缓冲区读取数据
-* 输入参数：p-读取的数据存放的首地址
+* 输入参数：ch-通道，EnumADCChannel，p-读取的数据存放的首地址
 * 输出参数：void
 * 返 回 值：成功标志位，1为成功，0为不成功
 * 创建日期：2021年07月11日
-* 注    意：
+* 注    意：读数为ADC_RESULT_BITS位，满量程ADC_FULL_SCALE；每ADC_OVS_NUM * ADC_SMP_US产生一个
 **********************************************************************************************************/
-uint8 ReadADCBuf(uint16* p)
+uint8 ReadADCBuf(uint8 ch, uint16* p)
 {
   uint8 ok = 0;  //将读取成功标志位的值设置为0
 
-  ok = DeU16Queue(&s_structADCCirQue, p, 1); //出队
+  ok = DeU16Queue(&s_arrADCCirQue[ch], p, 1); //出队
 
   return ok;  //返回读取成功标志位的值
 }
+/*********************************************************************************************************
+* 函数名称：ReadADCBlock
+* 函数功能：从ADC缓冲区读取一块数据
+* 输入参数：ch-通道，EnumADCChannel，p-读取的数据存放的首地址，len-最多读取的个数
+* 输出参数：void
+* 返 回 值：读到的个数
+* 创建日期：2026年10月19日
+* 注    意：供按块滤波使用，一次出队比逐个读取少了每个读数的入口开销
+**********************************************************************************************************/
+uint16 ReadADCBlock(uint8 ch, uint16* p, uint16 len)
+{
+  return (uint16)DeU16Queue(&s_arrADCCirQue[ch], p, (int16)len);
+}
+
 /*********************************************************************************************************
 * 函数名称：ClearADCBuf
 * 函数功能：清除ADC缓冲区的数据
-* 输入参数：void
+* 输入参数：ch-通道，EnumADCChannel
 * 输出参数：void
 * 返 回 值：void
 * 创建日期：2022年3月11日13:07:26
 * 注    意：
 **********************************************************************************************************/
-void ClearADCBuf(void)
+void ClearADCBuf(uint8 ch)
+{
+  ClearU16Queue(&s_arrADCCirQue[ch]);
+}
+
+/*********************************************************************************************************
+* 函数名称：SetADCAlarm
+* 函数功能：设置通道的报警阈值并布防
+* 输入参数：ch-通道，EnumADCChannel，low-下限，high-上限，都是ADC_RESULT_BITS位读数
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：读数低于low或高于high时报警；ADC_AWD_CH的阈值同时写入模拟看门狗，截去低位变为12位
+**********************************************************************************************************/
+void SetADCAlarm(uint8 ch, uint16 low, uint16 high)
+{
+  StructAlarmState* pAlarm = &s_arrAlarm[ch];
+
+  pAlarm->on = 0;  //修改阈值期间DMA中断不检查
+  if(ch == ADC_AWD_CH)
+  {
+    ADC_ITConfig(ADC1, ADC_IT_AWD, DISABLE);
+    ADC_AnalogWatchdogThresholdsConfig(ADC1, high >> (ADC_RESULT_BITS - 12), low >> (ADC_RESULT_BITS - 12));
+  }
+  pAlarm->low   = low;
+  pAlarm->high  = high;
+  pAlarm->armed = 0;  //读数在阈值以内时由CheckAlarm布防
+  __DMB();
+  pAlarm->on    = 1;
+}
+
+/*********************************************************************************************************
+* 函数名称：ClearADCAlarm
+* 函数功能：关闭通道的报警
+* 输入参数：ch-通道，EnumADCChannel
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：未取出的事件仍然保留
+**********************************************************************************************************/
+void ClearADCAlarm(uint8 ch)
+{
+  s_arrAlarm[ch].on    = 0;
+  s_arrAlarm[ch].armed = 0;
+  if(ch == ADC_AWD_CH)
+  {
+    ADC_ITConfig(ADC1, ADC_IT_AWD, DISABLE);
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：ReadADCAlarm
+* 函数功能：取出一个报警事件
+* 输入参数：void
+* 输出参数：pAlarm-报警事件
+* 返 回 值：1--有事件，0--没有
+* 创建日期：2026年10月19日
+* 注    意：在主循环中调用，每个通道最多保留一个事件
+**********************************************************************************************************/
+uint8 ReadADCAlarm(StructADCAlarm* pAlarm)
+{
+  uint8 ch;
+
+  for(ch = 0; ch < ADC_CH_NUM; ch++)
+  {
+    if(s_arrAlarm[ch].pending)
+    {
+      pAlarm->ch    = ch;
+      pAlarm->above = s_arrAlarm[ch].above;
+      pAlarm->adc   = s_arrAlarm[ch].adc;
+      __DMB();  //事件内容读完后再清pending
+      s_arrAlarm[ch].pending = 0;
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+/*********************************************************************************************************
+* 函数名称：ADCAlarmPending
+* 函数功能：查询是否有未取出的报警事件
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：1--有事件，0--没有
+* 创建日期：2026年10月19日
+* 注    意：主循环睡眠前调用
+**********************************************************************************************************/
+uint8 ADCAlarmPending(void)
+{
+  uint8 ch;
+
+  for(ch = 0; ch < ADC_CH_NUM; ch++)
+  {
+    if(s_arrAlarm[ch].pending)
+    {
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+/*********************************************************************************************************
+* 函数名称：StartADCWave
+* 函数功能：开始ch通道的波形流
+* 输入参数：ch-通道，EnumADCChannel，rate-期望的采样率(Hz)
+* 输出参数：void
+* 返 回 值：实际采样率(Hz)，为ADC_WAVE_RATE_MAX / 2^n中不超过rate的最大者，0--失败
+* 创建日期：2026年10月19日
+* 注    意：转换加快ADC_WAVE_DEC倍，ADC功耗相应增加，不用时应调用StopADCWave；
+*           已有波形流时直接切换到新的通道和速率，队列中的旧读数清除
+**********************************************************************************************************/
+uint16 StartADCWave(uint8 ch, uint16 rate)
 {
-  ClearU16Queue(&s_structADCCirQue);
+  uint8 shift = 0;
+
+  if(ch >= ADC_CH_NUM || rate == 0)
+  {
+    return 0;
+  }
+  while((ADC_WAVE_RATE_MAX >> shift) > rate && shift < ADC_WAVE_DEC_SHIFT)
+  {
+    shift++;
+  }
+
+  SwitchWave(ch, shift);
+
+  return ADC_WAVE_RATE_MAX >> shift;
+}
+
+/*********************************************************************************************************
+* 函数名称：StopADCWave
+* 函数功能：停止波形流
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：转换恢复为每ADC_SMP_US一次
+**********************************************************************************************************/
+void StopADCWave(void)
+{
+  if(s_iWaveCh < ADC_CH_NUM)
+  {
+    SwitchWave(ADC_CH_NUM, 0);
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：ReadADCWave
+* 函数功能：读取波形流读数
+* 输入参数：p-读取的数据存放的首地址，len-最多读取的个数
+* 输出参数：void
+* 返 回 值：读到的个数
+* 创建日期：2026年10月19日
+* 注    意：读数为ADC_RESULT_BITS位；主循环每2ms读一次，队列可缓存ADC_WAVE_BUF_SIZE个
+**********************************************************************************************************/
+uint16 ReadADCWave(uint16* p, uint16 len)
+{
+  return (uint16)DeU16Queue(&s_structWaveCirQue, p, (int16)len);
+}
+
+/*********************************************************************************************************
+* 函数名称：GetADCWaveLost
+* 函数功能：返回波形流队列满丢弃的读数个数
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：丢弃的读数个数，只增不减
+* 创建日期：2026年10月19日
+* 注    意：两次读取之间有变化说明读数不连续
+**********************************************************************************************************/
+uint32 GetADCWaveLost(void)
+{
+  return s_iWaveLost;
+}
+
+/*********************************************************************************************************
+* 函数名称：StartADCCapture
+* 函数功能：开始捕获ch通道的原始采样
+* 输入参数：ch-通道，EnumADCChannel，pBuf-存放采样的数组，len-采样个数，rate-期望的采样率(Hz)
+* 输出参数：void
+* 返 回 值：实际采样率(Hz)，为ADC_CAP_RATE_MAX / 2^n中不超过rate的最大者，0--失败
+* 创建日期：2026年10月19日
+* 注    意：采样为ADC_RESULT_BITS位量纲，低位为0；pBuf在StopADCCapture之前必须一直有效；
+*           转换加快ADC_WAVE_DEC倍，Sensor的读数不受影响；已在捕获时重新开始
+**********************************************************************************************************/
+uint16 StartADCCapture(uint8 ch, uint16* pBuf, uint16 len, uint16 rate)
+{
+  uint8 shift = 0;
+
+  if(ch >= ADC_CH_NUM || pBuf == NULL || len == 0 || rate == 0)
+  {
+    return 0;
+  }
+  while((ADC_CAP_RATE_MAX >> shift) > rate && shift < ADC_CAP_SHIFT_MAX)
+  {
+    shift++;
+  }
+
+  NVIC_DisableIRQ(DMA1_Channel1_IRQn);
+
+  s_iCapCh    = ch;
+  s_pCapBuf   = pBuf;
+  s_iCapLen   = len;
+  s_iCapNum   = 0;
+  s_iCapShift = shift;
+  s_iCapCnt   = 0;
+  s_iCapSum   = 0;
+  s_iCapSkip  = ADC_CAP_SKIP;
+  SetFastConv();
+
+  NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+
+  return ADC_CAP_RATE_MAX >> shift;
+}
+
+/*********************************************************************************************************
+* 函数名称：ADCCaptureDone
+* 函数功能：查询捕获是否完成
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：1--捕获的采样已存满，0--没有捕获或还没存满
+* 创建日期：2026年10月19日
+* 注    意：
+**********************************************************************************************************/
+uint8 ADCCaptureDone(void)
+{
+  return (s_iCapCh < ADC_CH_NUM) && (s_iCapNum >= s_iCapLen);
+}
+
+/*********************************************************************************************************
+* 函数名称：StopADCCapture
+* 函数功能：结束捕获
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：没有波形流时转换恢复为每ADC_SMP_US一次；之后中断不再写捕获数组
+**********************************************************************************************************/
+void StopADCCapture(void)
+{
+  if(s_iCapCh < ADC_CH_NUM)
+  {
+    NVIC_DisableIRQ(DMA1_Channel1_IRQn);
+    s_iCapCh = ADC_CH_NUM;
+    SetFastConv();
+    NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+  }
 }
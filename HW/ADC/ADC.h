@@ -7,10 +7,15 @@
 * 内    容：
 * 注    意：                                                                  
 **********************************************************************************************************
-* 取代版本：
-* 作    者：
-* 完成日期：
-* 修改内容：
+* 取代版本：1.1.0
+* 作    者：LYL
+* 完成日期：2026年10月19日
+* 修改内容：TIM3触发转换，DMA循环传输到乒乓缓冲区，半满/全满中断中过采样抽取为14位读数；
+*           扫描多个通道，每个通道一个读数缓冲区；
+*           各通道可设上下限报警，ADC_AWD_CH由模拟看门狗逐个采样比较，其余通道在抽取时比较读数；
+*           波形流：StartADCWave后转换加快ADC_WAVE_DEC倍，选定通道的快读数另存一个队列供波形流读取，
+*           各通道缓冲区中仍是平均后的普通读数，速率不变；
+*           捕获：StartADCCapture后转换同样加快，选定通道的12位原始采样直接存入调用者的数组，存满为止，供FFT分析
 * 修改文件：
 *********************************************************************************************************/
 #ifndef _ADC_H_
@@ -24,18 +29,69 @@
 /*********************************************************************************************************
 *                                              宏定义
 *********************************************************************************************************/
-#define ADC1_BUF_SIZE 100           //设置缓冲区的大小
+#define ADC1_BUF_SIZE 128           //每个通道读数缓冲区的大小，必须为2的幂
+
+#define ADC_SMP_US      500         //TIM3触发转换的周期(us)
+#define ADC_OVS_NUM     16          //每个读数的过采样次数，4^n次过采样多得到n位分辨率
+#define ADC_OVS_SHIFT   2           //过采样累加和右移的位数，16次累加和右移2位得到14位读数
+#define ADC_RESULT_BITS 14          //读数的位数
+#define ADC_FULL_SCALE  (1 << ADC_RESULT_BITS)  //读数的满量程，对应参考电压3.3V
+#define ADC_BLOCK_NUM   2           //乒乓缓冲区每半块包含的读数个数，半块填满产生一次中断
+
+#define ADC_WAVE_DEC_SHIFT 2        //波形流时转换加快2^n倍，每2^n个快读数平均为一个普通读数
+#define ADC_WAVE_DEC    (1 << ADC_WAVE_DEC_SHIFT)
+#define ADC_WAVE_SMP_US (ADC_SMP_US / ADC_WAVE_DEC)  //波形流时TIM3触发转换的周期(us)，须大于扫描全部通道的时间约60us
+#define ADC_WAVE_RATE_MAX (1000000 / (ADC_WAVE_SMP_US * ADC_OVS_NUM))  //波形流的最高采样率(Hz)，即快读数的速率500Hz
+#define ADC_WAVE_BUF_SIZE 256       //波形流队列的大小，必须为2的幂，500Hz时可缓存512ms
+
+#define ADC_CAP_RATE_MAX  (1000000 / ADC_WAVE_SMP_US)  //捕获的最高采样率(Hz)，即快速转换时每个通道的采样率8000Hz
+#define ADC_CAP_SHIFT_MAX 4         //捕获时最多每2^n个采样平均为一个，最低采样率为ADC_CAP_RATE_MAX / 16
+#define ADC_CAP_SKIP      2         //开始捕获后丢弃的半块数，其中可能有切换转换速率之前的采样
+
+#define ADC_AWD_CH      ADC_CH_AIN1 //由模拟看门狗硬件比较的通道，越限后几us内进入中断
+#define ADC_ALARM_HYST  64          //回差，读数回到阈值以内这么多才重新布防，防止在阈值附近反复报警
 
 /*********************************************************************************************************
 *                                              枚举结构体定义
 *********************************************************************************************************/
+//扫描序列中的通道，顺序与ADC.c中s_arrScanCh一致
+typedef enum
+{
+  ADC_CH_TEMP = 0,  //内部温度传感器，ADC通道16
+  ADC_CH_VREF,      //内部参考电压，ADC通道17，用于计算供电电压
+  ADC_CH_AIN1,      //外部模拟输入，PA1-ADC通道1
+  ADC_CH_NUM,       //扫描的通道数
+}EnumADCChannel;
+
+//越限报警事件
+typedef struct
+{
+  uint8  ch;     //通道，EnumADCChannel
+  uint8  above;  //1--高于上限，0--低于下限
+  uint16 adc;    //越限时的读数，ADC_RESULT_BITS位
+}StructADCAlarm;
 
 /*********************************************************************************************************
 *                                              API函数声明
 *********************************************************************************************************/
 void InitADC(void);  //初始化ADC模块
 
-uint8   WriteADCBuf(uint16 d); //向ADC缓冲区写入数据
-uint8   ReadADCBuf(uint16 *p); //从ADC缓冲区读取数据
-void    ClearADCBuf(void);     //清除ADC缓冲区的数据
+uint8   WriteADCBuf(uint8 ch, uint16 d); //向ch通道的缓冲区写入数据
+uint8   ReadADCBuf(uint8 ch, uint16 *p); //从ch通道的缓冲区读取一个ADC_RESULT_BITS位的读数
+uint16  ReadADCBlock(uint8 ch, uint16 *p, uint16 len); //从ch通道的缓冲区最多读取len个读数，返回读到的个数
+void    ClearADCBuf(uint8 ch);           //清除ch通道缓冲区的数据
+
+void    SetADCAlarm(uint8 ch, uint16 low, uint16 high); //设置ch通道的报警阈值，读数低于low或高于high时报警
+void    ClearADCAlarm(uint8 ch);                        //关闭ch通道的报警
+uint8   ReadADCAlarm(StructADCAlarm* pAlarm);           //取出一个报警事件，1--有事件
+uint8   ADCAlarmPending(void);                          //1--有未取出的报警事件
+
+uint16  StartADCWave(uint8 ch, uint16 rate);    //开始ch通道的波形流，返回实际采样率(Hz)，0--失败
+void    StopADCWave(void);                      //停止波形流，转换恢复为ADC_SMP_US
+uint16  ReadADCWave(uint16* p, uint16 len);     //最多读取len个波形流读数，返回读到的个数
+uint32  GetADCWaveLost(void);                   //波形流队列满丢弃的读数个数，只增不减
+
+uint16  StartADCCapture(uint8 ch, uint16* pBuf, uint16 len, uint16 rate); //开始捕获ch通道的len个采样，返回实际采样率(Hz)，0--失败
+uint8   ADCCaptureDone(void);                   //1--捕获的采样已存满
+void    StopADCCapture(void);                   //结束捕获，没有波形流时转换恢复为ADC_SMP_US
 #endif
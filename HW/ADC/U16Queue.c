@@ -7,10 +7,10 @@
 * 内    容：
 * 注    意：                                                                  
 **********************************************************************************************************
-* 取代版本：
-* 作    者：
-* 完成日期：
-* 修改内容：
+* 取代版本：1.1.0
+* 作    者：LYL
+* 完成日期：2026年10月19日
+* 修改内容：改为Ring模块的封装，读写位置分离，中断与主循环之间不再共用元素计数
 * 修改文件：
 *********************************************************************************************************/
 
@@ -50,22 +50,11 @@
 * 输出参数：pQue-结构体指针，即指向结构体变量的地址
 * 返 回 值：void
 * 创建日期：2021年07月11日
-* 注    意：
+* 注    意：len应为2的幂，否则只使用不超过len的最大2的幂个元素
 *********************************************************************************************************/
 void  InitU16Queue(StructU16CirQue* pQue, uint16* pBuf, int16 len)
 {
-  int16 i;
-
-  pQue->front   = 0;    //队头
-  pQue->rear    = 0;    //队尾
-  pQue->bufLen  = len;  //缓冲区长度（队列容量）
-  pQue->elemNum = 0;    //当前队列中元素的个数
-  pQue->pBuffer = pBuf; //指针变量pBuf赋给指针变量pQue->pBuffer
-  
-  for(i = 0; i < len; i++)
-  {
-    pQue->pBuffer[i]  = 0;  //对指针变量pQue->pBuffer所指向的元素均赋初值0
-  }
+  InitRing(pQue, pBuf, sizeof(uint16), (uint16)len);
 }
 
 /*********************************************************************************************************
@@ -75,41 +64,39 @@ void  InitU16Queue(StructU16CirQue* pQue, uint16* pBuf, int16 len)
 * 输出参数：pQue-结构体指针，即指向结构体变量的地址
 * 返 回 值：void
 * 创建日期：2021年07月11日
-* 注    意：
+* 注    意：由出队的一方调用
 *********************************************************************************************************/
 void  ClearU16Queue(StructU16CirQue* pQue)
 {
-  pQue->front   = 0; //队头
-  pQue->rear    = 0; //队尾
-  pQue->elemNum = 0; //当前队列中元素的个数
+  ClearRing(pQue);
 }
 
 /*********************************************************************************************************
-* 函数名称：QueueEmpty
+* 函数名称：U16QueueEmpty
 * 函数功能：判断队列是否为空，1为空，0为非空 
 * 输入参数：pQue-结构体指针，即指向结构体变量的地址
-* 输出参数：pQue-结构体指针，即指向结构体变量的地址
+* 输出参数：void
 * 返 回 值：返回队列是否为空，1为空，0为非空
 * 创建日期：2021年07月11日
 * 注    意：
 *********************************************************************************************************/
 uint8    U16QueueEmpty(StructU16CirQue* pQue)
 {
-  return(0 == pQue->elemNum);
+  return(0 == RingLength(pQue));
 }
 
 /*********************************************************************************************************
 * 函数名称：U16QueueLength
-* 函数功能：返回队列中元素个数
+* 函数功能：返回队列中元素个数 
 * 输入参数：pQue-结构体指针，即指向结构体变量的地址
-* 输出参数：pQue-结构体指针，即指向结构体变量的地址
+* 输出参数：void
 * 返 回 值：队列中元素的个数
 * 创建日期：2021年07月11日
 * 注    意：
 *********************************************************************************************************/
 int16   U16QueueLength(StructU16CirQue* pQue)
 {
-  return(pQue->elemNum);
+  return (int16)RingLength(pQue);
 }
 
 /*********************************************************************************************************
@@ -119,29 +106,11 @@ int16   U16QueueLength(StructU16CirQue* pQue)
 * 输出参数：pQue-结构体指针，即指向结构体变量的地址
 * 返 回 值：成功入队的元素的数量
 * 创建日期：2021年07月11日
-* 注    意：每次插入一个元素，rear自增，当rear的值大于等于队列容量bufLen时，rear值变为0。需要注意的是，当队
-*           列中的元素数量加上待写入的元素数量超过队列容量时，队列允许写入的元素数量等于队列中的元素数量+新写
-*           入的元素数量-队列的容量，即EnQueue函数对于超出元素采取不理睬的态度。
+* 注    意：空间不足时按SetU16QueuePolicy设置的策略丢弃，默认只写入能放下的部分；只能由一个生产者调用
 *********************************************************************************************************/
 int16 EnU16Queue(StructU16CirQue* pQue, uint16* pInput, int16 len)
 {
-  int16 wLen = 0; //待入队的元素有len个，wLen从0增加到len-1
-  
-  while((pQue->elemNum < pQue->bufLen) && (wLen < len))
-  {
-    pQue->pBuffer[pQue->rear] = pInput[wLen]; //将待入队的第wLen个元素pInput[wLen]插入队列
-    pQue->rear++;     //队尾rear自增，即指向队尾元素的下一个位置
-    
-    if(pQue->rear >= pQue->bufLen)
-    {
-      pQue->rear = 0; //如果队尾元素的下一个位置为pQue->bufLen，则rear指向队头，循环体现在此处
-    }
-
-    wLen++;
-    pQue->elemNum++;  //当前队列中的元素总数
-  }
-
-  return wLen;  //如果返回值wLen为0，表示没有元素入队
+  return (int16)RingPut(pQue, pInput, (uint16)len);
 }
 
 /*********************************************************************************************************
@@ -151,30 +120,23 @@ int16 EnU16Queue(StructU16CirQue* pQue, uint16* pInput, int16 len)
 * 输出参数：pQue-结构体指针，即指向结构体变量的地址，pOutput-出队元素存放的数组的地址
 * 返 回 值：成功出队的元素的数量
 * 创建日期：2021年07月11日
-* 注    意：每次取出一个元素，front自增，当front的值大于等于队列容量bufLen时，front值变为0。需要特别注意，从
-*           队列中读取元素的前提是队列中需要至少有一个元素，当期望取出的元素数量len小于或等于队列中元素的数量
-*           时，可以按期望取出len个元素，否则，只能取出队列中已有的所有元素。 
+* 注    意：元素不够时只能取出队列中已有的所有元素；只能由一个消费者调用
 *********************************************************************************************************/
 int16 DeU16Queue(StructU16CirQue* pQue, uint16* pOutput, int16 len)
 {
-  int16 rLen = 0; //期望取出len个元素，最终能取出rLen个元素
-  
-  while((pQue->elemNum > 0) && (rLen < len))
-  {
-    pOutput[rLen] = pQue->pBuffer[pQue->front];
-    pQue->front++;
-    
-    if( pQue->front >= pQue->bufLen )
-    {
-      pQue->front = 0;//如果队头元素的下一个位置为pQue->bufLen，则front指向队头，循环体现在此处
-    }
-
-    rLen++;
-    pQue->elemNum--;  //当前队列中的元素总数
-  }
-
-  return rLen;  //如果返回值rLen为0，表示队列中没有元素
+  return (int16)RingGet(pQue, pOutput, (uint16)len);
 }
 
-
-
+/*********************************************************************************************************
+* 函数名称：SetU16QueuePolicy
+* 函数功能：设置队列满时的丢弃策略
+* 输入参数：pQue-结构体指针，即指向结构体变量的地址，policy-丢弃策略，EnumRingPolicy
+* 输出参数：pQue-结构体指针，即指向结构体变量的地址
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+void SetU16QueuePolicy(StructU16CirQue* pQue, uint8 policy)
+{
+  RingSetPolicy(pQue, policy);
+}
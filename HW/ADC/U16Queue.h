@@ -7,10 +7,10 @@
 * 内    容：
 * 注    意：                                                                  
 **********************************************************************************************************
-* 取代版本：
-* 作    者：
-* 完成日期：
-* 修改内容：
+* 取代版本：1.1.0
+* 作    者：LYL
+* 完成日期：2026年10月19日
+* 修改内容：改为Ring模块的封装，读写位置分离，中断与主循环之间不再共用元素计数
 * 修改文件：
 *********************************************************************************************************/
 #ifndef _U16_QUEUE_H_
@@ -20,6 +20,7 @@
 *                                              包含头文件
 *********************************************************************************************************/
 #include "DataType.h"
+#include "Ring.h"
 
 /*********************************************************************************************************
 *                                              宏定义
@@ -28,15 +29,8 @@
 /*********************************************************************************************************
 *                                              枚举结构体定义
 *********************************************************************************************************/
-//定义循环队列结构体
-typedef struct
-{
-  int16 front;     //头指针，队非空时指向队头元素
-  int16 rear;      //尾指针，队非空时指向队尾元素的下一个位置
-  int16 bufLen;    //队列的总容量
-  int16 elemNum;   //当前队列中的元素的数量
-  uint16 *pBuffer;  //循环队列的缓冲区
-}StructU16CirQue;
+//定义循环队列结构体，即元素大小为2字节的环形缓冲区
+typedef StructRing StructU16CirQue;
 
 /*********************************************************************************************************
 *                                              API函数声明
@@ -47,5 +41,6 @@ uint8    U16QueueEmpty(StructU16CirQue* pQue);                     //判断队
 int16   U16QueueLength(StructU16CirQue* pQue);                    //返回队列中元素个数，即为队列的长度
 int16   EnU16Queue(StructU16CirQue* pQue, uint16* pInput, int16 len);  //入队len个元素
 int16   DeU16Queue(StructU16CirQue* pQue, uint16* pOutput, int16 len); //出队len个元素
+void  SetU16QueuePolicy(StructU16CirQue* pQue, uint8 policy);   //设置队列满时的丢弃策略，EnumRingPolicy
 
 #endif
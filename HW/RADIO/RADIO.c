@@ -15,6 +15,7 @@
                 5V      ------->    PWR
 * 注    意：LORA模块电压要求比单片机高，若单片机拉电线给LORA供电，有时射频电压不够大，发送失败。 
             配置Lora模块，去壹佰特搜索E22-400T22S1C，下载RF_Setting(E22-E9X(SL)) V2.3 配置软件，正确配置接线帽，即可设置参数
+            AUX消抖占用TIM6
 **********************************************************************************************************
 * 取代版本：
 * 作    者：
@@ -32,6 +33,9 @@
 #include "SysTick.h"
 #include "UART1.h"
 #include <stdlib.h>
+#include <string.h>
+
+#if (RADIO_BACKEND == RADIO_BACKEND_E22)  //E22串口模块后端，SX126x后端见RadioSX126x.c
 
 /*********************************************************************************************************
 *                                              宏定义
@@ -55,6 +59,22 @@
 #define PID7            0x86
 
 #define LoRaBufMax      1000
+
+#define E22_CMD_WRITE     0xC0    //写寄存器并掉电保存
+#define E22_CMD_READ      0xC1    //读寄存器，也是写寄存器的应答头
+#define E22_CMD_WRITE_TEMP  0xC2  //写寄存器不保存，掉电恢复
+#define E22_REG_NUM       7       //工作参数寄存器个数，0x00~0x06
+#define E22_CONFIG_BAUD   9600    //配置模式下模块串口波特率固定为9600,8N1
+#define E22_RESP_TIMEOUT  100     //等待模块应答的超时时间(ms)
+
+#define E22_NOISE_PERIOD  1000    //读取环境噪声的周期(ms)
+#define E22_NOISE_IDLE    50      //串口1连续无数据超过该时间(ms)才读取环境噪声，避免应答混入数据包
+#define E22_NOISE_TIMEOUT 50      //等待环境噪声应答的超时时间(ms)
+#define E22_NOISE_REG     0x00    //环境噪声寄存器，0x01为上一包的RSSI
+
+#define AUX_DEBOUNCE_US   100     //AUX消抖时间(us)，由TIM6单次定时
+#define AUX_LAG_US        5000    //串口数据发完到模块拉低AUX的最长时间(us)
+#define AUX_EVENT_NUM     8       //AUX事件队列长度，必须为2的幂
 /*********************************************************************************************************
 *                                              枚举结构体定义
 *********************************************************************************************************/
@@ -64,26 +84,79 @@ typedef enum
   AUX_STATE_FREE  = 0x01,
 }Enum_s_Aux_State;
 
+//AUX电平变化事件
+typedef struct
+{
+  uint32 time;    //边沿时刻(us)，取自EXTI中断
+  uint8  state;   //变化后的状态，Enum_s_Aux_State
+}StructAuxEvent;
+
 /*********************************************************************************************************
 *                                              内部变量
 *********************************************************************************************************/
 static uint8 s_curMode;       //当前模式
 volatile static uint8  s_Aux; //Aux位
-const static uint8 s_arrSetting[9] = {0xC0, 0x00, 0x00, 0x62, 0x00, 0x17, 0x03, 0x00, 0x00 }; //存放已设置的参数
 static uint16 s_address;      //Lora模块地址
 static uint16 s_RadioBuf;     //Lora模块缓冲区当前大小
 
+static uint8  s_arrShadow[E22_REG_NUM];  //影子寄存器，模块0x00~0x06寄存器的当前值
+static uint8  s_iShadowValid;            //1--影子寄存器与模块一致
+static StructE22Profile s_structProfile; //模块当前工作参数
+
+//默认工作参数：串口115200，空中速率2.4k，定点传输，使能环境噪声和RSSI字节，WOR发送方，WOR周期2s
+static const StructE22Profile s_structDefProfile = {
+  0x00, E22_BAUD_115200, E22_AIR_2K4, E22_SUB_240, 1, E22_POWER_22DBM, 0x17, RADIO_RSSI_BYTE, 1, 0, 1, 0x03
+};
+
+//出厂工作参数：串口9600，空中速率2.4k，透明传输
+static const StructE22Profile s_structFactoryProfile = {
+  0x00, E22_BAUD_9600, E22_AIR_2K4, E22_SUB_240, 0, E22_POWER_22DBM, 0x17, 0, 0, 0, 0, 0x03
+};
+
+//EnumE22Baud对应的波特率
+static const uint32 s_arrE22Baud[8] = {1200, 2400, 4800, 9600, 19200, 38400, 57600, 115200};
+
+static StructAuxEvent  s_arrAuxEvent[AUX_EVENT_NUM];  //AUX事件队列，TIM6中断写入，RadioProc读出
+static volatile uint8  s_iAuxEvtHead;     //写位置
+static volatile uint8  s_iAuxEvtTail;     //读位置
+static volatile uint32 s_iAuxEdgeTime;    //最近一个AUX边沿的时刻(us)
+static volatile uint8  s_iAuxEdgeLevel;   //最近一个AUX边沿后的电平
+static uint32 s_iTxStartUs;               //本轮发送第一帧写入串口的时刻(us)
+static uint8  s_iTxFrames;                //本轮发送尚未发完的帧数
+static uint32 s_iTxLatency;               //最近一轮发送每帧的平均时延(us)
+
+static uint32 s_iLastRxMs;                //最近一次从串口1读到数据的时刻(ms)
+static uint32 s_iNoiseReqMs;              //最近一次请求环境噪声的时刻(ms)
+static uint8  s_iNoisePending;            //1--等待环境噪声应答
+static uint8  s_iNoiseRespLen;            //已收到的应答字节数
+static uint8  s_iNoiseValid;              //1--有未读取的环境噪声测量值
+static int16  s_iNoise;                   //环境噪声(dBm)
+static uint8  s_arrRxBack[4];             //不是噪声应答、交还给上层的字节
+static uint8  s_iRxBackLen;               //交还的字节数
+static uint8  s_iRxBackPos;               //已读出的交还字节数
+static const uint8 s_arrNoiseHead[3] = {0xC1, E22_NOISE_REG, 0x01};  //环境噪声应答头
+
+static uint8  s_iIdleMode = MODEM_TRANSFER;  //发送完成后回到的模式
+
 /*********************************************************************************************************
 *                                              内部函数声明
 *********************************************************************************************************/
-static  void  DeInitLora(void);                                 //初始化模块参数---恢复出厂设置
 static  void  ConfigLRGPIO(void);                               //配置LOAR串口模块与单片机相连的GPIO
+static  void  ConfigAuxTimer(void);                             //配置AUX消抖用的TIM6
+static  void  OnAuxEvent(StructAuxEvent* pEvent);               //处理AUX事件
+static  void  RequestNoise(void);                               //空闲时请求环境噪声
+static  uint8 ParseNoiseResp(uint8 data);                       //解析环境噪声应答
+static  void  ReturnNoiseHead(void);                            //把已匹配的应答头交还给上层
 static  uint8    ConfigLRMode(uint8 mode);                 //配置LORA模块的模式
-static  uint8    readRegister(uint8 address);                         //读寄存器
-static  uint8    readRegisters(uint8 addHead, uint8 len, uint8* pBufdata);  //读寄存器组
-static  uint8    writeRegister(uint8 address, uint8 value);              //写寄存器
-static  uint8    writeRegisters(uint8 addHead, uint8 value);             //写寄存器组
+static  uint8    RecvConfigResp(uint8* pBuf, uint8 len);   //接收配置指令的应答
+static  uint8    EnterConfigMode(void);                    //进入配置模式
+static  void     LeaveConfigMode(void);                    //回到传输模式
+static  uint8    ReadRegs(uint8 addHead, uint8 len, uint8* pBuf);        //读寄存器组
+static  uint8    WriteRegs(uint8 cmd, uint8 addHead, uint8 len, const uint8* pBuf); //写寄存器组
+static  void     ProfileToRegs(const StructE22Profile* pProfile, uint8* pRegs); //工作参数转换为寄存器值
 static  uint8    GetAuxState(void);                                //查询LORA模块状态,1--空闲, 0--繁忙
+static  uint8    SetWorRole(uint8 worTx);                          //临时设置WOR角色
+static  uint8    SendInMode(uint16 addr, uint8 channel, uint8 *pData, uint8 size, uint8 mode); //在指定模式下发送数据
 
 /*********************************************************************************************************
 *                                              内部函数实现
@@ -143,6 +216,39 @@ static  void  ConfigLRGPIO(void)
   NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;               //使能中断
   NVIC_Init(&NVIC_InitStructure);                               //根据参数初始化NVIC 
 
+  ConfigAuxTimer();                                             //AUX消抖定时器
+}
+
+/*********************************************************************************************************
+* 函数名称：ConfigAuxTimer
+* 函数功能：配置AUX消抖用的TIM6，单脉冲模式，每次AUX边沿后重新启动
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：TIM6时钟为72MHz，预分频后1MHz，定时AUX_DEBOUNCE_US微秒；优先级与EXTI4相同，两者不会互相打断
+*********************************************************************************************************/
+static  void  ConfigAuxTimer(void)
+{
+  TIM_TimeBaseInitTypeDef  TIM_TimeBaseStructure;//TIM_TimeBaseStructure用于存放定时器的参数
+  NVIC_InitTypeDef NVIC_InitStructure;           //NVIC_InitStructure用于存放NVIC的参数
+
+  RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM6, ENABLE);  //使能TIM6的时钟
+
+  TIM_TimeBaseStructure.TIM_Period        = AUX_DEBOUNCE_US - 1;  //设置自动重装载值
+  TIM_TimeBaseStructure.TIM_Prescaler     = 71;                   //72MHz/(71+1)=1MHz
+  TIM_TimeBaseStructure.TIM_ClockDivision = TIM_CKD_DIV1;
+  TIM_TimeBaseStructure.TIM_CounterMode   = TIM_CounterMode_Up;
+  TIM_TimeBaseInit(TIM6, &TIM_TimeBaseStructure);
+  TIM_SelectOnePulseMode(TIM6, TIM_OPMode_Single);      //溢出后自动停止
+  TIM_ClearITPendingBit(TIM6, TIM_IT_Update);           //TIM_TimeBaseInit产生的更新事件不处理
+  TIM_ITConfig(TIM6, TIM_IT_Update, ENABLE);
+
+  NVIC_InitStructure.NVIC_IRQChannel = TIM6_IRQn;               //中断通道号
+  NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 2;     //设置抢占优先级
+  NVIC_InitStructure.NVIC_IRQChannelSubPriority = 2;            //设置子优先级
+  NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;               //使能中断
+  NVIC_Init(&NVIC_InitStructure);
 }
 
 /*********************************************************************************************************
@@ -152,7 +258,8 @@ static  void  ConfigLRGPIO(void)
 * 输出参数：void
 * 返 回 值：void
 * 创建日期：2022年02月10日
-* 注    意：PB4(Aux位)上升沿中断处理，捕获LORA模块响应信号
+* 注    意：PB4(Aux位)边沿中断，只记录边沿时刻和电平并(重新)启动TIM6，
+*           AUX_DEBOUNCE_US内没有新边沿，才由TIM6中断确认状态变化
 *********************************************************************************************************/
 void EXTI4_IRQHandler(void)  
 {  
@@ -160,24 +267,150 @@ void EXTI4_IRQHandler(void)
   {
     EXTI_ClearITPendingBit(EXTI_Line4);     //清除外部中断标志
     
-    if(GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_4) == 1)
+    s_iAuxEdgeTime  = micros();
+    s_iAuxEdgeLevel = GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_4);
+    
+    TIM_SetCounter(TIM6, 0);                //抖动时重新计时
+    TIM_Cmd(TIM6, ENABLE);
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：TIM6_IRQHandler
+* 函数功能：TIM6中断服务函数，AUX消抖结束
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：电平与边沿时一致才认为AUX状态改变，事件时刻取边沿时刻；事件队列满时丢弃最新事件，s_Aux仍然更新
+*********************************************************************************************************/
+void TIM6_IRQHandler(void)
+{
+  uint8 level;
+  uint8 next;
+
+  if(TIM_GetITStatus(TIM6, TIM_IT_Update) == SET)
+  {
+    TIM_ClearITPendingBit(TIM6, TIM_IT_Update);
+
+    level = GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_4);
+    if(level == s_iAuxEdgeLevel && level != s_Aux)
     {
-      DelayNus(100);//消抖
-      if(GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_4) == 1)
+      s_Aux = level ? AUX_STATE_FREE : AUX_STATE_BUSSY;   //高电平表示LORA模块空闲
+
+      next = (s_iAuxEvtHead + 1) & (AUX_EVENT_NUM - 1);
+      if(next != s_iAuxEvtTail)
       {
-        s_Aux = AUX_STATE_FREE;                 //上升沿中断表示LORA模块空闲
+        s_arrAuxEvent[s_iAuxEvtHead].time  = s_iAuxEdgeTime;
+        s_arrAuxEvent[s_iAuxEvtHead].state = s_Aux;
+        s_iAuxEvtHead = next;
       }
     }
-    else
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：OnAuxEvent
+* 函数功能：处理AUX事件，统计发送时延
+* 输入参数：pEvent-AUX事件
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：模块把串口收到的数据全部发完后AUX才变高，连续发送多帧时得到的是平均时延
+*********************************************************************************************************/
+static  void  OnAuxEvent(StructAuxEvent* pEvent)
+{
+  if(pEvent->state == AUX_STATE_FREE && s_iTxFrames > 0)
+  {
+    s_iTxLatency = (pEvent->time - s_iTxStartUs) / s_iTxFrames;
+    s_iTxFrames  = 0;
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：RequestNoise
+* 函数功能：空闲时请求环境噪声
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：传输模式下发送|C0 C1 C2 C3 |起始地址 |长度 |，应答|C1 |起始地址 |长度 |值 |混在接收数据中，
+*           所以只在模块空闲、串口1一段时间没有数据时请求，应答由RadioReadData取出
+*********************************************************************************************************/
+static  void  RequestNoise(void)
+{
+  uint8  arrCmd[6] = {0xC0, 0xC1, 0xC2, 0xC3, E22_NOISE_REG, 0x01};
+  uint32 now = millis();
+
+  if(s_iNoisePending)
+  {
+    if(now - s_iNoiseReqMs > E22_NOISE_TIMEOUT)
+    {
+      ReturnNoiseHead();     //应答超时，已匹配的字节是数据
+      s_iNoisePending = 0;
+    }
+    return;
+  }
+
+  if(now - s_iNoiseReqMs >= E22_NOISE_PERIOD && now - s_iLastRxMs >= E22_NOISE_IDLE &&
+     s_curMode == MODEM_TRANSFER && GetAuxState() && !GetUART1TxSts() && s_iTxFrames == 0)
+  {
+    s_iNoiseRespLen = 0;
+    s_iNoisePending = 1;
+    s_iNoiseReqMs   = now;
+    WriteUART1(arrCmd, 6);
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：ParseNoiseResp
+* 函数功能：解析环境噪声应答
+* 输入参数：data-串口1收到的字节
+* 输出参数：void
+* 返 回 值：1--该字节已处理，0--不是应答，交给上层
+* 创建日期：2026年10月19日
+* 注    意：只匹配了一部分应答头的字节属于数据包，连同该字节一起交还给上层
+*********************************************************************************************************/
+static  uint8 ParseNoiseResp(uint8 data)
+{
+  if(s_iNoiseRespLen < 3)
+  {
+    if(data != s_arrNoiseHead[s_iNoiseRespLen])
     {
-      DelayNus(100);//消抖
-      if(GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_4) == 0)
+      s_iNoisePending = 0;   //不是应答
+      if(s_iNoiseRespLen == 0)
       {
-        s_Aux = AUX_STATE_BUSSY;                 //下降沿中断表示LORA模块空闲
+        return 0;
       }
+      ReturnNoiseHead();
+      s_arrRxBack[s_iRxBackLen++] = data;
+      return 1;
     }
-    
+    s_iNoiseRespLen++;
+    return 1;
   }
+
+  s_iNoise        = RADIO_RSSI_DBM(data);
+  s_iNoiseValid   = 1;
+  s_iNoisePending = 0;
+  return 1;
+}
+
+/*********************************************************************************************************
+* 函数名称：ReturnNoiseHead
+* 函数功能：把已匹配的应答头交还给上层
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：由RadioReadData在读串口1之前先读出
+*********************************************************************************************************/
+static  void  ReturnNoiseHead(void)
+{
+  memcpy(s_arrRxBack, s_arrNoiseHead, s_iNoiseRespLen);
+  s_iRxBackLen    = s_iNoiseRespLen;
+  s_iRxBackPos    = 0;
+  s_iNoiseRespLen = 0;
 }
 
 /*********************************************************************************************************
@@ -210,150 +443,168 @@ static  uint8  ConfigLRMode(uint8 mode)
 }
 
 /*********************************************************************************************************
-* 函数名称：readRegister
-* 函数功能：读寄存器
-* 输入参数：address--待读寄存器地址
-* 输出参数：
-* 返 回 值：
-* 创建日期：2021年11月6日
+* 函数名称：RecvConfigResp
+* 函数功能：接收模块对配置指令的响应
+* 输入参数：pBuf-响应存放的首地址，len-期望的响应长度
+* 输出参数：pBuf
+* 返 回 值：1--收齐len个字节，0--超时
+* 创建日期：2026年10月19日
 * 注    意：
 *********************************************************************************************************/
-static uint8 readRegister(uint8 address)
+static uint8 RecvConfigResp(uint8* pBuf, uint8 len)
 {
-  //               指令, 地址 , 长度
-  uint8 pBufCMD[3] = {0xc1, 0x00, 0x01 };
-  uint8 pBufRes[4];
-  uint8 i,response;
+  uint8  cnt = 0;
   uint32 lastMillis;
-  
-  pBufCMD[1] = address;
-  
-  ConfigLRMode(MODEM_CONFIG); //设置配置模式
-  while(!isLoRaReady());      //等待设置完成
-  
-  WriteUART1(pBufCMD, 3);     //发送指令
-  
-  i=0;
+
   lastMillis = millis();      //当前毫秒数
-  while(i < 4 || millis() - lastMillis <= 100)//收到4字节或等待超过0.1S退出循环
+  while(cnt < len && millis() - lastMillis <= E22_RESP_TIMEOUT)//收齐或超时退出循环
   {
-    i += ReadUART1(&pBufRes[i] , 4);
+    cnt += ReadUART1(&pBuf[cnt], len - cnt);
   }
-  ConfigLRMode(MODEM_TRANSFER);   //设置退出配置模式，回到上次模式
-  
-  for(i=0; i<3; i++)
+
+  return cnt == len;
+}
+
+/*********************************************************************************************************
+* 函数名称：EnterConfigMode
+* 函数功能：进入配置模式，串口1切换到配置模式的波特率
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：1--成功，0--失败
+* 创建日期：2026年10月19日
+* 注    意：先等串口1发完，再丢弃接收缓冲区中残留的数据
+*********************************************************************************************************/
+static uint8 EnterConfigMode(void)
+{
+  uint8  temp;
+  uint32 lastMillis;
+
+  lastMillis = millis();
+  while(GetUART1TxSts() && millis() - lastMillis <= E22_RESP_TIMEOUT * 5);  //等待串口1发送完成
+
+  SetUART1Baud(E22_CONFIG_BAUD);
+  if(!ConfigLRMode(MODEM_CONFIG))
   {
-    if(pBufRes[i] != pBufCMD[i])
-    {
-      return 0; //读取失败
-    }
+    return 0;
   }
-  response = pBufRes[3];
-  
-  return response;
+  DelayNms(2);        //模式切换后至少2ms才能接收指令
+
+  while(ReadUART1(&temp, 1));  //丢弃残留数据
+
+  return 1;
 }
 
 /*********************************************************************************************************
-* 函数名称：readRegisters
-* 函数功能：读寄存器组
-* 输入参数：address--待读寄存器起始地址，len-要读寄存器个数，pBufdata-存放读出值地址
-* 输出参数：无
-* 返 回 值：1--成功，0--失败
-* 创建日期：2022年2月2日
-* 注    意：
+* 函数名称：LeaveConfigMode
+* 函数功能：回到传输模式，串口1切换到模块当前的波特率
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：影子寄存器无效时保持配置模式的波特率
 *********************************************************************************************************/
-static uint8 readRegisters(uint8 addHead, uint8 len, uint8* pBufdata)
+static void LeaveConfigMode(void)
 {
-  uint8 i;
-  uint8 Cnt;
-  uint8 pBufRes[3] = {0};
-  //               指令,起始地址, 长度
-  uint8 pBufCMD[3] = {0xC1, 0x00, 0x01 };
+  uint32 baud = E22_CONFIG_BAUD;
 
-  pBufCMD[1] = addHead;
-  pBufCMD[2] = len;
-  
-  ConfigLRMode(MODEM_CONFIG); //设置配置模式
-  DelayNms(12);               //延时给对方反应时间
-  WriteUART1(pBufCMD, 3);     //发送指令
-  DelayNms(12);
-  Cnt = ReadUART1(&pBufRes[0], 3);//接收响应
-  
-  for(i=0; i<3; i++)
+  if(s_iShadowValid)
   {
-    if(pBufRes[i] != pBufCMD[i])//接收正确则重复命令
-    {
-      return 0; //响应不对
-    }
+    baud = s_arrE22Baud[(s_arrShadow[REG_REG0] >> 5) & 0x07];
   }
-  
-  return ReadUART1(pBufdata, len)==len? 1:0;
-}  
+
+  ConfigLRMode(MODEM_TRANSFER);
+  DelayNms(2);
+  SetUART1Baud(baud);
+}
 
 /*********************************************************************************************************
-* 函数名称：writeRegister
-* 函数功能：写寄存器
-* 输入参数：address->寄存器地址, value->待写入的值
-* 输出参数：无
-* 返 回 值：1-写入成功, 0-写入失败
-* 创建日期：2021年11月6日
-* 注    意：
+* 函数名称：ReadRegs
+* 函数功能：一条C1指令读连续的寄存器
+* 输入参数：addHead-起始地址，len-寄存器个数，pBuf-存放读出值的首地址
+* 输出参数：pBuf
+* 返 回 值：1--成功，0--失败
+* 创建日期：2026年10月19日
+* 注    意：须在配置模式下调用，响应为|C1 |起始地址 |长度 |参数 |
 *********************************************************************************************************/
-static uint8 writeRegister(uint8 address, uint8 value)
+static uint8 ReadRegs(uint8 addHead, uint8 len, uint8* pBuf)
 {
-  //               指令, 地址 , 长度 ,参数
-  uint8 pBufCMD[4] = {0xc0, 0x00, 0x01 ,0x00};
-  uint8 pBufRes[4];
-  uint8 i;
-  uint32 lastMillis;
-  
-  pBufCMD[1] = address;
-  pBufCMD[3] = value;
-  
-  ConfigLRMode(MODEM_CONFIG); //设置配置模式
-  
-  WriteUART1(pBufCMD, 4);     //发送指令
-  
-  i=0;
-  lastMillis = millis();      //当前毫秒数
-  while(i < 4 || millis() - lastMillis <= 100)//收到4字节或等待超过0.1S退出循环
+  uint8 arrCmd[3];
+  uint8 arrRes[3 + E22_REG_NUM];
+
+  if(len > E22_REG_NUM)
   {
-    i += ReadUART1(&pBufRes[i] , 4);
-    
+    return 0;
   }
-  
-  ConfigLRMode(MODEM_TRANSFER);   //设置退出配置模式，回到上次模式
 
-  for(i=1; i<4; i++)
+  arrCmd[0] = E22_CMD_READ;
+  arrCmd[1] = addHead;
+  arrCmd[2] = len;
+  WriteUART1(arrCmd, 3);
+
+  if(!RecvConfigResp(arrRes, 3 + len) || memcmp(arrRes, arrCmd, 3) != 0)
   {
-    if(pBufRes[i] != pBufCMD[i])
-    {
-      return 0; //写入失败
-    }
+    return 0;
   }
-  
+  memcpy(pBuf, &arrRes[3], len);
+
   return 1;
 }
 
 /*********************************************************************************************************
-* 函数名称：
-* 函数功能：初始化模块参数---恢复出厂设置
-* 输入参数：
-* 输出参数：
-* 返 回 值：
-* 创建日期：2021年11月6日
-* 注    意：
+* 函数名称：WriteRegs
+* 函数功能：一条指令写连续的寄存器
+* 输入参数：cmd-E22_CMD_WRITE保存或E22_CMD_WRITE_TEMP不保存，addHead-起始地址，len-寄存器个数，pBuf-待写入的值
+* 输出参数：void
+* 返 回 值：1--模块应答正确，0--失败
+* 创建日期：2026年10月19日
+* 注    意：须在配置模式下调用，响应为|C1 |起始地址 |长度 |参数 |
 *********************************************************************************************************/
-static void  DeInitLora()
+static uint8 WriteRegs(uint8 cmd, uint8 addHead, uint8 len, const uint8* pBuf)
 {
-  //出厂默认参数
-  uint8 pBufTemp[9] = {0x00, 0x00, 0x00, 0x62, 0x00, 0x17, 0x03, 0x00, 0x00 };
-  
-  if(!SetLRMode(MODEM_CONFIG))//设置配置模式成功
+  uint8 arrCmd[3 + E22_REG_NUM];
+  uint8 arrRes[3 + E22_REG_NUM];
+
+  if(len > E22_REG_NUM)
   {
-    WriteUART1(pBufTemp, 9);  //写入串口缓冲区，返回已写入数据的个数
+    return 0;
   }
-} 
+
+  arrCmd[0] = cmd;
+  arrCmd[1] = addHead;
+  arrCmd[2] = len;
+  memcpy(&arrCmd[3], pBuf, len);
+  WriteUART1(arrCmd, 3 + len);
+
+  if(!RecvConfigResp(arrRes, 3 + len) || arrRes[0] != E22_CMD_READ || memcmp(&arrRes[1], &arrCmd[1], 2 + len) != 0)
+  {
+    return 0;
+  }
+
+  return 1;
+}
+
+/*********************************************************************************************************
+* 函数名称：ProfileToRegs
+* 函数功能：将工作参数转换为寄存器0x00~0x06的值
+* 输入参数：pProfile-工作参数，pRegs-寄存器值存放的首地址
+* 输出参数：pRegs
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：地址取自影子寄存器，校验位固定为8N1
+*********************************************************************************************************/
+static void ProfileToRegs(const StructE22Profile* pProfile, uint8* pRegs)
+{
+  pRegs[REG_ADDH]  = s_arrShadow[REG_ADDH];
+  pRegs[REG_ADDL]  = s_arrShadow[REG_ADDL];
+  pRegs[REG_NETID] = pProfile->netId;
+  pRegs[REG_REG0]  = ((pProfile->baud & 0x07) << 5) | (pProfile->airRate & 0x07);
+  pRegs[REG_REG1]  = ((pProfile->subPacket & 0x03) << 6) | ((pProfile->rssiNoise ? 1 : 0) << 5) |
+                     (pProfile->txPower & 0x03);
+  pRegs[REG_REG2]  = pProfile->channel;
+  pRegs[REG_REG3]  = ((pProfile->rssiByte ? 1 : 0) << 7) | ((pProfile->fixedTx ? 1 : 0) << 6) |
+                     ((pProfile->lbt ? 1 : 0) << 4) | ((pProfile->worTx ? 1 : 0) << 3) | (pProfile->worCycle & 0x07);
+}
+
 /*********************************************************************************************************
 * 函数名称：GetAuxState
 * 函数功能：查询模块状态
@@ -373,6 +624,132 @@ static uint8  GetAuxState(void)
   return ok;
 }
 
+/*********************************************************************************************************
+* 函数名称：SetWorRole
+* 函数功能：临时设置WOR角色
+* 输入参数：worTx-1--发送方，0--接收方
+* 输出参数：void
+* 返 回 值：1--成功，0--失败
+* 创建日期：2026年10月19日
+* 注    意：用C2指令只写REG3，与影子寄存器一致时不进入配置模式；返回后模块处于传输模式
+*********************************************************************************************************/
+static uint8 SetWorRole(uint8 worTx)
+{
+  uint8 reg3;
+  uint8 ok = 0;
+
+  if(!s_iShadowValid)
+  {
+    return 0;
+  }
+  if(((s_arrShadow[REG_REG3] >> 3) & 0x01) == (worTx ? 1 : 0))
+  {
+    return 1;
+  }
+
+  reg3 = (s_arrShadow[REG_REG3] & 0xF7) | ((worTx ? 1 : 0) << 3);
+  if(EnterConfigMode() && WriteRegs(E22_CMD_WRITE_TEMP, REG_REG3, 1, &reg3))
+  {
+    s_arrShadow[REG_REG3] = reg3;
+    s_structProfile.worTx = worTx ? 1 : 0;
+    ok = 1;
+  }
+  LeaveConfigMode();
+
+  return ok;
+}
+
+/*********************************************************************************************************
+* 函数名称：SendInMode
+* 函数功能：在指定模式下发送数据
+* 输入参数：addr-目的地址，channel-目的信道，pData-数据，size-数据长度，mode-MODEM_TRANSFER或MODEM_WOR
+* 输出参数：无
+* 返 回 值：1--发送成功， 0--发送失败
+* 创建日期：2021年11月7日
+* 注    意：模式不同时先切换模式，发送完成后由RadioProc回到s_iIdleMode；
+*           定点传输的|addh |addl |channel |和数据分两段写入串口，不需要拼包
+*********************************************************************************************************/
+static uint8 SendInMode(uint16 addr, uint8 channel, uint8 *pData, uint8 size, uint8 mode)
+{
+  uint8 ok_config = 0;//切换模式标志，0---切换失败
+  uint32 lastMillis;
+  uint8 arrHead[3];   //定点传输的帧头
+  StructIoVec arrVec[2];
+  
+  if(!GetUART1TxSts() && GetAuxState())// 上一个数据包已发完，串口缓冲区为 空
+  {
+    while(micros() - GetUART1TxDoneTime() < AUX_LAG_US)//串口刚发完时模块可能还没拉低AUX，发完很久则不用再等
+    {
+
+    }
+    if(GetAuxState())//lora模块空闲，缓冲区为 空
+    {
+      s_RadioBuf = LoRaBufMax;
+    }
+    else//Lora模块还在发上一个数据包
+    {
+      lastMillis = millis();      //当前毫秒数
+      while(!GetAuxState() && millis() - lastMillis <= 500)//最多等待x mS
+      {
+      
+      }
+      DelayNms(3 + rand()%4);
+    }
+  }
+  else//Lora模块还在发上一个数据包
+  {
+    lastMillis = millis();      //当前毫秒数
+    while(GetUART1TxSts() && millis() - lastMillis <= 500)//最多等待x mS
+    {
+      
+    }
+    DelayNms(10 + rand()%4);//等待时间太长，检测模块空闲已经过时
+  }
+  
+  if(s_curMode == mode)
+  {
+    ok_config = 1;
+  }
+  else//切换到发送所用的模式
+  {
+    ok_config = ConfigLRMode(mode);
+    s_RadioBuf = LoRaBufMax;
+  }
+  
+  if(ok_config && s_RadioBuf >= size + 3)
+  {
+    if(s_iTxFrames == 0)
+    {
+      s_iTxStartUs = micros();   //本轮发送开始时刻
+    }
+    arrHead[0] = HIBYTE(addr);
+    arrHead[1] = LOBYTE(addr);
+    arrHead[2] = channel;
+    arrVec[0].pBuf = arrHead;
+    arrVec[0].len  = 3;
+    arrVec[1].pBuf = pData;
+    arrVec[1].len  = size;
+    if(WriteUART1v(arrVec, 2) == 0)
+    {
+      debug("RadioSendData中串口缓冲区溢出\r\n");
+      return 0;
+    }
+    s_iTxFrames++;
+    s_RadioBuf -= size + 3;
+    return 1;
+  }
+  else if(!ok_config)
+  {
+    debug("切换传输模式失败462\r\n");
+  }
+  else if(s_RadioBuf < size + 3)
+  {
+    debug("数据太多lora接收缓冲区溢出\r\n");
+  }
+  return 0;
+}
+
+
 /*********************************************************************************************************
 *                                              API函数实现
 *********************************************************************************************************/
@@ -388,10 +765,14 @@ static uint8  GetAuxState(void)
 void  InitLORA(void)         
 {
   ConfigLRGPIO();               //初始化连接Lora模块的GPIO
-  ConfigLRMode(MODEM_TRANSFER); //初始化Lora模块的模式
-  s_Aux      = AUX_STATE_FREE;  //初始化Aux标志位为空闲
+  s_Aux      = GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_4);  //初始化Aux标志位
   s_RadioBuf = LoRaBufMax;      //初始化Lora接收缓冲区
   s_address  = 0xffff;          //初始化模块默认地址
+  
+  if(!ApplyE22Profile(&s_structDefProfile))  //写入默认工作参数
+  {
+    debug("E22工作参数配置失败\r\n");
+  }
   s_address  = getAddress();    //读取模块地址
 }
 
@@ -418,12 +799,11 @@ uint8  SetLRMode(uint8 mode)
 * 输出参数：
 * 返 回 值：
 * 创建日期：2021年10月16日
-* 注    意：配置模式下LoRa模块串口波特率固定为9600,8N1。
+* 注    意：配置模式下LoRa模块串口波特率固定为9600,8N1。模块地址保持不变
 *********************************************************************************************************/
 void  DeInitLORA(void)
 {
-  DeInitLora();
-  
+  ApplyE22Profile(&s_structFactoryProfile);
 }
 
 /*********************************************************************************************************
@@ -443,73 +823,195 @@ uint8 isLoRaReady()
 /*********************************************************************************************************
 * 函数名称：RadioSendData
 * 函数功能：无线发送数据
-* 输入参数：pBufData,size
+* 输入参数：addr-目的地址，0xFFFF为广播，channel-目的信道，pData-数据，size-数据长度
 * 输出参数：无
 * 返 回 值：1--发送成功， 0--发送失败
 * 创建日期：2021年11月7日
+* 注    意：目的节点处于WOR模式时用RadioSendWakeData
+*********************************************************************************************************/
+uint8  RadioSendData(uint16 addr, uint8 channel, uint8 *pData, uint8 size)
+{
+  return SendInMode(addr, channel, pData, size, MODEM_TRANSFER);
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioSendWakeData
+* 函数功能：带长前导码发送，唤醒处于WOR模式的目的节点
+* 输入参数：addr-目的地址，channel-目的信道，pData-数据，size-数据长度
+* 输出参数：无
+* 返 回 值：1--发送成功， 0--发送失败
+* 创建日期：2026年10月19日
+* 注    意：本模块作为WOR发送方在WOR模式下发送，前导码持续一个WOR周期，每帧空中时间增加约2s，
+*           收发双方的WOR周期须一致；发送完成后由RadioProc切回s_iIdleMode
+*********************************************************************************************************/
+uint8  RadioSendWakeData(uint16 addr, uint8 channel, uint8 *pData, uint8 size)
+{
+  if(s_curMode != MODEM_WOR && !SetWorRole(1))
+  {
+    debug("设置WOR发送方失败\r\n");
+    return 0;
+  }
+  return SendInMode(addr, channel, pData, size, MODEM_WOR);
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioSetIdleMode
+* 函数功能：设置发送完成后回到的模式
+* 输入参数：mode-MODEM_TRANSFER--连续接收，MODEM_WOR--作为WOR接收方低功耗监听
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：模式在RadioProc中模块空闲时切换
+*********************************************************************************************************/
+void  RadioSetIdleMode(uint8 mode)
+{
+  if(mode == MODEM_TRANSFER || mode == MODEM_WOR)
+  {
+    s_iIdleMode = mode;
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioGetIdleMode
+* 函数功能：返回发送完成后回到的模式
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：MODEM_TRANSFER或MODEM_WOR
+* 创建日期：2026年10月19日
 * 注    意：
 *********************************************************************************************************/
-uint8  RadioSendData(uint8 *pBufData, uint8 size)
+uint8 RadioGetIdleMode(void)
 {
-  uint8 ok_config = 0;//切换模式标志，0---切换失败
-  uint32 lastMillis;
-  
-  if(!GetUART1TxSts() && GetAuxState())// 上一个数据包已发完，串口缓冲区为 空
+  return s_iIdleMode;
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioReadData
+* 函数功能：读取无线接收到的数据
+* 输入参数：pBufData-数据存放的首地址，size-期望读取的字节数
+* 输出参数：pBufData
+* 返 回 值：实际读取的字节数
+* 创建日期：2026年10月19日
+* 注    意：E22透传模式下，接收到的数据直接从串口1输出；开启RSSI字节后每包末尾多1字节RSSI，
+*           等待环境噪声应答时先把应答取出，不是应答的字节按原顺序交还
+*********************************************************************************************************/
+uint8  RadioReadData(uint8 *pBufData, uint8 size)
+{
+  uint8 len;      //从串口读出的字节数
+  uint8 cnt = 0;  //去掉噪声应答后的字节数
+  uint8 data;
+
+  while(cnt < size)
   {
-    DelayNms(5);
-    if(GetAuxState())//lora模块空闲，缓冲区为 空
+    if(s_iRxBackPos < s_iRxBackLen)//先读出交还的字节
     {
-      s_RadioBuf = LoRaBufMax;
+      pBufData[cnt++] = s_arrRxBack[s_iRxBackPos++];
+      continue;
     }
-    else//Lora模块还在发上一个数据包
+    if(!s_iNoisePending)//其余整块读出
     {
-      lastMillis = millis();      //当前毫秒数
-      while(!GetAuxState() && millis() - lastMillis <= 500)//最多等待x mS
+      len = ReadUART1(&pBufData[cnt], size - cnt);
+      if(len > 0)
       {
-      
+        s_iLastRxMs = millis();
       }
-      DelayNms(3 + rand()%4);
+      cnt += len;
+      break;
     }
-  }
-  else//Lora模块还在发上一个数据包
-  {
-    lastMillis = millis();      //当前毫秒数
-    while(GetUART1TxSts() && millis() - lastMillis <= 500)//最多等待x mS
+    if(!ReadUART1(&data, 1))//等待噪声应答期间逐字节读，不是应答的字节可能连同已匹配的应答头一起交还
     {
-      
+      break;
+    }
+    s_iLastRxMs = millis();
+    if(!ParseNoiseResp(data))
+    {
+      pBufData[cnt++] = data;
     }
-    DelayNms(10 + rand()%4);//等待时间太长，检测模块空闲已经过时
   }
-  
-  if(s_curMode == MODEM_TRANSFER)
+
+  return cnt;
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioGetPktStatus
+* 函数功能：读取最近一包的RSSI/SNR
+* 输入参数：pRssi-RSSI存放地址(dBm)，pSnr-SNR存放地址(dB)
+* 输出参数：pRssi,pSnr
+* 返 回 值：1--有效，0--无效
+* 创建日期：2026年10月19日
+* 注    意：E22的RSSI字节跟在数据包后面，由UnPackData解析，见GetUnPackRssi
+*********************************************************************************************************/
+uint8  RadioGetPktStatus(int8 *pRssi, int8 *pSnr)
+{
+  return 0;
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioProc
+* 函数功能：无线后台处理，读出AUX事件，发送完成后回到空闲模式
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：E22模块收发由串口中断完成
+*********************************************************************************************************/
+void  RadioProc(void)
+{
+  while(s_iAuxEvtTail != s_iAuxEvtHead)
   {
-    ok_config = 1;
+    OnAuxEvent(&s_arrAuxEvent[s_iAuxEvtTail]);
+    s_iAuxEvtTail = (s_iAuxEvtTail + 1) & (AUX_EVENT_NUM - 1);
   }
-  else//切换到传输模式
+
+  if(s_iShadowValid && (s_arrShadow[REG_REG1] & 0x20))//已使能环境噪声读取
   {
-    ok_config = ConfigLRMode(MODEM_TRANSFER);
-    s_RadioBuf = LoRaBufMax;
+    RequestNoise();
   }
-  
-  if(ok_config && s_RadioBuf >= size)
+
+  //发送完成后回到空闲模式，WOR监听时模块须为WOR接收方
+  if(s_curMode != s_iIdleMode && s_iTxFrames == 0 && !s_iNoisePending && GetAuxState() && !GetUART1TxSts())
   {
-    if(size > WriteUART1(pBufData, size))
+    if(s_iIdleMode == MODEM_WOR && !SetWorRole(0))
     {
-      debug("RadioSendData中串口缓冲区溢出\r\n");
-      return 0;
+      s_iIdleMode = MODEM_TRANSFER;   //无法设置为WOR接收方，保持连续接收
+      debug("设置WOR接收方失败\r\n");
     }
-    s_RadioBuf -= size;
-    return 1;
+    ConfigLRMode(s_iIdleMode);
   }
-  else if(!ok_config)
-  {
-    debug("切换传输模式失败462\r\n");
-  }
-  else if(s_RadioBuf < size)
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioGetNoise
+* 函数功能：读取环境噪声
+* 输入参数：pNoise-环境噪声存放地址(dBm)
+* 输出参数：pNoise
+* 返 回 值：1--上次读取后有新的测量值，0--没有
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+uint8 RadioGetNoise(int16 *pNoise)
+{
+  if(!s_iNoiseValid)
   {
-    debug("数据太多lora接收缓冲区溢出\r\n");
+    return 0;
   }
-  return 0;
+  *pNoise = s_iNoise;
+  s_iNoiseValid = 0;
+  return 1;
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioGetTxLatency
+* 函数功能：返回最近一轮发送每帧的时延
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：时延(us)，从数据写入串口1到模块AUX变高(发送完成)
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+uint32 RadioGetTxLatency(void)
+{
+  return s_iTxLatency;
 }
 
 /*********************************************************************************************************
@@ -545,30 +1047,181 @@ void  RadioSendCMD(void)
 * 输出参数：
 * 返 回 值：uint16地址
 * 创建日期：2021年11月7日
-* 注    意：读取失败，返回0xffff,
+* 注    意：读取失败，返回0xffff，地址来自影子寄存器，不再占用串口
 *********************************************************************************************************/
 uint16 getAddress(void)
 {
-  uint16 add = 0xFFFF;
-  uint8 pAdd[3] = {0x00};
-  
-  if(s_address != 0xFFFF)
+  if(s_address == 0xFFFF && s_iShadowValid)
   {
-    return s_address;
+    s_address = MAKEHWORD(s_arrShadow[REG_ADDH], s_arrShadow[REG_ADDL]);
+    debug("s_address:%d\r\n",s_address);
   }
-  
-  if(readRegisters(REG_ADDH, 2, pAdd))//读取成功
+  return s_address;
+}
+
+/*********************************************************************************************************
+* 函数名称：ApplyE22Profile
+* 函数功能：写入模块工作参数
+* 输入参数：pProfile-工作参数
+* 输出参数：void
+* 返 回 值：1--成功，0--失败
+* 创建日期：2026年10月19日
+* 注    意：先用一条C1指令读出0x00~0x06到影子寄存器，参数有变化时用一条C0指令一次写入全部参数，
+*           再用一条C1指令回读校验；与影子寄存器相同时不写，减少模块Flash擦写。
+*           返回传输模式后串口1切换到模块当前的波特率，失败时模块保持原参数
+*********************************************************************************************************/
+uint8 ApplyE22Profile(const StructE22Profile* pProfile)
+{
+  uint8 arrRegs[E22_REG_NUM];
+  uint8 arrBack[E22_REG_NUM];
+  uint8 ok = 0;
+
+  if(EnterConfigMode())
   {
-    add = pAdd[0];
-    add <<= 8;
-    add = pAdd[1];
-    s_address = add;
+    if(!s_iShadowValid)
+    {
+      s_iShadowValid = ReadRegs(REG_ADDH, E22_REG_NUM, s_arrShadow);
+    }
+
+    if(s_iShadowValid)
+    {
+      ProfileToRegs(pProfile, arrRegs);
+      if(memcmp(arrRegs, s_arrShadow, E22_REG_NUM) == 0)
+      {
+        ok = 1;   //模块参数已经一致
+      }
+      else if(WriteRegs(E22_CMD_WRITE, REG_ADDH, E22_REG_NUM, arrRegs) && ReadRegs(REG_ADDH, E22_REG_NUM, arrBack) &&
+              memcmp(arrBack, arrRegs, E22_REG_NUM) == 0)
+      {
+        memcpy(s_arrShadow, arrRegs, E22_REG_NUM);
+        ok = 1;
+      }
+      else
+      {
+        s_iShadowValid = ReadRegs(REG_ADDH, E22_REG_NUM, s_arrShadow);  //写入失败，重新同步影子寄存器
+        debug("E22参数写入校验失败\r\n");
+      }
+    }
   }
-  else{
-    debug("读取Lora模块寄存器地址失败，当前地址%d\r\n",add);
+
+  if(ok)
+  {
+    s_structProfile = *pProfile;
   }
-  debug("s_address:%d\r\n",s_address);
-  return add;
+  LeaveConfigMode();
+
+  return ok;
+}
+
+/*********************************************************************************************************
+* 函数名称：GetE22Profile
+* 函数功能：返回模块当前工作参数
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：工作参数
+* 创建日期：2026年10月19日
+* 注    意：ApplyE22Profile成功后有效
+*********************************************************************************************************/
+const StructE22Profile* GetE22Profile(void)
+{
+  return &s_structProfile;
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioSetAirRate
+* 函数功能：临时修改空中速率
+* 输入参数：rate-空中速率档位，EnumE22AirRate
+* 输出参数：void
+* 返 回 值：1--成功，0--失败
+* 创建日期：2026年10月19日
+* 注    意：用C2指令只写REG0，不写Flash，模块复位后回到ApplyE22Profile写入的速率；
+*           E22接收和发送使用同一速率，无法按目的地址切换，速率切换须全网协调，见Route.c
+*********************************************************************************************************/
+uint8 RadioSetAirRate(uint8 rate)
+{
+  uint8 reg0;
+  uint8 ok = 0;
+
+  if(rate >= RADIO_AIR_RATE_NUM || !s_iShadowValid)
+  {
+    return 0;
+  }
+  if((s_arrShadow[REG_REG0] & 0x07) == rate)
+  {
+    return 1;
+  }
+
+  reg0 = (s_arrShadow[REG_REG0] & 0xF8) | rate;
+  if(EnterConfigMode() && WriteRegs(E22_CMD_WRITE_TEMP, REG_REG0, 1, &reg0))
+  {
+    s_arrShadow[REG_REG0]    = reg0;
+    s_structProfile.airRate  = rate;
+    ok = 1;
+  }
+  LeaveConfigMode();
+
+  return ok;
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioGetAirRate
+* 函数功能：返回当前空中速率档位
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：空中速率档位，EnumE22AirRate
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+uint8 RadioGetAirRate(void)
+{
+  return s_arrShadow[REG_REG0] & 0x07;
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioSetChannel
+* 函数功能：临时修改本节点的接收信道
+* 输入参数：channel-信道，频率为410.125MHz + channel * 1MHz
+* 输出参数：void
+* 返 回 值：1--成功，0--失败
+* 创建日期：2026年10月19日
+* 注    意：用C2指令只写REG2，不写Flash；定点传输时发送信道由每帧的channel字节指定，不受此影响
+*********************************************************************************************************/
+uint8 RadioSetChannel(uint8 channel)
+{
+  uint8 ok = 0;
+
+  if(!s_iShadowValid)
+  {
+    return 0;
+  }
+  if(s_arrShadow[REG_REG2] == channel)
+  {
+    return 1;
+  }
+
+  if(EnterConfigMode() && WriteRegs(E22_CMD_WRITE_TEMP, REG_REG2, 1, &channel))
+  {
+    s_arrShadow[REG_REG2]   = channel;
+    s_structProfile.channel = channel;
+    ok = 1;
+  }
+  LeaveConfigMode();
+
+  return ok;
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioGetChannel
+* 函数功能：返回本节点的接收信道
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：信道
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+uint8 RadioGetChannel(void)
+{
+  return s_arrShadow[REG_REG2];
 }
 
 /*********************************************************************************************************
@@ -610,3 +1263,5 @@ uint16 getAddress(void)
 * 创建日期：2021年11月6日
 * 注    意：
 *********************************************************************************************************/
+
+#endif
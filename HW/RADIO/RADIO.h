@@ -28,6 +28,16 @@
 /*********************************************************************************************************
 *                                              宏定义
 *********************************************************************************************************/
+//无线后端选择，编译时二选一
+#define RADIO_BACKEND_E22     0   //E22-400T22S模块，UART透传(定点传输)
+#define RADIO_BACKEND_SX126X  1   //SX1262/SX1268芯片，SPI直连
+
+#define RADIO_BACKEND RADIO_BACKEND_E22  //当前使用的无线后端
+
+#define RADIO_AIR_RATE_NUM    8   //空中速率档位数，0~7对应E22的0.3k~62.5k
+
+#define RADIO_RSSI_BYTE       TRUE  //每个接收到的数据包末尾附带1字节RSSI，由UnPackData解析
+#define RADIO_RSSI_DBM(b)     ((int16)(b) - 256)  //RSSI字节转换为dBm，与E22的定义一致
 
 /*********************************************************************************************************
 *                                              枚举结构体定义
@@ -40,6 +50,69 @@ typedef enum
     MODEM_DEEPSLEEP = 0x03,    //深度睡眠
 }RadioModems_t;
 
+#if (RADIO_BACKEND == RADIO_BACKEND_E22)
+//E22串口波特率，对应REG0的bit7-5
+typedef enum
+{
+  E22_BAUD_1200   = 0x00,
+  E22_BAUD_2400   = 0x01,
+  E22_BAUD_4800   = 0x02,
+  E22_BAUD_9600   = 0x03,
+  E22_BAUD_19200  = 0x04,
+  E22_BAUD_38400  = 0x05,
+  E22_BAUD_57600  = 0x06,
+  E22_BAUD_115200 = 0x07,
+}EnumE22Baud;
+
+//E22空中速率，对应REG0的bit2-0
+typedef enum
+{
+  E22_AIR_0K3  = 0x00,
+  E22_AIR_1K2  = 0x01,
+  E22_AIR_2K4  = 0x02,
+  E22_AIR_4K8  = 0x03,
+  E22_AIR_9K6  = 0x04,
+  E22_AIR_19K2 = 0x05,
+  E22_AIR_38K4 = 0x06,
+  E22_AIR_62K5 = 0x07,
+}EnumE22AirRate;
+
+//E22分包长度，对应REG1的bit7-6
+typedef enum
+{
+  E22_SUB_240 = 0x00,
+  E22_SUB_128 = 0x01,
+  E22_SUB_64  = 0x02,
+  E22_SUB_32  = 0x03,
+}EnumE22SubPacket;
+
+//E22发射功率，对应REG1的bit1-0
+typedef enum
+{
+  E22_POWER_22DBM = 0x00,
+  E22_POWER_17DBM = 0x01,
+  E22_POWER_13DBM = 0x02,
+  E22_POWER_10DBM = 0x03,
+}EnumE22Power;
+
+//E22模块工作参数，地址不在其中，由模块本身保存
+typedef struct
+{
+  uint8 netId;      //网络地址
+  uint8 baud;       //串口波特率，EnumE22Baud，校验固定8N1
+  uint8 airRate;    //空中速率，EnumE22AirRate
+  uint8 subPacket;  //分包长度，EnumE22SubPacket
+  uint8 rssiNoise;  //1--使能环境噪声RSSI读取
+  uint8 txPower;    //发射功率，EnumE22Power
+  uint8 channel;    //信道，频率为410.125MHz + channel * 1MHz
+  uint8 rssiByte;   //1--接收数据后在串口输出RSSI字节
+  uint8 fixedTx;    //1--定点传输，0--透明传输
+  uint8 lbt;        //1--发送前监听信道
+  uint8 worTx;      //WOR模式下的角色，1--发送方(唤醒WOR节点)，0--接收方(低功耗监听)
+  uint8 worCycle;   //WOR周期，(worCycle + 1) * 500ms
+}StructE22Profile;
+#endif
+
 
 /*********************************************************************************************************
 *                                              API函数声明
@@ -48,8 +121,25 @@ void  DeInitLORA(void);          //初始化模块参数---恢复出厂设置
 void  InitLORA(void);            //初始化LORA模块模式
 uint8    SetLRMode(uint8 NewMode);//设置LORA工作模式
 uint8    isLoRaReady(void);         //查询模块是否准备好
-uint8    RadioSendData(uint8 *pBufData, uint8 size);//无线发送数据
+uint8    RadioSendData(uint16 addr, uint8 channel, uint8 *pData, uint8 size);//无线发送数据到addr节点的channel信道
+uint8    RadioSendWakeData(uint16 addr, uint8 channel, uint8 *pData, uint8 size);//带长前导码发送，唤醒处于WOR模式的目的节点
+void  RadioSetIdleMode(uint8 mode);    //设置发送完成后回到的模式，MODEM_TRANSFER或MODEM_WOR
+uint8    RadioGetIdleMode(void);        //返回发送完成后回到的模式
+uint8    RadioReadData(uint8 *pBufData, uint8 size);//读取无线接收到的数据，返回读到的字节数
+uint8    RadioGetPktStatus(int8 *pRssi, int8 *pSnr);//读取最近一包的RSSI/SNR，1--有效
+void  RadioProc(void);              //无线后台处理，在主循环中调用
+uint32   RadioGetTxLatency(void);       //最近一次发送每帧的时延(us)
+uint8    RadioGetNoise(int16 *pNoise);  //读取环境噪声(dBm)，1--有新的测量值
 void  RadioSendCMD(void);
 void  RadioRx( uint32 timeout );    //在给定时间将模块设置为接收模式
 uint16   getAddress(void);              //返回模块地址
+uint8    RadioSetAirRate(uint8 rate);   //临时修改空中速率，1--成功
+uint8    RadioGetAirRate(void);         //返回当前空中速率档位
+uint8    RadioSetChannel(uint8 channel);//临时修改本节点的接收信道，1--成功
+uint8    RadioGetChannel(void);         //返回本节点的接收信道
+
+#if (RADIO_BACKEND == RADIO_BACKEND_E22)
+uint8    ApplyE22Profile(const StructE22Profile* pProfile);  //一次写入全部参数并回读校验，成功后串口1切换到新波特率
+const StructE22Profile* GetE22Profile(void);                 //返回模块当前参数
+#endif
 #endif
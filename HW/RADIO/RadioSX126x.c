@@ -0,0 +1,787 @@
+/*********************************************************************************************************
+* 模块名称：RadioSX126x.c
+* 摘    要：无线模块的SX126x后端，通过SPI直接驱动SX1262/SX1268，实现RADIO.h中与E22后端相同的接口
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：空中帧格式|addh |addl |数据 |，接收方按地址过滤后只把数据交给上层，与E22定点传输的行为一致；
+*           信道号换算为频率：410.125MHz + channel * 1MHz，与E22-400的信道定义一致
+* 注    意：RADIO.h中RADIO_BACKEND选择RADIO_BACKEND_SX126X时编译本文件，引脚连接见sx126x_board.h
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "RADIO.h"
+
+#if (RADIO_BACKEND == RADIO_BACKEND_SX126X)
+
+#include "sx126x.h"
+#include "sx126x_board.h"
+#include "Queue.h"
+#include "Timer.h"
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#define SX126X_FREQ_BASE      410125000UL   //信道0的频率(Hz)
+#define SX126X_FREQ_STEP      1000000UL     //信道间隔(Hz)
+#define SX126X_CHANNEL        0x17          //本节点默认接收信道，与E22的REG2默认值一致
+#define SX126X_TX_POWER       22            //发射功率(dBm)
+#define SX126X_AIR_RATE       0x02          //默认空中速率档位，与E22默认的2.4k档对应
+#define SX126X_LORA_BW        SX126X_LORA_BW_125
+#define SX126X_LORA_CR        SX126X_LORA_CR_4_5
+#define SX126X_PREAMBLE_LEN   8             //前导码长度(符号)
+#define SX126X_TCXO_TIMEOUT   320           //TCXO稳定时间，单位15.625us，即5ms
+#define SX126X_WOR_RX_MS      20            //WOR模式每次唤醒的接收时间(ms)
+#define SX126X_WOR_SLEEP_MS   1980          //WOR模式每次睡眠的时间(ms)
+#define SX126X_WAKE_FLAG      0x80          //发送帧队列中channel字节的最高位，1--用唤醒前导码发送
+
+#define SX126X_FRAME_MAX      255           //空中帧最大长度
+#define SX126X_RX_BUF_SIZE    512           //接收数据队列大小
+#define SX126X_TX_BUF_SIZE    512           //发送帧队列大小
+
+#define SX126X_IRQ_MASK  (SX126X_IRQ_TX_DONE | SX126X_IRQ_RX_DONE | SX126X_IRQ_TIMEOUT | \
+                          SX126X_IRQ_CRC_ERROR | SX126X_IRQ_HEADER_ERROR)
+
+/*********************************************************************************************************
+*                                              枚举结构体定义
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              内部变量
+*********************************************************************************************************/
+static uint8  s_curMode;                           //当前模式
+static uint16 s_address;                           //本节点地址
+static uint8  s_curChannel;                        //芯片当前所在信道
+static volatile uint8 s_iTxBusy;                   //1--正在发送
+static int8   s_iPktRssi;                          //最近一包的RSSI(dBm)
+static int8   s_iPktSnr;                           //最近一包的SNR(dB)
+static uint8  s_iPktValid;                         //最近一包的RSSI/SNR是否有效
+static uint8  s_iAirRate;                          //当前空中速率档位
+static uint32 s_iTxStartUs;                        //当前帧开始发送的时刻(us)
+static uint32 s_iTxLatency;                        //最近一帧的发送时延(us)
+static uint8  s_iIdleMode = MODEM_TRANSFER;        //发送完成后回到的模式
+static uint8  s_iRxChannel;                        //本节点接收信道
+
+//空中速率档位对应的扩频因子，BW125kHz下约0.3k~15.6kbps
+static const uint8 s_arrRateSF[RADIO_AIR_RATE_NUM] = {
+  SX126X_LORA_SF12, SX126X_LORA_SF11, SX126X_LORA_SF10, SX126X_LORA_SF9,
+  SX126X_LORA_SF8,  SX126X_LORA_SF7,  SX126X_LORA_SF6,  SX126X_LORA_SF5
+};
+
+static StructCirQue s_structRxCirQue;              //接收数据队列，只存放地址过滤后的数据
+static StructCirQue s_structTxCirQue;              //发送帧队列，每帧|len |channel |addh |addl |数据 |，channel最高位为唤醒标志
+static uint8  s_arrRxBuf[SX126X_RX_BUF_SIZE];
+static uint8  s_arrTxBuf[SX126X_TX_BUF_SIZE];
+static uint8  s_arrFrame[SX126X_FRAME_MAX + 1];    //收发时的单帧缓冲，多1字节存放RSSI
+
+/*********************************************************************************************************
+*                                              内部函数声明
+*********************************************************************************************************/
+static void   ConfigSX126x(void);            //配置芯片为LoRa模式并进入连续接收
+static void   SetChannel(uint8 channel);     //切换芯片频率
+static void   SetPayloadLen(uint8 len, uint16 preamble); //设置LoRa包参数中的负载长度和前导码长度
+static uint16 CalcWakePreamble(void);        //计算覆盖一个WOR周期的前导码长度
+static void   SetModParams(uint8 rate);     //按空中速率档位设置调制参数
+static void   StartRx(void);                 //回到本节点信道连续接收
+static void   StartIdle(void);               //回到空闲模式，连续接收或占空比接收
+static void   StartTx(void);                 //从发送帧队列中取一帧开始发送
+static void   OnRxDone(void);                //处理接收完成事件
+static uint8  QueueTxFrame(uint16 addr, uint8 channel, uint8 *pData, uint8 size, uint8 wake); //把一帧放入发送帧队列
+static uint16 CalcAddress(void);             //由芯片唯一ID计算节点地址
+
+/*********************************************************************************************************
+*                                              内部函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：ConfigSX126x
+* 函数功能：配置芯片为LoRa模式并进入连续接收
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：PA参数为SX1268输出22dBm的推荐值
+*********************************************************************************************************/
+static void ConfigSX126x(void)
+{
+  sx126x_pa_cfg_params_t   paCfg;
+
+  sx126x_set_standby(NULL, SX126X_STANDBY_CFG_RC);
+  sx126x_set_reg_mode(NULL, SX126X_REG_MODE_DCDC);
+  sx126x_set_dio3_as_tcxo_ctrl(NULL, SX126X_TCXO_CTRL_1_8V, SX126X_TCXO_TIMEOUT);
+  sx126x_cal(NULL, SX126X_CAL_ALL);
+  sx126x_set_dio2_as_rf_sw_ctrl(NULL, true);
+  sx126x_set_pkt_type(NULL, SX126X_PKT_TYPE_LORA);
+
+  paCfg.pa_duty_cycle = 0x04;
+  paCfg.hp_max        = 0x07;
+  paCfg.device_sel    = 0x00;
+  paCfg.pa_lut        = 0x01;
+  sx126x_set_pa_cfg(NULL, &paCfg);
+  sx126x_set_tx_params(NULL, SX126X_TX_POWER, SX126X_RAMP_200_US);
+
+  SetModParams(s_iAirRate);
+  SetPayloadLen(SX126X_FRAME_MAX, SX126X_PREAMBLE_LEN);
+
+  sx126x_set_buffer_base_address(NULL, 0x00, 0x00);
+  sx126x_set_dio_irq_params(NULL, SX126X_IRQ_MASK, SX126X_IRQ_MASK, SX126X_IRQ_NONE, SX126X_IRQ_NONE);
+  sx126x_clear_irq_status(NULL, SX126X_IRQ_ALL);
+
+  s_curChannel = 0xFF;
+  StartIdle();
+}
+
+/*********************************************************************************************************
+* 函数名称：SetChannel
+* 函数功能：切换芯片频率
+* 输入参数：channel-信道号
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：信道没有变化时不重复设置
+*********************************************************************************************************/
+static void SetChannel(uint8 channel)
+{
+  if(channel != s_curChannel)
+  {
+    sx126x_set_rf_freq(NULL, SX126X_FREQ_BASE + (uint32)channel * SX126X_FREQ_STEP);
+    s_curChannel = channel;
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：SetModParams
+* 函数功能：按空中速率档位设置调制参数
+* 输入参数：rate-空中速率档位
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：SF11/SF12在125kHz带宽下须打开低速率优化
+*********************************************************************************************************/
+static void SetModParams(uint8 rate)
+{
+  sx126x_mod_params_lora_t modParams;
+
+  modParams.sf   = (sx126x_lora_sf_t)s_arrRateSF[rate];
+  modParams.bw   = SX126X_LORA_BW;
+  modParams.cr   = SX126X_LORA_CR;
+  modParams.ldro = (modParams.sf >= SX126X_LORA_SF11) ? 1 : 0;
+  sx126x_set_lora_mod_params(NULL, &modParams);
+}
+
+/*********************************************************************************************************
+* 函数名称：SetPayloadLen
+* 函数功能：设置LoRa包参数中的负载长度和前导码长度
+* 输入参数：len-负载长度，显式包头模式下接收时为最大长度，preamble-前导码长度(符号)
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static void SetPayloadLen(uint8 len, uint16 preamble)
+{
+  sx126x_pkt_params_lora_t pktParams;
+
+  pktParams.preamble_len_in_symb = preamble;
+  pktParams.header_type          = SX126X_LORA_PKT_EXPLICIT;
+  pktParams.pld_len_in_bytes     = len;
+  pktParams.crc_is_on            = true;
+  pktParams.invert_iq_is_on      = false;
+  sx126x_set_lora_pkt_params(NULL, &pktParams);
+}
+
+/*********************************************************************************************************
+* 函数名称：CalcWakePreamble
+* 函数功能：计算覆盖一个WOR周期的前导码长度
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：前导码长度(符号)
+* 创建日期：2026年10月19日
+* 注    意：BW125kHz下符号时间为2^SF * 8us，占空比接收的节点在任意一次唤醒时都能检测到前导码
+*********************************************************************************************************/
+static uint16 CalcWakePreamble(void)
+{
+  uint32 symUs;
+  uint32 symNum;
+
+  symUs  = 8UL << s_arrRateSF[s_iAirRate];
+  symNum = (SX126X_WOR_RX_MS + SX126X_WOR_SLEEP_MS) * 1000UL / symUs + SX126X_PREAMBLE_LEN;
+
+  return (symNum > 0xFFFF) ? 0xFFFF : (uint16)symNum;
+}
+
+/*********************************************************************************************************
+* 函数名称：StartRx
+* 函数功能：回到本节点信道连续接收
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static void StartRx(void)
+{
+  SetChannel(s_iRxChannel);
+  SetPayloadLen(SX126X_FRAME_MAX, SX126X_PREAMBLE_LEN);
+  sx126x_set_rx_with_timeout_in_rtc_step(NULL, SX126X_RX_CONTINUOUS);
+  s_curMode = MODEM_TRANSFER;
+}
+
+/*********************************************************************************************************
+* 函数名称：StartIdle
+* 函数功能：回到空闲模式
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：空闲模式为MODEM_WOR时进入占空比接收，收到一包后芯片自动回到占空比接收
+*********************************************************************************************************/
+static void StartIdle(void)
+{
+  if(s_iIdleMode == MODEM_WOR)
+  {
+    SetChannel(s_iRxChannel);
+    SetPayloadLen(SX126X_FRAME_MAX, SX126X_PREAMBLE_LEN);
+    sx126x_set_rx_duty_cycle(NULL, SX126X_WOR_RX_MS, SX126X_WOR_SLEEP_MS);
+    s_curMode = MODEM_WOR;
+  }
+  else
+  {
+    StartRx();
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：StartTx
+* 函数功能：从发送帧队列中取一帧开始发送
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：队列中没有完整帧时回到空闲模式
+*********************************************************************************************************/
+static void StartTx(void)
+{
+  uint8 len;
+  uint8 channel;
+
+  if(DeQueue(&s_structTxCirQue, &len, 1) == 0 || DeQueue(&s_structTxCirQue, &channel, 1) == 0)
+  {
+    s_iTxBusy = 0;
+    StartIdle();
+    return;
+  }
+  DeQueue(&s_structTxCirQue, s_arrFrame, len);
+
+  s_iTxBusy = 1;
+  sx126x_set_standby(NULL, SX126X_STANDBY_CFG_XOSC);
+  SetChannel(channel & ~SX126X_WAKE_FLAG);
+  sx126x_write_buffer(NULL, 0x00, s_arrFrame, len);
+  SetPayloadLen(len, (channel & SX126X_WAKE_FLAG) ? CalcWakePreamble() : SX126X_PREAMBLE_LEN);
+  s_iTxStartUs = micros();
+  sx126x_set_tx(NULL, 0);
+}
+
+/*********************************************************************************************************
+* 函数名称：OnRxDone
+* 函数功能：处理接收完成事件，按地址过滤后把数据放入接收队列
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static void OnRxDone(void)
+{
+  sx126x_rx_buffer_status_t bufSts;
+  sx126x_pkt_status_lora_t  pktSts;
+  uint16 dst;
+
+  if(sx126x_get_rx_buffer_status(NULL, &bufSts) != SX126X_STATUS_OK || bufSts.pld_len_in_bytes < 2)
+  {
+    return;
+  }
+  sx126x_read_buffer(NULL, bufSts.buffer_start_pointer, s_arrFrame, bufSts.pld_len_in_bytes);
+
+  if(sx126x_get_lora_pkt_status(NULL, &pktSts) == SX126X_STATUS_OK)
+  {
+    s_iPktRssi  = pktSts.rssi_pkt_in_dbm;
+    s_iPktSnr   = pktSts.snr_pkt_in_db;
+    s_iPktValid = 1;
+  }
+
+  dst = MAKEHWORD(s_arrFrame[0], s_arrFrame[1]);
+  if(dst == s_address || dst == 0xFFFF)
+  {
+#if (RADIO_RSSI_BYTE == TRUE)
+    if(QueueFree(&s_structRxCirQue) < bufSts.pld_len_in_bytes - 1)
+    {
+      return;   //放不下整包和RSSI字节
+    }
+    s_arrFrame[bufSts.pld_len_in_bytes] = (uint8)(pktSts.rssi_pkt_in_dbm + 256);  //与E22一样在包末尾附带RSSI
+    EnQueue(&s_structRxCirQue, &s_arrFrame[2], bufSts.pld_len_in_bytes - 1);
+#else
+    EnQueue(&s_structRxCirQue, &s_arrFrame[2], bufSts.pld_len_in_bytes - 2);
+#endif
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：QueueTxFrame
+* 函数功能：把一帧放入发送帧队列，芯片空闲时立即开始发送
+* 输入参数：addr-目的地址，channel-目的信道，pData-数据，size-数据长度，wake-1--用唤醒前导码发送
+* 输出参数：void
+* 返 回 值：1--已放入发送队列，0--失败
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static uint8 QueueTxFrame(uint16 addr, uint8 channel, uint8 *pData, uint8 size, uint8 wake)
+{
+  uint8 head[4];
+
+  if(size + 2 > SX126X_FRAME_MAX)
+  {
+    return 0;
+  }
+  if(QueueFree(&s_structTxCirQue) < size + 4)
+  {
+    debug("SX126x发送队列已满\r\n");
+    return 0;
+  }
+
+  head[0] = size + 2;       //空中帧长度，|addh |addl |数据 |
+  head[1] = (channel & ~SX126X_WAKE_FLAG) | (wake ? SX126X_WAKE_FLAG : 0);  //channel
+  head[2] = HIBYTE(addr);   //addh
+  head[3] = LOBYTE(addr);   //addl
+  EnQueue(&s_structTxCirQue, head, 4);
+  EnQueue(&s_structTxCirQue, pData, size);
+
+  if(!s_iTxBusy)
+  {
+    StartTx();
+  }
+  return 1;
+}
+
+/*********************************************************************************************************
+* 函数名称：CalcAddress
+* 函数功能：由芯片96位唯一ID计算16位节点地址
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：节点地址
+* 创建日期：2026年10月19日
+* 注    意：避开广播地址0xFFFF
+*********************************************************************************************************/
+static uint16 CalcAddress(void)
+{
+  uint32 *pUID = (uint32 *)0x1FFFF7E8;
+  uint32 sum;
+  uint16 add;
+
+  sum = pUID[0] ^ pUID[1] ^ pUID[2];
+  add = (uint16)(sum ^ (sum >> 16));
+
+  return (add == 0xFFFF) ? 0xFFFE : add;
+}
+
+/*********************************************************************************************************
+*                                              API函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：InitLORA
+* 函数功能：初始化SX126x
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+void  InitLORA(void)
+{
+  InitQueue(&s_structRxCirQue, s_arrRxBuf, SX126X_RX_BUF_SIZE);
+  InitQueue(&s_structTxCirQue, s_arrTxBuf, SX126X_TX_BUF_SIZE);
+  s_iTxBusy   = 0;
+  s_iPktValid = 0;
+  s_iAirRate  = SX126X_AIR_RATE;
+  s_iRxChannel = SX126X_CHANNEL;
+  s_address   = CalcAddress();
+
+  InitSX126xBoard();
+  sx126x_reset(NULL);
+  ConfigSX126x();
+}
+
+/*********************************************************************************************************
+* 函数名称：DeInitLORA
+* 函数功能：复位芯片并恢复默认配置
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+void  DeInitLORA(void)
+{
+  ClearQueue(&s_structTxCirQue);
+  s_iTxBusy = 0;
+  sx126x_reset(NULL);
+  ConfigSX126x();
+}
+
+/*********************************************************************************************************
+* 函数名称：SetLRMode
+* 函数功能：设置工作模式
+* 输入参数：mode-RadioModems_t
+* 输出参数：void
+* 返 回 值：1--成功，0--失败
+* 创建日期：2026年10月19日
+* 注    意：模式含义与E22保持一致，MODEM_WOR对应芯片的占空比接收
+*********************************************************************************************************/
+uint8  SetLRMode(uint8 mode)
+{
+  sx126x_status_t sts = SX126X_STATUS_OK;
+
+  if(s_iTxBusy)
+  {
+    return 0;
+  }
+
+  switch(mode)
+  {
+    case MODEM_TRANSFER:
+      StartRx();
+      break;
+    case MODEM_WOR:
+      sts = sx126x_set_rx_duty_cycle(NULL, SX126X_WOR_RX_MS, SX126X_WOR_SLEEP_MS);
+      break;
+    case MODEM_CONFIG:
+      sts = sx126x_set_standby(NULL, SX126X_STANDBY_CFG_RC);
+      break;
+    case MODEM_DEEPSLEEP:
+      sts = sx126x_set_sleep(NULL, SX126X_SLEEP_CFG_WARM_START);
+      s_curChannel = 0xFF;  //唤醒后重新设置频率
+      break;
+    default:
+      return 0;
+  }
+  if(sts != SX126X_STATUS_OK)
+  {
+    return 0;
+  }
+  s_curMode = mode;
+  return 1;
+}
+
+/*********************************************************************************************************
+* 函数名称：isLoRaReady
+* 函数功能：查询芯片是否空闲
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：1--空闲，0--正在发送
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+uint8 isLoRaReady(void)
+{
+  return !s_iTxBusy;
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioSendData
+* 函数功能：无线发送数据
+* 输入参数：addr-目的地址，0xFFFF为广播，channel-目的信道，pData-数据，size-数据长度
+* 输出参数：void
+* 返 回 值：1--已放入发送队列，0--失败
+* 创建日期：2026年10月19日
+* 注    意：芯片空闲时立即开始发送，否则排队，在发送完成中断后由RadioProc接着发送，不需要等待
+*********************************************************************************************************/
+uint8  RadioSendData(uint16 addr, uint8 channel, uint8 *pData, uint8 size)
+{
+  return QueueTxFrame(addr, channel, pData, size, 0);
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioSendWakeData
+* 函数功能：带长前导码发送，唤醒处于占空比接收的目的节点
+* 输入参数：addr-目的地址，channel-目的信道，pData-数据，size-数据长度
+* 输出参数：void
+* 返 回 值：1--已放入发送队列，0--失败
+* 创建日期：2026年10月19日
+* 注    意：前导码覆盖一个WOR周期，见CalcWakePreamble
+*********************************************************************************************************/
+uint8  RadioSendWakeData(uint16 addr, uint8 channel, uint8 *pData, uint8 size)
+{
+  return QueueTxFrame(addr, channel, pData, size, 1);
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioSetIdleMode
+* 函数功能：设置发送完成后回到的模式
+* 输入参数：mode-MODEM_TRANSFER--连续接收，MODEM_WOR--占空比接收
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：芯片空闲时立即切换，正在发送时在发送完成后切换
+*********************************************************************************************************/
+void  RadioSetIdleMode(uint8 mode)
+{
+  if(mode != MODEM_TRANSFER && mode != MODEM_WOR)
+  {
+    return;
+  }
+  s_iIdleMode = mode;
+  if(!s_iTxBusy && s_curMode != mode)
+  {
+    sx126x_set_standby(NULL, SX126X_STANDBY_CFG_RC);
+    StartIdle();
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioGetIdleMode
+* 函数功能：返回发送完成后回到的模式
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：MODEM_TRANSFER或MODEM_WOR
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+uint8 RadioGetIdleMode(void)
+{
+  return s_iIdleMode;
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioReadData
+* 函数功能：读取无线接收到的数据
+* 输入参数：pBufData-数据存放的首地址，size-期望读取的字节数
+* 输出参数：pBufData
+* 返 回 值：实际读取的字节数
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+uint8  RadioReadData(uint8 *pBufData, uint8 size)
+{
+  return DeQueue(&s_structRxCirQue, pBufData, size);
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioGetPktStatus
+* 函数功能：读取最近一包的RSSI/SNR
+* 输入参数：pRssi-RSSI存放地址(dBm)，pSnr-SNR存放地址(dB)
+* 输出参数：pRssi,pSnr
+* 返 回 值：1--有效，0--无效
+* 创建日期：2026年10月19日
+* 注    意：数据来自sx126x_get_lora_pkt_status()
+*********************************************************************************************************/
+uint8  RadioGetPktStatus(int8 *pRssi, int8 *pSnr)
+{
+  if(!s_iPktValid)
+  {
+    return 0;
+  }
+  *pRssi = s_iPktRssi;
+  *pSnr  = s_iPktSnr;
+  return 1;
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioProc
+* 函数功能：处理DIO1中断事件，收包、发送完成后续发或回到接收
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：在主循环中调用，SPI读写不放在中断中进行
+*********************************************************************************************************/
+void  RadioProc(void)
+{
+  sx126x_irq_mask_t irq;
+
+  if(!GetSX126xDio1Flag())
+  {
+    return;
+  }
+  ClrSX126xDio1Flag();
+
+  if(sx126x_get_and_clear_irq_status(NULL, &irq) != SX126X_STATUS_OK)
+  {
+    return;
+  }
+
+  if(irq & SX126X_IRQ_RX_DONE)
+  {
+    if(!(irq & (SX126X_IRQ_CRC_ERROR | SX126X_IRQ_HEADER_ERROR)))
+    {
+      OnRxDone();
+    }
+    if(s_curMode == MODEM_WOR && !s_iTxBusy)
+    {
+      StartIdle();  //占空比接收收到一包后芯片停在待机，重新开始占空比接收
+    }
+  }
+
+  if(irq & SX126X_IRQ_TX_DONE)
+  {
+    s_iTxLatency = GetSX126xDio1Time() - s_iTxStartUs;
+  }
+
+  if(irq & (SX126X_IRQ_TX_DONE | SX126X_IRQ_TIMEOUT))
+  {
+    if(s_iTxBusy)
+    {
+      StartTx();  //继续发送队列中的下一帧，队列空则回到接收
+    }
+    else if(s_curMode == MODEM_TRANSFER)
+    {
+      StartRx();    //接收超时，回到连续接收
+    }
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioGetNoise
+* 函数功能：读取环境噪声
+* 输入参数：pNoise-环境噪声存放地址(dBm)
+* 输出参数：pNoise
+* 返 回 值：1--成功，0--芯片不在接收状态
+* 创建日期：2026年10月19日
+* 注    意：取芯片的瞬时RSSI
+*********************************************************************************************************/
+uint8 RadioGetNoise(int16 *pNoise)
+{
+  int16_t rssi;
+
+  if(s_iTxBusy || s_curMode != MODEM_TRANSFER || sx126x_get_rssi_inst(NULL, &rssi) != SX126X_STATUS_OK)
+  {
+    return 0;
+  }
+  *pNoise = rssi;
+  return 1;
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioGetTxLatency
+* 函数功能：返回最近一帧的发送时延
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：时延(us)，从SetTx到TX_DONE中断
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+uint32 RadioGetTxLatency(void)
+{
+  return s_iTxLatency;
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioSendCMD
+* 函数功能：
+* 输入参数：
+* 输出参数：
+* 返 回 值：
+* 创建日期：2026年10月19日
+* 注    意：SX126x没有E22的配置命令，保留空函数
+*********************************************************************************************************/
+void  RadioSendCMD(void)
+{
+
+}
+
+/*********************************************************************************************************
+* 函数名称：getAddress
+* 函数功能：返回节点地址
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：uint16地址
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+uint16 getAddress(void)
+{
+  return s_address;
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioSetAirRate
+* 函数功能：修改空中速率
+* 输入参数：rate-空中速率档位
+* 输出参数：void
+* 返 回 值：1--成功，0--失败
+* 创建日期：2026年10月19日
+* 注    意：正在发送时不切换
+*********************************************************************************************************/
+uint8 RadioSetAirRate(uint8 rate)
+{
+  if(rate >= RADIO_AIR_RATE_NUM || s_iTxBusy)
+  {
+    return 0;
+  }
+
+  s_iAirRate = rate;
+  sx126x_set_standby(NULL, SX126X_STANDBY_CFG_RC);
+  SetModParams(rate);
+  StartIdle();
+
+  return 1;
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioGetAirRate
+* 函数功能：返回当前空中速率档位
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：空中速率档位
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+uint8 RadioGetAirRate(void)
+{
+  return s_iAirRate;
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioSetChannel
+* 函数功能：修改本节点的接收信道
+* 输入参数：channel-信道号
+* 输出参数：void
+* 返 回 值：1--成功，0--失败
+* 创建日期：2026年10月19日
+* 注    意：正在发送时不切换，发送信道由每帧的channel字节指定
+*********************************************************************************************************/
+uint8 RadioSetChannel(uint8 channel)
+{
+  if((channel & SX126X_WAKE_FLAG) || s_iTxBusy)
+  {
+    return 0;
+  }
+
+  s_iRxChannel = channel;
+  sx126x_set_standby(NULL, SX126X_STANDBY_CFG_RC);
+  StartIdle();
+
+  return 1;
+}
+
+/*********************************************************************************************************
+* 函数名称：RadioGetChannel
+* 函数功能：返回本节点的接收信道
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：信道号
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+uint8 RadioGetChannel(void)
+{
+  return s_iRxChannel;
+}
+
+#endif
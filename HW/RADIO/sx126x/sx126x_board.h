@@ -0,0 +1,50 @@
+/*********************************************************************************************************
+* 模块名称：sx126x_board.h
+* 摘    要：SX126x板级支持，SPI1+DMA读写芯片，DIO1外部中断，实现sx126x_hal.h中要求用户实现的接口
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：引脚连接:
+            STM32f103RCT6   |   SX1262/SX1268
+                PA5     ------->    SCK
+                PA6     <-------    MISO
+                PA7     ------->    MOSI
+                PC4     ------->    NSS
+                PC5     ------->    NRESET
+                PB0     <-------    BUSY
+                PB1     <-------    DIO1
+* 注    意：SPI1_RX占用DMA1通道2，SPI1_TX占用DMA1通道3
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+#ifndef _SX126X_BOARD_H_
+#define _SX126X_BOARD_H_
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "DataType.h"
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#define SX126X_DMA_MIN_LEN    8     //不小于该长度的传输才使用DMA，短命令直接查询收发
+#define SX126X_BUSY_TIMEOUT   10    //等待BUSY变低的超时时间(ms)
+
+/*********************************************************************************************************
+*                                              枚举结构体定义
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              API函数声明
+*********************************************************************************************************/
+void  InitSX126xBoard(void);      //初始化SX126x相关的GPIO、SPI1、DMA和EXTI
+uint8 GetSX126xDio1Flag(void);    //获取DIO1中断标志
+void  ClrSX126xDio1Flag(void);    //清除DIO1中断标志
+uint32 GetSX126xDio1Time(void);  //获取最近一次DIO1上升沿的时刻(us)
+
+#endif
@@ -0,0 +1,467 @@
+/*********************************************************************************************************
+* 模块名称：sx126x_hal.c
+* 摘    要：SX126x板级支持，SPI1+DMA读写芯片，DIO1外部中断，实现sx126x_hal.h中要求用户实现的接口
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：引脚连接见sx126x_board.h
+* 注    意：context参数未使用，板上只有一片SX126x；本文件不随RADIO_BACKEND裁剪，保证sx126x.c在E22后端下也能链接，
+*           未被调用的函数由链接器去除
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "sx126x_board.h"
+#include "sx126x_hal.h"
+#include "RADIO.h"
+#include "stm32f10x_conf.h"
+#include "SysTick.h"
+#include "Timer.h"
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#define SX126X_NSS_LOW()    GPIO_ResetBits(GPIOC, GPIO_Pin_4)
+#define SX126X_NSS_HIGH()   GPIO_SetBits(GPIOC, GPIO_Pin_4)
+#define SX126X_IS_BUSY()    GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_0)
+
+/*********************************************************************************************************
+*                                              枚举结构体定义
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              内部变量
+*********************************************************************************************************/
+static volatile uint8 s_iDio1Flag;    //DIO1中断标志
+static volatile uint32 s_iDio1Time;   //最近一次DIO1上升沿的时刻(us)
+static volatile uint8 s_iSpiDmaDone;  //SPI DMA传输完成标志
+static uint8 s_iDummyTx = 0x00;       //只读时DMA发送的填充字节(NOP)
+static uint8 s_iDummyRx;              //只写时DMA接收的丢弃字节
+
+/*********************************************************************************************************
+*                                              内部函数声明
+*********************************************************************************************************/
+static void  ConfigSX126xGPIO(void);   //配置NSS、NRESET、BUSY、DIO1的GPIO和EXTI
+static void  ConfigSPI1(void);         //配置SPI1
+static void  ConfigSPI1DMA(void);      //配置SPI1收发DMA的中断
+static uint8 WaitSX126xBusy(void);     //等待BUSY变低
+static uint8 SpiTransfer(const uint8 *pTx, uint8 *pRx, uint16 len);  //SPI全双工收发
+
+/*********************************************************************************************************
+*                                              内部函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：ConfigSX126xGPIO
+* 函数功能：配置NSS、NRESET、BUSY、DIO1的GPIO，DIO1上升沿触发EXTI1中断
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static void ConfigSX126xGPIO(void)
+{
+  GPIO_InitTypeDef GPIO_InitStructure;
+  EXTI_InitTypeDef EXTI_InitStructure;
+  NVIC_InitTypeDef NVIC_InitStructure;
+
+  RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOB | RCC_APB2Periph_GPIOC | RCC_APB2Periph_AFIO, ENABLE);
+
+  //NSS和NRESET，推挽输出，默认高电平
+  GPIO_InitStructure.GPIO_Pin   = GPIO_Pin_4 | GPIO_Pin_5;
+  GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+  GPIO_InitStructure.GPIO_Mode  = GPIO_Mode_Out_PP;
+  GPIO_Init(GPIOC, &GPIO_InitStructure);
+  GPIO_SetBits(GPIOC, GPIO_Pin_4 | GPIO_Pin_5);
+
+  //BUSY和DIO1，下拉输入
+  GPIO_InitStructure.GPIO_Pin   = GPIO_Pin_0 | GPIO_Pin_1;
+  GPIO_InitStructure.GPIO_Mode  = GPIO_Mode_IPD;
+  GPIO_Init(GPIOB, &GPIO_InitStructure);
+
+  GPIO_EXTILineConfig(GPIO_PortSourceGPIOB, GPIO_PinSource1);
+  EXTI_InitStructure.EXTI_Line    = EXTI_Line1;
+  EXTI_InitStructure.EXTI_Mode    = EXTI_Mode_Interrupt;
+  EXTI_InitStructure.EXTI_Trigger = EXTI_Trigger_Rising;      //DIO1高电平表示有中断事件
+  EXTI_InitStructure.EXTI_LineCmd = ENABLE;
+  EXTI_Init(&EXTI_InitStructure);
+
+  NVIC_InitStructure.NVIC_IRQChannel = EXTI1_IRQn;
+  NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 2;
+  NVIC_InitStructure.NVIC_IRQChannelSubPriority = 2;
+  NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+  NVIC_Init(&NVIC_InitStructure);
+}
+
+/*********************************************************************************************************
+* 函数名称：ConfigSPI1
+* 函数功能：配置SPI1，主机模式0，8位，高位在前
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：APB2为72MHz，8分频后SCK为9MHz，SX126x最高支持16MHz
+*********************************************************************************************************/
+static void ConfigSPI1(void)
+{
+  GPIO_InitTypeDef GPIO_InitStructure;
+  SPI_InitTypeDef  SPI_InitStructure;
+
+  RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOA | RCC_APB2Periph_SPI1, ENABLE);
+
+  //SCK和MOSI，复用推挽输出
+  GPIO_InitStructure.GPIO_Pin   = GPIO_Pin_5 | GPIO_Pin_7;
+  GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+  GPIO_InitStructure.GPIO_Mode  = GPIO_Mode_AF_PP;
+  GPIO_Init(GPIOA, &GPIO_InitStructure);
+
+  //MISO，浮空输入
+  GPIO_InitStructure.GPIO_Pin   = GPIO_Pin_6;
+  GPIO_InitStructure.GPIO_Mode  = GPIO_Mode_IN_FLOATING;
+  GPIO_Init(GPIOA, &GPIO_InitStructure);
+
+  SPI_InitStructure.SPI_Direction         = SPI_Direction_2Lines_FullDuplex;
+  SPI_InitStructure.SPI_Mode              = SPI_Mode_Master;
+  SPI_InitStructure.SPI_DataSize          = SPI_DataSize_8b;
+  SPI_InitStructure.SPI_CPOL              = SPI_CPOL_Low;
+  SPI_InitStructure.SPI_CPHA              = SPI_CPHA_1Edge;
+  SPI_InitStructure.SPI_NSS               = SPI_NSS_Soft;       //NSS由PC4软件控制
+  SPI_InitStructure.SPI_BaudRatePrescaler = SPI_BaudRatePrescaler_8;
+  SPI_InitStructure.SPI_FirstBit          = SPI_FirstBit_MSB;
+  SPI_InitStructure.SPI_CRCPolynomial     = 7;
+  SPI_Init(SPI1, &SPI_InitStructure);
+
+  SPI_Cmd(SPI1, ENABLE);
+}
+
+/*********************************************************************************************************
+* 函数名称：ConfigSPI1DMA
+* 函数功能：使能DMA1时钟，打开SPI1接收DMA通道的传输完成中断
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：通道参数在每次传输时由SpiTransfer设置
+*********************************************************************************************************/
+static void ConfigSPI1DMA(void)
+{
+  NVIC_InitTypeDef NVIC_InitStructure;
+
+  RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+
+  NVIC_InitStructure.NVIC_IRQChannel = DMA1_Channel2_IRQn;
+  NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 1;
+  NVIC_InitStructure.NVIC_IRQChannelSubPriority = 1;
+  NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+  NVIC_Init(&NVIC_InitStructure);
+}
+
+/*********************************************************************************************************
+* 函数名称：WaitSX126xBusy
+* 函数功能：等待BUSY变低，芯片可以接收新命令
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：1--就绪，0--超时
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static uint8 WaitSX126xBusy(void)
+{
+  uint32 lastMillis = millis();
+
+  while(SX126X_IS_BUSY())
+  {
+    if(millis() - lastMillis > SX126X_BUSY_TIMEOUT)
+    {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/*********************************************************************************************************
+* 函数名称：SpiTransfer
+* 函数功能：SPI全双工收发len个字节
+* 输入参数：pTx-发送数据，为NULL时发送NOP；pRx-接收缓冲，为NULL时丢弃；len-字节数
+* 输出参数：pRx
+* 返 回 值：1--成功，0--超时
+* 创建日期：2026年10月19日
+* 注    意：短传输直接查询，DMA的配置开销比传输本身还大；长传输(读写FIFO)用DMA，
+*           等待期间其他中断照常响应
+*********************************************************************************************************/
+static uint8 SpiTransfer(const uint8 *pTx, uint8 *pRx, uint16 len)
+{
+  DMA_InitTypeDef DMA_InitStructure;
+  uint32 lastMillis;
+  uint16 i;
+  uint8  d;
+
+  if(len == 0)
+  {
+    return 1;
+  }
+
+  if(len < SX126X_DMA_MIN_LEN)
+  {
+    for(i = 0; i < len; i++)
+    {
+      while(SPI_I2S_GetFlagStatus(SPI1, SPI_I2S_FLAG_TXE) == RESET);
+      SPI_I2S_SendData(SPI1, (pTx != NULL) ? pTx[i] : s_iDummyTx);
+      while(SPI_I2S_GetFlagStatus(SPI1, SPI_I2S_FLAG_RXNE) == RESET);
+      d = (uint8)SPI_I2S_ReceiveData(SPI1);
+      if(pRx != NULL)
+      {
+        pRx[i] = d;
+      }
+    }
+    return 1;
+  }
+
+  SPI_I2S_ReceiveData(SPI1);  //清除残留的RXNE
+
+  //DMA1通道2，SPI1_RX
+  DMA_DeInit(DMA1_Channel2);
+  DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&(SPI1->DR);
+  DMA_InitStructure.DMA_MemoryBaseAddr     = (pRx != NULL) ? (uint32_t)pRx : (uint32_t)&s_iDummyRx;
+  DMA_InitStructure.DMA_DIR                = DMA_DIR_PeripheralSRC;
+  DMA_InitStructure.DMA_BufferSize         = len;
+  DMA_InitStructure.DMA_PeripheralInc      = DMA_PeripheralInc_Disable;
+  DMA_InitStructure.DMA_MemoryInc          = (pRx != NULL) ? DMA_MemoryInc_Enable : DMA_MemoryInc_Disable;
+  DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+  DMA_InitStructure.DMA_MemoryDataSize     = DMA_MemoryDataSize_Byte;
+  DMA_InitStructure.DMA_Mode               = DMA_Mode_Normal;
+  DMA_InitStructure.DMA_Priority           = DMA_Priority_High;
+  DMA_InitStructure.DMA_M2M                = DMA_M2M_Disable;
+  DMA_Init(DMA1_Channel2, &DMA_InitStructure);
+
+  //DMA1通道3，SPI1_TX
+  DMA_DeInit(DMA1_Channel3);
+  DMA_InitStructure.DMA_MemoryBaseAddr     = (pTx != NULL) ? (uint32_t)pTx : (uint32_t)&s_iDummyTx;
+  DMA_InitStructure.DMA_DIR                = DMA_DIR_PeripheralDST;
+  DMA_InitStructure.DMA_MemoryInc          = (pTx != NULL) ? DMA_MemoryInc_Enable : DMA_MemoryInc_Disable;
+  DMA_InitStructure.DMA_Priority           = DMA_Priority_Medium;
+  DMA_Init(DMA1_Channel3, &DMA_InitStructure);
+
+  s_iSpiDmaDone = 0;
+  DMA_ITConfig(DMA1_Channel2, DMA_IT_TC, ENABLE);  //接收完成即全部字节已移出
+  DMA_Cmd(DMA1_Channel2, ENABLE);
+  DMA_Cmd(DMA1_Channel3, ENABLE);
+  SPI_I2S_DMACmd(SPI1, SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx, ENABLE);
+
+  lastMillis = millis();
+  while(!s_iSpiDmaDone && millis() - lastMillis <= SX126X_BUSY_TIMEOUT)
+  {
+
+  }
+
+  SPI_I2S_DMACmd(SPI1, SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx, DISABLE);
+  DMA_Cmd(DMA1_Channel3, DISABLE);
+  DMA_Cmd(DMA1_Channel2, DISABLE);
+
+  return s_iSpiDmaDone;
+}
+
+/*********************************************************************************************************
+* 函数名称：DMA1_Channel2_IRQHandler
+* 函数功能：SPI1接收DMA传输完成中断
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+void DMA1_Channel2_IRQHandler(void)
+{
+  if(DMA_GetITStatus(DMA1_IT_TC2) != RESET)
+  {
+    DMA_ClearITPendingBit(DMA1_IT_GL2);
+    s_iSpiDmaDone = 1;
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：EXTI1_IRQHandler
+* 函数功能：EXTI1中断服务函数，SX126x的DIO1
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：中断中只记录时刻并置标志，读取和清除芯片IRQ状态在RadioProc中完成
+*********************************************************************************************************/
+void EXTI1_IRQHandler(void)
+{
+  if(EXTI_GetITStatus(EXTI_Line1) == SET)
+  {
+    EXTI_ClearITPendingBit(EXTI_Line1);
+    s_iDio1Time = micros();
+    s_iDio1Flag = 1;
+  }
+}
+
+/*********************************************************************************************************
+*                                              API函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：InitSX126xBoard
+* 函数功能：初始化SX126x相关的GPIO、SPI1、DMA和EXTI
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+void InitSX126xBoard(void)
+{
+  ConfigSX126xGPIO();
+  ConfigSPI1();
+  ConfigSPI1DMA();
+  s_iDio1Flag = 0;
+}
+
+/*********************************************************************************************************
+* 函数名称：GetSX126xDio1Flag
+* 函数功能：获取DIO1中断标志
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：1--有未处理的中断事件
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+uint8 GetSX126xDio1Flag(void)
+{
+  return s_iDio1Flag;
+}
+
+/*********************************************************************************************************
+* 函数名称：ClrSX126xDio1Flag
+* 函数功能：清除DIO1中断标志
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+void ClrSX126xDio1Flag(void)
+{
+  s_iDio1Flag = 0;
+}
+
+/*********************************************************************************************************
+* 函数名称：GetSX126xDio1Time
+* 函数功能：获取最近一次DIO1上升沿的时刻
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：时刻(us)
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+uint32 GetSX126xDio1Time(void)
+{
+  return s_iDio1Time;
+}
+
+/*********************************************************************************************************
+* 函数名称：sx126x_hal_write
+* 函数功能：向芯片写命令和数据
+* 输入参数：见sx126x_hal.h
+* 输出参数：void
+* 返 回 值：SX126X_HAL_STATUS_OK--成功
+* 创建日期：2026年10月19日
+* 注    意：SetSleep命令之后BUSY保持高电平，不能再等待
+*********************************************************************************************************/
+sx126x_hal_status_t sx126x_hal_write(const void* context, const uint8_t* command, const uint16_t command_length,
+                                     const uint8_t* data, const uint16_t data_length)
+{
+  uint8 ok;
+
+  if(!WaitSX126xBusy())
+  {
+    return SX126X_HAL_STATUS_ERROR;
+  }
+
+  SX126X_NSS_LOW();
+  ok = SpiTransfer(command, NULL, command_length);
+  if(ok)
+  {
+    ok = SpiTransfer(data, NULL, data_length);
+  }
+  while(SPI_I2S_GetFlagStatus(SPI1, SPI_I2S_FLAG_BSY) == SET);
+  SX126X_NSS_HIGH();
+
+  return ok ? SX126X_HAL_STATUS_OK : SX126X_HAL_STATUS_ERROR;
+}
+
+/*********************************************************************************************************
+* 函数名称：sx126x_hal_read
+* 函数功能：向芯片写命令后读取数据
+* 输入参数：见sx126x_hal.h
+* 输出参数：data
+* 返 回 值：SX126X_HAL_STATUS_OK--成功
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+sx126x_hal_status_t sx126x_hal_read(const void* context, const uint8_t* command, const uint16_t command_length,
+                                    uint8_t* data, const uint16_t data_length)
+{
+  uint8 ok;
+
+  if(!WaitSX126xBusy())
+  {
+    return SX126X_HAL_STATUS_ERROR;
+  }
+
+  SX126X_NSS_LOW();
+  ok = SpiTransfer(command, NULL, command_length);
+  if(ok)
+  {
+    ok = SpiTransfer(NULL, data, data_length);
+  }
+  while(SPI_I2S_GetFlagStatus(SPI1, SPI_I2S_FLAG_BSY) == SET);
+  SX126X_NSS_HIGH();
+
+  return ok ? SX126X_HAL_STATUS_OK : SX126X_HAL_STATUS_ERROR;
+}
+
+/*********************************************************************************************************
+* 函数名称：sx126x_hal_reset
+* 函数功能：硬件复位芯片
+* 输入参数：context
+* 输出参数：void
+* 返 回 值：SX126X_HAL_STATUS_OK--成功
+* 创建日期：2026年10月19日
+* 注    意：NRESET拉低至少100us
+*********************************************************************************************************/
+sx126x_hal_status_t sx126x_hal_reset(const void* context)
+{
+  GPIO_ResetBits(GPIOC, GPIO_Pin_5);
+  DelayNms(1);
+  GPIO_SetBits(GPIOC, GPIO_Pin_5);
+  DelayNms(5);
+
+  return WaitSX126xBusy() ? SX126X_HAL_STATUS_OK : SX126X_HAL_STATUS_ERROR;
+}
+
+/*********************************************************************************************************
+* 函数名称：sx126x_hal_wakeup
+* 函数功能：把芯片从睡眠中唤醒
+* 输入参数：context
+* 输出参数：void
+* 返 回 值：SX126X_HAL_STATUS_OK--成功
+* 创建日期：2026年10月19日
+* 注    意：NSS的下降沿即可唤醒
+*********************************************************************************************************/
+sx126x_hal_status_t sx126x_hal_wakeup(const void* context)
+{
+  SX126X_NSS_LOW();
+  DelayNus(100);
+  SX126X_NSS_HIGH();
+
+  return WaitSX126xBusy() ? SX126X_HAL_STATUS_OK : SX126X_HAL_STATUS_ERROR;
+}
@@ -33,7 +33,7 @@
 *********************************************************************************************************/
 static  uint8  s_i2msFlag  = FALSE;    //将2ms标志位的值设置为FALSE
 static  uint8  s_i1secFlag = FALSE;    //将1s标志位的值设置为FALSE
-static  uint32 s_millis_cur  = 0x0000;
+static  volatile uint32 s_millis_cur  = 0x0000;  //开机以来的毫秒数，在TIM2中断中增加
 /*********************************************************************************************************
 *                                              内部函数声明
 *********************************************************************************************************/
@@ -257,3 +257,31 @@ uint32 millis(void)
 {
   return s_millis_cur;
 }
+
+/*********************************************************************************************************
+* 函数名称：micros
+* 函数功能：当前微秒数，由毫秒数和TIM2计数值拼成
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：开机以来的微秒数，约71分钟回绕一次
+* 创建日期：2026年10月19日
+* 注    意：可在中断中调用；TIM2已溢出但其中断尚未执行时(调用者优先级不低于TIM2)，补上这1ms
+*********************************************************************************************************/
+uint32 micros(void)
+{
+  uint32 ms;
+  uint16 cnt;
+
+  do
+  {
+    ms  = s_millis_cur;
+    cnt = TIM_GetCounter(TIM2);
+  }while(ms != s_millis_cur);   //读取过程中TIM2中断执行过则重读
+
+  if(TIM_GetFlagStatus(TIM2, TIM_FLAG_Update) == SET && cnt < 500)
+  {
+    ms++;
+  }
+
+  return ms * 1000 + cnt;
+}
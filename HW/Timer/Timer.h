@@ -41,4 +41,5 @@ uint8    Get1SecFlag(void);    //获取1s标志位的值
 void  Clr1SecFlag(void);    //清除1s标志位
  
 uint32 millis(void);//当前毫秒数，记录开机在线时间，最大4294.967276秒，约71分钟
+uint32 micros(void);//当前微秒数，精度1us
 #endif
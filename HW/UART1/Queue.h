@@ -7,10 +7,10 @@
 * 内    容：
 * 注    意：                                                                  
 **********************************************************************************************************
-* 取代版本：
-* 作    者：
-* 完成日期：
-* 修改内容：
+* 取代版本：1.1.0
+* 作    者：LYL
+* 完成日期：2026年10月19日
+* 修改内容：改为Ring模块的封装，读写位置分离，中断与主循环之间不再共用元素计数
 * 修改文件：
 *********************************************************************************************************/
 #ifndef _QUEUE_H_
@@ -20,6 +20,7 @@
 *                                              包含头文件
 *********************************************************************************************************/
 #include "DataType.h"
+#include "Ring.h"
 
 /*********************************************************************************************************
 *                                              宏定义
@@ -31,15 +32,8 @@
 //定义数据类型，即队列中元素的数据类型
 typedef uint8  DATA_TYPE;
 
-//定义循环队列结构体
-typedef struct
-{
-  int16       front;    //头指针，队非空时指向队头元素
-  int16       rear;     //尾指针，队非空时指向队尾元素的下一个位置
-  int16       bufLen;   //队列的总容量
-  int16       elemNum;  //当前队列中的元素的数量
-  DATA_TYPE *pBuffer; //循环队列的缓冲区
-}StructCirQue;
+//定义循环队列结构体，即元素大小为sizeof(DATA_TYPE)的环形缓冲区
+typedef StructRing StructCirQue;
 
 /*********************************************************************************************************
 *                                              API函数声明
@@ -48,7 +42,12 @@ void  InitQueue(StructCirQue* pQue, DATA_TYPE* pBuf, int16 len);  //初始化队
 void  ClearQueue(StructCirQue* pQue);                           //清队列
 uint8    QueueEmpty(StructCirQue* pQue);                           //判断队列是否为空，1为空，0为非空
 int16   QueueLength(StructCirQue* pQue);                          //返回队列中元素个数，即为队列的长度
+int16   QueueFree(StructCirQue* pQue);                            //返回队列中还能写入的元素个数
 int16   EnQueue(StructCirQue* pQue, DATA_TYPE* pInput, int16 len);  //入队len个元素
 int16   DeQueue(StructCirQue* pQue, DATA_TYPE* pOutput, int16 len); //出队len个元素
+int16   GetQueueBlock(StructCirQue* pQue, DATA_TYPE** ppData);   //返回队头开始地址连续的元素个数，不出队
+void  SkipQueue(StructCirQue* pQue, int16 len);                 //从队头丢弃len个元素
+void  SetQueuePolicy(StructCirQue* pQue, uint8 policy);          //设置队列满时的丢弃策略，EnumRingPolicy
+void  GetQueueStats(StructCirQue* pQue, StructRingStats* pStats); //读取入队、丢弃的元素个数和最高水位
 
 #endif
@@ -23,6 +23,7 @@
 #include <string.h>
 #include "UART2.h"
 #include "Main.h"
+#include "Timer.h"
 
 /*********************************************************************************************************
 *                                              宏定义
@@ -46,17 +47,24 @@ static  StructCirQue s_structUART1SendCirQue;  //发送串口循环队列
 static  StructCirQue s_structUART1RecCirQue;   //接收串口循环队列
 static  uint8  s_arrSendBuf1[UART1_BUF_SIZE];     //发送串口循环队列的缓冲区
 static  uint8  s_arrRecBuf1[UART1_BUF_SIZE];      //接收串口循环队列的缓冲区
+static  uint8  s_arrRxDma1[UART1_RX_DMA_SIZE];  //接收DMA循环缓冲区，由DMA1_Channel5写入
+static  uint16 s_iRxDmaPos1;                     //接收DMA循环缓冲区中已搬入接收队列的位置
 
-static  uint8  s_iUART1TxSts;                     //串口发送数据状态
+static  volatile uint8 s_iUART1TxSts;                    //串口发送数据状态
+static  int16  s_iTxDmaLen1;                      //发送DMA本段正在发送的字节数
+static  volatile uint32 s_iTxDoneUs1;                     //最近一次发送完成(最后一个字节移出)的时刻(us)
+static  uint32 s_iUART1Baud;                      //当前波特率
           
 /*********************************************************************************************************
 *                                              内部函数声明
 *********************************************************************************************************/
 static  void  InitUART1Buf(void);      //初始化串口缓冲区，包括发送缓冲区和接收缓冲区 
-static  uint8    WriteReceiveBuf1(uint8 d);  //将接收到的数据写入UART1接收缓冲区
-static  uint8    ReadSendBuf1(uint8 *p);     //读取UART1发送缓冲区中的数据
+static  void     MoveRxDmaData1(void);     //将接收DMA新收到的数据整块写入UART1接收缓冲区
+static  void     StartTxDma1(void);         //从UART1发送缓冲区取一段连续数据启动DMA发送
                                             
 static  void  ConfigUART1(uint32 bound);  //配置UART1串口相关的参数，包括GPIO、RCC、USART和NVIC 
+static  void  ConfigDMA1Ch4(void);        //配置DMA1通道4，发送UART1的数据
+static  void  ConfigDMA1Ch5(void);        //配置DMA1通道5，循环接收UART1的数据
 static  void  EnableUART1Tx(void);     //使能UART1串口发送，WriteUARTx中调用，每次发送数据之后需要调用                                      
                                             
 static  void  SendCharUsedByFputc(uint16 ch);  //发送字符函数，专由fputc函数调用,与printf函数相关
@@ -83,44 +91,82 @@ static  void  InitUART1Buf(void)
     s_arrRecBuf1[i]  = 0;  
   }
 
+  for(i = 0; i < UART1_RX_DMA_SIZE; i++)
+  {
+    s_arrRxDma1[i] = 0;
+  }
+  s_iRxDmaPos1 = 0;
+
   InitQueue(&s_structUART1SendCirQue, s_arrSendBuf1, UART1_BUF_SIZE);
   InitQueue(&s_structUART1RecCirQue,  s_arrRecBuf1,  UART1_BUF_SIZE);
+
+  //发送缓冲区由DMA零拷贝读，不能丢弃旧数据；每次写入为一帧，放不下时整帧丢弃
+  SetQueuePolicy(&s_structUART1SendCirQue, RING_DROP_FRAME);
+  //接收的是字节流，上层解包会重新找帧头，放不下时保留能放下的部分
+  SetQueuePolicy(&s_structUART1RecCirQue,  RING_DROP_NEW);
 }
 
 /*********************************************************************************************************
-* 函数名称：WriteReceiveBuf1
-* 函数功能：写数据到串口接收缓冲区 
-* 输入参数：d，待写入串口接收缓冲区的数据
+* 函数名称：MoveRxDmaData1
+* 函数功能：将接收DMA循环缓冲区中新收到的数据整块写入串口接收缓冲区
+* 输入参数：void
 * 输出参数：void
-* 返 回 值：写入数据成功标志，0-不成功，1-成功 
-* 创建日期：2021年07月11日
-* 注    意：
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：由USART1的IDLE中断和DMA1_Channel5的半满、全满中断调用，两者抢占优先级相同，不会互相嵌套；
+*           半满和全满中断保证每收到半个DMA缓冲区至少搬运一次，DMA不会覆盖尚未搬走的数据
 *********************************************************************************************************/
-static  uint8  WriteReceiveBuf1(uint8 d)
+static  void  MoveRxDmaData1(void)
 {
-  uint8 ok = 0;  //写入数据成功标志，0-不成功，1-成功
-                                                                    
-  ok = EnQueue(&s_structUART1RecCirQue, &d, 1);   
-                                                                    
-  return ok;  //返回写入数据成功标志，0-不成功，1-成功 
+  uint16 pos;  //DMA当前写入的位置
+
+  pos = UART1_RX_DMA_SIZE - DMA_GetCurrDataCounter(DMA1_Channel5);
+  if(pos >= UART1_RX_DMA_SIZE)
+  {
+    pos = 0;
+  }
+
+  if(pos > s_iRxDmaPos1)
+  {
+    EnQueue(&s_structUART1RecCirQue, &s_arrRxDma1[s_iRxDmaPos1], pos - s_iRxDmaPos1);
+  }
+  else if(pos < s_iRxDmaPos1)
+  {
+    //DMA已经回绕，分两段搬运
+    EnQueue(&s_structUART1RecCirQue, &s_arrRxDma1[s_iRxDmaPos1], UART1_RX_DMA_SIZE - s_iRxDmaPos1);
+    EnQueue(&s_structUART1RecCirQue, s_arrRxDma1, pos);
+  }
+
+  s_iRxDmaPos1 = pos;
 }
 
 /*********************************************************************************************************
-* 函数名称：ReadSendBuf1
-* 函数功能：读取串口发送缓冲区中的数据 
-* 输入参数：p，读出来的数据存放的首地址
-* 输出参数：p，读出来的数据存放的首地址
-* 返 回 值：读取数据成功标志，0-不成功，1-成功 
-* 创建日期：2021年07月11日
-* 注    意：
+* 函数名称：StartTxDma1
+* 函数功能：从发送缓冲区队头取一段地址连续的数据，启动DMA发送
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：数据跨过缓冲区末尾时分两段发送，第二段在DMA传输完成中断中接着启动；
+*           发送缓冲区已空时打开USART1的TC中断，等最后一个字节移出后再结束发送
 *********************************************************************************************************/
-static  uint8  ReadSendBuf1(uint8 *p)
+static  void  StartTxDma1(void)
 {
-  uint8 ok = 0;  //读取数据成功标志，0-不成功，1-成功
-                                                                   
-  ok = DeQueue(&s_structUART1SendCirQue, p, 1);  
-                                                                   
-  return ok;  //返回读取数据成功标志，0-不成功，1-成功 
+  uint8* pData;  //本段数据的首地址
+
+  s_iTxDmaLen1 = GetQueueBlock(&s_structUART1SendCirQue, &pData);
+
+  if(s_iTxDmaLen1 > 0)
+  {
+    DMA_Cmd(DMA1_Channel4, DISABLE);                     //修改地址和长度前先关闭通道
+    DMA1_Channel4->CMAR = (uint32_t)pData;               //设置存储器地址，库函数中没有单独设置的接口
+    DMA_SetCurrDataCounter(DMA1_Channel4, s_iTxDmaLen1); //设置要传输的数据项数目
+    DMA_Cmd(DMA1_Channel4, ENABLE);                      //开始发送
+  }
+  else
+  {
+    USART_ITConfig(USART1, USART_IT_TC, ENABLE);             //等待最后一个字节发送完成
+  }
 }
 
 /*********************************************************************************************************
@@ -171,28 +217,116 @@ static  void  ConfigUART1(uint32 bound)
   NVIC_Init(&NVIC_InitStructure);                           //根据参数初始化NVIC
 
   //使能USART1及其中断
-  USART_ITConfig(USART1, USART_IT_RXNE, ENABLE);  //使能接收缓冲区非空中断
-  USART_ITConfig(USART1, USART_IT_TXE,  ENABLE);  //使能发送缓冲区空中断
+  ConfigDMA1Ch5();                               //配置接收DMA
+  USART_DMACmd(USART1, USART_DMAReq_Rx, ENABLE);     //使能接收DMA请求
+  USART_ITConfig(USART1, USART_IT_IDLE, ENABLE);  //使能总线空闲中断，一帧数据接收完毕
+  ConfigDMA1Ch4();                               //配置发送DMA
+  USART_DMACmd(USART1, USART_DMAReq_Tx, ENABLE);     //使能发送DMA请求
   USART_Cmd(USART1, ENABLE);                      //使能USART1
                                                                      
   s_iUART1TxSts = UART_STATE_OFF;  //串口发送数据状态设置为未发送数据
+  s_iUART1Baud  = bound;
+}
+
+/*********************************************************************************************************
+* 函数名称：ConfigDMA1Ch5
+* 函数功能：配置DMA1通道5，把USART1接收到的数据循环写入s_arrRxDma1
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：DMA1通道5固定对应USART1_RX
+*********************************************************************************************************/
+static  void  ConfigDMA1Ch5(void)
+{
+  DMA_InitTypeDef  DMA_InitStructure;   //DMA_InitStructure用于存放DMA的参数
+  NVIC_InitTypeDef NVIC_InitStructure;  //NVIC_InitStructure用于存放NVIC的参数
+
+  RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);  //使能DMA1的时钟
+
+  //配置DMA1_Channel5
+  DMA_DeInit(DMA1_Channel5);  //将DMA1_CH5寄存器设置为默认值
+  DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&(USART1->DR);          //设置外设地址
+  DMA_InitStructure.DMA_MemoryBaseAddr     = (uint32_t)s_arrRxDma1;           //设置存储器地址
+  DMA_InitStructure.DMA_DIR                = DMA_DIR_PeripheralSRC;           //设置为外设到存储器模式
+  DMA_InitStructure.DMA_BufferSize         = UART1_RX_DMA_SIZE;              //设置要传输的数据项数目
+  DMA_InitStructure.DMA_PeripheralInc      = DMA_PeripheralInc_Disable;       //设置外设为非递增模式
+  DMA_InitStructure.DMA_MemoryInc          = DMA_MemoryInc_Enable;            //设置存储器为递增模式
+  DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;     //设置外设数据长度为字节
+  DMA_InitStructure.DMA_MemoryDataSize     = DMA_MemoryDataSize_Byte;         //设置存储器数据长度为字节
+  DMA_InitStructure.DMA_Mode               = DMA_Mode_Circular;               //设置为循环模式
+  DMA_InitStructure.DMA_Priority           = DMA_Priority_High;               //设置为高优先级
+  DMA_InitStructure.DMA_M2M                = DMA_M2M_Disable;                 //禁止存储器到存储器访问
+  DMA_Init(DMA1_Channel5, &DMA_InitStructure);  //根据参数初始化DMA1_Channel5
+
+  //配置NVIC，抢占优先级与USART1相同
+  NVIC_InitStructure.NVIC_IRQChannel = DMA1_Channel5_IRQn;  //中断通道号
+  NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0; //设置抢占优先级
+  NVIC_InitStructure.NVIC_IRQChannelSubPriority        = 0; //设置子优先级
+  NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;           //使能中断
+  NVIC_Init(&NVIC_InitStructure);                           //根据参数初始化NVIC
+
+  DMA_ITConfig(DMA1_Channel5, DMA_IT_HT | DMA_IT_TC, ENABLE);  //使能半满和全满中断
+  DMA_Cmd(DMA1_Channel5, ENABLE);                             //使能DMA1_Channel5
+}
+
+/*********************************************************************************************************
+* 函数名称：ConfigDMA1Ch4
+* 函数功能：配置DMA1通道4，把发送缓冲区中的数据写入USART1
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：DMA1通道4固定对应USART1_TX，存储器地址和长度在StartTxDma1中每段设置
+*********************************************************************************************************/
+static  void  ConfigDMA1Ch4(void)
+{
+  DMA_InitTypeDef  DMA_InitStructure;   //DMA_InitStructure用于存放DMA的参数
+  NVIC_InitTypeDef NVIC_InitStructure;  //NVIC_InitStructure用于存放NVIC的参数
+
+  RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);  //使能DMA1的时钟
+
+  //配置DMA1_Channel4
+  DMA_DeInit(DMA1_Channel4);  //将DMA1_CH4寄存器设置为默认值
+  DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&(USART1->DR);          //设置外设地址
+  DMA_InitStructure.DMA_MemoryBaseAddr     = (uint32_t)s_arrSendBuf1;         //设置存储器地址
+  DMA_InitStructure.DMA_DIR                = DMA_DIR_PeripheralDST;           //设置为存储器到外设模式
+  DMA_InitStructure.DMA_BufferSize         = 1;                               //设置要传输的数据项数目，发送时再修改
+  DMA_InitStructure.DMA_PeripheralInc      = DMA_PeripheralInc_Disable;       //设置外设为非递增模式
+  DMA_InitStructure.DMA_MemoryInc          = DMA_MemoryInc_Enable;            //设置存储器为递增模式
+  DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;     //设置外设数据长度为字节
+  DMA_InitStructure.DMA_MemoryDataSize     = DMA_MemoryDataSize_Byte;         //设置存储器数据长度为字节
+  DMA_InitStructure.DMA_Mode               = DMA_Mode_Normal;                 //设置为正常模式
+  DMA_InitStructure.DMA_Priority           = DMA_Priority_Medium;             //设置为中等优先级
+  DMA_InitStructure.DMA_M2M                = DMA_M2M_Disable;                 //禁止存储器到存储器访问
+  DMA_Init(DMA1_Channel4, &DMA_InitStructure);  //根据参数初始化DMA1_Channel4
+
+  //配置NVIC，抢占优先级与USART1相同
+  NVIC_InitStructure.NVIC_IRQChannel = DMA1_Channel4_IRQn;  //中断通道号
+  NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0; //设置抢占优先级
+  NVIC_InitStructure.NVIC_IRQChannelSubPriority        = 0; //设置子优先级
+  NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;           //使能中断
+  NVIC_Init(&NVIC_InitStructure);                           //根据参数初始化NVIC
+
+  DMA_ITConfig(DMA1_Channel4, DMA_IT_TC, ENABLE);  //使能传输完成中断
 }
 
 /*********************************************************************************************************
 * 函数名称：EnableUART1Tx
-* 函数功能：使能串口发送，在WriteUARTx中调用，即每次发送数据之后需要调用这个函数来使能发送中断 
+* 函数功能：使能串口发送，在WriteUARTx中调用，发送缓冲区从空变为非空时启动DMA发送
 * 输入参数：void
 * 输出参数：void
 * 返 回 值：void 
 * 创建日期：2021年07月11日
-* 注    意：s_iUART1TxSts = UART_STATE_ON;这句话必须放在USART_ITConfig之前，否则会导致中断打开无法执行
+* 注    意：s_iUART1TxSts = UART_STATE_ON;这句话必须放在启动DMA之前；
+*           DMA发送前需先清除TC标志，否则会误判为最后一个字节已经发送完成
 *********************************************************************************************************/
 static  void  EnableUART1Tx(void)
 {
   s_iUART1TxSts = UART_STATE_ON;                     //串口发送数据状态设置为正在发送数据
-//  s_Aux = AUX_STATE_BUSSY;  //先置忙标志位
-  
-  USART_ITConfig(USART1, USART_IT_TXE, ENABLE);     //使能发送中断
+
+  USART_ClearFlag(USART1, USART_FLAG_TC);               //清除发送完成标志
+  StartTxDma1();                                     //启动DMA发送
 }
 
 /*********************************************************************************************************
@@ -202,30 +336,19 @@ static  void  EnableUART1Tx(void)
 * 输出参数：void
 * 返 回 值：void 
 * 创建日期：2021年07月11日
-* 注    意：
+* 注    意：字符写入发送缓冲区后由DMA发出，不再查询等待；发送缓冲区满时丢弃该字符
 *********************************************************************************************************/
 static  void  SendCharUsedByFputc(uint16 ch)
 {  
+  uint8 c = (uint8)ch;
+
   #if (defined SINK) && (SINK == TRUE)//汇聚节点
   //网关发送位置
-  USART_SendData(USART2, (uint8)ch);
-
-  //等待发送完毕
-  while(USART_GetFlagStatus(USART2, USART_FLAG_TC) == RESET)
-  {
-    
-  }
+  WriteUART2(&c, 1);
   #else
   //普通节点发送位置
-  USART_SendData(USART1, (uint8)ch);
-
-  //等待发送完毕
-  while(USART_GetFlagStatus(USART1, USART_FLAG_TC) == RESET)
-  {
-    
-  }
+  WriteUART1(&c, 1);
   #endif
-  
 }
 
 /*********************************************************************************************************
@@ -235,18 +358,15 @@ static  void  SendCharUsedByFputc(uint16 ch)
 * 输出参数：void
 * 返 回 值：void
 * 创建日期：2021年07月11日
-* 注    意：
+* 注    意：发送完成时记下时刻，供GetUART1TxDoneTime判断E22是否刚收完串口数据
 *********************************************************************************************************/
 void USART1_IRQHandler(void)                
 {
-  uint8  uData = 0x07;
-
-  if(USART_GetITStatus(USART1, USART_IT_RXNE) != RESET)  //接收缓冲区非空中断（串口接收到数据）
+  if(USART_GetITStatus(USART1, USART_IT_IDLE) != RESET)  //总线空闲中断（一帧数据接收完毕）
   {                                                         
-    NVIC_ClearPendingIRQ(USART1_IRQn);  //清除USART1中断挂起
-    uData = USART_ReceiveData(USART1);  //将USART1接收到的数据保存到uData
+    USART_ReceiveData(USART1);           //先读SR再读DR，清除IDLE标志
                                                           
-    WriteReceiveBuf1(uData);  //将接收到的数据写入接收缓冲区                                 
+    MoveRxDmaData1();  //将DMA收到的数据整块写入接收缓冲区
   }                                                         
                                                             
   if(USART_GetFlagStatus(USART1, USART_FLAG_ORE) == SET) //溢出错误标志为1（串口接收溢出）
@@ -255,24 +375,62 @@ void USART1_IRQHandler(void)
     USART_ReceiveData(USART1);                           //读取USART_DR 
   }                                                         
                                                            
-  if(USART_GetITStatus(USART1, USART_IT_TXE)!= RESET)    //发送缓冲区空中断（串口发送完成）
-  {                                                        
-    USART_ClearITPendingBit(USART1, USART_IT_TXE);       //清除发送中断标志
-    NVIC_ClearPendingIRQ(USART1_IRQn);                   //清除USART1中断挂起
-                                                           
-    if(1 == ReadSendBuf1(&uData))                           //读取发送缓冲区的数据到uData
-    {                                                                
-      USART_SendData(USART1, uData);                       //将uData写入USART_DR
+  if(USART_GetITStatus(USART1, USART_IT_TC) != RESET)     //发送完成中断（最后一个字节已移出）
+  {
+    USART_ITConfig(USART1, USART_IT_TC, DISABLE);        //关闭发送完成中断
+    s_iTxDoneUs1 = micros();                             //记录发送完成的时刻
+
+    if(QueueEmpty(&s_structUART1SendCirQue))            //当发送缓冲区为空时
+    {
+      s_iUART1TxSts = UART_STATE_OFF;                   //串口发送数据状态设置为未发送数据
     }
-    
-    if(QueueEmpty(&s_structUART1SendCirQue))              //当发送缓冲区为空时
-    {                                                               
-      s_iUART1TxSts = UART_STATE_OFF;                     //串口发送数据状态设置为未发送数据       
-      USART_ITConfig(USART1, USART_IT_TXE, DISABLE);     //关闭串口发送缓冲区空中断
+    else                                                 //等待TC期间又写入了数据
+    {
+      USART_ClearFlag(USART1, USART_FLAG_TC);             //清除发送完成标志
+      StartTxDma1();
     }
   }
 } 
 
+/*********************************************************************************************************
+* 函数名称：DMA1_Channel5_IRQHandler
+* 函数功能：DMA1通道5中断服务函数，USART1接收DMA半满、全满时搬运数据
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+void DMA1_Channel5_IRQHandler(void)
+{
+  if(DMA_GetITStatus(DMA1_IT_HT5) != RESET || DMA_GetITStatus(DMA1_IT_TC5) != RESET)
+  {
+    DMA_ClearITPendingBit(DMA1_IT_HT5 | DMA1_IT_TC5 | DMA1_IT_GL5);  //清除中断标志
+
+    MoveRxDmaData1();  //将DMA收到的数据整块写入接收缓冲区
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：DMA1_Channel4_IRQHandler
+* 函数功能：DMA1通道4中断服务函数，USART1发送DMA一段传输完成后接着发送下一段
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+void DMA1_Channel4_IRQHandler(void)
+{
+  if(DMA_GetITStatus(DMA1_IT_TC4) != RESET)
+  {
+    DMA_ClearITPendingBit(DMA1_IT_GL4);                   //清除中断标志
+
+    SkipQueue(&s_structUART1SendCirQue, s_iTxDmaLen1);  //已发送的数据出队
+    StartTxDma1();                                        //发送下一段
+  }
+}
+
 /*********************************************************************************************************
 *                                              API函数实现
 *********************************************************************************************************/
@@ -292,37 +450,108 @@ void InitUART1(uint32 bound)
   ConfigUART1(bound);    //配置串口相关的参数，包括GPIO、RCC、USART和NVIC  
 }
 
+/*********************************************************************************************************
+* 函数名称：SetUART1Baud
+* 函数功能：修改UART1的波特率，缓冲区中的数据保留
+* 输入参数：bound,波特率
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：先等待发送缓冲区中的数据全部发完，收发DMA保持运行
+*********************************************************************************************************/
+void SetUART1Baud(uint32 bound)
+{
+  USART_InitTypeDef USART_InitStructure;  //USART_InitStructure用于存放USART的参数
+
+  while(s_iUART1TxSts == UART_STATE_ON)
+  {
+
+  }
+
+  USART_Cmd(USART1, DISABLE);
+  USART_StructInit(&USART_InitStructure);                   //初始化USART_InitStructure
+  USART_InitStructure.USART_BaudRate   = bound;             //设置波特率
+  USART_InitStructure.USART_WordLength = USART_WordLength_8b;   //设置数据字长度
+  USART_InitStructure.USART_StopBits   = USART_StopBits_1;  //设置停止位
+  USART_InitStructure.USART_Parity     = USART_Parity_No;   //设置奇偶校验位
+  USART_InitStructure.USART_Mode       = USART_Mode_Rx | USART_Mode_Tx;           //设置模式
+  USART_InitStructure.USART_HardwareFlowControl = USART_HardwareFlowControl_None; //设置硬件流控制模式
+  USART_Init(USART1, &USART_InitStructure);                 //根据参数初始化USART1
+  USART_Cmd(USART1, ENABLE);                                //使能USART1
+  s_iUART1Baud = bound;
+}
+
 /*********************************************************************************************************
 * 函数名称：WriteUART1
 * 函数功能：写串口，即写数据到的串口发送缓冲区  
-* 输入参数：pBuf，要写入数据的首地址，len，期望写入数据的个数,最大1000字节
+* 输入参数：pBuf，要写入数据的首地址，len，期望写入数据的个数，最大为发送缓冲区的大小
 * 输出参数：void
 * 返 回 值：成功写入数据的个数，不一定与形参len相等
 * 创建日期：2021年07月11日
 * 注    意：
 *********************************************************************************************************/
-uint8  WriteUART1(uint8 *pBuf, uint8 len)
+uint16 WriteUART1(uint8 *pBuf, uint16 len)
 {
-  uint8 wLen = 0;  //实际写入数据的个数
+  uint16 wLen = 0;  //实际写入数据的个数
                                                                   
   wLen = EnQueue(&s_structUART1SendCirQue, pBuf, len);
 
-  if(wLen < UART1_BUF_SIZE)
+  if(wLen < len)
   {
-    if(s_iUART1TxSts == UART_STATE_OFF)
-    {
-      EnableUART1Tx();//使能中断发送
-    }    
+    debug("UART1发送缓冲区溢出,还要%d个字节\r\n",len - wLen);
   }
   
-  if(wLen < len)
+  if(wLen == 0)//没有写入数据，不启动发送，否则空队列启动的DMA不会结束，发送状态一直为正在发送
   {
-    debug("UART1发送缓冲区溢出,还要%d个字节\r\n",len - wLen);
+    return 0;
+  }
+  
+  if(s_iUART1TxSts == UART_STATE_OFF)
+  {
+    EnableUART1Tx();//启动DMA发送
   }
   
   return wLen;  //返回实际写入数据的个数
 }
 
+/*********************************************************************************************************
+* 函数名称：WriteUART1v
+* 函数功能：分段写串口，帧头、数据和校验等不需要先拼成一块再写
+* 输入参数：pVec-各段数据，num-段数
+* 输出参数：void
+* 返 回 值：写入的总字节数，发送缓冲区放不下全部数据时返回0，一段也不写
+* 创建日期：2026年10月19日
+* 注    意：每段一次写入发送缓冲区，由主循环调用
+*********************************************************************************************************/
+uint16 WriteUART1v(StructIoVec* pVec, uint8 num)
+{
+  uint16 total = 0;  //总字节数
+  uint8  i;
+
+  for(i = 0; i < num; i++)
+  {
+    total += pVec[i].len;
+  }
+
+  if(total > QueueFree(&s_structUART1SendCirQue))
+  {
+    debug("UART1发送缓冲区溢出,需要%d个字节\r\n", total);
+    return 0;
+  }
+
+  for(i = 0; i < num; i++)
+  {
+    EnQueue(&s_structUART1SendCirQue, pVec[i].pBuf, pVec[i].len);
+  }
+
+  if(s_iUART1TxSts == UART_STATE_OFF)
+  {
+    EnableUART1Tx();  //启动DMA发送
+  }
+
+  return total;
+}
+
 /*********************************************************************************************************
 * 函数名称：ReadUART1
 * 函数功能：读串口，即读取串口接收缓冲区中的数据  
@@ -341,6 +570,25 @@ uint8  ReadUART1(uint8 *pBuf, uint8 len)
   return rLen;  //返回实际读取数据的长度
 }
 
+/*********************************************************************************************************
+* 函数名称：GetUART1RxLatency
+* 函数功能：接收数据在DMA缓冲区中最长的停留时间
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：停留时间(ms)
+* 创建日期：2026年10月19日
+* 注    意：连续接收时数据要等到DMA半满才搬入接收缓冲区，即收满半个UART1_RX_DMA_SIZE的时间，
+*           9600波特率约133ms；一帧被半满分成两段时，两段的处理时刻相差这么久
+*********************************************************************************************************/
+uint16 GetUART1RxLatency(void)
+{
+  if(s_iUART1Baud == 0)
+  {
+    return 0;
+  }
+  return (uint16)((uint32)UART1_RX_DMA_SIZE / 2 * 10 * 1000 / s_iUART1Baud);  //每字节10位
+}
+
 /*********************************************************************************************************
 * 函数名称：ReadUART1
 * 函数功能：读串口状态
@@ -355,6 +603,35 @@ uint8 GetUART1TxSts(void)
   return s_iUART1TxSts;
 }
 
+/*********************************************************************************************************
+* 函数名称：GetUART1TxDoneTime
+* 函数功能：返回最近一次发送完成的时刻
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：最后一个字节移出移位寄存器的时刻(us)，与micros()同一时基
+* 创建日期：2026年10月19日
+* 注    意：GetUART1TxSts()为0时有效，无线层据此判断数据何时全部进入模块
+*********************************************************************************************************/
+uint32 GetUART1TxDoneTime(void)
+{
+  return s_iTxDoneUs1;
+}
+
+/*********************************************************************************************************
+* 函数名称：GetUART1Stats
+* 函数功能：读取串口发送、接收缓冲区的统计
+* 输入参数：void
+* 输出参数：pTx-发送缓冲区统计，pRx-接收缓冲区统计
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：丢弃数和最高水位用于根据现场数据调整UART1_BUF_SIZE
+*********************************************************************************************************/
+void GetUART1Stats(StructRingStats* pTx, StructRingStats* pRx)
+{
+  GetQueueStats(&s_structUART1SendCirQue, pTx);
+  GetQueueStats(&s_structUART1RecCirQue,  pRx);
+}
+
 /*********************************************************************************************************
 * 函数名称：fputc
 * 函数功能：重定向函数  
@@ -21,23 +21,36 @@
 *********************************************************************************************************/
 #include <stdio.h>
 #include "DataType.h"
+#include "Ring.h"
 #include "stm32f10x_conf.h"
 
 /*********************************************************************************************************
 *                                              宏定义
 *********************************************************************************************************/
 #define UART1_BUF_SIZE 1024*2          //设置缓冲区的大小,发送接收缓存大小一致,串口一段时间后异常就是缓冲区溢出
+#define UART1_RX_DMA_SIZE 256          //接收DMA循环缓冲区的大小，半满、全满或总线空闲时整块搬入接收缓冲区
 
 /*********************************************************************************************************
 *                                              枚举结构体定义
 *********************************************************************************************************/
+//分段写串口时的一段数据
+typedef struct
+{
+  uint8* pBuf;  //数据首地址
+  uint16 len;   //数据长度
+}StructIoVec;
 
 /*********************************************************************************************************
 *                                              API函数声明
 *********************************************************************************************************/
 void  InitUART1(uint32 bound);             //初始化UART1模块
-uint8 WriteUART1(uint8 *pBuf, uint8 len);  //写串口，返回已写入数据的个数
+void  SetUART1Baud(uint32 bound);          //修改UART1的波特率
+uint16 WriteUART1(uint8 *pBuf, uint16 len); //写串口，返回已写入数据的个数
+uint16 WriteUART1v(StructIoVec* pVec, uint8 num); //按顺序写入num段数据，空间不够时一段也不写，返回写入的总字节数
 uint8 ReadUART1(uint8 *pBuf, uint8 len);   //读串口，返回读到数据的个数
 extern void debug(uint8 * msg, ...);
-uint8 GetUART1TxSts(void);
+uint8 GetUART1TxSts(void);                 //1--串口正在发送数据
+uint32 GetUART1TxDoneTime(void);           //最近一次发送完成的时刻(us)
+void  GetUART1Stats(StructRingStats* pTx, StructRingStats* pRx); //读取发送、接收缓冲区的统计
+uint16 GetUART1RxLatency(void);            //接收数据在DMA缓冲区中最长的停留时间(ms)
 #endif
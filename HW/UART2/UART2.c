@@ -50,17 +50,22 @@ static  StructCirQue s_structUART2SendCirQue;  //发送串口循环队列
 static  StructCirQue s_structUART2RecCirQue;   //接收串口循环队列
 static  uint8  s_arrSendBuf2[UART2_BUF_SIZE];     //发送串口循环队列的缓冲区
 static  uint8  s_arrRecBuf2[UART2_BUF_SIZE];      //接收串口循环队列的缓冲区
+static  uint8  s_arrRxDma2[UART2_RX_DMA_SIZE];  //接收DMA循环缓冲区，由DMA1_Channel6写入
+static  uint16 s_iRxDmaPos2;                     //接收DMA循环缓冲区中已搬入接收队列的位置
 
-static  uint8  s_iUART2TxSts;                     //串口发送数据状态
+static  volatile uint8 s_iUART2TxSts;                    //串口发送数据状态
+static  int16  s_iTxDmaLen2;                      //发送DMA本段正在发送的字节数
           
 /*********************************************************************************************************
 *                                              内部函数声明
 *********************************************************************************************************/
 static  void  InitUART2Buf(void);      //初始化串口缓冲区，包括发送缓冲区和接收缓冲区 
-static  uint8    WriteReceiveBuf2(uint8 d);  //将接收到的数据写入UART2接收缓冲区
-static  uint8    ReadSendBuf2(uint8 *p);     //读取UART2发送缓冲区中的数据
+static  void     MoveRxDmaData2(void);     //将接收DMA新收到的数据整块写入UART2接收缓冲区
+static  void     StartTxDma2(void);         //从UART2发送缓冲区取一段连续数据启动DMA发送
                                             
 static  void  ConfigUART2(uint32 bound);  //配置UART2串口相关的参数，包括GPIO、RCC、USART和NVIC 
+static  void  ConfigDMA1Ch7(void);        //配置DMA1通道7，发送UART2的数据
+static  void  ConfigDMA1Ch6(void);        //配置DMA1通道6，循环接收UART2的数据
 static  void  EnableUART2Tx(void);     //使能UART2串口发送，WriteUARTx中调用，每次发送数据之后需要调用                                      
                                             
   
@@ -86,44 +91,82 @@ static  void  InitUART2Buf(void)
     s_arrRecBuf2[i]  = 0;  
   }
 
+  for(i = 0; i < UART2_RX_DMA_SIZE; i++)
+  {
+    s_arrRxDma2[i] = 0;
+  }
+  s_iRxDmaPos2 = 0;
+
   InitQueue(&s_structUART2SendCirQue, s_arrSendBuf2, UART2_BUF_SIZE);
   InitQueue(&s_structUART2RecCirQue,  s_arrRecBuf2,  UART2_BUF_SIZE);
+
+  //发送缓冲区由DMA零拷贝读，不能丢弃旧数据；每次写入为一帧，放不下时整帧丢弃
+  SetQueuePolicy(&s_structUART2SendCirQue, RING_DROP_FRAME);
+  //接收的是字节流，上层解包会重新找帧头，放不下时保留能放下的部分
+  SetQueuePolicy(&s_structUART2RecCirQue,  RING_DROP_NEW);
 }
 
 /*********************************************************************************************************
-* 函数名称：WriteReceiveBuf2
-* 函数功能：写数据到串口接收缓冲区 
-* 输入参数：d，待写入串口接收缓冲区的数据
+* 函数名称：MoveRxDmaData2
+* 函数功能：将接收DMA循环缓冲区中新收到的数据整块写入串口接收缓冲区
+* 输入参数：void
 * 输出参数：void
-* 返 回 值：写入数据成功标志，0-不成功，1-成功 
-* 创建日期：2021年07月11日
-* 注    意：
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：由USART2的IDLE中断和DMA1_Channel6的半满、全满中断调用，两者抢占优先级相同，不会互相嵌套；
+*           半满和全满中断保证每收到半个DMA缓冲区至少搬运一次，DMA不会覆盖尚未搬走的数据
 *********************************************************************************************************/
-static  uint8  WriteReceiveBuf2(uint8 d)
+static  void  MoveRxDmaData2(void)
 {
-  uint8 ok = 0;  //写入数据成功标志，0-不成功，1-成功
-                                                                    
-  ok = EnQueue(&s_structUART2RecCirQue, &d, 1);   
-                                                                    
-  return ok;  //返回写入数据成功标志，0-不成功，1-成功 
+  uint16 pos;  //DMA当前写入的位置
+
+  pos = UART2_RX_DMA_SIZE - DMA_GetCurrDataCounter(DMA1_Channel6);
+  if(pos >= UART2_RX_DMA_SIZE)
+  {
+    pos = 0;
+  }
+
+  if(pos > s_iRxDmaPos2)
+  {
+    EnQueue(&s_structUART2RecCirQue, &s_arrRxDma2[s_iRxDmaPos2], pos - s_iRxDmaPos2);
+  }
+  else if(pos < s_iRxDmaPos2)
+  {
+    //DMA已经回绕，分两段搬运
+    EnQueue(&s_structUART2RecCirQue, &s_arrRxDma2[s_iRxDmaPos2], UART2_RX_DMA_SIZE - s_iRxDmaPos2);
+    EnQueue(&s_structUART2RecCirQue, s_arrRxDma2, pos);
+  }
+
+  s_iRxDmaPos2 = pos;
 }
 
 /*********************************************************************************************************
-* 函数名称：ReadSendBuf2
-* 函数功能：读取串口发送缓冲区中的数据 
-* 输入参数：p，读出来的数据存放的首地址
-* 输出参数：p，读出来的数据存放的首地址
-* 返 回 值：读取数据成功标志，0-不成功，1-成功 
-* 创建日期：2021年07月11日
-* 注    意：
+* 函数名称：StartTxDma2
+* 函数功能：从发送缓冲区队头取一段地址连续的数据，启动DMA发送
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：数据跨过缓冲区末尾时分两段发送，第二段在DMA传输完成中断中接着启动；
+*           发送缓冲区已空时打开USART2的TC中断，等最后一个字节移出后再结束发送
 *********************************************************************************************************/
-static  uint8  ReadSendBuf2(uint8 *p)
+static  void  StartTxDma2(void)
 {
-  uint8 ok = 0;  //读取数据成功标志，0-不成功，1-成功
-                                                                   
-  ok = DeQueue(&s_structUART2SendCirQue, p, 1);  
-                                                                   
-  return ok;  //返回读取数据成功标志，0-不成功，1-成功 
+  uint8* pData;  //本段数据的首地址
+
+  s_iTxDmaLen2 = GetQueueBlock(&s_structUART2SendCirQue, &pData);
+
+  if(s_iTxDmaLen2 > 0)
+  {
+    DMA_Cmd(DMA1_Channel7, DISABLE);                     //修改地址和长度前先关闭通道
+    DMA1_Channel7->CMAR = (uint32_t)pData;               //设置存储器地址，库函数中没有单独设置的接口
+    DMA_SetCurrDataCounter(DMA1_Channel7, s_iTxDmaLen2); //设置要传输的数据项数目
+    DMA_Cmd(DMA1_Channel7, ENABLE);                      //开始发送
+  }
+  else
+  {
+    USART_ITConfig(USART2, USART_IT_TC, ENABLE);             //等待最后一个字节发送完成
+  }
 }
 
 /*********************************************************************************************************
@@ -174,27 +217,115 @@ static  void  ConfigUART2(uint32 bound)
   NVIC_Init(&NVIC_InitStructure);                           //根据参数初始化NVIC
 
   //使能USART2及其中断
-  USART_ITConfig(USART2, USART_IT_RXNE, ENABLE);  //使能接收缓冲区非空中断
-  USART_ITConfig(USART2, USART_IT_TXE,  ENABLE);  //使能发送缓冲区空中断
+  ConfigDMA1Ch6();                               //配置接收DMA
+  USART_DMACmd(USART2, USART_DMAReq_Rx, ENABLE);     //使能接收DMA请求
+  USART_ITConfig(USART2, USART_IT_IDLE, ENABLE);  //使能总线空闲中断，一帧数据接收完毕
+  ConfigDMA1Ch7();                               //配置发送DMA
+  USART_DMACmd(USART2, USART_DMAReq_Tx, ENABLE);     //使能发送DMA请求
   USART_Cmd(USART2, ENABLE);                      //使能USART2
                                                                      
   s_iUART2TxSts = UART_STATE_OFF;  //串口发送数据状态设置为未发送数据
 }
 
+/*********************************************************************************************************
+* 函数名称：ConfigDMA1Ch6
+* 函数功能：配置DMA1通道6，把USART2接收到的数据循环写入s_arrRxDma2
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：DMA1通道6固定对应USART2_RX
+*********************************************************************************************************/
+static  void  ConfigDMA1Ch6(void)
+{
+  DMA_InitTypeDef  DMA_InitStructure;   //DMA_InitStructure用于存放DMA的参数
+  NVIC_InitTypeDef NVIC_InitStructure;  //NVIC_InitStructure用于存放NVIC的参数
+
+  RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);  //使能DMA1的时钟
+
+  //配置DMA1_Channel6
+  DMA_DeInit(DMA1_Channel6);  //将DMA1_CH6寄存器设置为默认值
+  DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&(USART2->DR);          //设置外设地址
+  DMA_InitStructure.DMA_MemoryBaseAddr     = (uint32_t)s_arrRxDma2;           //设置存储器地址
+  DMA_InitStructure.DMA_DIR                = DMA_DIR_PeripheralSRC;           //设置为外设到存储器模式
+  DMA_InitStructure.DMA_BufferSize         = UART2_RX_DMA_SIZE;              //设置要传输的数据项数目
+  DMA_InitStructure.DMA_PeripheralInc      = DMA_PeripheralInc_Disable;       //设置外设为非递增模式
+  DMA_InitStructure.DMA_MemoryInc          = DMA_MemoryInc_Enable;            //设置存储器为递增模式
+  DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;     //设置外设数据长度为字节
+  DMA_InitStructure.DMA_MemoryDataSize     = DMA_MemoryDataSize_Byte;         //设置存储器数据长度为字节
+  DMA_InitStructure.DMA_Mode               = DMA_Mode_Circular;               //设置为循环模式
+  DMA_InitStructure.DMA_Priority           = DMA_Priority_High;               //设置为高优先级
+  DMA_InitStructure.DMA_M2M                = DMA_M2M_Disable;                 //禁止存储器到存储器访问
+  DMA_Init(DMA1_Channel6, &DMA_InitStructure);  //根据参数初始化DMA1_Channel6
+
+  //配置NVIC，抢占优先级与USART2相同
+  NVIC_InitStructure.NVIC_IRQChannel = DMA1_Channel6_IRQn;  //中断通道号
+  NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0; //设置抢占优先级
+  NVIC_InitStructure.NVIC_IRQChannelSubPriority        = 1; //设置子优先级
+  NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;           //使能中断
+  NVIC_Init(&NVIC_InitStructure);                           //根据参数初始化NVIC
+
+  DMA_ITConfig(DMA1_Channel6, DMA_IT_HT | DMA_IT_TC, ENABLE);  //使能半满和全满中断
+  DMA_Cmd(DMA1_Channel6, ENABLE);                             //使能DMA1_Channel6
+}
+
+/*********************************************************************************************************
+* 函数名称：ConfigDMA1Ch7
+* 函数功能：配置DMA1通道7，把发送缓冲区中的数据写入USART2
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：DMA1通道7固定对应USART2_TX，存储器地址和长度在StartTxDma2中每段设置
+*********************************************************************************************************/
+static  void  ConfigDMA1Ch7(void)
+{
+  DMA_InitTypeDef  DMA_InitStructure;   //DMA_InitStructure用于存放DMA的参数
+  NVIC_InitTypeDef NVIC_InitStructure;  //NVIC_InitStructure用于存放NVIC的参数
+
+  RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);  //使能DMA1的时钟
+
+  //配置DMA1_Channel7
+  DMA_DeInit(DMA1_Channel7);  //将DMA1_CH7寄存器设置为默认值
+  DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&(USART2->DR);          //设置外设地址
+  DMA_InitStructure.DMA_MemoryBaseAddr     = (uint32_t)s_arrSendBuf2;         //设置存储器地址
+  DMA_InitStructure.DMA_DIR                = DMA_DIR_PeripheralDST;           //设置为存储器到外设模式
+  DMA_InitStructure.DMA_BufferSize         = 1;                               //设置要传输的数据项数目，发送时再修改
+  DMA_InitStructure.DMA_PeripheralInc      = DMA_PeripheralInc_Disable;       //设置外设为非递增模式
+  DMA_InitStructure.DMA_MemoryInc          = DMA_MemoryInc_Enable;            //设置存储器为递增模式
+  DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;     //设置外设数据长度为字节
+  DMA_InitStructure.DMA_MemoryDataSize     = DMA_MemoryDataSize_Byte;         //设置存储器数据长度为字节
+  DMA_InitStructure.DMA_Mode               = DMA_Mode_Normal;                 //设置为正常模式
+  DMA_InitStructure.DMA_Priority           = DMA_Priority_Medium;             //设置为中等优先级
+  DMA_InitStructure.DMA_M2M                = DMA_M2M_Disable;                 //禁止存储器到存储器访问
+  DMA_Init(DMA1_Channel7, &DMA_InitStructure);  //根据参数初始化DMA1_Channel7
+
+  //配置NVIC，抢占优先级与USART2相同
+  NVIC_InitStructure.NVIC_IRQChannel = DMA1_Channel7_IRQn;  //中断通道号
+  NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0; //设置抢占优先级
+  NVIC_InitStructure.NVIC_IRQChannelSubPriority        = 1; //设置子优先级
+  NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;           //使能中断
+  NVIC_Init(&NVIC_InitStructure);                           //根据参数初始化NVIC
+
+  DMA_ITConfig(DMA1_Channel7, DMA_IT_TC, ENABLE);  //使能传输完成中断
+}
+
 /*********************************************************************************************************
 * 函数名称：EnableUART2Tx
-* 函数功能：使能串口发送，在WriteUARTx中调用，即每次发送数据之后需要调用这个函数来使能发送中断 
+* 函数功能：使能串口发送，在WriteUARTx中调用，发送缓冲区从空变为非空时启动DMA发送
 * 输入参数：void
 * 输出参数：void
 * 返 回 值：void 
 * 创建日期：2021年07月11日
-* 注    意：s_iUART2TxSts = UART_STATE_ON;这句话必须放在USART_ITConfig之前，否则会导致中断打开无法执行
+* 注    意：s_iUART2TxSts = UART_STATE_ON;这句话必须放在启动DMA之前；
+*           DMA发送前需先清除TC标志，否则会误判为最后一个字节已经发送完成
 *********************************************************************************************************/
 static  void  EnableUART2Tx(void)
 {
   s_iUART2TxSts = UART_STATE_ON;                     //串口发送数据状态设置为正在发送数据
 
-  USART_ITConfig(USART2, USART_IT_TXE, ENABLE);     //使能发送中断
+  USART_ClearFlag(USART2, USART_FLAG_TC);               //清除发送完成标志
+  StartTxDma2();                                     //启动DMA发送
 }
 
 /*********************************************************************************************************
@@ -208,14 +339,11 @@ static  void  EnableUART2Tx(void)
 *********************************************************************************************************/
 void USART2_IRQHandler(void)                
 {
-  uint8  uData = 0x07;
-
-  if(USART_GetITStatus(USART2, USART_IT_RXNE) != RESET)  //接收缓冲区非空中断（串口接收到数据）
+  if(USART_GetITStatus(USART2, USART_IT_IDLE) != RESET)  //总线空闲中断（一帧数据接收完毕）
   {                                                         
-    NVIC_ClearPendingIRQ(USART2_IRQn);  //清除USART2中断挂起
-    uData = USART_ReceiveData(USART2);  //将USART2接收到的数据保存到uData
+    USART_ReceiveData(USART2);           //先读SR再读DR，清除IDLE标志
                                                           
-    WriteReceiveBuf2(uData);  //将接收到的数据写入接收缓冲区                                 
+    MoveRxDmaData2();  //将DMA收到的数据整块写入接收缓冲区
   }                                                         
                                                             
   if(USART_GetFlagStatus(USART2, USART_FLAG_ORE) == SET) //溢出错误标志为1（串口接收溢出）
@@ -224,24 +352,61 @@ void USART2_IRQHandler(void)
     USART_ReceiveData(USART2);                           //读取USART_DR 
   }                                                         
                                                            
-  if(USART_GetITStatus(USART2, USART_IT_TXE)!= RESET)    //发送缓冲区空中断（串口发送完成）
-  {                                                        
-    USART_ClearITPendingBit(USART2, USART_IT_TXE);       //清除发送中断标志
-    NVIC_ClearPendingIRQ(USART2_IRQn);                   //清除USART2中断挂起
-                                                           
-    if(1 == ReadSendBuf2(&uData))                           //读取发送缓冲区的数据到uData
-    {                                                                
-      USART_SendData(USART2, uData);                       //将uData写入USART_DR
+  if(USART_GetITStatus(USART2, USART_IT_TC) != RESET)     //发送完成中断（最后一个字节已移出）
+  {
+    USART_ITConfig(USART2, USART_IT_TC, DISABLE);        //关闭发送完成中断
+
+    if(QueueEmpty(&s_structUART2SendCirQue))            //当发送缓冲区为空时
+    {
+      s_iUART2TxSts = UART_STATE_OFF;                   //串口发送数据状态设置为未发送数据
     }
-    
-    if(QueueEmpty(&s_structUART2SendCirQue))              //当发送缓冲区为空时
-    {                                                               
-      s_iUART2TxSts = UART_STATE_OFF;                     //串口发送数据状态设置为未发送数据       
-      USART_ITConfig(USART2, USART_IT_TXE, DISABLE);     //关闭串口发送缓冲区空中断
+    else                                                 //等待TC期间又写入了数据
+    {
+      USART_ClearFlag(USART2, USART_FLAG_TC);             //清除发送完成标志
+      StartTxDma2();
     }
   }
 } 
 
+/*********************************************************************************************************
+* 函数名称：DMA1_Channel6_IRQHandler
+* 函数功能：DMA1通道6中断服务函数，USART2接收DMA半满、全满时搬运数据
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+void DMA1_Channel6_IRQHandler(void)
+{
+  if(DMA_GetITStatus(DMA1_IT_HT6) != RESET || DMA_GetITStatus(DMA1_IT_TC6) != RESET)
+  {
+    DMA_ClearITPendingBit(DMA1_IT_HT6 | DMA1_IT_TC6 | DMA1_IT_GL6);  //清除中断标志
+
+    MoveRxDmaData2();  //将DMA收到的数据整块写入接收缓冲区
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：DMA1_Channel7_IRQHandler
+* 函数功能：DMA1通道7中断服务函数，USART2发送DMA一段传输完成后接着发送下一段
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+void DMA1_Channel7_IRQHandler(void)
+{
+  if(DMA_GetITStatus(DMA1_IT_TC7) != RESET)
+  {
+    DMA_ClearITPendingBit(DMA1_IT_GL7);                   //清除中断标志
+
+    SkipQueue(&s_structUART2SendCirQue, s_iTxDmaLen2);  //已发送的数据出队
+    StartTxDma2();                                        //发送下一段
+  }
+}
+
 /*********************************************************************************************************
 *                                              API函数实现
 *********************************************************************************************************/
@@ -264,33 +429,31 @@ void InitUART2(uint32 bound)
 /*********************************************************************************************************
 * 函数名称：WriteUART2
 * 函数功能：写串口，即写数据到的串口发送缓冲区  
-* 输入参数：pBuf，要写入数据的首地址，len，期望写入数据的个数,最大1000字节
+* 输入参数：pBuf，要写入数据的首地址，len，期望写入数据的个数，最大为发送缓冲区的大小
 * 输出参数：void
 * 返 回 值：成功写入数据的个数，不一定与形参len相等
 * 创建日期：2021年07月11日
 * 注    意：
 *********************************************************************************************************/
-uint8  WriteUART2(uint8 *pBuf, uint8 len)
+uint16 WriteUART2(uint8 *pBuf, uint16 len)
 {
-  uint8 wLen = 0;  //实际写入数据的个数
+  uint16 wLen = 0;  //实际写入数据的个数
                                                                   
   wLen = EnQueue(&s_structUART2SendCirQue, pBuf, len);
 
-  if(wLen < UART2_BUF_SIZE)
+  if(wLen < len)
   {
-    if(s_iUART2TxSts == UART_STATE_OFF)
-    {
-      EnableUART2Tx();//使能中断发送
-    }    
+    debug("UART2发送缓冲区溢出,还要%d个字节\r\n",len - wLen);
   }
-  else
+  
+  if(wLen == 0)//没有写入数据，不启动发送，否则空队列启动的DMA不会结束，发送状态一直为正在发送
   {
-    debug("UART2发送缓冲区溢出");
+    return 0;
   }
   
-  if(wLen < len)
+  if(s_iUART2TxSts == UART_STATE_OFF)
   {
-    debug("UART2发送缓冲区溢出,还要%d个字节\r\n",len - wLen);
+    EnableUART2Tx();//启动DMA发送
   }
   
   return wLen;  //返回实际写入数据的个数
@@ -313,4 +476,19 @@ uint8  ReadUART2(uint8 *pBuf, uint8 len)
 
   return rLen;  //返回实际读取数据的长度
 }
+
+/*********************************************************************************************************
+* 函数名称：GetUART2Stats
+* 函数功能：读取串口发送、接收缓冲区的统计
+* 输入参数：void
+* 输出参数：pTx-发送缓冲区统计，pRx-接收缓冲区统计
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：丢弃数和最高水位用于根据现场数据调整UART2_BUF_SIZE
+*********************************************************************************************************/
+void GetUART2Stats(StructRingStats* pTx, StructRingStats* pRx)
+{
+  GetQueueStats(&s_structUART2SendCirQue, pTx);
+  GetQueueStats(&s_structUART2RecCirQue,  pRx);
+}
     
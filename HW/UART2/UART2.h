@@ -21,12 +21,14 @@
 *********************************************************************************************************/
 #include <stdio.h>
 #include "DataType.h"
+#include "Ring.h"
 #include "stm32f10x_conf.h"
 
 /*********************************************************************************************************
 *                                              宏定义
 *********************************************************************************************************/
 #define UART2_BUF_SIZE 1024          //设置缓冲区的大小,发送接收缓存大小一致,串口一段时间后异常就是缓冲区溢出
+#define UART2_RX_DMA_SIZE 256        //接收DMA循环缓冲区的大小，半满、全满或总线空闲时整块搬入接收缓冲区
 
 /*********************************************************************************************************
 *                                              枚举结构体定义
@@ -36,7 +38,8 @@
 *                                              API函数声明
 *********************************************************************************************************/
 void  InitUART2(uint32 bound);             //初始化UART2模块
-uint8 WriteUART2(uint8 *pBuf, uint8 len);  //写串口，返回已写入数据的个数
+uint16 WriteUART2(uint8 *pBuf, uint16 len); //写串口，返回已写入数据的个数
 uint8 ReadUART2(uint8 *pBuf, uint8 len);   //读串口，返回读到数据的个数
+void  GetUART2Stats(StructRingStats* pTx, StructRingStats* pRx); //读取发送、接收缓冲区的统计
 
 #endif
@@ -0,0 +1,317 @@
+/*********************************************************************************************************
+* 模块名称：BcastTest.c
+* 摘    要：广播命令去重的主机测试，云端连续下发的全网命令在中继节点上都要执行且只执行一次
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：直接包含ProcHostCmd.c，并链接真实的SendDataToHost.c：汇聚节点一侧用SendCmdPack发起广播，
+*           RadioSendData的桩记下发到空中的数据包，再交给中继节点一侧的ProcCmdPack；
+*           两个节点的地址由getAddress的桩切换，其余硬件、路由和传感器模块的函数在此打桩；
+*           依次检查：同一个云端命令ID连续下发CMD_SET_DEADBAND和CMD_SET_HEARTBEAT，两条都执行并各转发一次；
+*           邻居转发回来的副本和重复收到的原包不再执行；其他节点发起的相同序号是新命令；
+*           连续发起多于BCAST_SEEN_NUM条广播，每条都执行一次；记录超过BCAST_SEEN_MS过期后，
+*           发起节点重启、序号从头开始的命令照常执行
+* 注    意：make test运行，失败时返回非0
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "ProcHostCmd.c"
+#include <stdio.h>
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#define TEST_SINK_ADDR   0x0000  //汇聚节点地址
+#define TEST_NODE_ADDR   0x0102  //被测的中继节点地址
+#define TEST_OTHER_ADDR  0x0203  //另一个发起广播的节点地址
+#define TEST_CLOUD_ID    '1'     //云端命令ID的首字符，连续两条命令相同
+#define TEST_AIR_NUM     32      //记录的空中数据包个数
+
+/*********************************************************************************************************
+*                                              内部变量
+*********************************************************************************************************/
+static uint8  s_arrAir[TEST_AIR_NUM][PACKLEN];  //发到空中的数据包
+static uint8  s_iAirNum;                        //发到空中的数据包个数
+static uint16 s_iMyAddr;                        //getAddress返回的地址
+static uint32 s_iNowMs;                         //millis返回的时刻
+static uint8  s_iDeadband;                      //最近一次设置的死区
+static uint8  s_iHeartbeatMin;                  //最近一次设置的心跳间隔
+static uint8  s_iDeadbandNum;                   //设置死区的次数
+static uint8  s_iHeartbeatNum;                  //设置心跳间隔的次数
+static uint32 s_iErrNum = 0;                    //检查失败的次数
+
+/*********************************************************************************************************
+*                                              内部函数声明
+*********************************************************************************************************/
+static void   ResetCount(void);                                     //清零执行次数和空中数据包
+static void   Deliver(uint8 idx);                                   //中继节点收到第idx个空中数据包
+static void   Check(uint8 ok, const char* pName);                   //记录一项检查的结果
+static void   TestBackToBack(void);                                 //同一个云端命令ID连续下发两条广播
+static void   TestDuplicate(void);                                  //转发回来的副本和其他节点发起的广播
+static void   TestMany(void);                                       //连续多于BCAST_SEEN_NUM条广播
+static void   TestRestart(void);                                    //记录过期后发起节点重启
+
+/*********************************************************************************************************
+*                                              被测模块依赖的函数打桩
+*********************************************************************************************************/
+uint16 getAddress(void)                                   { return s_iMyAddr; }
+uint32 millis(void)                                       { return s_iNowMs; }
+void   debug(uint8* msg, ...)                             { (void)msg; }
+uint8  PackData(StructPackType* pPT)                      { (void)pPT; return 1; }
+uint8  HasWorNeighbor(void)                               { return 0; }
+uint8  IsWorNeighbor(uint16 add)                          { (void)add; return 0; }
+uint8  GetNeighborChannel(uint16 add)                     { (void)add; return 0; }
+uint16 GetParentAddr(void)                                { return TEST_SINK_ADDR; }
+uint8  GetBcastChannels(uint8* pCh)                       { pCh[0] = 0; return 1; }
+uint16 GetAirRateRemain(void)                             { return 0; }
+void   SetPendingAirRate(uint8 rate, uint16 remain)       { (void)rate; (void)remain; }
+uint8  UpdateRouTab2(uint8* pMsg, int16 rssi)             { (void)pMsg; (void)rssi; return 0; }
+uint8  UnPackData(uint8 data)                             { (void)data; return 0; }
+int16  GetUnPackRssi(void)                                { return 0; }
+uint8  SetSmpPrd(uint8 Period)                            { (void)Period; return 1; }
+uint8  SetSmpMax(uint8 Period)                            { (void)Period; return 1; }
+uint8  StartWaveStream(uint16 rate)                       { (void)rate; return 0; }
+void   StopWaveStream(void)                               { }
+uint16 WaveStreamRate(void)                               { return 0; }
+uint16 RouteGetHeadroom(void)                             { return 0; }
+uint16 RouteGetReserve(void)                              { return 0; }
+void   SetVibPeriod(uint8 sec)                            { (void)sec; }
+void   SetDACWave(StructDACWave wave)                     { (void)wave; }
+uint16* GetRectWave100PointAddr(void)                     { return NULL; }
+uint16* GetSineWave100PointAddr(void)                     { return NULL; }
+uint16* GetTriWave100PointAddr(void)                      { return NULL; }
+void   GetUART1Stats(StructRingStats* pTx, StructRingStats* pRx) { (void)pTx; (void)pRx; }
+void   GetUART2Stats(StructRingStats* pTx, StructRingStats* pRx) { (void)pTx; (void)pRx; }
+void   SetReportDeadband(uint8 steps)                     { s_iDeadband = steps; s_iDeadbandNum++; }
+void   SetReportHeartbeat(uint8 minutes)                  { s_iHeartbeatMin = minutes; s_iHeartbeatNum++; }
+
+StructPackType GetUnPackRslt(void)
+{
+  StructPackType pt;
+
+  memset(&pt, 0, sizeof(pt));
+  return pt;
+}
+
+uint8 RadioSendData(uint16 addr, uint8 channel, uint8* pData, uint8 size)
+{
+  (void)addr;
+  (void)channel;
+  if(s_iAirNum < TEST_AIR_NUM)
+  {
+    memcpy(s_arrAir[s_iAirNum++], pData, size);
+  }
+  return 1;
+}
+
+uint8 RadioSendWakeData(uint16 addr, uint8 channel, uint8* pData, uint8 size)
+{
+  return RadioSendData(addr, channel, pData, size);
+}
+
+/*********************************************************************************************************
+*                                              内部函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：ResetCount
+* 函数功能：清零执行次数和记录的空中数据包
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static void ResetCount(void)
+{
+  s_iAirNum       = 0;
+  s_iDeadbandNum  = 0;
+  s_iHeartbeatNum = 0;
+}
+
+/*********************************************************************************************************
+* 函数名称：Deliver
+* 函数功能：中继节点收到第idx个空中数据包
+* 输入参数：idx-s_arrAir的下标
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：与ProcHostCmd中TYPE_SYS分组一样，把数据部分交给ProcCmdPack；包先拷出来，转发会追加s_arrAir
+*********************************************************************************************************/
+static void Deliver(uint8 idx)
+{
+  StructPackType pt;
+
+  memcpy(&pt, s_arrAir[idx], PACKLEN);
+  s_iMyAddr = TEST_NODE_ADDR;
+  ProcCmdPack(pt.arrData);
+}
+
+/*********************************************************************************************************
+* 函数名称：Check
+* 函数功能：记录并打印一项检查的结果
+* 输入参数：ok-1--通过，pName-检查项的名称
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static void Check(uint8 ok, const char* pName)
+{
+  if(!ok)
+  {
+    s_iErrNum++;
+  }
+  printf("%-52s %s\n", pName, ok ? "PASS" : "FAIL");
+}
+
+/*********************************************************************************************************
+* 函数名称：TestBackToBack
+* 函数功能：同一个云端命令ID连续下发死区和心跳间隔两条广播
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：ProcCloudCmd取云端id字符串的首字符作为命令ID，相邻两条命令经常相同
+*********************************************************************************************************/
+static void TestBackToBack(void)
+{
+  uint8 fwdOk;
+
+  ResetCount();
+  s_iMyAddr = TEST_SINK_ADDR;
+  SendCmdPack(TEST_CLOUD_ID, CMD_SET_DEADBAND, 3, 0xFFFF, 0);
+  SendCmdPack(TEST_CLOUD_ID, CMD_SET_HEARTBEAT, 5, 0xFFFF, 0);
+  Check(s_iAirNum == 2, "sink sends both broadcasts");
+
+  Deliver(0);
+  Deliver(1);
+  Check(s_iDeadbandNum == 1 && s_iDeadband == 3, "deadband applied once");
+  Check(s_iHeartbeatNum == 1 && s_iHeartbeatMin == 5, "heartbeat applied once, same cloud CmdID");
+
+  fwdOk = (s_iAirNum == 4) &&
+          (s_arrAir[2][1 + 1] == CMD_SET_DEADBAND) && (s_arrAir[2][1 + 5] == 2) &&
+          (s_arrAir[3][1 + 1] == CMD_SET_HEARTBEAT) && (s_arrAir[3][1 + 5] == 2);
+  Check(fwdOk, "both forwarded once with hop count 2");
+}
+
+/*********************************************************************************************************
+* 函数名称：TestDuplicate
+* 函数功能：转发回来的副本、重复收到的原包不再执行；其他节点发起的相同序号是新命令
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：接在TestBackToBack之后，s_arrAir[0..3]为上一项的原包和本节点的转发
+*********************************************************************************************************/
+static void TestDuplicate(void)
+{
+  uint8 arrPack[PACKLEN];
+  uint8 i;
+
+  s_iDeadbandNum  = 0;
+  s_iHeartbeatNum = 0;
+  for(i = 0; i < 4; i++)
+  {
+    Deliver(i);
+  }
+  Check(s_iDeadbandNum == 0 && s_iHeartbeatNum == 0 && s_iAirNum == 4, "copies and echoes ignored, not forwarded");
+
+  memcpy(arrPack, s_arrAir[1], PACKLEN);  //同一个序号，换一个发起节点
+  arrPack[1 + CMD_OFS_SRC]     = TEST_OTHER_ADDR >> 8;
+  arrPack[1 + CMD_OFS_SRC + 1] = TEST_OTHER_ADDR & 0xFF;
+  memcpy(s_arrAir[s_iAirNum++], arrPack, PACKLEN);
+  Deliver(s_iAirNum - 1);
+  Check(s_iHeartbeatNum == 1 && s_iAirNum == 6, "same seq from another source is new");
+}
+
+/*********************************************************************************************************
+* 函数名称：TestMany
+* 函数功能：连续发起多于BCAST_SEEN_NUM条广播，每条都执行一次
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：记录表满后覆盖最旧的记录，新命令的序号不同，不会误判
+*********************************************************************************************************/
+static void TestMany(void)
+{
+  uint8 i;
+  uint8 n = BCAST_SEEN_NUM + 4;
+
+  ResetCount();
+  s_iMyAddr = TEST_SINK_ADDR;
+  for(i = 0; i < n; i++)
+  {
+    SendCmdPack(TEST_CLOUD_ID, (i & 1) ? CMD_SET_HEARTBEAT : CMD_SET_DEADBAND, i, 0xFFFF, 0);
+  }
+  for(i = 0; i < n; i++)
+  {
+    Deliver(i);
+  }
+  Check(s_iDeadbandNum + s_iHeartbeatNum == n && s_iAirNum == 2 * n, "more broadcasts than BCAST_SEEN_NUM");
+}
+
+/*********************************************************************************************************
+* 函数名称：TestRestart
+* 函数功能：记录过期后，发起节点重启、序号从头开始的命令照常执行
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：重启后的序号与TestBackToBack的第一条相同，用它的原包模拟；过期之前收到仍是重复
+*********************************************************************************************************/
+static void TestRestart(void)
+{
+  uint8 arrPack[PACKLEN];
+
+  ResetCount();
+  s_iMyAddr = TEST_SINK_ADDR;
+  SendCmdPack(TEST_CLOUD_ID, CMD_SET_DEADBAND, 7, 0xFFFF, 0);
+  memcpy(arrPack, s_arrAir[0], PACKLEN);
+  Deliver(0);
+  Check(s_iDeadbandNum == 1 && s_iDeadband == 7, "new broadcast before restart applied");
+
+  s_iNowMs += BCAST_SEEN_MS - 1;
+  memcpy(s_arrAir[s_iAirNum++], arrPack, PACKLEN);
+  Deliver(s_iAirNum - 1);
+  Check(s_iDeadbandNum == 1, "repeat within BCAST_SEEN_MS ignored");
+
+  s_iNowMs += 1;
+  memcpy(s_arrAir[s_iAirNum++], arrPack, PACKLEN);
+  Deliver(s_iAirNum - 1);
+  Check(s_iDeadbandNum == 2, "same (source, seq) after BCAST_SEEN_MS applied");
+}
+
+/*********************************************************************************************************
+*                                              API函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：main
+* 函数功能：运行全部检查
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：0--全部通过，1--有失败
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+int main(void)
+{
+  s_iNowMs = 1000;
+  InitSendDataToHost();
+
+  TestBackToBack();
+  TestDuplicate();
+  TestMany();
+  TestRestart();
+
+  printf("BcastTest: %s\n", (s_iErrNum == 0) ? "PASS" : "FAIL");
+  return (s_iErrNum == 0) ? 0 : 1;
+}
@@ -0,0 +1,392 @@
+/*********************************************************************************************************
+* 模块名称：FftTest.c
+* 摘    要：Fft模块的主机测试，与双精度DFT比较，按误差能量设通过门限
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：对FFT_LOG2N_MIN ~ FFT_LOG2N_MAX的每种点数和几类输入做FftReal，输出乘以2^指数后与双精度DFT逐频点比较，
+*           误差 = 10 * log10(各频点误差的模平方之和 / 参考频谱的模平方之和)，单位dB，不得高于各类输入的门限，
+*           门限为1024点的值，点数每减半降低slopeDb，舍入误差随级数增长；
+*           输入：满量程白噪声和满量程正弦几乎每级都要右移，覆盖块浮点缩放，指数接近log2N；
+*           数十个读数的小信号先左移约8位，指数比log2N小8以上，覆盖预先归一化；半满量程正弦介于两者之间；
+*           另外检查指数的范围、FftHann与双精度汉宁窗的差、点数不支持时返回FFT_EXP_ERR
+* 注    意：make test运行，失败时返回非0；门限比实测的最差值留约3dB余量，Fft.h中的误差数字出自这里
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "Fft.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#define TEST_LEN_MAX  (1 << FFT_LOG2N_MAX)  //最大点数
+#define TEST_PI       3.14159265358979323846
+
+/*********************************************************************************************************
+*                                              枚举结构体定义
+*********************************************************************************************************/
+//输入的种类
+typedef enum
+{
+  TEST_SIG_NOISE = 0,  //满量程白噪声
+  TEST_SIG_SINE,       //满量程正弦，不在频点上
+  TEST_SIG_HALF,       //半满量程的两个正弦加直流
+  TEST_SIG_SMALL,      //数十个读数的小信号，正弦加噪声
+  TEST_SIG_HANN,       //满量程白噪声经FftHann加窗
+  TEST_SIG_NUM,
+}EnumTestSignal;
+
+//一类输入的描述
+typedef struct
+{
+  const char* name;      //名称
+  double      limitDb;   //1024点的误差门限(dB)
+  double      slopeDb;   //点数每减半门限降低的dB数
+  int8        expMin;    //指数减log2N的下限
+  int8        expMax;    //指数减log2N的上限
+}StructTestSignal;
+
+/*********************************************************************************************************
+*                                              内部变量
+*********************************************************************************************************/
+//实测各点数的最差误差(dB)，N = 16 ~ 1024：
+//满量程白噪声 -72.9 -70.0 -67.8 -67.4 -66.4 -64.0 -63.6，指数 - log2N为-3 ~ -1
+//满量程正弦   -68.1 -65.9 -64.0 -60.3 -57.5 -54.7 -51.8，指数 = log2N，每级都右移
+//半满量程     -73.4 -71.5 -67.7 -64.9 -61.2 -58.5 -55.4，指数 - log2N = -2
+//小信号       -72.5 -67.5 -64.5 -61.4 -57.9 -54.5 -51.6，指数 - log2N为-9 ~ -8
+//加窗白噪声   -73.2 -70.5 -68.4 -66.0 -66.6 -64.7 -65.1，指数 - log2N为-4 ~ -2
+static const StructTestSignal s_arrSignal[TEST_SIG_NUM] =
+{
+  {"full-scale noise", -60.0, 1.0, -4,  0},
+  {"full-scale sine",  -48.5, 2.5, -1,  0},
+  {"half-scale tones", -52.0, 2.5, -3, -1},
+  {"small signal",     -48.5, 2.5, -10, -7},
+  {"hann noise",       -60.0, 1.0, -5, -1},
+};
+
+static int16  s_arrData[TEST_LEN_MAX];        //被测数据
+static double s_arrIn[TEST_LEN_MAX];          //输入的双精度副本，加窗时为加窗后的值
+static double s_arrRefRe[TEST_LEN_MAX / 2 + 1];  //参考频谱实部，k = 0 ~ N/2
+static double s_arrRefIm[TEST_LEN_MAX / 2 + 1];  //参考频谱虚部
+static uint32 s_iSeed   = 0x2545F491;          //随机数种子
+static uint32 s_iErrNum = 0;                   //检查失败的次数
+
+/*********************************************************************************************************
+*                                              内部函数声明
+*********************************************************************************************************/
+static uint32 NextRand(void);                                   //xorshift32伪随机数
+static int16  RandIn(int16 amp);                                //-amp ~ amp的均匀随机数
+static void   MakeSignal(uint8 sig, uint8 log2N);               //生成输入
+static void   RefDft(uint8 log2N);                              //双精度DFT
+static double ErrDb(uint8 log2N, int8 exp);                     //FftReal输出与参考频谱的误差(dB)
+static void   CheckSignal(uint8 sig);                           //对各点数检查一类输入
+static void   CheckHann(void);                                  //检查FftHann
+static void   CheckBadSize(void);                               //检查不支持的点数
+
+/*********************************************************************************************************
+*                                              内部函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：NextRand
+* 函数功能：xorshift32伪随机数
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：随机数
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static uint32 NextRand(void)
+{
+  s_iSeed ^= s_iSeed << 13;
+  s_iSeed ^= s_iSeed >> 17;
+  s_iSeed ^= s_iSeed << 5;
+
+  return s_iSeed;
+}
+
+/*********************************************************************************************************
+* 函数名称：RandIn
+* 函数功能：-amp ~ amp的均匀随机数
+* 输入参数：amp-幅度
+* 输出参数：void
+* 返 回 值：随机数
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static int16 RandIn(int16 amp)
+{
+  return (int16)((int32)(NextRand() % (2 * (uint32)amp + 1)) - amp);
+}
+
+/*********************************************************************************************************
+* 函数名称：MakeSignal
+* 函数功能：生成一类输入，写入s_arrData并把双精度副本写入s_arrIn
+* 输入参数：sig-EnumTestSignal，log2N-点数的对数
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：正弦的频率不在频点上，有泄漏，各频点都有能量；加窗时参考用FftHann加窗后的整数，只比较FFT本身
+*********************************************************************************************************/
+static void MakeSignal(uint8 sig, uint8 log2N)
+{
+  uint16 len = 1 << log2N;
+  double phase = (NextRand() % 1000) * 2.0 * TEST_PI / 1000.0;
+  double f1 = (len / 8) + 0.37;   //以频点为单位的频率
+  double f2 = (len / 3) + 0.61;
+  double v;
+  uint16 n;
+
+  for(n = 0; n < len; n++)
+  {
+    switch(sig)
+    {
+      case TEST_SIG_SINE:
+        v = FFT_IN_MAX * sin(2.0 * TEST_PI * f1 * n / len + phase);
+        break;
+      case TEST_SIG_HALF:
+        v = 3000.0 + 2500.0 * sin(2.0 * TEST_PI * f1 * n / len + phase) + 2500.0 * cos(2.0 * TEST_PI * f2 * n / len);
+        break;
+      case TEST_SIG_SMALL:
+        v = 30.0 * sin(2.0 * TEST_PI * f1 * n / len + phase) + RandIn(8);
+        break;
+      default:
+        v = RandIn(FFT_IN_MAX);
+        break;
+    }
+    v = floor(v + 0.5);
+    if(v > FFT_IN_MAX)
+    {
+      v = FFT_IN_MAX;
+    }
+    if(v < -FFT_IN_MAX)
+    {
+      v = -FFT_IN_MAX;
+    }
+    s_arrData[n] = (int16)v;
+  }
+
+  if(sig == TEST_SIG_HANN)
+  {
+    FftHann(s_arrData, log2N);
+  }
+  for(n = 0; n < len; n++)
+  {
+    s_arrIn[n] = s_arrData[n];
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：RefDft
+* 函数功能：对s_arrIn做双精度DFT，得到k = 0 ~ N/2的频谱
+* 输入参数：log2N-点数的对数
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：直接按定义计算，角度取(k * n) mod N，N = 1024时也不损失精度
+*********************************************************************************************************/
+static void RefDft(uint8 log2N)
+{
+  uint32 len = 1UL << log2N;
+  double re;
+  double im;
+  double a;
+  uint32 k;
+  uint32 n;
+
+  for(k = 0; k <= len / 2; k++)
+  {
+    re = 0.0;
+    im = 0.0;
+    for(n = 0; n < len; n++)
+    {
+      a   = 2.0 * TEST_PI * ((k * n) & (len - 1)) / len;
+      re += s_arrIn[n] * cos(a);
+      im -= s_arrIn[n] * sin(a);
+    }
+    s_arrRefRe[k] = re;
+    s_arrRefIm[k] = im;
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：ErrDb
+* 函数功能：FftReal的输出与参考频谱的误差
+* 输入参数：log2N-点数的对数，exp-FftReal返回的指数
+* 输出参数：void
+* 返 回 值：10 * log10(误差能量 / 参考能量)
+* 创建日期：2026年10月19日
+* 注    意：直流和奈奎斯特频率只有实部，其余频点按实部、虚部比较
+*********************************************************************************************************/
+static double ErrDb(uint8 log2N, int8 exp)
+{
+  uint16 half  = 1 << (log2N - 1);
+  double scale = ldexp(1.0, exp);
+  double sig   = 0.0;
+  double err   = 0.0;
+  double dr;
+  double di;
+  uint16 k;
+
+  for(k = 0; k <= half; k++)
+  {
+    if(k == 0 || k == half)
+    {
+      dr = ((k == 0) ? s_arrData[0] : s_arrData[1]) * scale - s_arrRefRe[k];
+      di = 0.0;
+    }
+    else
+    {
+      dr = s_arrData[2 * k] * scale - s_arrRefRe[k];
+      di = s_arrData[2 * k + 1] * scale - s_arrRefIm[k];
+    }
+    err += dr * dr + di * di;
+    sig += s_arrRefRe[k] * s_arrRefRe[k] + s_arrRefIm[k] * s_arrRefIm[k];
+  }
+
+  return 10.0 * log10(err / sig);
+}
+
+/*********************************************************************************************************
+* 函数名称：CheckSignal
+* 函数功能：对各点数检查一类输入的误差和指数
+* 输入参数：sig-EnumTestSignal
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：每种点数做4组不同的随机输入，打印最后一组的误差和全部输入中离门限最近的余量
+*********************************************************************************************************/
+static void CheckSignal(uint8 sig)
+{
+  const StructTestSignal* pSig = &s_arrSignal[sig];
+  uint32 errBefore = s_iErrNum;
+  double worst = -1000.0;
+  double limit;
+  double db;
+  uint8  log2N;
+  uint8  rep;
+  int8   exp;
+
+  printf("%-18s", pSig->name);
+  for(log2N = FFT_LOG2N_MIN; log2N <= FFT_LOG2N_MAX; log2N++)
+  {
+    limit = pSig->limitDb - pSig->slopeDb * (FFT_LOG2N_MAX - log2N);
+    for(rep = 0; rep < 4; rep++)
+    {
+      MakeSignal(sig, log2N);
+      RefDft(log2N);
+      exp = FftReal(s_arrData, log2N);
+      db  = ErrDb(log2N, exp);
+      worst = (db - limit > worst) ? db - limit : worst;
+      if(db > limit)
+      {
+        s_iErrNum++;
+        printf("\n  FAIL: %s N=%d error %.1f dB > %.1f dB", pSig->name, 1 << log2N, db, limit);
+      }
+      if(exp < pSig->expMin + log2N || exp > pSig->expMax + log2N)
+      {
+        s_iErrNum++;
+        printf("\n  FAIL: %s N=%d exp %d not in [%d, %d]", pSig->name, 1 << log2N, exp, pSig->expMin + log2N, pSig->expMax + log2N);
+      }
+    }
+    printf(" %6.1f", db);
+  }
+  printf("  dB  %s  margin %.1f dB\n", (s_iErrNum == errBefore) ? "PASS" : "FAIL", -worst);
+}
+
+/*********************************************************************************************************
+* 函数名称：CheckHann
+* 函数功能：检查FftHann与双精度汉宁窗的差
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：输入取满量程常数，各点的结果与FFT_IN_MAX * w[n]相差不超过1
+*********************************************************************************************************/
+static void CheckHann(void)
+{
+  uint32 errBefore = s_iErrNum;
+  double ref;
+  double errMax = 0.0;
+  uint16 len;
+  uint16 n;
+  uint8  log2N;
+
+  for(log2N = FFT_LOG2N_MIN; log2N <= FFT_LOG2N_MAX; log2N++)
+  {
+    len = 1 << log2N;
+    for(n = 0; n < len; n++)
+    {
+      s_arrData[n] = FFT_IN_MAX;
+    }
+    FftHann(s_arrData, log2N);
+    for(n = 0; n < len; n++)
+    {
+      ref = FFT_IN_MAX * (0.5 - 0.5 * cos(2.0 * TEST_PI * n / len));
+      errMax = (fabs(s_arrData[n] - ref) > errMax) ? fabs(s_arrData[n] - ref) : errMax;
+    }
+  }
+  if(errMax > 1.0)
+  {
+    s_iErrNum++;
+  }
+
+  printf("%-18s %s  max err %.2f LSB\n", "hann window", (s_iErrNum == errBefore) ? "PASS" : "FAIL", errMax);
+}
+
+/*********************************************************************************************************
+* 函数名称：CheckBadSize
+* 函数功能：检查不支持的点数
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static void CheckBadSize(void)
+{
+  uint8 ok = (FftReal(s_arrData, FFT_LOG2N_MIN - 1) == FFT_EXP_ERR) && (FftReal(s_arrData, FFT_LOG2N_MAX + 1) == FFT_EXP_ERR);
+
+  if(!ok)
+  {
+    s_iErrNum++;
+  }
+  printf("%-18s %s\n", "bad size", ok ? "PASS" : "FAIL");
+}
+
+/*********************************************************************************************************
+*                                              API函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：main
+* 函数功能：运行全部检查
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：0--全部通过，1--有失败
+* 创建日期：2026年10月19日
+* 注    意：每行依次为N = 16 ~ 1024最后一组输入的误差
+*********************************************************************************************************/
+int main(void)
+{
+  uint8 sig;
+
+  for(sig = 0; sig < TEST_SIG_NUM; sig++)
+  {
+    CheckSignal(sig);
+  }
+  CheckHann();
+  CheckBadSize();
+
+  printf("FftTest: %s\n", (s_iErrNum == 0) ? "PASS" : "FAIL");
+  return (s_iErrNum == 0) ? 0 : 1;
+}
@@ -0,0 +1,151 @@
+/*********************************************************************************************************
+* 模块名称：FilterBench.c
+* 摘    要：Filter模块的主机基准测试，测量各滤波级和Sensor默认滤波链每个采样的主机周期数
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：与目标板上的FilterBench测同样几种滤波级，另加Sensor.c中温度和AIN1的默认滤波链；
+*           每种按块长16(Sensor按块读出的SENSOR_BLOCK_LEN)和256各测一次，取多遍中最快的一遍，减少调度干扰；
+*           同时列出Filter.h中Cortex-M3周期数的估算公式，便于对照各级开销的相对大小
+* 注    意：make bench运行；主机周期数只能比较各级的相对开销，不是Cortex-M3的周期数，
+*           目标板上的实测值由FilterBench(Filter.h中FILTER_BENCH)输出
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "Filter.h"
+#include "HostCycles.h"
+#include <stdio.h>
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#define BENCH_SAMPLES  (1 << 16)  //每遍处理的采样个数
+#define BENCH_PASSES   20         //遍数，取最快的一遍
+#define BENCH_CASE_NUM 7          //测量的滤波链种数
+
+/*********************************************************************************************************
+*                                              内部变量
+*********************************************************************************************************/
+static const int16 s_arrFir8[8]   = {4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096};
+static const int16 s_arrFir16[16] = {2048, 2048, 2048, 2048, 2048, 2048, 2048, 2048,
+                                     2048, 2048, 2048, 2048, 2048, 2048, 2048, 2048};
+static const int16 s_arrFirHum[5] = {6553, 6554, 6554, 6554, 6553};        //同Sensor.c，滤除50Hz
+static const int16 s_arrBiquad[5] = {39, 77, 39, -30442, 14213};           //同Sensor.c，2Hz低通
+
+//各滤波链的名称和Filter.h中估算的Cortex-M3每采样周期数
+static const char* s_arrName[BENCH_CASE_NUM] =
+{
+  "fir 8 taps", "fir 16 taps", "biquad", "median 5", "median 9",
+  "temp: median3+biquad", "ain1: median5+fir5",
+};
+static const uint16 s_arrEstimate[BENCH_CASE_NUM] =
+{
+  12 + 6 * 8, 12 + 6 * 16, 45, 20 + 3 * 5 * 5 / 2, 20 + 3 * 9 * 9 / 2,
+  (20 + 3 * 3 * 3 / 2) + 45, (20 + 3 * 5 * 5 / 2) + (12 + 6 * 5),
+};
+
+static int16 s_arrData[BENCH_SAMPLES];  //采样
+
+/*********************************************************************************************************
+*                                              内部函数声明
+*********************************************************************************************************/
+static void   MakeChain(StructFilterChain* pChain, uint8 test);  //按序号配置滤波链
+static double Measure(uint8 test, uint16 block);                 //测量每个采样的主机周期数
+
+/*********************************************************************************************************
+*                                              内部函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：MakeChain
+* 函数功能：按序号配置滤波链
+* 输入参数：test-序号，0 ~ BENCH_CASE_NUM - 1
+* 输出参数：pChain-滤波链
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：前5种与目标板上的FilterBench一致
+*********************************************************************************************************/
+static void MakeChain(StructFilterChain* pChain, uint8 test)
+{
+  FilterInit(pChain);
+  switch(test)
+  {
+    case 0: FilterAddFir(pChain, s_arrFir8, 8);    break;
+    case 1: FilterAddFir(pChain, s_arrFir16, 16);  break;
+    case 2: FilterAddBiquad(pChain, s_arrBiquad);  break;
+    case 3: FilterAddMedian(pChain, 5);            break;
+    case 4: FilterAddMedian(pChain, 9);            break;
+    case 5: FilterAddMedian(pChain, 3); FilterAddBiquad(pChain, s_arrBiquad); break;
+    default: FilterAddMedian(pChain, 5); FilterAddFir(pChain, s_arrFirHum, 5); break;
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：Measure
+* 函数功能：测量每个采样的主机周期数
+* 输入参数：test-滤波链序号，block-每次调用FilterBlock的采样个数
+* 输出参数：void
+* 返 回 值：最快一遍的每采样周期数，包含函数调用开销
+* 创建日期：2026年10月19日
+* 注    意：每遍重新生成伪随机采样，滤波是就地的
+*********************************************************************************************************/
+static double Measure(uint8 test, uint16 block)
+{
+  StructFilterChain chain;
+  uint64_t best = ~0ULL;
+  uint64_t t;
+  uint32 i;
+  uint8  pass;
+
+  MakeChain(&chain, test);
+  for(pass = 0; pass < BENCH_PASSES; pass++)
+  {
+    for(i = 0; i < BENCH_SAMPLES; i++)
+    {
+      s_arrData[i] = (int16)(((i + pass) * 2654435761UL) >> 16);  //伪随机采样
+    }
+
+    t = HostCycles();
+    for(i = 0; i < BENCH_SAMPLES; i += block)
+    {
+      FilterBlock(&chain, &s_arrData[i], block);
+    }
+    t = HostCycles() - t;
+    best = (t < best) ? t : best;
+  }
+
+  return (double)best / BENCH_SAMPLES;
+}
+
+/*********************************************************************************************************
+*                                              API函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：main
+* 函数功能：测量全部滤波链并打印
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：0
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+int main(void)
+{
+  uint8 test;
+
+  printf("%-22s %12s %12s %14s\n", "filter", "block 16", "block 256", "M3 estimate");
+  for(test = 0; test < BENCH_CASE_NUM; test++)
+  {
+    printf("%-22s %12.1f %12.1f %14u\n", s_arrName[test], Measure(test, 16), Measure(test, 256), s_arrEstimate[test]);
+  }
+  printf("host columns: %s/sample; M3 estimate: cycles/sample from Filter.h, not measured\n", HOST_CYCLES_UNIT);
+
+  return 0;
+}
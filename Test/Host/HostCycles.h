@@ -0,0 +1,54 @@
+/*********************************************************************************************************
+* 模块名称：HostCycles.h
+* 摘    要：主机基准测试用的周期计数
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：x86上读TSC，其他主机退回单调时钟的纳秒数
+* 注    意：主机周期数只用于同一次运行中两种实现的相对比较，不能代替目标板上DWT测得的周期数；
+*           TSC按标称频率计数，不随睿频变化
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+#ifndef _HOST_CYCLES_H_
+#define _HOST_CYCLES_H_
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include <stdint.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#if defined(__x86_64__) || defined(__i386__)
+#define HOST_CYCLES_UNIT "TSC cycles"
+#else
+#define HOST_CYCLES_UNIT "ns"
+#endif
+
+/*********************************************************************************************************
+*                                              API函数实现
+*********************************************************************************************************/
+static inline uint64_t HostCycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+#endif
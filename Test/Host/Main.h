@@ -0,0 +1,46 @@
+/*********************************************************************************************************
+* 模块名称：Main.h
+* 摘    要：主机测试用的替身头文件，代替App/Main/Main.h
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：真正的Main.h包含全部硬件模块的头文件，主机上无法编译；这里只给出PackUnpack.c、ProcHostCmd.c、WaveStream.c用到的
+*           编译开关、RADIO.h中的RSSI宏、Main.c中的SetSmpPrd、SetSmpMax和几个声明头文件；
+*           SINK默认取FALSE，即中继节点的配置，接收缓冲区的压力和广播命令的去重都在中继节点
+* 注    意：只在Test目录下的主机测试中使用；App/Main/Main.h或RADIO.h中这些宏改动时同步修改
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+#ifndef _HOST_MAIN_H_
+#define _HOST_MAIN_H_
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "DataType.h"
+#include "Timer.h"
+#include "UART1.h"
+#include "PackUnpack.h"
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#ifndef SINK
+#define SINK     FALSE  //中继节点，汇聚节点一侧的测试用-DSINK=TRUE编译
+#endif
+#define MAC_TDMA FALSE
+
+#define RADIO_RSSI_BYTE       TRUE  //同HW/RADIO/RADIO.h
+#define RADIO_RSSI_DBM(b)     ((int16)(b) - 256)
+
+/*********************************************************************************************************
+*                                              API函数声明
+*********************************************************************************************************/
+uint8  SetSmpPrd(uint8 Period);  //同App/Main/Main.h
+uint8  SetSmpMax(uint8 Period);
+
+#endif
@@ -0,0 +1,79 @@
+/*********************************************************************************************************
+* 模块名称：stm32f10x.h
+* 摘    要：主机测试用的替身头文件，只提供被测模块用到的CMSIS内核函数
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：__LDREXH/__STREXH用GCC原子比较交换模拟：STREXH只在独占标记仍有效、且该地址仍为LDREXH读到的值时写入；
+*           Cortex-M3进入和退出异常时自动清除独占标记，模拟中断的信号处理函数退出前调用__CLREX达到同样效果，
+*           被打断的LDREXH/STREXH因此失败重试；__DMB用全屏障；
+*           LDREXH之后和DMB处调用测试设置的g_pHostPreempt，测试在此注入中断，专门打断最窄的竞争窗口
+* 注    意：只在Test目录下的主机测试中使用，放在包含路径最前面以代替ARM/System下的同名文件
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+#ifndef _HOST_STM32F10X_H_
+#define _HOST_STM32F10X_H_
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/*********************************************************************************************************
+*                                              API变量定义
+*********************************************************************************************************/
+void (*g_pHostPreempt)(void) __attribute__((weak)) = NULL;  //抢占点回调，默认为NULL，需要注入中断的测试另行定义
+
+/*********************************************************************************************************
+*                                              内部变量
+*********************************************************************************************************/
+static __thread uint16_t s_iHostExclusive;  //本线程LDREXH读到的值
+static __thread volatile uint8_t s_iHostMonitor;  //1--独占标记有效
+
+/*********************************************************************************************************
+*                                              API函数实现
+*********************************************************************************************************/
+static inline uint16_t __LDREXH(volatile uint16_t* addr)
+{
+  s_iHostExclusive = __atomic_load_n(addr, __ATOMIC_SEQ_CST);
+  s_iHostMonitor   = 1;
+  if(g_pHostPreempt != NULL)
+  {
+    g_pHostPreempt();
+  }
+  return s_iHostExclusive;
+}
+
+static inline uint32_t __STREXH(uint16_t value, volatile uint16_t* addr)
+{
+  uint16_t expect = s_iHostExclusive;
+
+  if(!s_iHostMonitor)
+  {
+    return 1;
+  }
+  s_iHostMonitor = 0;
+  return __atomic_compare_exchange_n(addr, &expect, value, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ? 0 : 1;
+}
+
+static inline void __CLREX(void)
+{
+  s_iHostMonitor = 0;
+}
+
+static inline void __DMB(void)
+{
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  if(g_pHostPreempt != NULL)
+  {
+    g_pHostPreempt();
+  }
+}
+
+#endif
@@ -0,0 +1,24 @@
+/*********************************************************************************************************
+* 模块名称：stm32f10x_conf.h
+* 摘    要：主机测试用的替身头文件，代替固件库配置头文件
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：UART1.h等声明头文件包含它，但只用到其中的CMSIS内核函数，这里改为包含Host/stm32f10x.h
+* 注    意：只在Test目录下的主机测试中使用
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+#ifndef _HOST_STM32F10X_CONF_H_
+#define _HOST_STM32F10X_CONF_H_
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "stm32f10x.h"
+
+#endif
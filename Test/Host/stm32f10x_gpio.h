@@ -0,0 +1,31 @@
+/*********************************************************************************************************
+* 模块名称：stm32f10x_gpio.h
+* 摘    要：主机测试用的替身头文件，代替固件库GPIO头文件
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：RADIO.h包含它，被测模块只用到RADIO.h中的函数声明和随后SysTick.h中的__IO
+* 注    意：只在Test目录下的主机测试中使用
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+#ifndef _HOST_STM32F10X_GPIO_H_
+#define _HOST_STM32F10X_GPIO_H_
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "stm32f10x.h"
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#ifndef __IO
+#define __IO volatile
+#endif
+
+#endif
@@ -0,0 +1,593 @@
+/*********************************************************************************************************
+* 模块名称：RingTest.c
+* 摘    要：Ring模块的主机压力测试，生产者线程模拟中断，主线程作为主循环消费
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：先用小缓冲区逐项检查三种丢弃策略的结果；再对元素大小1、2、4字节和三种策略，
+*           生产者线程每隔随机的几十微秒向主线程发SIGUSR1，信号处理函数在主线程被打断的任意位置写入一帧，
+*           与Cortex-M3上中断抢占主循环相同，单核主机上也能交错；帧长随机，元素值为流水号，
+*           主线程随机长度读出，并不时忙于别的事几毫秒制造溢出；主线程经过LDREXH和DMB时还会随机同步注入一串中断，
+*           专门打断读完数据到释放空间、LDREXH到STREXH这些最窄的竞争窗口；
+*           RING_DROP_NEW、RING_DROP_FRAME：生产者按RingPut的返回值记下被接收的流水号，消费者读出的序列必须与之完全一致，
+*           RING_DROP_FRAME时每帧要么全部接收要么全部丢弃；RING_DROP_OLD：读出的流水号必须递增，
+*           跳过的个数之和等于统计的丢弃个数；最后核对写入、丢弃个数和最高水位
+* 注    意：make test运行，失败时返回非0；参数为每种情况的元素个数，默认524288
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "Ring.h"
+#include "stm32f10x.h"
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#define TEST_RING_LEN   256       //压力测试的缓冲区容量(元素个数)
+#define TEST_FRAME_MAX  48        //生产者每帧最多的元素个数
+#define TEST_READ_MAX   64        //消费者每次最多读出的元素个数
+#define TEST_OLD_LAG    20000     //RING_DROP_OLD时生产者最多领先消费者的元素个数，保证16位流水号不会绕回
+#define TEST_TOTAL_DEF  (1 << 19) //每种情况默认写入的元素个数
+#define TEST_ISR_US     40        //两次模拟中断之间的平均间隔(us)
+#define TEST_BUSY_EVERY 4096      //消费者平均每读出这么多个元素忙一次
+#define TEST_BUSY_US    3000      //消费者每次忙的时间(us)，期间只有中断在写，足以写满缓冲区
+#define TEST_PREEMPT_ODDS 16      //主循环平均每经过这么多个抢占点注入一次中断
+#define TEST_PREEMPT_MAX  12      //每次注入最多连续几次中断，足以在窗口内写满缓冲区
+
+/*********************************************************************************************************
+*                                              枚举结构体定义
+*********************************************************************************************************/
+//一种测试情况
+typedef struct
+{
+  uint8       elemSize;   //元素大小(字节)
+  uint8       policy;     //丢弃策略，EnumRingPolicy
+  uint8       peekRead;   //1--消费者用RingPeekRead/RingCommitRead零拷贝读
+  uint8       peekWrite;  //1--生产者用RingPeekWrite/RingCommitWrite零拷贝写，放不下的部分自行丢弃，模拟接收DMA
+  const char* name;
+}StructTestCase;
+
+/*********************************************************************************************************
+*                                              内部变量
+*********************************************************************************************************/
+static const StructTestCase s_arrCase[] =
+{
+  {1, RING_DROP_NEW,   0, 0, "u8  DROP_NEW"},
+  {1, RING_DROP_NEW,   1, 1, "u8  DROP_NEW  peek read/write"},
+  {1, RING_DROP_FRAME, 1, 0, "u8  DROP_FRAME peek read"},
+  {2, RING_DROP_NEW,   0, 0, "u16 DROP_NEW"},
+  {2, RING_DROP_FRAME, 0, 0, "u16 DROP_FRAME"},
+  {2, RING_DROP_OLD,   0, 0, "u16 DROP_OLD"},
+  {4, RING_DROP_NEW,   1, 0, "u32 DROP_NEW  peek read"},
+  {4, RING_DROP_FRAME, 0, 0, "u32 DROP_FRAME"},
+  {4, RING_DROP_OLD,   0, 0, "u32 DROP_OLD"},
+};
+
+static const StructTestCase* s_pCase;             //当前情况
+static StructRing     s_structRing;               //被测缓冲区
+static uint8          s_arrRingBuf[TEST_RING_LEN * 4];
+static uint32         s_iTotal;                   //每种情况写入的元素个数
+static uint32*        s_pLog;                     //被接收的流水号，按写入顺序
+static volatile uint32 s_iLogNum;                 //s_pLog中的个数，只由生产者修改
+static volatile uint32 s_iConsumed;               //消费者已读出的个数
+static volatile uint8  s_iProducerDone;           //1--生产者已写完
+static uint32         s_iPeekDrop;                //零拷贝写时放不下而自行丢弃的个数
+static uint32         s_iCount;                   //中断已产生的元素个数
+static uint32         s_iIsrSeed;                 //中断用的随机数种子
+static volatile uint32 s_iIsrErr;                 //中断中检查失败的次数，信号处理函数中不打印
+static pthread_t      s_structMain;               //主线程，即被中断的一方
+static uint32         s_iErrNum;                  //检查失败的次数
+static uint32         s_iPreemptSeed;             //抢占点用的随机数种子
+static volatile uint8 s_iInIsr;                   //1--正在模拟中断中
+
+/*********************************************************************************************************
+*                                              内部函数声明
+*********************************************************************************************************/
+static uint32 NextRand(uint32* pSeed);                                //xorshift32随机数
+static void   Encode(uint8* pDst, uint32 value, uint8 size);          //流水号按元素大小截断后写入
+static uint32 Decode(const uint8* pSrc, uint8 size);                  //读出截断的流水号
+static void   Fail(const char* pMsg, uint32 a, uint32 b);             //记录一次检查失败
+static void   CheckPolicies(void);                                    //小缓冲区上逐项检查三种丢弃策略
+static void   OnIsr(int sig);                                         //模拟中断，写入一帧
+static void*  Producer(void* pArg);                                   //生产者线程，定时触发模拟中断
+static uint64_t NowUs(void);                                          //单调时钟(us)
+static void   Preempt(void);                                          //抢占点，随机注入中断
+static void   RunCase(const StructTestCase* pCase);                   //运行一种情况
+
+/*********************************************************************************************************
+*                                              内部函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：NextRand
+* 函数功能：xorshift32随机数，每个线程用自己的种子
+* 输入参数：pSeed-种子
+* 输出参数：pSeed-更新后的种子
+* 返 回 值：随机数
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static uint32 NextRand(uint32* pSeed)
+{
+  uint32 x = *pSeed;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *pSeed = x;
+
+  return x;
+}
+
+/*********************************************************************************************************
+* 函数名称：Encode
+* 函数功能：流水号按元素大小截断后写入
+* 输入参数：value-流水号，size-元素大小
+* 输出参数：pDst-元素
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：主机为小端，取低size个字节
+*********************************************************************************************************/
+static void Encode(uint8* pDst, uint32 value, uint8 size)
+{
+  memcpy(pDst, &value, size);
+}
+
+/*********************************************************************************************************
+* 函数名称：Decode
+* 函数功能：读出截断的流水号
+* 输入参数：pSrc-元素，size-元素大小
+* 输出参数：void
+* 返 回 值：流水号的低size个字节
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static uint32 Decode(const uint8* pSrc, uint8 size)
+{
+  uint32 value = 0;
+
+  memcpy(&value, pSrc, size);
+
+  return value;
+}
+
+/*********************************************************************************************************
+* 函数名称：Fail
+* 函数功能：记录一次检查失败，只打印前几次
+* 输入参数：pMsg-说明，a、b-相关的数值
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static void Fail(const char* pMsg, uint32 a, uint32 b)
+{
+  if(s_iErrNum < 10)
+  {
+    printf("  FAIL: %s (%u, %u)\n", pMsg, a, b);
+  }
+  s_iErrNum++;
+}
+
+/*********************************************************************************************************
+* 函数名称：CheckPolicies
+* 函数功能：在8个元素的缓冲区上逐项检查三种丢弃策略
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：先写入0 ~ 5，再写入100 ~ 103，只有2个空位
+*********************************************************************************************************/
+static void CheckPolicies(void)
+{
+  static const uint8 s_arrExpect[3][8] =  //按EnumRingPolicy的顺序
+  {
+    {0, 1, 2, 3, 4, 5, 100, 101},        //RING_DROP_NEW：写入能放下的前2个
+    {2, 3, 4, 5, 100, 101, 102, 103},    //RING_DROP_OLD：丢弃最旧的2个
+    {0, 1, 2, 3, 4, 5, 0, 0},            //RING_DROP_FRAME：整帧丢弃
+  };
+  static const uint16 s_arrPut[3]  = {2, 4, 0};
+  static const uint16 s_arrDrop[3] = {2, 2, 4};
+  static const uint16 s_arrLen[3]  = {8, 8, 6};
+  StructRing      ring;
+  StructRingStats stats;
+  uint8  arrBuf[8];
+  uint8  arrOut[8];
+  uint8  arrOld[6] = {0, 1, 2, 3, 4, 5};
+  uint8  arrNew[4] = {100, 101, 102, 103};
+  uint8  policy;
+  uint16 num;
+
+  for(policy = RING_DROP_NEW; policy <= RING_DROP_FRAME; policy++)
+  {
+    InitRing(&ring, arrBuf, 1, 9);  //不是2的幂，向下取整为8
+    RingSetPolicy(&ring, policy);
+    if(RingPut(&ring, arrOld, 6) != 6 || RingFree(&ring) != 2)
+    {
+      Fail("policy: first put", policy, RingFree(&ring));
+    }
+    num = RingPut(&ring, arrNew, 4);
+    if(num != s_arrPut[policy])
+    {
+      Fail("policy: put count", policy, num);
+    }
+    RingGetStats(&ring, &stats);
+    if(stats.dropNum != s_arrDrop[policy] || stats.size != 8 || stats.peak != s_arrLen[policy])
+    {
+      Fail("policy: stats", policy, stats.dropNum);
+    }
+    memset(arrOut, 0, sizeof(arrOut));
+    num = RingGet(&ring, arrOut, 8);
+    if(num != s_arrLen[policy] || memcmp(arrOut, s_arrExpect[policy], 8) != 0)
+    {
+      Fail("policy: contents", policy, num);
+    }
+    if(RingLength(&ring) != 0)
+    {
+      Fail("policy: not empty", policy, RingLength(&ring));
+    }
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：OnIsr
+* 函数功能：模拟中断，写入一帧随机长度的流水号
+* 输入参数：sig-未用
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：在主线程上执行，打断主线程的任意位置；RING_DROP_NEW、RING_DROP_FRAME时先把整帧的流水号写入s_pLog，
+*           RingPut之后按实际写入个数增加s_iLogNum，主线程读到元素时对应的记录一定已经写好，且之后不会再被改写；
+*           RING_DROP_OLD时领先主线程太多就跳过本次，相当于外设没有新数据；退出前__CLREX，同硬件退出异常
+*********************************************************************************************************/
+static void OnIsr(int sig)
+{
+  const StructTestCase* pCase = s_pCase;
+  uint8  arrFrame[TEST_FRAME_MAX * 4];
+  uint16 len;
+  uint16 done;
+  uint16 num;
+  uint16 i;
+  uint8* pData;
+
+  (void)sig;
+  s_iInIsr = 1;
+  if(s_iProducerDone || (pCase->policy == RING_DROP_OLD && s_iCount - s_iConsumed > TEST_OLD_LAG))
+  {
+    s_iInIsr = 0;
+    __CLREX();
+    return;
+  }
+
+  len = 1 + NextRand(&s_iIsrSeed) % TEST_FRAME_MAX;
+  if(len > s_iTotal - s_iCount)
+  {
+    len = s_iTotal - s_iCount;
+  }
+  for(i = 0; i < len; i++)
+  {
+    Encode(&arrFrame[i * pCase->elemSize], s_iCount + i, pCase->elemSize);
+  }
+
+  if(pCase->policy == RING_DROP_OLD)
+  {
+    if(RingPut(&s_structRing, arrFrame, len) != len)
+    {
+      s_iIsrErr++;
+    }
+  }
+  else
+  {
+    for(i = 0; i < len; i++)
+    {
+      s_pLog[s_iLogNum + i] = s_iCount + i;
+    }
+    if(pCase->peekWrite)
+    {
+      done = 0;
+      while(done < len)
+      {
+        num = RingPeekWrite(&s_structRing, (void**)&pData);
+        if(num == 0)
+        {
+          break;
+        }
+        if(num > len - done)
+        {
+          num = len - done;
+        }
+        memcpy(pData, &arrFrame[done * pCase->elemSize], num * pCase->elemSize);
+        RingCommitWrite(&s_structRing, num);
+        done += num;
+      }
+      s_iPeekDrop += len - done;
+    }
+    else
+    {
+      done = RingPut(&s_structRing, arrFrame, len);
+      if(pCase->policy == RING_DROP_FRAME && done != 0 && done != len)
+      {
+        s_iIsrErr++;  //半帧
+      }
+    }
+    s_iLogNum += done;
+  }
+
+  s_iCount += len;
+  if(s_iCount >= s_iTotal)
+  {
+    s_iProducerDone = 1;
+  }
+  s_iInIsr = 0;
+  __CLREX();
+}
+
+/*********************************************************************************************************
+* 函数名称：Producer
+* 函数功能：生产者线程，每隔随机的时间向主线程发一次模拟中断
+* 输入参数：pArg-未用
+* 输出参数：void
+* 返 回 值：NULL
+* 创建日期：2026年10月19日
+* 注    意：两次信号之间睡眠，单核主机上主线程在睡眠期间运行，醒来时在任意位置被打断
+*********************************************************************************************************/
+static void* Producer(void* pArg)
+{
+  uint32 seed = 0x12345678;
+
+  (void)pArg;
+  while(!s_iProducerDone)
+  {
+    pthread_kill(s_structMain, SIGUSR1);
+    usleep(1 + NextRand(&seed) % (2 * TEST_ISR_US));
+  }
+
+  return NULL;
+}
+
+/*********************************************************************************************************
+* 函数名称：NowUs
+* 函数功能：单调时钟
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：当前时刻(us)
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static uint64_t NowUs(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/*********************************************************************************************************
+* 函数名称：Preempt
+* 函数功能：抢占点，主循环经过LDREXH或DMB时随机注入一串中断
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：定时信号很难恰好落在读完数据到释放空间之间、LDREXH到STREXH之间这几条指令上，
+*           在这里同步注入，连续几次足以写满缓冲区，使RING_DROP_OLD的丢旧数据与消费者释放空间真正冲突
+*********************************************************************************************************/
+static void Preempt(void)
+{
+  uint32 num;
+
+  if(s_iInIsr || NextRand(&s_iPreemptSeed) % TEST_PREEMPT_ODDS != 0)
+  {
+    return;
+  }
+  for(num = NextRand(&s_iPreemptSeed) % (TEST_PREEMPT_MAX + 1); num > 0; num--)
+  {
+    raise(SIGUSR1);
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：RunCase
+* 函数功能：运行一种情况并核对结果
+* 输入参数：pCase-测试情况
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static void RunCase(const StructTestCase* pCase)
+{
+  StructRingStats stats;
+  pthread_t thread;
+  uint8  arrOut[TEST_READ_MAX * 4];
+  uint8* pData;
+  uint32 errBefore = s_iErrNum;
+  uint32 seed = 0x9E3779B9;
+  uint32 recv = 0;        //读出的个数
+  uint32 next = 0;        //RING_DROP_OLD时期望的下一个流水号
+  uint32 gapSum = 0;      //RING_DROP_OLD时跳过的流水号个数
+  uint32 mask = (pCase->elemSize == 4) ? 0xFFFFFFFF : (1UL << (8 * pCase->elemSize)) - 1;
+  uint32 value;
+  uint32 gap;
+  uint16 num;
+  uint16 i;
+  uint8  done;
+  uint32 busyAt;          //读出个数到此值时忙一次
+  uint64_t until;
+
+  s_pCase         = pCase;
+  s_iLogNum       = 0;
+  s_iConsumed     = 0;
+  s_iProducerDone = 0;
+  s_iPeekDrop     = 0;
+  s_iCount        = 0;
+  s_iIsrSeed      = 0x2545F491;
+  s_iIsrErr       = 0;
+  s_iPreemptSeed  = 0x6C078965;
+  busyAt          = 1 + NextRand(&seed) % (2 * TEST_BUSY_EVERY);
+  InitRing(&s_structRing, s_arrRingBuf, pCase->elemSize, TEST_RING_LEN);
+  RingSetPolicy(&s_structRing, pCase->policy);
+  g_pHostPreempt = Preempt;  //Host/stm32f10x.h的抢占点回调
+  pthread_create(&thread, NULL, Producer, NULL);
+
+  while(1)
+  {
+    done = s_iProducerDone;  //先取标志再读，标志为1后读空即全部读完
+    num  = 1 + NextRand(&seed) % TEST_READ_MAX;
+    if(pCase->peekRead)
+    {
+      i = RingPeekRead(&s_structRing, (void**)&pData);
+      if(num > i)
+      {
+        num = i;
+      }
+      memcpy(arrOut, pData, num * pCase->elemSize);
+      RingCommitRead(&s_structRing, num);
+    }
+    else
+    {
+      num = RingGet(&s_structRing, arrOut, num);
+    }
+
+    for(i = 0; i < num; i++)
+    {
+      value = Decode(&arrOut[i * pCase->elemSize], pCase->elemSize);
+      if(pCase->policy == RING_DROP_OLD)
+      {
+        gap = (value - next) & mask;
+        if(gap > TEST_OLD_LAG + TEST_RING_LEN)
+        {
+          Fail("old: sequence went back", value, next & mask);
+        }
+        gapSum += gap;
+        next   += gap + 1;
+      }
+      else
+      {
+        if(value != (s_pLog[recv + i] & mask))
+        {
+          Fail("sequence mismatch", value, s_pLog[recv + i] & mask);
+        }
+      }
+    }
+    recv += num;
+    s_iConsumed = recv;
+
+    if(num == 0 && done)
+    {
+      break;
+    }
+    if(recv >= busyAt)  //主循环偶尔忙于别的事，制造溢出
+    {
+      until = NowUs() + TEST_BUSY_US;
+      while(NowUs() < until && !s_iProducerDone)
+      {
+      }
+      busyAt = recv + 1 + NextRand(&seed) % (2 * TEST_BUSY_EVERY);
+    }
+  }
+  pthread_join(thread, NULL);
+  g_pHostPreempt = NULL;
+
+  if(s_iIsrErr != 0)
+  {
+    Fail("isr: short put or partial frame", s_iIsrErr, 0);
+  }
+
+  RingGetStats(&s_structRing, &stats);
+  if(pCase->policy == RING_DROP_OLD)
+  {
+    gapSum += s_iTotal - next;
+    if(stats.putNum != s_iTotal)
+    {
+      Fail("old: putNum", stats.putNum, s_iTotal);
+    }
+    if(stats.dropNum != gapSum || recv + stats.dropNum != s_iTotal)
+    {
+      Fail("old: dropNum", stats.dropNum, gapSum);
+    }
+  }
+  else
+  {
+    if(recv != s_iLogNum)
+    {
+      Fail("received count", recv, s_iLogNum);
+    }
+    if(stats.putNum != s_iLogNum)
+    {
+      Fail("putNum", stats.putNum, s_iLogNum);
+    }
+    if(stats.dropNum + s_iPeekDrop != s_iTotal - s_iLogNum)
+    {
+      Fail("dropNum", stats.dropNum + s_iPeekDrop, s_iTotal - s_iLogNum);
+    }
+  }
+  if(stats.peak > stats.size || stats.size != TEST_RING_LEN)
+  {
+    Fail("peak", stats.peak, stats.size);
+  }
+  if(recv == 0 || recv == s_iTotal)
+  {
+    Fail("no overflow exercised", recv, s_iTotal);
+  }
+
+  printf("%-32s %s  read %u, dropped %u, peak %u/%u\n", pCase->name, (s_iErrNum == errBefore) ? "PASS" : "FAIL",
+         recv, s_iTotal - recv, stats.peak, stats.size);
+}
+
+/*********************************************************************************************************
+*                                              API函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：main
+* 函数功能：运行全部检查
+* 输入参数：argc、argv-可选的每种情况写入的元素个数
+* 输出参数：void
+* 返 回 值：0--全部通过，1--有失败
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+int main(int argc, char* argv[])
+{
+  struct sigaction act;
+  uint8 i;
+
+  memset(&act, 0, sizeof(act));
+  act.sa_handler = OnIsr;
+  sigemptyset(&act.sa_mask);
+  act.sa_flags = SA_RESTART;
+  sigaction(SIGUSR1, &act, NULL);
+  s_structMain = pthread_self();
+
+  s_iTotal = (argc > 1) ? (uint32)strtoul(argv[1], NULL, 0) : TEST_TOTAL_DEF;
+  s_pLog   = (uint32*)malloc(sizeof(uint32) * (s_iTotal + TEST_FRAME_MAX));
+  if(s_pLog == NULL)
+  {
+    return 1;
+  }
+
+  CheckPolicies();
+  printf("%-32s %s\n", "policy checks", (s_iErrNum == 0) ? "PASS" : "FAIL");
+  for(i = 0; i < sizeof(s_arrCase) / sizeof(s_arrCase[0]); i++)
+  {
+    RunCase(&s_arrCase[i]);
+  }
+  free(s_pLog);
+
+  printf("RingTest: %s\n", (s_iErrNum == 0) ? "PASS" : "FAIL");
+  return (s_iErrNum == 0) ? 0 : 1;
+}
@@ -0,0 +1,526 @@
+/*********************************************************************************************************
+* 模块名称：RxBench.c
+* 摘    要：主循环接收处理的基准测试，求各波特率下持续收包的帧率，并给出ProcRxTask分块和预算取值的依据
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：ProcRxTask依赖全部硬件模块，主机上无法直接运行；这里用真实的Queue.c(串口1接收缓冲区，RING_DROP_NEW)
+*           和PackUnpack.c(UnPackData，含字节间隔超时和RSSI字节)，按Main.c中ProcRxTask的同样循环读出和解包，
+*           时间则是虚拟的：链路按波特率满负荷送来数据包，每包之间只隔FRAME_GAP个字节时间(模块每包一次输出)，
+*           DMA半满、全满以及每包之后的总线空闲时搬入接收缓冲区；
+*           主循环每一步按下面的Cortex-M3周期数模型推进时间，millis()返回虚拟时间；
+*           第一张表：固件的分块和预算在各波特率下送达和解出的帧率、接收缓冲区满丢掉的帧数、解包丢掉的帧数、
+*           缓冲区最高水位、一次ProcRxTask的最长时间(即它能推迟2ms任务的最长时间)和接收处理的CPU占用，
+*           并与原来每2ms只处理1个字节的做法对比；解出的帧数与送达的不等时该行标*，
+*           第二张表：115200波特率、每秒一次较长停顿造成积压时，分块和预算的各种组合；
+*           固件的分块和预算在任一波特率下丢帧则返回1；
+*           最后在主机上实测解包的吞吐量，作为解包本身不是瓶颈的旁证
+* 注    意：make bench运行；周期数模型是按代码路径估算的，不是实测值，结论依赖的是各项的数量级而不是精确值；
+*           空中速率2.4k时模块实际送不出这么多包，这里求的是串口一侧的处理能力
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "PackUnpack.h"
+#include "Queue.h"
+#include "HostCycles.h"
+#include <stdio.h>
+#include <string.h>
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#define FW_CHUNK        32    //同Main.c中的RX_DRAIN_CHUNK
+#define FW_BUDGET       256   //同Main.c中的RX_DRAIN_BUDGET
+
+#define SIM_MS          20000 //每种情况模拟的时间(ms)
+#define FRAME_LEN       (PACKLEN + 1)  //空中的一个数据包在串口上的字节数，末尾1字节RSSI
+#define FRAME_GAP       4              //包与包之间的空闲(字节时间)，超过1个字节时间即触发IDLE中断
+#define DMA_BLOCK       (UART1_RX_DMA_SIZE / 2)  //DMA半满、全满时搬入接收缓冲区的字节数
+
+//Cortex-M3周期数模型(72MHz)，估算值
+#define CPU_MHZ         72
+#define COST_PASS       120     //一轮主循环的固定开销：ProcAlarmTask、标志检查
+#define COST_CHUNK      150     //一次RadioReadData：ReadUART1/DeQueue的关中断、memcpy启动、RSSI噪声应答检查
+#define COST_BYTE       110     //每字节：ProcHostCmd调用、UnPackData状态机、两次millis()
+#define COST_FRAME      4000    //收齐一个数据包：校验和、拷贝结构体、转发给父结点(打包、写64字节到发送缓冲区)
+#define COST_2MS        (300 * CPU_MHZ)   //Proc2msTask：传感器采样滤波、打包上报等，按0.3ms计
+#define STALL_MS        20      //Proc1SecTask中偶尔的长任务(如1024点FFT和特征提取、路由维护)，第一张表按20ms计
+#define STALL_LONG_MS   50      //第二张表按50ms计，积压超过预算
+
+/*********************************************************************************************************
+*                                              枚举结构体定义
+*********************************************************************************************************/
+//一种情况的结果
+typedef struct
+{
+  uint32   offered;       //完整送到串口的帧数
+  uint32   parsed;        //解包成功的帧数
+  uint32   queueDrop;     //接收缓冲区满时被丢掉部分字节的帧数
+  uint32   parseDrop;     //字节完整进入接收缓冲区却没有解出的帧数，含解包超时和失步后重新对齐丢掉的
+  uint16   peak;          //接收缓冲区最高水位
+  uint32   passMaxUs;     //一次ProcRxTask的最长执行时间(us)
+  double   rxBusy;        //接收处理的CPU占用率
+}StructRxResult;
+
+/*********************************************************************************************************
+*                                              内部变量
+*********************************************************************************************************/
+static StructCirQue s_structRecQue;               //串口1接收缓冲区
+static uint8        s_arrRecBuf[UART1_BUF_SIZE];  //接收缓冲区的存储
+static uint8        s_arrFrame[FRAME_LEN];        //一个数据包在串口上的字节
+static double       s_fNowUs;                     //虚拟时间(us)
+static double       s_fByteUs;                    //一个字节的时间(us)，8N1每字节10位
+static uint32       s_iMoved;                     //已经由DMA搬入接收缓冲区的字节数
+static uint32       s_iBaud;                      //模拟的波特率，GetUART1RxLatency用
+static uint32       s_iDamaged;                   //接收缓冲区满时被丢掉部分字节的帧数
+static uint32       s_iDamagedNext;               //下一个还没计入s_iDamaged的帧序号
+static uint8        s_iFail;                      //固件的分块和预算丢了帧
+
+/*********************************************************************************************************
+*                                              内部函数声明
+*********************************************************************************************************/
+static void   MakeFrame(void);                                            //生成一个数据包的串口字节
+static double ByteDoneUs(uint32 n);                                       //第n个字节收完的时刻
+static void   Feed(void);                                                 //把虚拟时间之前DMA收到的数据搬入接收缓冲区
+static double NextFeedUs(void);                                           //下一次DMA搬数据的时刻
+static void   Cost(uint32 cycles, double* pBusy);                         //按周期数推进虚拟时间
+static void   Simulate(uint32 baud, uint16 chunk, uint16 budget, uint8 old, uint16 stall, StructRxResult* pRslt);
+static void   PrintTable1(void);                                          //各波特率的结果
+static void   PrintTable2(void);                                          //分块和预算的组合
+static void   HostThroughput(void);                                       //主机上解包的吞吐量
+
+/*********************************************************************************************************
+*                                              被测模块依赖的函数打桩
+*********************************************************************************************************/
+uint32 millis(void)              { return (uint32)(s_fNowUs / 1000.0); }
+uint32 micros(void)              { return (uint32)s_fNowUs; }
+void   debug(uint8* msg, ...)    { (void)msg; }
+
+//同UART1.c：数据在DMA缓冲区中最长要停留收满半个UART1_RX_DMA_SIZE的时间
+uint16 GetUART1RxLatency(void)
+{
+  return (s_iBaud == 0) ? 0 : (uint16)((uint32)UART1_RX_DMA_SIZE / 2 * 10 * 1000 / s_iBaud);
+}
+
+/*********************************************************************************************************
+*                                              内部函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：MakeFrame
+* 函数功能：生成一个数据分组在串口上的字节：整个StructPackType加1字节RSSI
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：数据部分避开包类型的取值，解包失步时也能很快重新对齐，与实际的传感器数据无关
+*********************************************************************************************************/
+static void MakeFrame(void)
+{
+  StructPackType pack;
+  uint8 i;
+
+  memset(&pack, 0, sizeof(pack));
+  pack.packType = TYPE_DATA;
+  for(i = 0; i < DATALEN; i++)
+  {
+    pack.arrData[i] = (uint8)(0x40 + i);
+  }
+  PackData(&pack);
+  memcpy(s_arrFrame, &pack, PACKLEN);
+  s_arrFrame[PACKLEN] = 0xB0;  //RSSI -80dBm
+}
+
+/*********************************************************************************************************
+* 函数名称：ByteDoneUs
+* 函数功能：求链路上第n个字节收完的时刻
+* 输入参数：n-字节数，从1开始
+* 输出参数：void
+* 返 回 值：时刻(us)
+* 创建日期：2026年10月19日
+* 注    意：每包FRAME_LEN个字节连续发送，包后空闲FRAME_GAP个字节时间
+*********************************************************************************************************/
+static double ByteDoneUs(uint32 n)
+{
+  uint32 frame = (n - 1) / FRAME_LEN;
+
+  return ((double)frame * (FRAME_LEN + FRAME_GAP) + (n - frame * FRAME_LEN)) * s_fByteUs;
+}
+
+/*********************************************************************************************************
+* 函数名称：Feed
+* 函数功能：把虚拟时间之前DMA收到的数据搬入接收缓冲区
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：同UART1.c：DMA半满、全满时搬半块，一包收完后总线空闲1个字节时间触发IDLE中断，搬入剩下的部分；
+*           缓冲区满时EnQueue按RING_DROP_NEW丢弃，被丢掉字节所在的帧计入s_iDamaged
+*********************************************************************************************************/
+static void Feed(void)
+{
+  uint8  arrBlock[DMA_BLOCK];
+  uint32 target;
+  uint32 idle;
+  uint32 first;
+  uint32 last;
+  uint32 n;
+  uint16 acc;
+  uint16 i;
+
+  n      = (uint32)(s_fNowUs / ((FRAME_LEN + FRAME_GAP) * s_fByteUs));  //已经开始的整包数
+  target = (uint32)(s_fNowUs / s_fByteUs) - n * (FRAME_LEN + FRAME_GAP); //当前这一包已经收完的字节数
+  idle   = (target > FRAME_LEN) ? n + 1 : n;                             //已经触发过IDLE中断的包数
+  target = n * FRAME_LEN + ((target < FRAME_LEN) ? target : FRAME_LEN);  //已经收完的字节数
+  target = (idle * FRAME_LEN > target / DMA_BLOCK * DMA_BLOCK) ? idle * FRAME_LEN : target / DMA_BLOCK * DMA_BLOCK;
+
+  while(s_iMoved < target)
+  {
+    n = (target - s_iMoved > DMA_BLOCK) ? DMA_BLOCK : target - s_iMoved;
+    for(i = 0; i < n; i++)
+    {
+      arrBlock[i] = s_arrFrame[(s_iMoved + i) % FRAME_LEN];
+    }
+    acc = (uint16)EnQueue(&s_structRecQue, arrBlock, (int16)n);
+    if(acc < n)
+    {
+      first = (s_iMoved + acc) / FRAME_LEN;
+      first = (first < s_iDamagedNext) ? s_iDamagedNext : first;
+      last  = (s_iMoved + n - 1) / FRAME_LEN;
+      if(last >= first)
+      {
+        s_iDamaged     += last - first + 1;
+        s_iDamagedNext  = last + 1;
+      }
+    }
+    s_iMoved += n;
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：NextFeedUs
+* 函数功能：求下一次DMA搬数据的时刻，WFI睡到这时
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：时刻(us)
+* 创建日期：2026年10月19日
+* 注    意：下一个半块收满，或者当前这一包收完后的IDLE中断，取较早的
+*********************************************************************************************************/
+static double NextFeedUs(void)
+{
+  double half = ByteDoneUs((s_iMoved / DMA_BLOCK + 1) * DMA_BLOCK);
+  double idle = ByteDoneUs((s_iMoved / FRAME_LEN + 1) * FRAME_LEN) + s_fByteUs;
+
+  return (half < idle) ? half : idle;
+}
+
+/*********************************************************************************************************
+* 函数名称：Cost
+* 函数功能：按周期数推进虚拟时间
+* 输入参数：cycles-周期数，pBusy-累计的忙碌时间(us)
+* 输出参数：pBusy
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static void Cost(uint32 cycles, double* pBusy)
+{
+  s_fNowUs += (double)cycles / CPU_MHZ;
+  *pBusy   += (double)cycles / CPU_MHZ;
+}
+
+/*********************************************************************************************************
+* 函数名称：Simulate
+* 函数功能：模拟一种情况的主循环
+* 输入参数：baud-波特率，chunk-每次读出的字节数，budget-每轮最多处理的字节数，
+*           old-1--原来的做法，只在2ms任务中处理1个字节，stall-每秒一次长任务的时间(ms)
+* 输出参数：pRslt-结果
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：主循环与Main.c一致：ProcAlarmTask、ProcRxTask、Proc2msTask、Proc1SecTask，没有数据也没有到期的任务时WFI，
+*           睡到下一次DMA搬数据或下一个2ms节拍；2ms标志只是标志，错过的节拍合并为一次；
+*           模拟结束时把接收缓冲区中剩下的字节解完，送达的帧数只算RSSI字节也已搬入的整帧
+*********************************************************************************************************/
+static void Simulate(uint32 baud, uint16 chunk, uint16 budget, uint8 old, uint16 stall, StructRxResult* pRslt)
+{
+  StructRingStats stats;
+  uint8  arrRec[256];
+  uint32 frames  = 0;        //解包成功的个数
+  double next2ms = 2000.0;   //下一个2ms节拍(us)
+  double next1s  = 1000000.0;
+  double busy    = 0.0;      //其他任务的忙碌时间(us)，只用来推进时间
+  double rxBusy  = 0.0;      //接收处理的忙碌时间(us)
+  double passUs;
+  double wake;
+  uint16 total;
+  uint16 len;
+  uint16 i;
+  uint8  more;
+
+  memset(pRslt, 0, sizeof(*pRslt));
+  InitQueue(&s_structRecQue, s_arrRecBuf, UART1_BUF_SIZE);
+  SetQueuePolicy(&s_structRecQue, RING_DROP_NEW);
+  InitPackUnpack();
+  s_fNowUs  = 0.0;
+  s_fByteUs = 10.0 * 1000000.0 / baud;
+  s_iMoved  = 0;
+  s_iBaud   = baud;
+  s_iDamaged     = 0;
+  s_iDamagedNext = 0;
+
+  while(s_fNowUs < SIM_MS * 1000.0)
+  {
+    Feed();
+    Cost(COST_PASS, &busy);
+
+    //ProcRxTask，循环与Main.c相同
+    more = 0;
+    if(!old)
+    {
+      passUs = s_fNowUs;
+      total  = 0;
+      do
+      {
+        Feed();
+        len = DeQueue(&s_structRecQue, arrRec, chunk);
+        Cost(COST_CHUNK, &rxBusy);
+        for(i = 0; i < len; i++)
+        {
+          Cost(COST_BYTE, &rxBusy);
+          while(UnPackData(arrRec[i]))  //同ProcHostCmd，返回1后再送同一个字节
+          {
+            frames++;
+            Cost(COST_FRAME, &rxBusy);
+          }
+        }
+        total += len;
+      }while(len == chunk && total < budget);
+      more   = (len == chunk);
+      passUs = s_fNowUs - passUs;
+      pRslt->passMaxUs = (passUs > pRslt->passMaxUs) ? (uint32)passUs : pRslt->passMaxUs;
+    }
+
+    //Proc2msTask，原来的做法在这里读1个字节
+    if(s_fNowUs >= next2ms)
+    {
+      if(old && DeQueue(&s_structRecQue, arrRec, 1) == 1)
+      {
+        Cost(COST_CHUNK + COST_BYTE, &rxBusy);
+        while(UnPackData(arrRec[0]))
+        {
+          frames++;
+          Cost(COST_FRAME, &rxBusy);
+        }
+      }
+      Cost(COST_2MS, &busy);
+      while(next2ms <= s_fNowUs)
+      {
+        next2ms += 2000.0;
+      }
+    }
+
+    //Proc1SecTask
+    if(s_fNowUs >= next1s)
+    {
+      Cost(stall * 1000 * CPU_MHZ, &busy);
+      next1s += 1000000.0;
+    }
+
+    //WFI
+    Feed();
+    if(!more && QueueEmpty(&s_structRecQue) && s_fNowUs < next2ms)
+    {
+      wake     = NextFeedUs();
+      wake     = (wake < next2ms) ? wake : next2ms;
+      s_fNowUs = (wake > s_fNowUs) ? wake : s_fNowUs;
+    }
+  }
+
+  //解完接收缓冲区中剩下的字节，虚拟时间不再推进
+  while((len = DeQueue(&s_structRecQue, arrRec, chunk)) > 0)
+  {
+    for(i = 0; i < len; i++)
+    {
+      while(UnPackData(arrRec[i]))
+      {
+        frames++;
+      }
+    }
+  }
+
+  GetQueueStats(&s_structRecQue, &stats);
+  pRslt->offered   = s_iMoved / FRAME_LEN;
+  pRslt->parsed    = frames;
+  pRslt->queueDrop = s_iDamaged;
+  pRslt->parseDrop = (pRslt->offered > s_iDamaged + frames) ? pRslt->offered - s_iDamaged - frames : 0;
+  pRslt->peak         = stats.peak;
+  pRslt->rxBusy       = rxBusy / s_fNowUs;
+}
+
+/*********************************************************************************************************
+* 函数名称：PrintTable1
+* 函数功能：固件的分块和预算以及原来的做法在各波特率下的结果
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：原来的做法一轮主循环只在2ms任务中处理1个字节，没有单独的接收处理时间；
+*           固件的做法解出的帧数与送达的不等时置s_iFail
+*********************************************************************************************************/
+static void PrintTable1(void)
+{
+  static const uint32 arrBaud[5] = {9600, 19200, 38400, 57600, 115200};
+  StructRxResult rslt;
+  uint8 i;
+  uint8 old;
+
+  printf("sustained receive: %u-byte frames, %u-byte gap, %u ms stall once a second, %u s simulated\n",
+         (unsigned)FRAME_LEN, FRAME_GAP, STALL_MS, SIM_MS / 1000);
+  printf("%-17s %7s %9s %9s %7s %10s %6s %9s %7s\n",
+         "", "baud", "offered/s", "parsed/s", "q drop", "parse drop", "peak", "rx pass", "rx cpu");
+  for(old = 0; old <= 1; old++)
+  {
+    for(i = 0; i < 5; i++)
+    {
+      Simulate(arrBaud[i], FW_CHUNK, FW_BUDGET, old, STALL_MS, &rslt);
+      printf("%-17s %7u %9.1f %9.1f %7u %10u %6u ", old ? "old 1 byte/2ms" : "chunk 32/bud 256",
+             (unsigned)arrBaud[i], rslt.offered * 1000.0 / SIM_MS, rslt.parsed * 1000.0 / SIM_MS,
+             (unsigned)rslt.queueDrop, (unsigned)rslt.parseDrop, rslt.peak);
+      if(old)
+      {
+        printf("%9s %7s", "-", "-");
+      }
+      else
+      {
+        printf("%7uus %6.2f%%", (unsigned)rslt.passMaxUs, rslt.rxBusy * 100.0);
+        s_iFail |= (rslt.parsed != rslt.offered);
+      }
+      printf("%s\n", (rslt.parsed != rslt.offered) ? " *" : "");
+    }
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：PrintTable2
+* 函数功能：115200波特率下分块和预算的各种组合
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：分块是ProcRxTask栈上的数组，决定每字节分摊的读出开销；预算决定积压时一轮最长处理多久，
+*           也就是2ms任务最多被推迟多久
+*********************************************************************************************************/
+static void PrintTable2(void)
+{
+  static const uint16 arrChunk[5]  = {8, 16, 32, 64, 128};
+  static const uint16 arrBudget[5] = {64, 128, 256, 512, 2048};
+  StructRxResult rslt;
+  uint8 c;
+  uint8 b;
+
+  printf("\n115200 baud, %u ms stall once a second: parsed frames/s, max rx pass, rx cpu, * if any frame dropped;\n"
+         "chunk (rows) x budget (columns)\n", STALL_LONG_MS);
+  printf("%-6s", "chunk");
+  for(b = 0; b < 5; b++)
+  {
+    printf(" %22u", arrBudget[b]);
+  }
+  printf("\n");
+  for(c = 0; c < 5; c++)
+  {
+    printf("%-6u", arrChunk[c]);
+    for(b = 0; b < 5; b++)
+    {
+      if(arrBudget[b] < arrChunk[c])
+      {
+        printf(" %22s", "-");
+        continue;
+      }
+      Simulate(115200, arrChunk[c], arrBudget[b], 0, STALL_LONG_MS, &rslt);
+      printf(" %5.1f %6uus %5.2f%%%c", rslt.parsed * 1000.0 / SIM_MS, (unsigned)rslt.passMaxUs, rslt.rxBusy * 100.0,
+             (rslt.parsed != rslt.offered) ? '*' : ' ');
+    }
+    printf("\n");
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：HostThroughput
+* 函数功能：在主机上实测按固件的分块从接收缓冲区读出并解包的吞吐量
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：虚拟时间停在0，UnPackData的字节间隔超时不会触发
+*********************************************************************************************************/
+static void HostThroughput(void)
+{
+  uint8    arrRec[FW_CHUNK];
+  uint32   frames = 0;
+  uint32   bytes  = 0;
+  uint32   sent   = 0;
+  uint64_t t;
+  uint16   len;
+  uint16   i;
+
+  InitQueue(&s_structRecQue, s_arrRecBuf, UART1_BUF_SIZE);
+  InitPackUnpack();
+  s_fNowUs = 0.0;
+  s_iBaud  = 115200;
+
+  t = HostCycles();
+  while(frames < 200000)
+  {
+    while(QueueFree(&s_structRecQue) >= FRAME_LEN)
+    {
+      EnQueue(&s_structRecQue, s_arrFrame, FRAME_LEN);
+      sent++;
+    }
+    while((len = DeQueue(&s_structRecQue, arrRec, FW_CHUNK)) > 0)
+    {
+      for(i = 0; i < len; i++)
+      {
+        while(UnPackData(arrRec[i]))
+        {
+          frames++;
+        }
+      }
+      bytes += len;
+    }
+  }
+  t = HostCycles() - t;
+
+  printf("\nhost: queue + UnPackData %.1f %s/byte, %.0f %s/frame (%u frames sent, %u parsed)\n",
+         (double)t / bytes, HOST_CYCLES_UNIT, (double)t / frames, HOST_CYCLES_UNIT, (unsigned)sent, (unsigned)frames);
+}
+
+/*********************************************************************************************************
+*                                              API函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：main
+* 函数功能：打印全部结果
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：0-固件的分块和预算没有丢帧，1-丢了帧
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+int main(void)
+{
+  MakeFrame();
+  printf("Cortex-M3 cost model, estimated cycles, not measured: pass %u, chunk %u, byte %u, frame %u, 2ms task %u\n\n",
+         COST_PASS, COST_CHUNK, COST_BYTE, COST_FRAME, COST_2MS);
+  PrintTable1();
+  PrintTable2();
+  HostThroughput();
+
+  return s_iFail;
+}
@@ -0,0 +1,367 @@
+/*********************************************************************************************************
+* 模块名称：SensorTest.c
+* 摘    要：Sensor模块定点换算的主机测试，与双精度浮点的标定公式比较，并比较两者的主机周期数
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：直接包含Sensor.c以调用内部的Convert、Invert，ADC、Timer模块的函数在此打桩；
+*           登记表中每个传感器的默认标定和一批随机标定下，逐个换算全部ADC_FULL_SCALE个读数，
+*           与按Sensor.h标定公式用double算出并四舍五入的结果相差不得超过TEST_TOL_UNIT，
+*           再加上增益量化误差的上界：gain只有shift位小数，舍入误差乘以满量程读数为2^(bits-1-shift)，
+*           14位读数、数值跨度不超过int16时shift至少15，这一项为0；
+*           再检查Invert：报警阈值换算成的读数再换算回来，与阈值之差不超过相邻读数间隔的一半；
+*           最后统计定点换算和浮点换算每次的主机周期数
+* 注    意：make test运行，失败时返回非0；主机有FPU，浮点换算在这里并不慢，
+*           Cortex-M3上软件浮点的真实周期数由目标板上的SensorBench(Sensor.h中SENSOR_BENCH)测量
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "Sensor.c"
+#include "HostCycles.h"
+#include <math.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#define TEST_TOL_UNIT   1     //允许与浮点结果相差的最小单位数
+#define TEST_RAND_CAL   2000  //随机标定的组数
+#define TEST_BENCH_REP  64    //计时时重复换算全部读数的遍数
+
+/*********************************************************************************************************
+*                                              内部变量
+*********************************************************************************************************/
+static uint32 s_iSeed   = 0x2545F491;  //随机数种子
+static uint32 s_iErrNum = 0;           //检查失败的次数
+
+/*********************************************************************************************************
+*                                              内部函数声明
+*********************************************************************************************************/
+static uint32 NextRand(void);                                         //xorshift32伪随机数
+static double RefValue(const StructSensorDef* pDef, const StructSensorCal* pCal, uint16 adc); //浮点标定公式
+static int16  RefConvert(const StructSensorDef* pDef, const StructSensorCal* pCal, uint16 adc); //浮点结果四舍五入并限幅
+static int32  CheckConvert(uint8 idx, const char* pName, uint8 print);//比较全部读数，返回最大误差
+static void   CheckInvert(uint8 idx, const char* pName);              //检查Invert
+static void   CheckRandomCal(void);                                   //随机标定
+static void   Bench(uint8 idx);                                       //比较定点与浮点换算的主机周期数
+
+/*********************************************************************************************************
+*                                              ADC、Timer模块打桩
+*********************************************************************************************************/
+uint8  ReadADCBuf(uint8 ch, uint16* p)                      { (void)ch; (void)p; return 0; }
+uint16 ReadADCBlock(uint8 ch, uint16* p, uint16 len)        { (void)ch; (void)p; (void)len; return 0; }
+void   SetADCAlarm(uint8 ch, uint16 low, uint16 high)       { (void)ch; (void)low; (void)high; }
+void   ClearADCAlarm(uint8 ch)                              { (void)ch; }
+uint8  ReadADCAlarm(StructADCAlarm* pAlarm)                 { (void)pAlarm; return 0; }
+uint32 millis(void)                                         { return 0; }
+
+/*********************************************************************************************************
+*                                              内部函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：NextRand
+* 函数功能：xorshift32伪随机数
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：随机数
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static uint32 NextRand(void)
+{
+  s_iSeed ^= s_iSeed << 13;
+  s_iSeed ^= s_iSeed >> 17;
+  s_iSeed ^= s_iSeed << 5;
+
+  return s_iSeed;
+}
+
+/*********************************************************************************************************
+* 函数名称：RefValue
+* 函数功能：按Sensor.h中的标定公式用double换算
+* 输入参数：pDef-登记表项，pCal-标定参数，adc-ADC读数
+* 输出参数：void
+* 返 回 值：未取整的数值
+* 创建日期：2026年10月19日
+* 注    意：线性：数值 = refVal + scale * (电压 - refUV) / slopeUV，电压 = adc * vrefUV / 2^bits；
+*           供电电压：VDDA(mV) = Vrefint(mV) * 2^bits / adc
+*********************************************************************************************************/
+static double RefValue(const StructSensorDef* pDef, const StructSensorCal* pCal, uint16 adc)
+{
+  double full = (double)(1UL << pCal->bits);
+  double uv;
+
+  if(pDef->conv == SENSOR_CONV_SUPPLY)
+  {
+    return (adc == 0) ? 0.0 : (pCal->refUV / 1000) * full / adc;
+  }
+
+  uv = adc * (double)pCal->vrefUV / full;
+  return pCal->refVal + (double)pCal->scale * (uv - pCal->refUV) / pCal->slopeUV;
+}
+
+/*********************************************************************************************************
+* 函数名称：RefConvert
+* 函数功能：浮点结果四舍五入并限幅
+* 输入参数：pDef-登记表项，pCal-标定参数，adc-ADC读数
+* 输出参数：void
+* 返 回 值：数值
+* 创建日期：2026年10月19日
+* 注    意：供电电压读数为0时与Convert一样返回0
+*********************************************************************************************************/
+static int16 RefConvert(const StructSensorDef* pDef, const StructSensorCal* pCal, uint16 adc)
+{
+  double value = floor(RefValue(pDef, pCal, adc) + 0.5);
+
+  if(pDef->conv == SENSOR_CONV_SUPPLY && adc == 0)
+  {
+    return 0;
+  }
+  if(value > 32767.0)
+  {
+    return 32767;
+  }
+  if(value < -32768.0)
+  {
+    return -32768;
+  }
+
+  return (int16)value;
+}
+
+/*********************************************************************************************************
+* 函数名称：CheckConvert
+* 函数功能：逐个换算全部读数，与浮点结果比较
+* 输入参数：idx-登记表下标，pName-打印的名称，print-1--打印结果
+* 输出参数：void
+* 返 回 值：最大误差(最小单位)，超过允许误差时计为失败
+* 创建日期：2026年10月19日
+* 注    意：换算系数为当前s_arrSensorCal[idx]标定后的值
+*********************************************************************************************************/
+static int32 CheckConvert(uint8 idx, const char* pName, uint8 print)
+{
+  const StructSensorCal* pCal = &s_arrSensorCal[idx];
+  int32  tol = TEST_TOL_UNIT + ((1L << (pCal->bits - 1)) >> s_arrSensorState[idx].conv.shift);  //允许的误差
+  int32  err;
+  int32  errMax = 0;
+  uint16 errAdc = 0;
+  uint32 adc;
+
+  if(s_arrSensorDef[idx].conv == SENSOR_CONV_SUPPLY)
+  {
+    tol = TEST_TOL_UNIT;
+  }
+
+  for(adc = 0; adc < (1UL << pCal->bits); adc++)
+  {
+    err = abs((int32)Convert(idx, (uint16)adc) - RefConvert(&s_arrSensorDef[idx], pCal, (uint16)adc));
+    if(err > errMax)
+    {
+      errMax = err;
+      errAdc = (uint16)adc;
+    }
+  }
+
+  if(errMax > tol)
+  {
+    s_iErrNum++;
+    printf("  FAIL: %s adc %u: fixed %d, float %.3f (refUV %d refVal %d slopeUV %d scale %d vrefUV %u bits %u)\n",
+           pName, errAdc, Convert(idx, errAdc), RefValue(&s_arrSensorDef[idx], pCal, errAdc),
+           (int)pCal->refUV, pCal->refVal, (int)pCal->slopeUV, pCal->scale, (unsigned)pCal->vrefUV, pCal->bits);
+  }
+  if(print)
+  {
+    printf("%-24s %s  max err %d/%d unit (gain %d >> %u, offset %d)\n", pName, (errMax > tol) ? "FAIL" : "PASS",
+           (int)errMax, (int)tol, (int)s_arrSensorState[idx].conv.gain, s_arrSensorState[idx].conv.shift,
+           (int)s_arrSensorState[idx].conv.offset);
+  }
+
+  return errMax;
+}
+
+/*********************************************************************************************************
+* 函数名称：CheckInvert
+* 函数功能：检查Invert，阈值换算成读数再换算回来应最接近原阈值
+* 输入参数：idx-登记表下标，pName-打印的名称
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：只检查读数能表示的范围内的阈值，超出范围时Invert取边界读数
+*********************************************************************************************************/
+static void CheckInvert(uint8 idx, const char* pName)
+{
+  int32  lo = 32767;
+  int32  hi = -32768;
+  int32  value;
+  int32  back;
+  int32  step;
+  uint16 adc;
+  uint32 i;
+  uint32 errBefore = s_iErrNum;
+
+  for(i = 1; i < ADC_FULL_SCALE; i++)
+  {
+    value = Convert(idx, (uint16)i);
+    lo = (value < lo) ? value : lo;
+    hi = (value > hi) ? value : hi;
+  }
+
+  for(value = lo; value <= hi; value += 1 + (hi - lo) / 4096)
+  {
+    adc  = Invert(idx, (int16)value);
+    back = Convert(idx, adc);
+    step = 0;
+    if(adc + 1 < ADC_FULL_SCALE)
+    {
+      step = abs(Convert(idx, adc + 1) - back);
+    }
+    if(adc > 1 && abs(back - Convert(idx, adc - 1)) > step)
+    {
+      step = abs(back - Convert(idx, adc - 1));
+    }
+    if(abs(back - value) > step / 2 + TEST_TOL_UNIT)
+    {
+      s_iErrNum++;
+      printf("  FAIL: %s invert %d -> adc %u -> %d (step %d)\n", pName, (int)value, adc, (int)back, (int)step);
+      break;
+    }
+  }
+
+  printf("%-24s %s  invert %d..%d\n", pName, (s_iErrNum == errBefore) ? "PASS" : "FAIL", (int)lo, (int)hi);
+}
+
+/*********************************************************************************************************
+* 函数名称：CheckRandomCal
+* 函数功能：用随机标定参数检查线性换算
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：参数范围覆盖正负斜率、12~16位读数和1.8V~3.6V参考电压，借用登记表第一个线性传感器；
+*           满量程对应的数值跨度超过int16的标定没有意义，不参与检查
+*********************************************************************************************************/
+static void CheckRandomCal(void)
+{
+  static const uint8 arrBits[3] = {12, 14, 16};
+  StructSensorCal cal;
+  uint32 errBefore = s_iErrNum;
+  int32  errMax = 0;
+  int32  err;
+  uint32 n;
+  uint8  idx = 0;
+
+  while(s_arrSensorDef[idx].conv != SENSOR_CONV_LINEAR)
+  {
+    idx++;
+  }
+
+  for(n = 0; n < TEST_RAND_CAL && s_iErrNum == errBefore; n++)
+  {
+    cal.vrefUV  = 1800000 + NextRand() % 1800001;
+    cal.bits    = arrBits[NextRand() % 3];
+    cal.refUV   = (int32)(NextRand() % cal.vrefUV);
+    cal.refVal  = (int16)(NextRand() % 20001) - 10000;
+    cal.slopeUV = 100 + (int32)(NextRand() % 100000);
+    cal.slopeUV = (NextRand() & 1) ? cal.slopeUV : -cal.slopeUV;
+    cal.scale   = (int16)(1 + NextRand() % 1000);
+    if((double)cal.scale * cal.vrefUV / fabs((double)cal.slopeUV) > 65535.0)
+    {
+      n--;
+      continue;
+    }
+    SetSensorCal(s_arrSensorDef[idx].id, &cal);
+    err = CheckConvert(idx, "random cal", 0);
+    errMax = (err > errMax) ? err : errMax;
+  }
+  SetSensorCal(s_arrSensorDef[idx].id, &s_arrSensorDef[idx].cal);
+
+  printf("%-24s %s  %u cals, max err %d unit\n", "random linear cal", (s_iErrNum == errBefore) ? "PASS" : "FAIL",
+         (unsigned)n, (int)errMax);
+}
+
+/*********************************************************************************************************
+* 函数名称：Bench
+* 函数功能：比较定点换算与浮点换算的主机周期数
+* 输入参数：idx-登记表下标
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：各换算全部读数TEST_BENCH_REP遍，结果包含函数调用开销
+*********************************************************************************************************/
+static void Bench(uint8 idx)
+{
+  const StructSensorDef* pDef = &s_arrSensorDef[idx];
+  const StructSensorCal* pCal = &s_arrSensorCal[idx];
+  volatile int32 sink = 0;
+  uint64_t fix;
+  uint64_t flt;
+  uint32 rep;
+  uint32 adc;
+
+  fix = HostCycles();
+  for(rep = 0; rep < TEST_BENCH_REP; rep++)
+  {
+    for(adc = 0; adc < ADC_FULL_SCALE; adc++)
+    {
+      sink += Convert(idx, (uint16)adc);
+    }
+  }
+  fix = HostCycles() - fix;
+
+  flt = HostCycles();
+  for(rep = 0; rep < TEST_BENCH_REP; rep++)
+  {
+    for(adc = 0; adc < ADC_FULL_SCALE; adc++)
+    {
+      sink += RefConvert(pDef, pCal, (uint16)adc);
+    }
+  }
+  flt = HostCycles() - flt;
+
+  printf("%-24s fixed %.1f, float %.1f %s/conv\n", pDef->name,
+         (double)fix / (TEST_BENCH_REP * ADC_FULL_SCALE), (double)flt / (TEST_BENCH_REP * ADC_FULL_SCALE), HOST_CYCLES_UNIT);
+  (void)sink;
+}
+
+/*********************************************************************************************************
+*                                              API函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：main
+* 函数功能：运行全部检查
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：0--全部通过，1--有失败
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+int main(void)
+{
+  uint8 i;
+
+  InitSensor();
+  for(i = 0; i < SENSOR_NUM; i++)
+  {
+    CheckConvert(i, s_arrSensorDef[i].name, 1);
+    CheckInvert(i, s_arrSensorDef[i].name);
+  }
+  CheckRandomCal();
+
+  printf("host timing, float is hardware here; run SensorBench on the board for Cortex-M3 soft-float cycles\n");
+  for(i = 0; i < SENSOR_NUM; i++)
+  {
+    Bench(i);
+  }
+
+  printf("SensorTest: %s\n", (s_iErrNum == 0) ? "PASS" : "FAIL");
+  return (s_iErrNum == 0) ? 0 : 1;
+}
@@ -0,0 +1,503 @@
+/*********************************************************************************************************
+* 模块名称：WaveTest.c
+* 摘    要：WaveStream模块的主机测试，数据块压缩解包的往返和块序号的丢块检测
+* 当前版本：1.0.0
+* 作    者：LYL(COPYRIGHT 2026 - 2026 LYL. All rights reserved.)
+* 完成日期：2026年10月19日
+* 内    容：直接包含WaveStream.c，同一份源文件编译两次：
+*           中继节点一侧(SINK为FALSE)：ADC、路由和发送函数打桩，按500Hz每2ms送入一个读数并调用WaveStreamProc，
+*           发出的数据块用WaveUnpack解包，每块的读数须在送入的读数中按顺序连续找到，块序号连续时不能有缺口；
+*           依次检查：心电样的平稳波形逐个读数还原且平均位数不超过WAVE_EST_BITS；满量程随机读数逐个还原；
+*           主循环停顿到ADC队列溢出时序号恰好跳过1，缺口在溢出前的最后一个读数之后；读数多到令牌桶发不完、
+*           发送队列丢弃最旧的块时，序号的缺口之和等于丢弃的块数；格式错误的数据块解包失败；
+*           汇聚节点一侧(-DSINK=TRUE)：WaveCheckSeq对连续、丢块、重复、窗口内迟到、序号回绕、
+*           源节点重启和跟踪表替换的处理
+* 注    意：make test运行，失败时返回非0
+**********************************************************************************************************
+* 取代版本：
+* 作    者：
+* 完成日期：
+* 修改内容：
+* 修改文件：
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              包含头文件
+*********************************************************************************************************/
+#include "WaveStream.c"
+#include <stdio.h>
+#include <math.h>
+
+/*********************************************************************************************************
+*                                              宏定义
+*********************************************************************************************************/
+#define TEST_NODE_ADDR   0x0102  //被测节点的地址
+#define TEST_RATE        500     //波形流的采样率(Hz)，每2ms一个读数
+#define TEST_SMP_NUM     2000    //每种情况最多送入的读数个数，4秒
+#define TEST_AIR_NUM     200     //记录的数据块个数
+#define TEST_HEADROOM    2000    //路径余量(字节/秒)，足够接纳500Hz
+#define TEST_NOT_FOUND   0xFFFF
+
+/*********************************************************************************************************
+*                                              内部变量
+*********************************************************************************************************/
+static uint32 s_iNowMs;                          //millis返回的时刻
+static uint32 s_iErrNum = 0;                     //检查失败的次数
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+#else
+static uint16 s_arrFeed[TEST_SMP_NUM];           //送入ADC波形流队列的读数，不含溢出丢弃的
+static uint16 s_iFeedNum;                        //送入的读数个数
+static uint16 s_iFeedRd;                         //已被ReadADCWave读走的个数
+static uint32 s_iAdcLost;                        //GetADCWaveLost返回的丢弃个数
+static uint16 s_iGapPos;                         //第一次溢出时送入的读数个数，即缺口的位置
+static uint8  s_arrAir[TEST_AIR_NUM][DATALEN];   //发给父结点的数据块，长度之后补0
+static uint8  s_arrAirLen[TEST_AIR_NUM];
+static uint8  s_iAirNum;
+static uint32 s_iRand = 1;                       //随机读数的种子
+static StructWaveBlock s_structBlock;            //解包结果
+//Collect的结果
+static uint16 s_iBadNum;                         //解包失败、头部不对或读数在送入的读数中找不到的块数
+static uint16 s_iHoleNum;                        //序号连续、读数却不连续的块数
+static uint16 s_iSkipNum;                        //序号缺口之和
+static uint16 s_iGapSkip;                        //从s_iGapPos开始的块之前的序号缺口
+static uint16 s_iCovered;                        //最后一块结束的位置
+static uint32 s_iPayloadBits;                    //全部差值位流的位数
+#endif
+
+/*********************************************************************************************************
+*                                              内部函数声明
+*********************************************************************************************************/
+static void   Check(uint8 ok, const char* pName);  //记录一项检查的结果
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+static void   TestSeq(void);                       //WaveCheckSeq的各种序号
+#else
+static uint16 SmoothSmp(uint16 i);                 //心电样的平稳波形
+static uint16 NoiseSmp(uint16 i);                  //满量程随机读数
+static void   Run(uint16 (*pGen)(uint16), uint16 n, uint16 stallAt, uint16 stallLen);  //运行波形流
+static uint16 Find(uint16 from, const StructWaveBlock* pBlock);  //在送入的读数中查找一块
+static void   Collect(void);                       //解包全部数据块并对照送入的读数
+static void   TestSmooth(void);                    //平稳波形的往返
+static void   TestNoise(void);                     //随机读数的往返
+static void   TestAdcGap(void);                    //ADC队列溢出
+static void   TestTxDrop(void);                    //发送队列丢弃最旧的块
+static void   TestMalformed(void);                 //格式错误的数据块
+#endif
+
+/*********************************************************************************************************
+*                                              被测模块依赖的函数打桩
+*********************************************************************************************************/
+uint32 millis(void)                                       { return s_iNowMs; }
+void   debug(uint8* msg, ...)                             { (void)msg; }
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+#else
+uint16 getAddress(void)                                   { return TEST_NODE_ADDR; }
+uint16 StartADCWave(uint8 ch, uint16 rate)                { (void)ch; return (rate >= ADC_WAVE_RATE_MAX) ? ADC_WAVE_RATE_MAX : ADC_WAVE_RATE_MAX / 2; }
+void   StopADCWave(void)                                  { }
+uint32 GetADCWaveLost(void)                               { return s_iAdcLost; }
+uint16 RouteGetHeadroom(void)                             { return TEST_HEADROOM; }
+uint16 RouteGetReserve(void)                              { return 0; }
+void   RouteSetReserve(uint16 load)                       { (void)load; }
+
+uint16 ReadADCWave(uint16* p, uint16 len)
+{
+  uint16 n = 0;
+
+  while(n < len && s_iFeedRd < s_iFeedNum)
+  {
+    p[n++] = s_arrFeed[s_iFeedRd++];
+  }
+  return n;
+}
+
+uint8 SendWaveToParent(uint8* pWave, uint8 len)
+{
+  if(s_iAirNum < TEST_AIR_NUM)
+  {
+    memset(s_arrAir[s_iAirNum], 0, DATALEN);
+    memcpy(s_arrAir[s_iAirNum], pWave, len);
+    s_arrAirLen[s_iAirNum] = len;
+    s_iAirNum++;
+  }
+  return 1;
+}
+#endif
+
+/*********************************************************************************************************
+*                                              内部函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：Check
+* 函数功能：记录并打印一项检查的结果
+* 输入参数：ok-1--通过，pName-检查项的名称
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static void Check(uint8 ok, const char* pName)
+{
+  if(!ok)
+  {
+    s_iErrNum++;
+  }
+  printf("%-52s %s\n", pName, ok ? "PASS" : "FAIL");
+}
+
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+/*********************************************************************************************************
+* 函数名称：TestSeq
+* 函数功能：检查WaveCheckSeq对各种块序号的处理
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：源节点重启后序号从0开始，回退远超WAVE_SEQ_WINDOW，须重新同步而不是一直当作迟到的块丢弃
+*********************************************************************************************************/
+static void TestSeq(void)
+{
+  uint16 lost;
+  uint8  ok;
+  uint8  i;
+
+  InitWaveStream();
+  Check(WaveCheckSeq(0x0101, 100, &lost) == 1 && lost == 0, "first block of a stream, no loss");
+  Check(WaveCheckSeq(0x0101, 101, &lost) == 1 && lost == 0, "next block, no loss");
+  Check(WaveCheckSeq(0x0101, 104, &lost) == 1 && lost == 2, "gap of 2 blocks counted");
+  Check(WaveCheckSeq(0x0101, 104, &lost) == 0, "duplicate block dropped");
+  Check(WaveCheckSeq(0x0101, 105 - WAVE_SEQ_WINDOW, &lost) == 0, "late block within WAVE_SEQ_WINDOW dropped");
+  Check(WaveCheckSeq(0x0101, 105, &lost) == 1 && lost == 0, "stream continues after late block");
+
+  ok = (WaveCheckSeq(0x0101, 0, &lost) == 1 && lost == 0);
+  ok = ok && (WaveCheckSeq(0x0101, 1, &lost) == 1 && lost == 0);
+  Check(ok, "source restart from seq 0 resyncs");
+
+  ok = (WaveCheckSeq(0x0202, 0xFFFE, &lost) == 1);
+  ok = ok && (WaveCheckSeq(0x0202, 0xFFFF, &lost) == 1 && lost == 0);
+  ok = ok && (WaveCheckSeq(0x0202, 0, &lost) == 1 && lost == 0);
+  ok = ok && (WaveCheckSeq(0x0202, 2, &lost) == 1 && lost == 1);
+  Check(ok, "seq wraps from 0xFFFF to 0");
+
+  ok = (WaveCheckSeq(0x0303, 50, &lost) == 1);
+  ok = ok && (WaveCheckSeq(0x0303, 50 - WAVE_SEQ_WINDOW, &lost) == 1 && lost == 0);
+  ok = ok && (WaveCheckSeq(0x0303, 51 - WAVE_SEQ_WINDOW, &lost) == 1 && lost == 0);
+  Check(ok, "step back of WAVE_SEQ_WINDOW + 1 resyncs");
+
+  ok = 1;
+  for(i = 0; i < WAVE_SRC_MAX; i++)
+  {
+    ok = ok && (WaveCheckSeq(0x0400 + i, 7, &lost) == 1 && lost == 0);
+  }
+  ok = ok && (WaveCheckSeq(0x0101, 3, &lost) == 1 && lost == 0);
+  Check(ok, "more than WAVE_SRC_MAX streams, evicted one restarts");
+}
+#else
+/*********************************************************************************************************
+* 函数名称：SmoothSmp
+* 函数功能：生成心电样的平稳波形
+* 输入参数：i-读数的序号
+* 输出参数：void
+* 返 回 值：ADC_RESULT_BITS位的读数
+* 创建日期：2026年10月19日
+* 注    意：半量程基线上叠加1.2Hz的缓慢起伏和几个LSB的噪声，每秒一个10ms宽的尖峰，相邻读数最多差600
+*********************************************************************************************************/
+static uint16 SmoothSmp(uint16 i)
+{
+  uint16 t = i % TEST_RATE;
+  int32  v;
+
+  v  = ADC_FULL_SCALE / 2 + (int32)(300 * sin(2 * 3.14159265 * 1.2 * i / TEST_RATE));
+  v += (int32)((i * 7u) % 5) - 2;
+  if(t < 10)
+  {
+    v += ((t < 5) ? t : 10 - t) * 600;
+  }
+  return (uint16)v;
+}
+
+/*********************************************************************************************************
+* 函数名称：NoiseSmp
+* 函数功能：生成满量程随机读数
+* 输入参数：i-读数的序号，不用
+* 输出参数：void
+* 返 回 值：ADC_RESULT_BITS位的读数
+* 创建日期：2026年10月19日
+* 注    意：差值zigzag编码后多为ADC_RESULT_BITS + 1位，一块只能装下二十几个读数
+*********************************************************************************************************/
+static uint16 NoiseSmp(uint16 i)
+{
+  (void)i;
+  s_iRand = s_iRand * 1103515245 + 12345;
+  return (uint16)((s_iRand >> 16) % ADC_FULL_SCALE);
+}
+
+/*********************************************************************************************************
+* 函数名称：Run
+* 函数功能：以TEST_RATE开始波形流，每2ms送入一个读数并调用WaveStreamProc，最后发完全部读数
+* 输入参数：pGen-读数生成函数，n-读数个数，stallAt、stallLen-从第stallAt个读数起主循环停顿stallLen个读数的时间
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：停顿时ADC队列攒满ADC_WAVE_BUF_SIZE个读数后，与ADC.c一样丢弃新读数
+*********************************************************************************************************/
+static void Run(uint16 (*pGen)(uint16), uint16 n, uint16 stallAt, uint16 stallLen)
+{
+  uint16 i;
+
+  s_iFeedNum = 0;
+  s_iFeedRd  = 0;
+  s_iAirNum  = 0;
+  s_iGapPos  = TEST_NOT_FOUND;
+  StartWaveStream(TEST_RATE);
+
+  for(i = 0; i < n; i++)
+  {
+    if(s_iFeedNum - s_iFeedRd >= ADC_WAVE_BUF_SIZE)
+    {
+      s_iAdcLost++;
+      if(s_iGapPos == TEST_NOT_FOUND)
+      {
+        s_iGapPos = s_iFeedNum;
+      }
+    }
+    else
+    {
+      s_arrFeed[s_iFeedNum++] = pGen(i);
+    }
+    if(i < stallAt || i >= stallAt + stallLen)
+    {
+      WaveStreamProc();
+    }
+    s_iNowMs += 2;
+  }
+
+  FlushPend();
+  while(s_iTxNum > 0)
+  {
+    WaveStreamProc();
+    s_iNowMs += 2;
+  }
+  StopWaveStream();
+}
+
+/*********************************************************************************************************
+* 函数名称：Find
+* 函数功能：从送入的第from个读数起，查找与数据块的读数完全相同的一段
+* 输入参数：from-开始查找的位置，pBlock-解包的数据块
+* 输出参数：void
+* 返 回 值：这段读数的开始位置，TEST_NOT_FOUND--找不到
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static uint16 Find(uint16 from, const StructWaveBlock* pBlock)
+{
+  uint16 p;
+
+  for(p = from; p + pBlock->num <= s_iFeedNum; p++)
+  {
+    if(memcmp(&s_arrFeed[p], pBlock->arrSmp, pBlock->num * sizeof(uint16)) == 0)
+    {
+      return p;
+    }
+  }
+  return TEST_NOT_FOUND;
+}
+
+/*********************************************************************************************************
+* 函数名称：Collect
+* 函数功能：解包发出的全部数据块，对照送入的读数和块序号
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：结果放在s_iBadNum等变量中
+*********************************************************************************************************/
+static void Collect(void)
+{
+  uint16 cursor = 0;
+  uint16 prevSeq = 0;
+  uint16 skip;
+  uint16 p;
+  uint8  k;
+
+  s_iBadNum      = 0;
+  s_iHoleNum     = 0;
+  s_iSkipNum     = 0;
+  s_iGapSkip     = 0;
+  s_iPayloadBits = 0;
+
+  for(k = 0; k < s_iAirNum; k++)
+  {
+    if(s_arrAirLen[k] > DATALEN || !WaveUnpack(s_arrAir[k], &s_structBlock) ||
+       s_structBlock.addr != TEST_NODE_ADDR || s_structBlock.module != WAVE_MODULE ||
+       s_structBlock.secondId != WAVE_SECOND_ID || s_structBlock.rate != TEST_RATE)
+    {
+      s_iBadNum++;
+      continue;
+    }
+
+    skip = (k == 0) ? 0 : (uint16)(s_structBlock.seq - prevSeq - 1);
+      p = Find(cursor, &s_structBlock);
+    if(p == TEST_NOT_FOUND)
+    {
+      s_iBadNum++;
+      continue;
+    }
+    if(p != cursor && skip == 0)
+    {
+      s_iHoleNum++;
+    }
+    if(p == s_iGapPos)
+    {
+      s_iGapSkip = skip;
+    }
+
+    s_iSkipNum     += skip;
+    s_iPayloadBits += (s_arrAirLen[k] - WAVE_HEAD_LEN) * 8;
+    cursor  = p + s_structBlock.num;
+    prevSeq = s_structBlock.seq;
+  }
+  s_iCovered = cursor;
+}
+
+/*********************************************************************************************************
+* 函数名称：TestSmooth
+* 函数功能：心电样的平稳波形逐个读数还原，压缩效果不差于接纳时的估算
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static void TestSmooth(void)
+{
+  double bits;
+
+  Run(SmoothSmp, TEST_SMP_NUM, TEST_NOT_FOUND, 0);
+  Collect();
+  bits = (double)s_iPayloadBits / s_iFeedNum;
+  printf("smooth: %u blocks, %.2f bits per reading\n", s_iAirNum, bits);
+  Check(s_iAirNum > 0 && s_iBadNum == 0 && s_iHoleNum == 0 && s_iSkipNum == 0 && s_iCovered == s_iFeedNum,
+        "ECG-like stream round trip exact");
+  Check(bits <= WAVE_EST_BITS, "ECG-like stream within WAVE_EST_BITS");
+}
+
+/*********************************************************************************************************
+* 函数名称：TestNoise
+* 函数功能：满量程随机读数逐个还原
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：读数少，令牌桶和发送队列来得及，不丢块
+*********************************************************************************************************/
+static void TestNoise(void)
+{
+  Run(NoiseSmp, 100, TEST_NOT_FOUND, 0);
+  Collect();
+  Check(s_iAirNum > 1 && s_iBadNum == 0 && s_iHoleNum == 0 && s_iSkipNum == 0 && s_iCovered == s_iFeedNum,
+        "full-scale random readings round trip exact");
+}
+
+/*********************************************************************************************************
+* 函数名称：TestAdcGap
+* 函数功能：主循环停顿到ADC队列溢出时，序号恰好跳过1，缺口在溢出前的最后一个读数之后
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：停顿600ms，队列攒满256个读数后再丢44个；队列中攒下的读数在缺口之前，
+*           一下压缩成几块，发送队列还会丢弃最旧的，这些缺口另计
+*********************************************************************************************************/
+static void TestAdcGap(void)
+{
+  uint16 seq0 = s_iSeq;
+
+  Run(SmoothSmp, TEST_SMP_NUM, 777, 300);
+  Collect();
+  Check(s_iGapPos != TEST_NOT_FOUND && s_iBadNum == 0 && s_iHoleNum == 0 && s_iCovered == s_iFeedNum,
+        "every hole around an ADC overflow shows as a seq gap");
+  Check(s_iGapSkip == 1, "ADC overflow skips one seq right at the gap");
+  Check(s_iAirNum + s_iSkipNum == (uint16)(s_iSeq - seq0), "seq gaps sum to dropped blocks plus the overflow");
+}
+
+/*********************************************************************************************************
+* 函数名称：TestTxDrop
+* 函数功能：读数多到令牌桶发不完，发送队列丢弃最旧的块，序号的缺口之和等于丢弃的块数
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：随机读数每块只装二十几个，每秒约20块，超过按WAVE_EST_BITS预留的约10包/秒
+*********************************************************************************************************/
+static void TestTxDrop(void)
+{
+  uint16 seq0 = s_iSeq;
+
+  Run(NoiseSmp, 1000, TEST_NOT_FOUND, 0);
+  Collect();
+  printf("tx drop: %u blocks made, %u sent\n", (uint16)(s_iSeq - seq0), s_iAirNum);
+  Check(s_iBadNum == 0 && s_iHoleNum == 0 && s_iCovered == s_iFeedNum, "every hole in the readings shows as a seq gap");
+  Check(s_iSkipNum > 0 && s_iAirNum + s_iSkipNum == (uint16)(s_iSeq - seq0), "seq gaps sum to the dropped blocks");
+}
+
+/*********************************************************************************************************
+* 函数名称：TestMalformed
+* 函数功能：格式错误的数据块解包失败
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+static void TestMalformed(void)
+{
+  uint8 arrBlock[DATALEN];
+
+  memset(arrBlock, 0, DATALEN);
+  arrBlock[8]  = 1;
+  arrBlock[9]  = 0x12;
+  arrBlock[10] = 0x34;
+  Check(WaveUnpack(arrBlock, &s_structBlock) == 1 && s_structBlock.arrSmp[0] == 0x1234, "single-reading block");
+
+  arrBlock[8] = 0;
+  Check(WaveUnpack(arrBlock, &s_structBlock) == 0, "zero readings rejected");
+  arrBlock[8] = WAVE_SMP_MAX + 1;
+  Check(WaveUnpack(arrBlock, &s_structBlock) == 0, "more than WAVE_SMP_MAX readings rejected");
+
+  //每组位宽15，几组之后超出数据块
+  arrBlock[8] = WAVE_SMP_MAX;
+  memset(&arrBlock[WAVE_HEAD_LEN], 0xFF, DATALEN - WAVE_HEAD_LEN);
+  Check(WaveUnpack(arrBlock, &s_structBlock) == 0, "bit stream past the block rejected");
+}
+#endif
+
+/*********************************************************************************************************
+*                                              API函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：main
+* 函数功能：运行全部检查
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：0--全部通过，1--有失败
+* 创建日期：2026年10月19日
+* 注    意：
+*********************************************************************************************************/
+int main(void)
+{
+  s_iNowMs = 1000;
+  InitWaveStream();
+
+#if (defined SINK) && (SINK == TRUE)//汇聚节点
+  TestSeq();
+  printf("WaveTest (sink): %s\n", (s_iErrNum == 0) ? "PASS" : "FAIL");
+#else
+  TestSmooth();
+  TestNoise();
+  TestAdcGap();
+  TestTxDrop();
+  TestMalformed();
+  printf("WaveTest (node): %s\n", (s_iErrNum == 0) ? "PASS" : "FAIL");
+#endif
+  return (s_iErrNum == 0) ? 0 : 1;
+}